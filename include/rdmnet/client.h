@@ -31,6 +31,7 @@
 #include "etcpal/uuid.h"
 #include "rdm/uid.h"
 #include "rdmnet/common.h"
+#include "rdmnet/message.h"
 
 /**
  * @addtogroup rdmnet_api_common
@@ -98,6 +99,21 @@ typedef struct RdmnetDestinationAddr
   uint16_t subdevice;
 } RdmnetDestinationAddr;
 
+/** An RDM command to be sent as part of a batch; see rdmnet_controller_send_rdm_commands(). */
+typedef struct RdmnetBatchRdmCommand
+{
+  /** Addressing information for the RDMnet client and responder to which to send the command. */
+  RdmnetDestinationAddr destination;
+  /** Whether this is a GET or a SET command. */
+  rdmnet_command_class_t command_class;
+  /** The command's RDM parameter ID. */
+  uint16_t param_id;
+  /** Any RDM parameter data associated with the command (NULL for no data). */
+  const uint8_t* data;
+  /** Length of any RDM parameter data associated with the command (0 for no data). */
+  uint8_t data_len;
+} RdmnetBatchRdmCommand;
+
 /**
  * @brief Initialize an RdmnetDestinationAddr with a default responder address.
  * @param manu_id The manufacturer ID portion of the default responder's UID.
@@ -316,6 +332,34 @@ typedef struct RdmnetScopeConfig
     (configptr)->static_broker_addr = (broker_addr);                   \
   }
 
+/** The ways in which an RDM command sent with request tracking enabled can complete. */
+typedef enum
+{
+  /** An RDM response to the command was received. */
+  kRdmnetRequestResponseReceived,
+  /** An RPT status message was received in response to the command. */
+  kRdmnetRequestStatusReceived,
+  /** No response was received within the request timeout, including any retries. */
+  kRdmnetRequestTimedOut,
+  /** The connection on which the command was sent was lost before a response was received. */
+  kRdmnetRequestCancelled
+} rdmnet_request_outcome_t;
+
+/** Information about a completed RDM command that was sent with request tracking enabled. */
+typedef struct RdmnetRequestResult
+{
+  /** The sequence number that was returned when the command was sent. */
+  uint32_t seq_num;
+  /** The destination to which the command was sent. */
+  RdmnetDestinationAddr destination;
+  /** How the command completed. */
+  rdmnet_request_outcome_t outcome;
+  /** The response that was received, if outcome is #kRdmnetRequestResponseReceived; otherwise NULL. */
+  const RdmnetRdmResponse* response;
+  /** The status that was received, if outcome is #kRdmnetRequestStatusReceived; otherwise NULL. */
+  const RdmnetRptStatus* status;
+} RdmnetRequestResult;
+
 /**
  * @}
  */
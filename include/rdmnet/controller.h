@@ -148,6 +148,25 @@ typedef void (*RdmnetControllerResponderIdsReceivedCallback)(rdmnet_controller_t
                                                              const RdmnetDynamicUidAssignmentList* list,
                                                              void*                                 context);
 
+/**
+ * @brief An RDM command sent with request tracking enabled has completed.
+ *
+ * Delivered exactly once for each tracked command; see RdmnetControllerRequestTracking. The RDM
+ * response or RPT status message which completes a tracked command is delivered here instead of
+ * through the rdm_response_received or status_received callbacks. If the response arrives in
+ * several parts, each part is delivered here as it arrives, with result->response->more_coming set
+ * on every part but the last; the command completes with the last part.
+ *
+ * @param[in] controller_handle Handle to the controller which sent the RDM command.
+ * @param[in] scope_handle Handle to the scope on which the RDM command was sent.
+ * @param[in] result The outcome of the command, including any response or status received.
+ * @param[in] context Context pointer that was given at the creation of the controller instance.
+ */
+typedef void (*RdmnetControllerRequestCompleteCallback)(rdmnet_controller_t        controller_handle,
+                                                        rdmnet_client_scope_t      scope_handle,
+                                                        const RdmnetRequestResult* result,
+                                                        void*                      context);
+
 /** A set of notification callbacks received about a controller. */
 typedef struct RdmnetControllerCallbacks
 {
@@ -249,6 +268,33 @@ typedef struct RdmnetControllerRdmData
   bool device_label_settable;
 } RdmnetControllerRdmData;
 
+/** The default time to wait for a response to a tracked RDM command before retrying it. */
+#define RDMNET_CONTROLLER_DEFAULT_REQUEST_TIMEOUT_MS 2000
+
+/**
+ * @brief Settings for tracking the RDM commands sent by a controller until they are answered.
+ *
+ * Request tracking is disabled by default. When enabled, the library remembers each RDM command
+ * sent to a single RDMnet client, resends it if no response arrives within timeout_ms, and
+ * delivers its outcome through request_complete once it has been answered, has exhausted its
+ * retries or has been lost with its scope's connection. Commands sent to broadcast addresses are
+ * not tracked.
+ */
+typedef struct RdmnetControllerRequestTracking
+{
+  /** Called when a tracked command completes. Set to enable request tracking; NULL to disable it. */
+  RdmnetControllerRequestCompleteCallback request_complete;
+  /** How long to wait for a response to a command before resending it, in milliseconds. */
+  unsigned int timeout_ms;
+  /** How many times to resend a command that has not been answered before giving up on it. */
+  unsigned int max_retries;
+  /**
+   * The most commands that can await a response from one RDMnet client at a time; 0 for no limit.
+   * Sending further commands to that client fails with #kEtcPalErrWouldBlock until some complete.
+   */
+  unsigned int max_in_flight_per_destination;
+} RdmnetControllerRequestTracking;
+
 /**
  * @brief A default-value initializer for an RdmnetControllerRdmData struct.
  *
@@ -311,6 +357,12 @@ typedef struct RdmnetControllerConfig
    * (optional) Whether to create an LLRP target associated with this controller. Default is false.
    */
   bool create_llrp_target;
+
+  /**
+   * (optional) Settings for tracking sent RDM commands until they are answered. Disabled by
+   * default; see RdmnetControllerRequestTracking.
+   */
+  RdmnetControllerRequestTracking request_tracking;
 } RdmnetControllerConfig;
 
 /**
@@ -327,7 +379,10 @@ typedef struct RdmnetControllerConfig
 #define RDMNET_CONTROLLER_CONFIG_DEFAULT_INIT(manu_id)                                 \
   {                                                                                    \
     {{0}}, {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL}, \
-        RDMNET_CONTROLLER_RDM_DATA_DEFAULT_INIT, {(0x8000 | manu_id), 0}, NULL, false  \
+        RDMNET_CONTROLLER_RDM_DATA_DEFAULT_INIT, {(0x8000 | manu_id), 0}, NULL, false, \
+    {                                                                                  \
+      NULL, RDMNET_CONTROLLER_DEFAULT_REQUEST_TIMEOUT_MS, 0, 0                         \
+    }                                                                                  \
   }
 
 void rdmnet_controller_config_init(RdmnetControllerConfig* config, uint16_t manufacturer_id);
@@ -345,6 +400,11 @@ void rdmnet_controller_set_rdm_cmd_callbacks(RdmnetControllerConfig*
                                              RdmnetControllerLlrpRdmCommandReceivedCallback llrp_rdm_command_received,
                                              uint8_t*                                       response_buf,
                                              void*                                          context);
+void rdmnet_controller_set_request_tracking(RdmnetControllerConfig*                 config,
+                                            RdmnetControllerRequestCompleteCallback request_complete,
+                                            unsigned int                            timeout_ms,
+                                            unsigned int                            max_retries,
+                                            unsigned int                            max_in_flight_per_destination);
 
 etcpal_error_t rdmnet_controller_create(const RdmnetControllerConfig* config, rdmnet_controller_t* handle);
 etcpal_error_t rdmnet_controller_destroy(rdmnet_controller_t controller_handle, rdmnet_disconnect_reason_t reason);
@@ -399,6 +459,12 @@ etcpal_error_t rdmnet_controller_send_set_command(rdmnet_controller_t          c
                                                   const uint8_t*               data,
                                                   uint8_t                      data_len,
                                                   uint32_t*                    seq_num);
+etcpal_error_t rdmnet_controller_send_rdm_commands(rdmnet_controller_t          controller_handle,
+                                                   rdmnet_client_scope_t        scope_handle,
+                                                   const RdmnetBatchRdmCommand* commands,
+                                                   size_t                       num_commands,
+                                                   uint32_t*                    seq_nums,
+                                                   size_t*                      num_sent);
 
 etcpal_error_t rdmnet_controller_send_rdm_ack(rdmnet_controller_t          controller_handle,
                                               rdmnet_client_scope_t        scope_handle,
@@ -161,6 +161,27 @@ public:
     /// If you reach the number of max connections, this number of tcp-level connections are still
     /// supported to reject the connection request.
     unsigned int reject_connections{1000};
+    /// @brief The maximum number of dynamic UID reservations to keep. 0 means infinite.
+    ///
+    /// The broker reserves each dynamic UID it assigns for the component that requested it, so that
+    /// the component gets the same UID back when it reconnects. When this limit is reached, the
+    /// reservation of the component that has been disconnected the longest is discarded.
+    /// Reservations of connected components are never discarded.
+    unsigned int uid_reservations{100000};
+    /// @brief The maximum sustained rate at which client connect requests are processed, per
+    ///        second. 0 means infinite.
+    ///
+    /// When many clients connect at once (e.g. after a site power cycle), processing every connect
+    /// request as it arrives makes the broker spend most of its time contending for its client
+    /// list and telling controllers about new clients. When this limit is reached, device connect
+    /// requests are held in arrival order and processed as the rate allows. Controller connect
+    /// requests are never held.
+    unsigned int connect_rate{0};
+    /// The number of connect requests which can be processed at once before connect_rate applies.
+    unsigned int connect_burst{100};
+    /// The maximum number of device connect requests held because of connect_rate. Requests
+    /// beyond this number are rejected. 0 means infinite.
+    unsigned int deferred_connects{10000};
   };
 
   /// @ingroup rdmnet_broker
@@ -190,6 +211,52 @@ public:
     /// a GUID.
     std::vector<std::string> listen_interfaces;
 
+    /// @brief The maximum number of bytes of queued messages to coalesce into a single send to a client.
+    ///
+    /// When nonzero, the broker drains each client's queues in priority order (broker protocol
+    /// messages, then RPT status messages, then other RPT messages) into a single buffer of up to
+    /// this many bytes and writes it with one send call. Messages larger than this are still sent,
+    /// one at a time. 0 means send each queued message individually.
+    size_t send_batch_size{0};
+
+    /// @brief How long to collect client connects and disconnects before telling controllers about
+    ///        them, in milliseconds.
+    ///
+    /// Changes which happen within this window are combined into as few CLIENT_ADD and
+    /// CLIENT_REMOVE messages as possible, which are packed once and shared between all
+    /// controllers. A longer window combines more changes when many clients connect at once (e.g.
+    /// after a broker restart), at the cost of controllers learning about each change later. 0
+    /// means changes are sent on the broker's next pass through its client queues.
+    unsigned int client_list_update_window_ms{0};
+
+    /// @brief The number of threads used to read and route messages from client sockets.
+    ///
+    /// Client sockets are divided evenly between the threads, each of which waits on its own set
+    /// of sockets, so that routing one client's traffic does not hold up reading from clients
+    /// handled by other threads. 0 means use one thread per available CPU core. Currently only
+    /// supported on Linux; other platforms ignore this setting.
+    unsigned int socket_worker_threads{1};
+
+    /// @brief Whether to pin each socket worker thread to its own CPU core.
+    ///
+    /// Currently only supported on Linux; other platforms ignore this setting.
+    bool pin_socket_worker_threads{false};
+
+    /// @brief The size in bytes of the buffer used to receive data from each client.
+    ///
+    /// Larger buffers let bursts of messages from a client be read from the network stack in fewer
+    /// reads, at the cost of memory per connected client. 0 means use the library default
+    /// (RDMNET_RECV_BUF_DEFAULT_SIZE).
+    size_t recv_buffer_size{0};
+
+    /// @brief The path of a file in which to keep dynamic UID reservations across broker restarts.
+    ///
+    /// When set, reservations are loaded from this file at startup and saved to it periodically and
+    /// at shutdown, so that dynamic-UID components keep their UIDs when the broker restarts and
+    /// controllers don't have to rediscover them. The file is created if it does not exist. Empty
+    /// means reservations are only kept in memory.
+    std::string uid_reservation_file;
+
     Settings() = default;
     Settings(const etcpal::Uuid& cid_in, const rdm::Uid& static_uid_in);
     Settings(const etcpal::Uuid& cid_in, uint16_t rdm_manu_id_in);
@@ -199,6 +266,41 @@ public:
     bool IsValid() const;
   };
 
+  /// @ingroup rdmnet_broker
+  /// @brief Statistics about the pool of buffers used for messages queued to clients.
+  ///
+  /// The pool is shared by all broker instances in a process.
+  struct BufferPoolStats
+  {
+    /// The total number of buffers requested.
+    size_t allocations{0};
+    /// The number of requests satisfied by recycling a previously-released buffer.
+    size_t pool_hits{0};
+    /// The number of requests which required a new heap allocation.
+    size_t heap_allocations{0};
+    /// The number of buffers currently held by client queues.
+    size_t buffers_in_use{0};
+    /// The number of released buffers currently held by the pool for reuse.
+    size_t buffers_free{0};
+  };
+
+  /// @ingroup rdmnet_broker
+  /// @brief Statistics about the connections and connect requests admitted by the broker.
+  struct AdmissionStats
+  {
+    /// The number of TCP connections accepted.
+    size_t connections_accepted{0};
+    /// The number of TCP connections closed immediately because the broker was over its
+    /// connection limits.
+    size_t connections_rejected{0};
+    /// The number of connect requests held because of Limits::connect_rate.
+    size_t connects_deferred{0};
+    /// The number of connect requests rejected because too many were already being held.
+    size_t connects_rejected{0};
+    /// The number of connect requests currently being held.
+    size_t connects_queued{0};
+  };
+
   /// @ingroup rdmnet_broker
   /// @brief A callback interface for notifications from the broker.
   class NotifyHandler
@@ -231,6 +333,8 @@ public:
   etcpal::Error ChangeScope(const std::string& new_scope, rdmnet_disconnect_reason_t disconnect_reason);
 
   const Settings& settings() const;
+  BufferPoolStats buffer_pool_stats() const;
+  AdmissionStats  admission_stats() const;
 
 private:
   std::unique_ptr<BrokerCore> core_;
@@ -143,6 +143,27 @@ public:
       ETCPAL_UNUSED_ARG(scope_handle);
       ETCPAL_UNUSED_ARG(list);
     }
+
+    /// @brief An RDM command sent with request tracking enabled has completed.
+    ///
+    /// This callback does not need to be implemented if Settings::track_requests is false. When it
+    /// is true, the RDM responses and RPT status messages which complete tracked commands are
+    /// delivered here instead of through HandleRdmResponse() and HandleRptStatus(). A response which
+    /// arrives in several parts is delivered one part at a time, with more_coming set on every part
+    /// but the last.
+    ///
+    /// @param controller_handle Handle to controller instance which sent the RDM command.
+    /// @param scope_handle Handle to the scope on which the RDM command was sent.
+    /// @param result The outcome of the command, including any response or status received. The
+    ///               response or status is only valid until this callback returns; save it to keep it.
+    virtual void HandleRequestComplete(Handle               controller_handle,
+                                       ScopeHandle          scope_handle,
+                                       const RequestResult& result)
+    {
+      ETCPAL_UNUSED_ARG(controller_handle);
+      ETCPAL_UNUSED_ARG(scope_handle);
+      ETCPAL_UNUSED_ARG(result);
+    }
   };
 
   /// @ingroup rdmnet_controller_cpp
@@ -187,6 +208,17 @@ public:
     /// (optional) Whether to create an LLRP target associated with this controller.
     bool create_llrp_target{false};
 
+    /// (optional) Whether to track sent RDM commands until they are answered, delivering their
+    /// outcomes via NotifyHandler::HandleRequestComplete().
+    bool track_requests{false};
+    /// (optional) How long to wait for a response to a tracked command before resending it.
+    unsigned int request_timeout_ms{RDMNET_CONTROLLER_DEFAULT_REQUEST_TIMEOUT_MS};
+    /// (optional) How many times to resend an unanswered tracked command before it times out.
+    unsigned int request_max_retries{0};
+    /// (optional) The most tracked commands that can await a response from one RDMnet client at a
+    /// time; 0 for no limit.
+    unsigned int max_requests_in_flight_per_destination{0};
+
     /// Create an empty, invalid data structure by default.
     Settings() = default;
     Settings(const etcpal::Uuid& new_cid, const rdm::Uid& new_uid);
@@ -233,6 +265,43 @@ public:
     bool IsValid() const;
   };
 
+  /// @ingroup rdmnet_controller_cpp
+  /// @brief An RDM command to be sent as part of a batch; see Controller::SendRdmCommands().
+  struct BatchRdmCommand
+  {
+    DestinationAddr        destination;                          ///< Where to send the command.
+    rdmnet_command_class_t command_class{kRdmnetCCGetCommand};  ///< Whether this is a GET or a SET command.
+    uint16_t               param_id{0};                          ///< The command's RDM parameter ID.
+    const uint8_t*         data{nullptr};  ///< (optional) The command's RDM parameter data, if it has any.
+    uint8_t                data_len{0};    ///< (optional) The length of the RDM parameter data.
+
+    /// Create an empty, invalid command by default.
+    BatchRdmCommand() = default;
+    BatchRdmCommand(const DestinationAddr& new_destination,
+                    rdmnet_command_class_t new_command_class,
+                    uint16_t               new_param_id,
+                    const uint8_t*         new_data = nullptr,
+                    uint8_t                new_data_len = 0);
+  };
+
+  /// @ingroup rdmnet_controller_cpp
+  /// @brief The result of sending a batch of RDM commands; see Controller::SendRdmCommands().
+  ///
+  /// Sending stops at the first command which cannot be sent. The commands before it have been
+  /// sent, and their sequence numbers are available even if the batch as a whole failed.
+  struct BatchSendResult
+  {
+    /// The sequence number of each command which was sent, in the order the commands were given.
+    std::vector<uint32_t> seq_nums;
+    /// The error for the first command which could not be sent, or etcpal::Error::Ok() if all
+    /// commands were sent.
+    etcpal::Error error{kEtcPalErrOk};
+
+    size_t num_sent() const noexcept;
+    bool   ok() const noexcept;
+    explicit operator bool() const noexcept;
+  };
+
   Controller() = default;
   Controller(const Controller& other) = delete;
   Controller& operator=(const Controller& other) = delete;
@@ -278,6 +347,10 @@ public:
                                             uint16_t               param_id,
                                             const uint8_t*         data = nullptr,
                                             uint8_t                data_len = 0);
+  BatchSendResult            SendRdmCommands(ScopeHandle            scope_handle,
+                                             const BatchRdmCommand* commands,
+                                             size_t                 num_commands);
+  BatchSendResult            SendRdmCommands(ScopeHandle scope_handle, const std::vector<BatchRdmCommand>& commands);
 
   etcpal::Error RequestClientList(ScopeHandle scope_handle);
   etcpal::Error RequestResponderIds(ScopeHandle scope_handle, const rdm::Uid* uids, size_t num_uids);
@@ -398,6 +471,18 @@ extern "C" inline void ControllerLibCbStatusReceived(rdmnet_controller_t    cont
   }
 }
 
+extern "C" inline void ControllerLibCbRequestComplete(rdmnet_controller_t        controller_handle,
+                                                      rdmnet_client_scope_t      scope_handle,
+                                                      const RdmnetRequestResult* result,
+                                                      void*                      context)
+{
+  if (result && context)
+  {
+    static_cast<Controller::NotifyHandler*>(context)->HandleRequestComplete(Controller::Handle(controller_handle),
+                                                                            ScopeHandle(scope_handle), *result);
+  }
+}
+
 extern "C" inline void ControllerLibCbResponderIdsReceived(rdmnet_controller_t                   controller_handle,
                                                            rdmnet_client_scope_t                 scope_handle,
                                                            const RdmnetDynamicUidAssignmentList* list,
@@ -507,6 +592,38 @@ inline bool Controller::RdmData::IsValid() const
           (!device_label.empty()));
 }
 
+/// Create a BatchRdmCommand instance by passing all members explicitly.
+inline Controller::BatchRdmCommand::BatchRdmCommand(const DestinationAddr& new_destination,
+                                                    rdmnet_command_class_t new_command_class,
+                                                    uint16_t               new_param_id,
+                                                    const uint8_t*         new_data,
+                                                    uint8_t                new_data_len)
+    : destination(new_destination)
+    , command_class(new_command_class)
+    , param_id(new_param_id)
+    , data(new_data)
+    , data_len(new_data_len)
+{
+}
+
+/// The number of commands which were sent.
+inline size_t Controller::BatchSendResult::num_sent() const noexcept
+{
+  return seq_nums.size();
+}
+
+/// Whether all commands in the batch were sent.
+inline bool Controller::BatchSendResult::ok() const noexcept
+{
+  return error.IsOk();
+}
+
+/// Whether all commands in the batch were sent.
+inline Controller::BatchSendResult::operator bool() const noexcept
+{
+  return ok();
+}
+
 /// @brief Allocate resources and start up this controller with the given configuration.
 ///
 /// This overload provides a set of RDM data to the library to use for the controller's RDM
@@ -557,6 +674,12 @@ inline etcpal::Error Controller::Startup(NotifyHandler&  notify_handler,
     settings.uid.get(),             // UID
     settings.search_domain.c_str(), // Search domain
     settings.create_llrp_target,    // Create LLRP target
+    {                               // Request tracking
+      settings.track_requests ? internal::ControllerLibCbRequestComplete : nullptr,
+      settings.request_timeout_ms,
+      settings.request_max_retries,
+      settings.max_requests_in_flight_per_destination
+    }
   };
   // clang-format on
 
@@ -616,6 +739,12 @@ inline etcpal::Error Controller::Startup(NotifyHandler&     notify_handler,
     settings.uid.get(),             // UID
     settings.search_domain.c_str(), // Search domain
     settings.create_llrp_target,    // Create LLRP target
+    {                               // Request tracking
+      settings.track_requests ? internal::ControllerLibCbRequestComplete : nullptr,
+      settings.request_timeout_ms,
+      settings.request_max_retries,
+      settings.max_requests_in_flight_per_destination
+    }
   };
   // clang-format on
 
@@ -793,7 +922,10 @@ inline etcpal::Error Controller::ChangeSearchDomain(const char*                n
 
 /// @brief Send an RDM command from a controller on a scope.
 ///
-/// The response will be delivered via the Controller::NotifyHandler::HandleRdmResponse() callback.
+/// The response will be delivered via either the Controller::NotifyHandler::HandleRdmResponse() or
+/// the Controller::NotifyHandler::HandleRptStatus() callback, depending on the outcome of the
+/// command. If Settings::track_requests is true, the outcome is delivered via the
+/// Controller::NotifyHandler::HandleRequestComplete() callback instead.
 ///
 /// @param scope_handle Handle to the scope on which to send the RDM command.
 /// @param destination The destination addressing information for the RDM command.
@@ -803,6 +935,12 @@ inline etcpal::Error Controller::ChangeSearchDomain(const char*                n
 /// @param data_len [optional] The length of the RDM parameter data (or 0 if data is nullptr).
 /// @return On success, a sequence number which can be used to match the command with a response.
 /// @return On failure, error codes from rdmnet_controller_send_rdm_command().
+/// @return #kEtcPalErrWouldBlock: Too much data is queued for sending on the scope's connection,
+///                               or request tracking is enabled and the destination already has
+///                               the maximum number of commands awaiting a response; try again
+///                               later.
+/// @return #kEtcPalErrNoMem: Request tracking is enabled and no more commands can be tracked on the
+///                          scope.
 inline etcpal::Expected<uint32_t> Controller::SendRdmCommand(ScopeHandle            scope_handle,
                                                              const DestinationAddr& destination,
                                                              rdmnet_command_class_t command_class,
@@ -821,7 +959,10 @@ inline etcpal::Expected<uint32_t> Controller::SendRdmCommand(ScopeHandle
 
 /// @brief Send an RDM GET command from a controller on a scope.
 ///
-/// The response will be delivered via the Controller::NotifyHandler::HandleRdmResponse() callback.
+/// The response will be delivered via either the Controller::NotifyHandler::HandleRdmResponse() or
+/// the Controller::NotifyHandler::HandleRptStatus() callback, depending on the outcome of the
+/// command. If Settings::track_requests is true, the outcome is delivered via the
+/// Controller::NotifyHandler::HandleRequestComplete() callback instead.
 ///
 /// @param scope_handle Handle to the scope on which to send the RDM command.
 /// @param destination The destination addressing information for the RDM command.
@@ -830,6 +971,12 @@ inline etcpal::Expected<uint32_t> Controller::SendRdmCommand(ScopeHandle
 /// @param data_len [optional] The length of the RDM parameter data (or 0 if data is nullptr).
 /// @return On success, a sequence number which can be used to match the command with a response.
 /// @return On failure, error codes from rdmnet_controller_send_get_command().
+/// @return #kEtcPalErrWouldBlock: Too much data is queued for sending on the scope's connection,
+///                               or request tracking is enabled and the destination already has
+///                               the maximum number of commands awaiting a response; try again
+///                               later.
+/// @return #kEtcPalErrNoMem: Request tracking is enabled and no more commands can be tracked on the
+///                          scope.
 inline etcpal::Expected<uint32_t> Controller::SendGetCommand(ScopeHandle            scope_handle,
                                                              const DestinationAddr& destination,
                                                              uint16_t               param_id,
@@ -847,7 +994,10 @@ inline etcpal::Expected<uint32_t> Controller::SendGetCommand(ScopeHandle
 
 /// @brief Send an RDM SET command from a controller on a scope.
 ///
-/// The response will be delivered via the Controller::NotifyHandler::HandleRdmResponse() callback.
+/// The response will be delivered via either the Controller::NotifyHandler::HandleRdmResponse() or
+/// the Controller::NotifyHandler::HandleRptStatus() callback, depending on the outcome of the
+/// command. If Settings::track_requests is true, the outcome is delivered via the
+/// Controller::NotifyHandler::HandleRequestComplete() callback instead.
 ///
 /// @param scope_handle Handle to the scope on which to send the RDM command.
 /// @param destination The destination addressing information for the RDM command.
@@ -856,6 +1006,12 @@ inline etcpal::Expected<uint32_t> Controller::SendGetCommand(ScopeHandle
 /// @param data_len [optional] The length of the RDM parameter data (or 0 if data is nullptr).
 /// @return On success, a sequence number which can be used to match the command with a response.
 /// @return On failure, error codes from rdmnet_controller_send_set_command().
+/// @return #kEtcPalErrWouldBlock: Too much data is queued for sending on the scope's connection,
+///                               or request tracking is enabled and the destination already has
+///                               the maximum number of commands awaiting a response; try again
+///                               later.
+/// @return #kEtcPalErrNoMem: Request tracking is enabled and no more commands can be tracked on the
+///                          scope.
 inline etcpal::Expected<uint32_t> Controller::SendSetCommand(ScopeHandle            scope_handle,
                                                              const DestinationAddr& destination,
                                                              uint16_t               param_id,
@@ -871,6 +1027,64 @@ inline etcpal::Expected<uint32_t> Controller::SendSetCommand(ScopeHandle
     return res;
 }
 
+/// @brief Send a batch of RDM commands from a controller on a scope.
+///
+/// Much cheaper than calling SendRdmCommand() in a loop when polling many responders. The
+/// responses will be delivered via either the Controller::NotifyHandler::HandleRdmResponse() or
+/// the Controller::NotifyHandler::HandleRptStatus() callback. If Settings::track_requests is true,
+/// the outcome of each command is delivered via the
+/// Controller::NotifyHandler::HandleRequestComplete() callback instead.
+///
+/// Sending stops at the first command which cannot be sent. The result holds the sequence numbers
+/// of the commands which were sent, so that the rest can be submitted again later (for example,
+/// after #kEtcPalErrWouldBlock).
+///
+/// @param scope_handle Handle to the scope on which to send the RDM commands.
+/// @param commands Array of RDM commands to send.
+/// @param num_commands Size of the commands array.
+/// @return The sequence numbers of the commands which were sent, and an error which is
+///         etcpal::Error::Ok() if all commands were sent, #kEtcPalErrInvalid on invalid argument,
+///         or otherwise an error code from rdmnet_controller_send_rdm_commands().
+inline Controller::BatchSendResult Controller::SendRdmCommands(ScopeHandle            scope_handle,
+                                                               const BatchRdmCommand* commands,
+                                                               size_t                 num_commands)
+{
+  BatchSendResult result;
+  if (!commands || (num_commands == 0))
+  {
+    result.error = kEtcPalErrInvalid;
+    return result;
+  }
+
+  std::vector<RdmnetBatchRdmCommand> c_commands;
+  c_commands.reserve(num_commands);
+  std::transform(commands, commands + num_commands, std::back_inserter(c_commands), [](const BatchRdmCommand& cmd) {
+    return RdmnetBatchRdmCommand{cmd.destination.get(), cmd.command_class, cmd.param_id, cmd.data, cmd.data_len};
+  });
+
+  size_t num_sent = 0;
+  result.seq_nums.resize(num_commands);
+  result.error = rdmnet_controller_send_rdm_commands(handle_.value(), scope_handle.value(), c_commands.data(),
+                                                     c_commands.size(), result.seq_nums.data(), &num_sent);
+  result.seq_nums.resize(num_sent);
+  return result;
+}
+
+/// @brief Send a batch of RDM commands from a controller on a scope.
+///
+/// See SendRdmCommands(ScopeHandle, const BatchRdmCommand*, size_t) for more information.
+///
+/// @param scope_handle Handle to the scope on which to send the RDM commands.
+/// @param commands List of RDM commands to send.
+/// @return The sequence numbers of the commands which were sent, and an error which is
+///         etcpal::Error::Ok() if all commands were sent, #kEtcPalErrInvalid on invalid argument,
+///         or otherwise an error code from rdmnet_controller_send_rdm_commands().
+inline Controller::BatchSendResult Controller::SendRdmCommands(ScopeHandle                         scope_handle,
+                                                               const std::vector<BatchRdmCommand>& commands)
+{
+  return SendRdmCommands(scope_handle, commands.data(), commands.size());
+}
+
 /// @brief Request a client list from a broker.
 ///
 /// The response will be delivered via the Controller::NotifyHandler::HandleClientListUpdate()
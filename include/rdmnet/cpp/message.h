@@ -34,6 +34,7 @@
 #include "rdmnet/cpp/message_types/llrp_rdm_response.h"
 #include "rdmnet/cpp/message_types/rdm_command.h"
 #include "rdmnet/cpp/message_types/rdm_response.h"
+#include "rdmnet/cpp/message_types/request_result.h"
 #include "rdmnet/cpp/message_types/rpt_client.h"
 #include "rdmnet/cpp/message_types/rpt_status.h"
 
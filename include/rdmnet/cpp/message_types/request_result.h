@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+/// @file rdmnet/cpp/message_types/request_result.h
+/// @brief Definitions for the outcomes of RDM commands sent with request tracking enabled.
+
+#ifndef RDMNET_CPP_MESSAGE_TYPES_REQUEST_RESULT_H_
+#define RDMNET_CPP_MESSAGE_TYPES_REQUEST_RESULT_H_
+
+#include <cstdint>
+#include "rdm/cpp/uid.h"
+#include "rdmnet/client.h"
+#include "rdmnet/cpp/message_types/rdm_response.h"
+#include "rdmnet/cpp/message_types/rpt_status.h"
+
+namespace rdmnet
+{
+/// @ingroup rdmnet_cpp_common
+/// @brief The outcome of an RDM command sent with request tracking enabled, delivered to an RDMnet
+///        callback function.
+///
+/// Not valid for use other than as a parameter to an RDMnet callback function; the response or
+/// status it refers to must likewise be used or saved before the callback returns.
+class RequestResult
+{
+public:
+  /// Not default-constructible.
+  RequestResult() = delete;
+  constexpr RequestResult(const RdmnetRequestResult& c_result) noexcept;
+
+  constexpr uint32_t                 seq_num() const noexcept;
+  constexpr rdmnet_request_outcome_t outcome() const noexcept;
+
+  constexpr rdm::Uid rdmnet_dest_uid() const noexcept;
+  constexpr uint16_t dest_endpoint() const noexcept;
+  constexpr rdm::Uid rdm_dest_uid() const noexcept;
+  constexpr uint16_t dest_subdevice() const noexcept;
+
+  constexpr bool HasResponse() const noexcept;
+  constexpr bool HasStatus() const noexcept;
+  RdmResponse    response() const noexcept;
+  RptStatus      status() const noexcept;
+
+  constexpr const RdmnetRequestResult& get() const noexcept;
+
+private:
+  const RdmnetRequestResult& result_;
+};
+
+/// Construct a RequestResult from an instance of the C RdmnetRequestResult type.
+constexpr RequestResult::RequestResult(const RdmnetRequestResult& c_result) noexcept : result_(c_result)
+{
+}
+
+/// Get the sequence number that was returned when the command was sent.
+constexpr uint32_t RequestResult::seq_num() const noexcept
+{
+  return result_.seq_num;
+}
+
+/// Get how the command completed.
+constexpr rdmnet_request_outcome_t RequestResult::outcome() const noexcept
+{
+  return result_.outcome;
+}
+
+/// Get the UID of the RDMnet component to which the command was sent.
+constexpr rdm::Uid RequestResult::rdmnet_dest_uid() const noexcept
+{
+  return result_.destination.rdmnet_uid;
+}
+
+/// Get the endpoint to which the command was sent.
+constexpr uint16_t RequestResult::dest_endpoint() const noexcept
+{
+  return result_.destination.endpoint;
+}
+
+/// Get the UID of the RDM responder to which the command was sent.
+constexpr rdm::Uid RequestResult::rdm_dest_uid() const noexcept
+{
+  return result_.destination.rdm_uid;
+}
+
+/// Get the sub-device to which the command was sent.
+constexpr uint16_t RequestResult::dest_subdevice() const noexcept
+{
+  return result_.destination.subdevice;
+}
+
+/// Whether an RDM response completed the command; if so, it is available from response().
+constexpr bool RequestResult::HasResponse() const noexcept
+{
+  return (result_.outcome == kRdmnetRequestResponseReceived && result_.response != nullptr);
+}
+
+/// Whether an RPT status message completed the command; if so, it is available from status().
+constexpr bool RequestResult::HasStatus() const noexcept
+{
+  return (result_.outcome == kRdmnetRequestStatusReceived && result_.status != nullptr);
+}
+
+/// @brief Get the RDM response which completed the command.
+/// @pre HasResponse() returns true.
+inline RdmResponse RequestResult::response() const noexcept
+{
+  return {*result_.response};
+}
+
+/// @brief Get the RPT status message which completed the command.
+/// @pre HasStatus() returns true.
+inline RptStatus RequestResult::status() const noexcept
+{
+  return {*result_.status};
+}
+
+/// Get a const reference to the underlying C type.
+constexpr const RdmnetRequestResult& RequestResult::get() const noexcept
+{
+  return result_;
+}
+
+};  // namespace rdmnet
+
+#endif  // RDMNET_CPP_MESSAGE_TYPES_REQUEST_RESULT_H_
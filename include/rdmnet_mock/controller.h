@@ -51,6 +51,12 @@ DECLARE_FAKE_VOID_FUNC(rdmnet_controller_set_rdm_cmd_callbacks,
                        RdmnetControllerLlrpRdmCommandReceivedCallback,
                        uint8_t*,
                        void*);
+DECLARE_FAKE_VOID_FUNC(rdmnet_controller_set_request_tracking,
+                       RdmnetControllerConfig*,
+                       RdmnetControllerRequestCompleteCallback,
+                       unsigned int,
+                       unsigned int,
+                       unsigned int);
 
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rdmnet_controller_create, const RdmnetControllerConfig*, rdmnet_controller_t*);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rdmnet_controller_destroy, rdmnet_controller_t, rdmnet_disconnect_reason_t);
@@ -112,6 +118,14 @@ DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
                         const uint8_t*,
                         uint8_t,
                         uint32_t*);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
+                        rdmnet_controller_send_rdm_commands,
+                        rdmnet_controller_t,
+                        rdmnet_client_scope_t,
+                        const RdmnetBatchRdmCommand*,
+                        size_t,
+                        uint32_t*,
+                        size_t*);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
                         rdmnet_controller_send_rdm_ack,
                         rdmnet_controller_t,
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "broker_admission.h"
+
+#include <algorithm>
+#include "etcpal/timer.h"
+
+// Resets the token bucket and the statistics. Should be called before the broker starts.
+void ConnectAdmission::Configure(const rdmnet::Broker::Limits& limits)
+{
+  etcpal::MutexGuard guard(lock_);
+
+  rate_ = limits.connect_rate;
+  max_tokens_ = std::max(limits.connect_burst, 1u) * kTokenScale;
+  max_deferred_ = limits.deferred_connects;
+
+  tokens_ = max_tokens_;
+  last_refill_ms_ = etcpal_getms();
+
+  deferred_.clear();
+  stats_ = rdmnet::Broker::AdmissionStats{};
+}
+
+// Drops all held connect requests.
+void ConnectAdmission::Clear()
+{
+  etcpal::MutexGuard guard(lock_);
+  deferred_.clear();
+}
+
+// Decides whether a connect request should be processed now, held for later or rejected.
+ConnectAdmission::Decision ConnectAdmission::Admit(BrokerClient::Handle        handle,
+                                                   const RdmnetRptClientEntry& client_entry)
+{
+  etcpal::MutexGuard guard(lock_);
+
+  if (rate_ == 0)
+    return Decision::kAdmit;
+
+  if (client_entry.type == kRPTClientTypeController)
+  {
+    TakeTokenLocked();
+    return Decision::kAdmit;
+  }
+
+  if (deferred_.empty() && TakeTokenLocked())
+    return Decision::kAdmit;
+
+  if (max_deferred_ > 0 && deferred_.size() >= max_deferred_)
+  {
+    ++stats_.connects_rejected;
+    return Decision::kReject;
+  }
+
+  deferred_.push_back(DeferredConnect{handle, client_entry});
+  ++stats_.connects_deferred;
+  return Decision::kDefer;
+}
+
+// Removes and returns up to max_connects held connect requests, in arrival order, for which the
+// rate now allows processing.
+std::vector<ConnectAdmission::DeferredConnect> ConnectAdmission::TakeReady(size_t max_connects)
+{
+  std::vector<DeferredConnect> ready;
+
+  etcpal::MutexGuard guard(lock_);
+  while (!deferred_.empty() && ready.size() < max_connects && TakeTokenLocked())
+  {
+    ready.push_back(deferred_.front());
+    deferred_.pop_front();
+  }
+  return ready;
+}
+
+bool ConnectAdmission::HasDeferred() const
+{
+  etcpal::MutexGuard guard(lock_);
+  return !deferred_.empty();
+}
+
+// Drops the deferred connect request of a client which has gone away, so that it doesn't use up a
+// token or a deferred slot.
+void ConnectAdmission::Remove(BrokerClient::Handle handle)
+{
+  etcpal::MutexGuard guard(lock_);
+  deferred_.erase(std::remove_if(deferred_.begin(), deferred_.end(),
+                                 [handle](const DeferredConnect& connect) { return connect.handle == handle; }),
+                  deferred_.end());
+}
+
+void ConnectAdmission::CountConnections(size_t accepted, size_t rejected)
+{
+  etcpal::MutexGuard guard(lock_);
+  stats_.connections_accepted += accepted;
+  stats_.connections_rejected += rejected;
+}
+
+rdmnet::Broker::AdmissionStats ConnectAdmission::stats() const
+{
+  etcpal::MutexGuard guard(lock_);
+
+  rdmnet::Broker::AdmissionStats result = stats_;
+  result.connects_queued = deferred_.size();
+  return result;
+}
+
+bool ConnectAdmission::TakeTokenLocked()
+{
+  RefillLocked();
+  if (tokens_ < kTokenScale)
+    return false;
+
+  tokens_ -= kTokenScale;
+  return true;
+}
+
+void ConnectAdmission::RefillLocked()
+{
+  uint32_t now = etcpal_getms();
+  // Unsigned subtraction handles the millisecond counter wrapping.
+  uint32_t elapsed_ms = now - last_refill_ms_;
+  last_refill_ms_ = now;
+
+  // Each millisecond adds rate_ thousandths of a token.
+  tokens_ = std::min(max_tokens_, tokens_ + static_cast<uint64_t>(elapsed_ms) * rate_);
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+/// @file broker_admission.h
+
+#ifndef BROKER_ADMISSION_H_
+#define BROKER_ADMISSION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "etcpal/cpp/mutex.h"
+#include "rdmnet/cpp/broker.h"
+#include "broker_client.h"
+
+// Decides when the broker processes client connect requests, and keeps the broker's admission
+// statistics.
+//
+// Connect requests are limited by a token bucket which refills at Limits::connect_rate tokens per
+// second, up to Limits::connect_burst tokens. Controllers are always admitted, and take a token if
+// one is available. Devices are admitted only if a token is available and no earlier device is
+// waiting; otherwise their requests are held in arrival order (up to Limits::deferred_connects of
+// them) until TakeReady() hands them back to be processed.
+//
+// All functions are safe to call from any thread.
+class ConnectAdmission
+{
+public:
+  enum class Decision
+  {
+    kAdmit,
+    kDefer,
+    kReject
+  };
+
+  struct DeferredConnect
+  {
+    BrokerClient::Handle handle;
+    RdmnetRptClientEntry client_entry;
+  };
+
+  ConnectAdmission() = default;
+  ConnectAdmission(const ConnectAdmission& other) = delete;
+  ConnectAdmission& operator=(const ConnectAdmission& other) = delete;
+
+  void Configure(const rdmnet::Broker::Limits& limits);
+  void Clear();
+
+  Decision                     Admit(BrokerClient::Handle handle, const RdmnetRptClientEntry& client_entry);
+  std::vector<DeferredConnect> TakeReady(size_t max_connects);
+  bool                         HasDeferred() const;
+  void                         Remove(BrokerClient::Handle handle);
+
+  void CountConnections(size_t accepted, size_t rejected);
+
+  rdmnet::Broker::AdmissionStats stats() const;
+
+private:
+  // Tokens are counted in thousandths so that they can be refilled every millisecond.
+  static constexpr uint64_t kTokenScale = 1000;
+
+  unsigned int rate_{0};
+  uint64_t     max_tokens_{0};
+  size_t       max_deferred_{0};
+
+  uint64_t tokens_{0};
+  uint32_t last_refill_ms_{0};
+
+  std::deque<DeferredConnect>    deferred_;
+  rdmnet::Broker::AdmissionStats stats_;
+
+  mutable etcpal::Mutex lock_;
+
+  bool TakeTokenLocked();
+  void RefillLocked();
+};
+
+#endif  // BROKER_ADMISSION_H_
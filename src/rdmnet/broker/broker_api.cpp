@@ -20,6 +20,7 @@
 // Implementation of the public rdmnet/cpp/broker API.
 
 #include "rdmnet/cpp/broker.h"
+#include "broker_buffer_pool.h"
 #include "broker_core.h"
 
 /*************************** Function definitions ****************************/
@@ -105,3 +106,22 @@ const rdmnet::Broker::Settings& rdmnet::Broker::settings() const
 
   return core_->settings();
 }
+
+/// @brief Get statistics about the buffers used for messages queued to clients.
+///
+/// The buffer pool is shared by all broker instances in the process, so the statistics are as well.
+rdmnet::Broker::BufferPoolStats rdmnet::Broker::buffer_pool_stats() const
+{
+  return BrokerBufferPool::Get().stats();
+}
+
+/// @brief Get statistics about the connections and connect requests admitted by the broker.
+///
+/// The statistics are kept from when the broker was started.
+rdmnet::Broker::AdmissionStats rdmnet::Broker::admission_stats() const
+{
+  if (!RDMNET_ASSERT_VERIFY(core_))
+    return AdmissionStats{};
+
+  return core_->admission_stats();
+}
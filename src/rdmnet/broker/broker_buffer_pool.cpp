@@ -0,0 +1,312 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "broker_buffer_pool.h"
+
+#include <new>
+#include "rdmnet/core/common.h"
+
+struct PooledBuffer::Block
+{
+  std::atomic<unsigned int> ref_count;
+  size_t                    size_class;
+  size_t                    capacity;
+  Block*                    next;  // Only valid while on a free list
+
+  uint8_t* data() noexcept { return reinterpret_cast<uint8_t*>(this + 1); }
+};
+
+// Set when the calling thread's cache has been destroyed. Other thread-local and static objects
+// can outlive the cache (on the main thread, every static does), so buffers they release after
+// that point must not touch it. Being trivially destructible, the flag itself stays valid until
+// the thread is gone.
+static thread_local bool thread_cache_destroyed = false;
+
+// Each thread that releases buffers keeps a few free buffers of each size class, which are
+// returned to the shared free lists when the thread exits.
+struct BrokerBufferPool::ThreadCache
+{
+  std::array<FreeList, kNumSizeClasses> lists;
+
+  ~ThreadCache()
+  {
+    thread_cache_destroyed = true;
+    for (size_t i = 0; i < kNumSizeClasses; ++i)
+      BrokerBufferPool::Get().FlushThreadCache(lists[i], i, 0);
+  }
+};
+
+/*************************** Function definitions ****************************/
+
+PooledBuffer::PooledBuffer(size_t size) : block_(BrokerBufferPool::Get().Allocate(size))
+{
+}
+
+PooledBuffer::PooledBuffer(const PooledBuffer& other) noexcept : block_(other.block_)
+{
+  if (block_)
+    block_->ref_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept : block_(other.block_)
+{
+  other.block_ = nullptr;
+}
+
+PooledBuffer& PooledBuffer::operator=(const PooledBuffer& other) noexcept
+{
+  if (other.block_)
+    other.block_->ref_count.fetch_add(1, std::memory_order_relaxed);
+  reset();
+  block_ = other.block_;
+  return *this;
+}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept
+{
+  if (this != &other)
+  {
+    reset();
+    block_ = other.block_;
+    other.block_ = nullptr;
+  }
+  return *this;
+}
+
+PooledBuffer::~PooledBuffer()
+{
+  reset();
+}
+
+uint8_t* PooledBuffer::get() const noexcept
+{
+  return block_ ? block_->data() : nullptr;
+}
+
+size_t PooledBuffer::capacity() const noexcept
+{
+  return block_ ? block_->capacity : 0;
+}
+
+void PooledBuffer::reset() noexcept
+{
+  if (block_)
+  {
+    if (block_->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      BrokerBufferPool::Get().Release(block_);
+    block_ = nullptr;
+  }
+}
+
+// The pool is never destroyed, so that buffers may safely be released at any point during process
+// teardown.
+BrokerBufferPool& BrokerBufferPool::Get()
+{
+  static BrokerBufferPool* pool = new BrokerBufferPool;
+  return *pool;
+}
+
+// Returns nullptr once the calling thread's cache has been destroyed.
+BrokerBufferPool::ThreadCache* BrokerBufferPool::LocalCache()
+{
+  if (thread_cache_destroyed)
+    return nullptr;
+
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+PooledBuffer::Block* BrokerBufferPool::Allocate(size_t size)
+{
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+
+  size_t index = SizeClassIndex(size);
+  if (index >= kNumSizeClasses)
+    return NewBlock(index, size);
+
+  ThreadCache* local_cache = LocalCache();
+  if (!local_cache)
+    return NewBlock(index, SizeClassCapacity(index));
+
+  FreeList& cache = local_cache->lists[index];
+  if (!cache.head)
+    RefillThreadCache(cache, index);
+
+  PooledBuffer::Block* block = cache.head;
+  if (!block)
+    return NewBlock(index, SizeClassCapacity(index));
+
+  cache.head = block->next;
+  --cache.count;
+  block->ref_count.store(1, std::memory_order_relaxed);
+
+  pool_hits_.fetch_add(1, std::memory_order_relaxed);
+  buffers_free_.fetch_sub(1, std::memory_order_relaxed);
+  buffers_in_use_.fetch_add(1, std::memory_order_relaxed);
+  return block;
+}
+
+void BrokerBufferPool::Release(PooledBuffer::Block* block)
+{
+  if (!RDMNET_ASSERT_VERIFY(block))
+    return;
+
+  buffers_in_use_.fetch_sub(1, std::memory_order_relaxed);
+
+  size_t index = block->size_class;
+  if (index >= kNumSizeClasses)
+  {
+    DeleteBlock(block);
+    return;
+  }
+
+  buffers_free_.fetch_add(1, std::memory_order_relaxed);
+
+  ThreadCache* local_cache = LocalCache();
+  if (!local_cache)
+  {
+    // Past this thread's cache; hand the buffer straight to the shared free list.
+    block->next = nullptr;
+    FreeList uncached{block, 1};
+    FlushThreadCache(uncached, index, 0);
+    return;
+  }
+
+  FreeList& cache = local_cache->lists[index];
+  block->next = cache.head;
+  cache.head = block;
+  ++cache.count;
+
+  if (cache.count > kThreadCacheSize)
+    FlushThreadCache(cache, index, kThreadCacheSize / 2);
+}
+
+rdmnet::Broker::BufferPoolStats BrokerBufferPool::stats() const
+{
+  rdmnet::Broker::BufferPoolStats stats;
+  stats.allocations = allocations_.load(std::memory_order_relaxed);
+  stats.pool_hits = pool_hits_.load(std::memory_order_relaxed);
+  stats.heap_allocations = heap_allocations_.load(std::memory_order_relaxed);
+  stats.buffers_in_use = buffers_in_use_.load(std::memory_order_relaxed);
+  stats.buffers_free = buffers_free_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+size_t BrokerBufferPool::SizeClassIndex(size_t size)
+{
+  size_t index = 0;
+  size_t capacity = kMinClassSize;
+  while (capacity < size && index < kNumSizeClasses)
+  {
+    capacity <<= 1;
+    ++index;
+  }
+  return index;
+}
+
+size_t BrokerBufferPool::SizeClassCapacity(size_t index)
+{
+  return kMinClassSize << index;
+}
+
+size_t BrokerBufferPool::MaxSharedFreeBuffers(size_t index)
+{
+  size_t max_by_bytes = kMaxSharedFreeBytes / SizeClassCapacity(index);
+  return (max_by_bytes < kMaxSharedFreeBuffers ? max_by_bytes : kMaxSharedFreeBuffers);
+}
+
+PooledBuffer::Block* BrokerBufferPool::NewBlock(size_t index, size_t capacity)
+{
+  void* mem = ::operator new(sizeof(PooledBuffer::Block) + capacity, std::nothrow);
+  if (!mem)
+    return nullptr;
+
+  PooledBuffer::Block* block = new (mem) PooledBuffer::Block;
+  block->ref_count.store(1, std::memory_order_relaxed);
+  block->size_class = index;
+  block->capacity = capacity;
+  block->next = nullptr;
+
+  heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+  buffers_in_use_.fetch_add(1, std::memory_order_relaxed);
+  return block;
+}
+
+void BrokerBufferPool::DeleteBlock(PooledBuffer::Block* block)
+{
+  block->~Block();
+  ::operator delete(block);
+}
+
+// Move up to half a thread cache's worth of buffers from the shared free list.
+void BrokerBufferPool::RefillThreadCache(FreeList& cache, size_t index)
+{
+  SharedFreeList& shared = shared_free_lists_[index];
+
+  etcpal::MutexGuard guard(shared.lock);
+  while (shared.list.head && cache.count < kThreadCacheSize / 2)
+  {
+    PooledBuffer::Block* block = shared.list.head;
+    shared.list.head = block->next;
+    --shared.list.count;
+
+    block->next = cache.head;
+    cache.head = block;
+    ++cache.count;
+  }
+}
+
+// Move buffers from a thread cache to the shared free list until num_to_keep remain in the cache.
+// Buffers that do not fit on the shared free list are returned to the heap.
+void BrokerBufferPool::FlushThreadCache(FreeList& cache, size_t index, size_t num_to_keep)
+{
+  SharedFreeList& shared = shared_free_lists_[index];
+  const size_t    max_shared = MaxSharedFreeBuffers(index);
+
+  PooledBuffer::Block* to_delete = nullptr;
+  {
+    etcpal::MutexGuard guard(shared.lock);
+    while (cache.head && cache.count > num_to_keep)
+    {
+      PooledBuffer::Block* block = cache.head;
+      cache.head = block->next;
+      --cache.count;
+
+      if (shared.list.count < max_shared)
+      {
+        block->next = shared.list.head;
+        shared.list.head = block;
+        ++shared.list.count;
+      }
+      else
+      {
+        block->next = to_delete;
+        to_delete = block;
+      }
+    }
+  }
+
+  while (to_delete)
+  {
+    PooledBuffer::Block* next = to_delete->next;
+    buffers_free_.fetch_sub(1, std::memory_order_relaxed);
+    DeleteBlock(to_delete);
+    to_delete = next;
+  }
+}
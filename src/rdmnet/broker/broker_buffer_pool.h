@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+/// @file broker_buffer_pool.h
+
+#ifndef BROKER_BUFFER_POOL_H_
+#define BROKER_BUFFER_POOL_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "etcpal/cpp/mutex.h"
+#include "rdmnet/cpp/broker.h"
+
+// A reference-counted handle to a buffer allocated from the BrokerBufferPool. Copying the handle
+// shares the buffer; the buffer is returned to the pool when the last handle is destroyed.
+class PooledBuffer
+{
+public:
+  PooledBuffer() = default;
+  explicit PooledBuffer(size_t size);
+  PooledBuffer(const PooledBuffer& other) noexcept;
+  PooledBuffer(PooledBuffer&& other) noexcept;
+  PooledBuffer& operator=(const PooledBuffer& other) noexcept;
+  PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+  ~PooledBuffer();
+
+  uint8_t* get() const noexcept;
+  size_t   capacity() const noexcept;
+  void     reset() noexcept;
+
+  explicit operator bool() const noexcept { return block_ != nullptr; }
+
+  struct Block;
+
+private:
+  Block* block_{nullptr};
+};
+
+// Hands out buffers for packed messages from a set of power-of-two size classes, recycling released
+// buffers instead of returning them to the heap.
+//
+// Released buffers are first kept in a small cache owned by the releasing thread, and move between
+// the thread caches and a locked shared free list in batches, so the lock is taken at most once per
+// kThreadCacheSize / 2 operations on a given thread. Requests larger than the largest size class
+// bypass the pool.
+class BrokerBufferPool
+{
+public:
+  static constexpr size_t kMinClassSize = 64;
+  static constexpr size_t kNumSizeClasses = 11;  // 64 bytes to 64 KiB
+  static constexpr size_t kMaxClassSize = kMinClassSize << (kNumSizeClasses - 1);
+  // The maximum number of free buffers per size class held by each thread.
+  static constexpr size_t kThreadCacheSize = 32;
+  // The maximum number of free buffers, and the maximum total size of the free buffers, per size
+  // class held in the shared free lists. Buffers released beyond either limit are returned to the
+  // heap, so that a burst of large messages doesn't leave the large size classes holding hundreds
+  // of megabytes.
+  static constexpr size_t kMaxSharedFreeBuffers = 4096;
+  static constexpr size_t kMaxSharedFreeBytes = 4 * 1024 * 1024;
+
+  static BrokerBufferPool& Get();
+
+  PooledBuffer::Block* Allocate(size_t size);
+  void                 Release(PooledBuffer::Block* block);
+
+  rdmnet::Broker::BufferPoolStats stats() const;
+
+  // Returns kNumSizeClasses if size is too big for any size class.
+  static size_t SizeClassIndex(size_t size);
+  static size_t SizeClassCapacity(size_t index);
+  static size_t MaxSharedFreeBuffers(size_t index);
+
+  struct ThreadCache;
+
+private:
+  BrokerBufferPool() = default;
+
+  struct FreeList
+  {
+    PooledBuffer::Block* head{nullptr};
+    size_t               count{0};
+  };
+
+  struct SharedFreeList
+  {
+    etcpal::Mutex lock;
+    FreeList      list;
+  };
+
+  static ThreadCache* LocalCache();
+
+  PooledBuffer::Block* NewBlock(size_t index, size_t capacity);
+  void                 DeleteBlock(PooledBuffer::Block* block);
+  void                 RefillThreadCache(FreeList& cache, size_t index);
+  void                 FlushThreadCache(FreeList& cache, size_t index, size_t num_to_keep);
+
+  std::array<SharedFreeList, kNumSizeClasses> shared_free_lists_;
+
+  std::atomic<size_t> allocations_{0};
+  std::atomic<size_t> pool_hits_{0};
+  std::atomic<size_t> heap_allocations_{0};
+  std::atomic<size_t> buffers_in_use_{0};
+  std::atomic<size_t> buffers_free_{0};
+};
+
+#endif  // BROKER_BUFFER_POOL_H_
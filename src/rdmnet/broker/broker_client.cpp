@@ -19,11 +19,90 @@
 
 #include "broker_client.h"
 
+#include <algorithm>
+#include <cstring>
 #include "rdmnet/cpp/broker.h"
 #include "rdmnet/core/broker_prot.h"
 #include "rdmnet/core/common.h"
 #include "rdmnet/core/connection.h"
 #include "rdmnet/core/opts.h"
+#include "broker_service_schedule.h"
+
+MessageRef PackRptMessage(const etcpal::Uuid& sender_cid, const RptMessage& msg)
+{
+  switch (msg.vector)
+  {
+    case VECTOR_RPT_REQUEST: {
+      auto rdm_buf_list = RPT_GET_RDM_BUF_LIST(&msg);
+      if (!RDMNET_ASSERT_VERIFY(rdm_buf_list))
+        return MessageRef{};
+
+      size_t     bufsize = rc_rpt_get_request_buffer_size(rdm_buf_list->rdm_buffers);
+      MessageRef packed(bufsize);
+      if (packed.data)
+      {
+        packed.size =
+            rc_rpt_pack_request(packed.data.get(), bufsize, &sender_cid.get(), &msg.header, rdm_buf_list->rdm_buffers);
+      }
+      return packed;
+    }
+
+    case VECTOR_RPT_STATUS: {
+      auto status_msg = RPT_GET_STATUS_MSG(&msg);
+      if (!RDMNET_ASSERT_VERIFY(status_msg))
+        return MessageRef{};
+
+      size_t     bufsize = rc_rpt_get_status_buffer_size(status_msg);
+      MessageRef packed(bufsize);
+      if (packed.data)
+        packed.size = rc_rpt_pack_status(packed.data.get(), bufsize, &sender_cid.get(), &msg.header, status_msg);
+      return packed;
+    }
+
+    case VECTOR_RPT_NOTIFICATION: {
+      auto rdm_buf_list = RPT_GET_RDM_BUF_LIST(&msg);
+      if (!RDMNET_ASSERT_VERIFY(rdm_buf_list))
+        return MessageRef{};
+
+      const RdmBuffer* buffers = rdm_buf_list->rdm_buffers;
+      const size_t     num_buffers = rdm_buf_list->num_rdm_buffers;
+
+      size_t     bufsize = rc_rpt_get_notification_buffer_size(buffers, num_buffers);
+      MessageRef packed(bufsize);
+      if (packed.data)
+      {
+        packed.size =
+            rc_rpt_pack_notification(packed.data.get(), bufsize, &sender_cid.get(), &msg.header, buffers, num_buffers);
+      }
+      return packed;
+    }
+
+    default:
+      return MessageRef{};
+  }
+}
+
+MessageRef PackForwardedRptMessage(const RdmnetMessage& msg, const RawMessage& raw)
+{
+  if (!raw.data)
+  {
+    const RptMessage* rptmsg = RDMNET_GET_RPT_MSG(&msg);
+    if (!RDMNET_ASSERT_VERIFY(rptmsg))
+      return MessageRef{};
+
+    return PackRptMessage(msg.sender_cid, *rptmsg);
+  }
+
+  // The broker forwards RPT messages with the original sender's CID and headers, so the received
+  // bytes are exactly what re-packing the parsed message would produce.
+  MessageRef copied(raw.size);
+  if (copied.data)
+  {
+    memcpy(copied.data.get(), raw.data, raw.size);
+    copied.size = raw.size;
+  }
+  return copied;
+}
 
 bool BrokerClient::HasRoomToPush()
 {
@@ -40,8 +119,25 @@ ClientPushResult BrokerClient::Push(const etcpal::Uuid& sender_cid, const Broker
   return PushPostSizeCheck(sender_cid, msg);
 }
 
+// Queue a broker protocol message which has already been packed, so that one copy can be shared
+// between clients.
+ClientPushResult BrokerClient::PushPackedBrokerMessage(const MessageRef& packed_msg)
+{
+  if (marked_for_destruction_)
+    return ClientPushResult::Error;
+  if (!HasRoomToPush())
+    return ClientPushResult::QueueFull;
+
+  broker_msgs_.push_back(packed_msg);
+  MessageQueued();
+  return ClientPushResult::Ok;
+}
+
 bool BrokerClient::Send(const etcpal::Uuid& broker_cid)
 {
+  if (send_batch_size_ > 0)
+    return SendBatch(broker_cid);
+
   // Try to send the next broker protocol message.
   if (!broker_msgs_.empty())
   {
@@ -73,12 +169,39 @@ bool BrokerClient::Send(const etcpal::Uuid& broker_cid)
   return false;
 }
 
+// Sends from a client which was on its schedule's send-ready list, and puts it back on the list if
+// it still has messages to send.
+bool BrokerClient::SendReady(const etcpal::Uuid& broker_cid)
+{
+  bool result = Send(broker_cid);
+
+  send_ready_ = HasQueuedMessages();
+  if (send_ready_ && schedule_)
+    schedule_->MarkSendReady(handle_);
+
+  return result;
+}
+
+bool BrokerClient::HasQueuedMessages() const
+{
+  return !broker_msgs_.empty() || !send_batch_.empty();
+}
+
+// The time in milliseconds until the client's next heartbeat timeout or null message is due.
+uint32_t BrokerClient::TimeUntilNextTimer() const
+{
+  return std::min(send_timer_.GetRemaining(), heartbeat_timer_.GetRemaining());
+}
+
 void BrokerClient::MarkForDestruction(const etcpal::Uuid&        broker_cid,
                                       const rdm::Uid&            broker_uid,
                                       const ClientDestroyAction& destroy_action)
 {
-  // Clear out the existing queue
+  // Clear out the existing queue. A batch that has been partially sent must be finished to keep
+  // the stream well-formed.
   ClearAllQueues();
+  if (send_batch_sent_ == 0)
+    send_batch_.clear();
   ApplyDestroyAction(broker_cid, broker_uid, destroy_action);
   marked_for_destruction_ = true;
 }
@@ -101,6 +224,7 @@ ClientPushResult BrokerClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
         if (to_push.size)
         {
           broker_msgs_.push_back(std::move(to_push));
+          MessageQueued();
           res = ClientPushResult::Ok;
         }
       }
@@ -129,6 +253,7 @@ ClientPushResult BrokerClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
           if (to_push.size)
           {
             broker_msgs_.push_back(std::move(to_push));
+            MessageQueued();
             res = ClientPushResult::Ok;
           }
         }
@@ -145,6 +270,7 @@ ClientPushResult BrokerClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
         if (to_push.size)
         {
           broker_msgs_.push_back(std::move(to_push));
+          MessageQueued();
           res = ClientPushResult::Ok;
         }
       }
@@ -158,9 +284,87 @@ ClientPushResult BrokerClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
 
 bool BrokerClient::SendNull(const etcpal::Uuid& broker_cid)
 {
-  auto   send_buf = std::unique_ptr<uint8_t[]>(new uint8_t[BROKER_NULL_FULL_MSG_SIZE]);
-  size_t send_size = rc_broker_pack_null(send_buf.get(), BROKER_NULL_FULL_MSG_SIZE, &broker_cid.get());
-  return (rc_send(socket_, send_buf.get(), send_size, 0) >= 0);
+  if (null_msg_.size > 0)
+    return (rc_send(socket_, null_msg_.data.get(), null_msg_.size, 0) >= 0);
+
+  uint8_t send_buf[BROKER_NULL_FULL_MSG_SIZE];
+  size_t  send_size = rc_broker_pack_null(send_buf, BROKER_NULL_FULL_MSG_SIZE, &broker_cid.get());
+  return (rc_send(socket_, send_buf, send_size, 0) >= 0);
+}
+
+// Coalesce as many queued messages as will fit into one send. Partial sends are tracked in the
+// batch buffer, and the queues are not drained again until the current batch has been sent
+// completely.
+bool BrokerClient::SendBatch(const etcpal::Uuid& broker_cid)
+{
+  if (send_batch_.empty())
+    FillSendBatch();
+
+  if (!send_batch_.empty())
+  {
+    int res = rc_send(socket_, &send_batch_[send_batch_sent_], send_batch_.size() - send_batch_sent_, 0);
+    if (res >= 0)
+    {
+      send_batch_sent_ += res;
+      if (send_batch_sent_ >= send_batch_.size())
+      {
+        // We are done with this batch.
+        send_batch_.clear();
+        send_batch_sent_ = 0;
+        send_timer_.Reset();
+      }
+      return true;
+    }
+  }
+  else if (send_timer_.IsExpired())
+  {
+    if (SendNull(broker_cid))
+    {
+      send_timer_.Reset();
+      return true;
+    }
+  }
+  return false;
+}
+
+void BrokerClient::FillSendBatch()
+{
+  MessageRef* msg = NextQueuedMessage();
+  while (msg)
+  {
+    auto msg_data = msg->data.get();
+    if (!RDMNET_ASSERT_VERIFY(msg_data))
+      return;
+
+    // Always take at least one message, even if it is bigger than the batch size.
+    size_t remaining = msg->size - msg->size_sent;
+    if (!send_batch_.empty() && send_batch_.size() + remaining > send_batch_size_)
+      break;
+
+    send_batch_.insert(send_batch_.end(), &msg_data[msg->size_sent], &msg_data[msg->size]);
+    PopQueuedMessage();
+    msg = NextQueuedMessage();
+  }
+}
+
+// Called after a message has been added to one of the queues.
+void BrokerClient::MessageQueued()
+{
+  if (!send_ready_ && schedule_)
+  {
+    send_ready_ = true;
+    schedule_->MarkSendReady(handle_);
+  }
+}
+
+MessageRef* BrokerClient::NextQueuedMessage()
+{
+  return broker_msgs_.empty() ? nullptr : &broker_msgs_.front();
+}
+
+void BrokerClient::PopQueuedMessage()
+{
+  broker_msgs_.pop_front();
 }
 
 void BrokerClient::ApplyDestroyAction(const etcpal::Uuid&        broker_cid,
@@ -234,93 +438,86 @@ ClientPushResult RPTClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
     if (to_push.size)
     {
       status_msgs_.push_back(std::move(to_push));
+      MessageQueued();
       res = ClientPushResult::Ok;
     }
   }
   return res;
 }
 
+bool RPTClient::HasQueuedMessages() const
+{
+  return BrokerClient::HasQueuedMessages() || !status_msgs_.empty();
+}
+
 void RPTClient::ClearAllQueues()
 {
   broker_msgs_.clear();
   status_msgs_.clear();
 }
 
+MessageRef* RPTClient::NextQueuedMessage()
+{
+  if (!broker_msgs_.empty())
+    return &broker_msgs_.front();
+  if (!status_msgs_.empty())
+    return &status_msgs_.front();
+  return nullptr;
+}
+
+void RPTClient::PopQueuedMessage()
+{
+  if (!broker_msgs_.empty())
+    broker_msgs_.pop_front();
+  else
+    status_msgs_.pop_front();
+}
+
 bool RPTController::HasRoomToPush()
 {
   return ((max_q_size_ == kLimitlessQueueSize) ||
           (status_msgs_.size() + broker_msgs_.size() + rpt_msgs_.size()) < max_q_size_);
 }
 
-ClientPushResult RPTController::Push(BrokerClient::Handle /*from_client*/,
-                                     const etcpal::Uuid& sender_cid,
-                                     const RptMessage&   msg)
+ClientPushResult RPTController::Push(BrokerClient::Handle from_client,
+                                     const etcpal::Uuid&  sender_cid,
+                                     const RptMessage&    msg)
 {
   if (marked_for_destruction_)
     return ClientPushResult::Error;
   if (!HasRoomToPush())
     return ClientPushResult::QueueFull;
 
-  ClientPushResult res = ClientPushResult::Error;
-
-  switch (msg.vector)
-  {
-    case VECTOR_RPT_REQUEST: {
-      auto rdm_buf_list = RPT_GET_RDM_BUF_LIST(&msg);
-      if (!RDMNET_ASSERT_VERIFY(rdm_buf_list))
-        return ClientPushResult::Error;
-
-      size_t     bufsize = rc_rpt_get_request_buffer_size(rdm_buf_list->rdm_buffers);
-      MessageRef to_push(bufsize);
-      if (to_push.data)
-      {
-        to_push.size =
-            rc_rpt_pack_request(to_push.data.get(), bufsize, &sender_cid.get(), &msg.header, rdm_buf_list->rdm_buffers);
-        if (to_push.size)
-        {
-          rpt_msgs_.push_back(std::move(to_push));
-          res = ClientPushResult::Ok;
-        }
-      }
-    }
-    break;
-
-    case VECTOR_RPT_STATUS: {
-      auto status_msg = RPT_GET_STATUS_MSG(&msg);
-      if (!RDMNET_ASSERT_VERIFY(status_msg))
-        return ClientPushResult::Error;
-
-      res = RPTClient::PushPostSizeCheck(sender_cid, msg.header, *status_msg);
-    }
-    break;
-
-    case VECTOR_RPT_NOTIFICATION: {
-      auto rdm_buf_list = RPT_GET_RDM_BUF_LIST(&msg);
-      if (!RDMNET_ASSERT_VERIFY(rdm_buf_list))
-        return ClientPushResult::Error;
+  MessageRef to_push = PackRptMessage(sender_cid, msg);
+  if (to_push.size == 0)
+    return ClientPushResult::Error;
 
-      const RdmBuffer* buffers = rdm_buf_list->rdm_buffers;
-      const size_t     num_buffers = rdm_buf_list->num_rdm_buffers;
+  return Push(from_client, msg.vector, to_push);
+}
 
-      size_t     bufsize = rc_rpt_get_notification_buffer_size(buffers, num_buffers);
-      MessageRef to_push(bufsize);
-      if (to_push.data)
-      {
-        to_push.size =
-            rc_rpt_pack_notification(to_push.data.get(), bufsize, &sender_cid.get(), &msg.header, buffers, num_buffers);
-        if (to_push.size)
-        {
-          rpt_msgs_.push_back(std::move(to_push));
-          res = ClientPushResult::Ok;
-        }
-      }
-    }
-    break;
+ClientPushResult RPTController::Push(BrokerClient::Handle /*from_client*/,
+                                     uint32_t          rpt_vector,
+                                     const MessageRef& packed_msg)
+{
+  if (marked_for_destruction_)
+    return ClientPushResult::Error;
+  if (!HasRoomToPush())
+    return ClientPushResult::QueueFull;
 
+  switch (rpt_vector)
+  {
+    case VECTOR_RPT_REQUEST:
+    case VECTOR_RPT_NOTIFICATION:
+      rpt_msgs_.push_back(packed_msg);
+      MessageQueued();
+      return ClientPushResult::Ok;
+    case VECTOR_RPT_STATUS:
+      status_msgs_.push_back(packed_msg);
+      MessageQueued();
+      return ClientPushResult::Ok;
     default:
-      break;
+      return ClientPushResult::Error;
   }
-  return res;
 }
 
 ClientPushResult RPTController::Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg)
@@ -345,6 +542,9 @@ ClientPushResult RPTController::Push(const etcpal::Uuid& sender_cid, const RptHe
 
 bool RPTController::Send(const etcpal::Uuid& broker_cid)
 {
+  if (send_batch_size_ > 0)
+    return SendBatch(broker_cid);
+
   MessageRef*             msg = nullptr;
   std::deque<MessageRef>* q = nullptr;
 
@@ -392,6 +592,11 @@ bool RPTController::Send(const etcpal::Uuid& broker_cid)
   return false;
 }
 
+bool RPTController::HasQueuedMessages() const
+{
+  return RPTClient::HasQueuedMessages() || !rpt_msgs_.empty();
+}
+
 void RPTController::ClearAllQueues()
 {
   rpt_msgs_.clear();
@@ -399,6 +604,23 @@ void RPTController::ClearAllQueues()
   broker_msgs_.clear();
 }
 
+MessageRef* RPTController::NextQueuedMessage()
+{
+  // Broker messages are first priority, then status messages, then RPT messages.
+  MessageRef* msg = RPTClient::NextQueuedMessage();
+  if (!msg && !rpt_msgs_.empty())
+    msg = &rpt_msgs_.front();
+  return msg;
+}
+
+void RPTController::PopQueuedMessage()
+{
+  if (!broker_msgs_.empty() || !status_msgs_.empty())
+    RPTClient::PopQueuedMessage();
+  else
+    rpt_msgs_.pop_front();
+}
+
 bool RPTDevice::HasRoomToPush()
 {
   return ((max_q_size_ == kLimitlessQueueSize) ||
@@ -414,43 +636,33 @@ ClientPushResult RPTDevice::Push(BrokerClient::Handle from_client,
   if (!HasRoomToPush())
     return ClientPushResult::QueueFull;
 
-  ClientPushResult res = ClientPushResult::Error;
-
-  switch (msg.vector)
-  {
-    case VECTOR_RPT_STATUS: {
-      auto status_msg = RPT_GET_STATUS_MSG(&msg);
-      if (!RDMNET_ASSERT_VERIFY(status_msg))
-        return ClientPushResult::Error;
-
-      res = RPTClient::PushPostSizeCheck(sender_cid, msg.header, *status_msg);
-    }
-    break;
+  MessageRef to_push = PackRptMessage(sender_cid, msg);
+  if (to_push.size == 0)
+    return ClientPushResult::Error;
 
-    case VECTOR_RPT_REQUEST: {
-      auto rdm_buf_list = RPT_GET_RDM_BUF_LIST(&msg);
-      if (!RDMNET_ASSERT_VERIFY(rdm_buf_list))
-        return ClientPushResult::Error;
+  return Push(from_client, msg.vector, to_push);
+}
 
-      size_t     bufsize = rc_rpt_get_request_buffer_size(rdm_buf_list->rdm_buffers);
-      MessageRef to_push(bufsize);
-      if (to_push.data)
-      {
-        to_push.size =
-            rc_rpt_pack_request(to_push.data.get(), bufsize, &sender_cid.get(), &msg.header, rdm_buf_list->rdm_buffers);
-        if (to_push.size)
-        {
-          rpt_msgs_.push_back(from_client, std::move(to_push));
-          res = ClientPushResult::Ok;
-        }
-      }
-    }
-    break;
+ClientPushResult RPTDevice::Push(BrokerClient::Handle from_client, uint32_t rpt_vector, const MessageRef& packed_msg)
+{
+  if (marked_for_destruction_)
+    return ClientPushResult::Error;
+  if (!HasRoomToPush())
+    return ClientPushResult::QueueFull;
 
+  switch (rpt_vector)
+  {
+    case VECTOR_RPT_STATUS:
+      status_msgs_.push_back(packed_msg);
+      MessageQueued();
+      return ClientPushResult::Ok;
+    case VECTOR_RPT_REQUEST:
+      rpt_msgs_.push_back(from_client, MessageRef(packed_msg));
+      MessageQueued();
+      return ClientPushResult::Ok;
     default:
-      break;
+      return ClientPushResult::Error;
   }
-  return res;
 }
 
 ClientPushResult RPTDevice::Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg)
@@ -465,6 +677,9 @@ ClientPushResult RPTDevice::Push(const etcpal::Uuid& sender_cid, const BrokerMes
 
 bool RPTDevice::Send(const etcpal::Uuid& broker_cid)
 {
+  if (send_batch_size_ > 0)
+    return SendBatch(broker_cid);
+
   MessageRef* msg = nullptr;
   bool        is_rpt = false;
 
@@ -523,6 +738,11 @@ bool RPTDevice::Send(const etcpal::Uuid& broker_cid)
   return false;
 }
 
+bool RPTDevice::HasQueuedMessages() const
+{
+  return RPTClient::HasQueuedMessages() || !rpt_msgs_.empty();
+}
+
 void RPTDevice::ClearAllQueues()
 {
   rpt_msgs_.clear();
@@ -530,6 +750,24 @@ void RPTDevice::ClearAllQueues()
   broker_msgs_.clear();
 }
 
+MessageRef* RPTDevice::NextQueuedMessage()
+{
+  // Broker messages are first priority, then RPT messages.
+  if (!broker_msgs_.empty())
+    return &broker_msgs_.front();
+  if (!rpt_msgs_.empty())
+    return rpt_msgs_.front();
+  return nullptr;
+}
+
+void RPTDevice::PopQueuedMessage()
+{
+  if (!broker_msgs_.empty())
+    broker_msgs_.pop_front();
+  else
+    rpt_msgs_.pop_front();
+}
+
 bool RPTDevice::RptMsgQ::empty() const
 {
   return total_msg_count_ == 0;
@@ -537,6 +775,16 @@ bool RPTDevice::RptMsgQ::empty() const
 
 MessageRef* RPTDevice::RptMsgQ::front()
 {
+  // The controller chosen to go next keeps its turn until its message is popped, so peeking at the
+  // front of the queue more than once (e.g. for a partial send) doesn't skip anyone.
+  if (current_selected_)
+  {
+    auto con_pair = rpt_msgs_.find(current_controller_);
+    if (con_pair != rpt_msgs_.end() && !con_pair->second.empty())
+      return &con_pair->second.front();
+    current_selected_ = false;
+  }
+
   // Fair scheduler - we iterate through the controller map in order, starting from the last
   // controller serviced.
   auto con_pair = rpt_msgs_.upper_bound(current_controller_);
@@ -560,17 +808,21 @@ MessageRef* RPTDevice::RptMsgQ::front()
   if (!con_pair->second.empty())
   {
     current_controller_ = con_pair->first;
+    current_selected_ = true;
     return &con_pair->second.front();
   }
   return nullptr;
 }
 
+// Removes the message last returned by front(), and moves the fair scheduler on to the next
+// controller.
 void RPTDevice::RptMsgQ::pop_front()
 {
-  if (current_controller_ != kInvalidHandle)
+  if (current_selected_)
   {
     rpt_msgs_[current_controller_].pop_front();
     --total_msg_count_;
+    current_selected_ = false;
   }
 }
 
@@ -593,6 +845,7 @@ void RPTDevice::RptMsgQ::RemoveCurrentController()
     total_msg_count_ -= controller_pair->second.size();
     rpt_msgs_.erase(controller_pair);
   }
+  current_selected_ = false;
 }
 
 void RPTDevice::RptMsgQ::clear()
@@ -600,4 +853,5 @@ void RPTDevice::RptMsgQ::clear()
   rpt_msgs_.clear();
   total_msg_count_ = 0;
   current_controller_ = kInvalidHandle;
+  current_selected_ = false;
 }
@@ -27,6 +27,7 @@
 #include <map>
 #include <deque>
 #include <stdexcept>
+#include <vector>
 #include "etcpal/cpp/error.h"
 #include "etcpal/cpp/inet.h"
 #include "etcpal/cpp/rwlock.h"
@@ -38,17 +39,39 @@
 #include "rdmnet/core/message.h"
 #include "rdmnet/core/rpt_prot.h"
 #include "rdmnet/defs.h"
+#include "broker_buffer_pool.h"
 
+// A packed message in a client's send queue.
+//
+// The packed data is reference-counted and must not be modified once the message has been queued,
+// so that a message routed to many clients (e.g. a broadcast) is packed once and shared between
+// their queues. Each copy of a MessageRef tracks its own send progress.
 struct MessageRef
 {
   MessageRef() = default;
-  MessageRef(size_t alloc_size) : data(new uint8_t[alloc_size]) {}
+  MessageRef(size_t alloc_size) : data(alloc_size) {}
 
-  std::unique_ptr<uint8_t[]> data;
-  size_t                     size{0};
-  size_t                     size_sent{0};
+  PooledBuffer data;
+  size_t       size{0};
+  size_t       size_sent{0};
 };
 
+// Pack an RPT message for queueing. Returns a MessageRef with a size of 0 on error.
+MessageRef PackRptMessage(const etcpal::Uuid& sender_cid, const RptMessage& msg);
+
+// The bytes an RDMnet message was received as, TCP preamble included. data is nullptr if they are
+// not available.
+struct RawMessage
+{
+  const uint8_t* data{nullptr};
+  size_t         size{0};
+};
+
+// Queue an RPT message which is being forwarded unchanged. The bytes it was received as are copied
+// as-is when available, which avoids re-packing the parsed message. Returns a MessageRef with a
+// size of 0 on error.
+MessageRef PackForwardedRptMessage(const RdmnetMessage& msg, const RawMessage& raw);
+
 // RPT RDM messages are two sets of data, the RPT header and the RDM message.
 struct RPTMessageRef
 {
@@ -120,6 +143,8 @@ inline ClientDestroyAction ClientDestroyAction::MarkSocketInvalid()
   return to_return;
 }
 
+class ClientServiceSchedule;
+
 // The result of attempting to push to a client's outgoing send queue.
 enum class ClientPushResult
 {
@@ -154,19 +179,26 @@ public:
       , handle_(other.handle_)
       , socket_(other.socket_)
       , max_q_size_(other.max_q_size_)
+      , send_batch_size_(other.send_batch_size_)
+      , null_msg_(other.null_msg_)
+      , schedule_(other.schedule_)
   {
   }
   virtual ~BrokerClient() = default;
 
   virtual bool             HasRoomToPush();
   virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg);
+  ClientPushResult         PushPackedBrokerMessage(const MessageRef& packed_msg);
   virtual bool             Send(const etcpal::Uuid& broker_cid);
+  bool                     SendReady(const etcpal::Uuid& broker_cid);
+  virtual bool             HasQueuedMessages() const;
   void                     MarkForDestruction(const etcpal::Uuid&        broker_cid,
                                               const rdm::Uid&            broker_uid,
                                               const ClientDestroyAction& destroy_action);
 
-  bool TcpConnExpired() const { return heartbeat_timer_.IsExpired(); }
-  void MessageReceived() { heartbeat_timer_.Reset(); }
+  bool     TcpConnExpired() const { return heartbeat_timer_.IsExpired(); }
+  void     MessageReceived() { heartbeat_timer_.Reset(); }
+  uint32_t TimeUntilNextTimer() const;
 
   etcpal::Uuid           cid_{};
   client_protocol_t      client_protocol_{kClientProtocolUnknown};
@@ -175,18 +207,34 @@ public:
   mutable etcpal::RwLock lock_;
   etcpal_socket_t        socket_{ETCPAL_SOCKET_INVALID};
   size_t                 max_q_size_{kLimitlessQueueSize};
+  size_t                 send_batch_size_{0};  // 0 means one message per send
+  MessageRef             null_msg_;            // Preencoded heartbeat, shared between clients
+  ClientServiceSchedule* schedule_{nullptr};   // Told when messages are queued, if set
   bool                   marked_for_destruction_{false};
 
 protected:
   ClientPushResult PushPostSizeCheck(const etcpal::Uuid& sender_cid, const BrokerMessage& msg);
+  void             MessageQueued();
   bool             SendNull(const etcpal::Uuid& broker_cid);
+  bool             SendBatch(const etcpal::Uuid& broker_cid);
+  void             FillSendBatch();
   void             ApplyDestroyAction(const etcpal::Uuid&        broker_cid,
                                       const rdm::Uid&            broker_uid,
                                       const ClientDestroyAction& destroy_action);
 
   virtual void ClearAllQueues() { broker_msgs_.clear(); }
 
+  // Access the queued messages in send priority order, for batched sends. PopQueuedMessage() must
+  // only be called after NextQueuedMessage() has returned a valid message.
+  virtual MessageRef* NextQueuedMessage();
+  virtual void        PopQueuedMessage();
+
   std::deque<MessageRef> broker_msgs_;
+  // Messages which have been taken off the queues and coalesced for a batched send.
+  std::vector<uint8_t>   send_batch_;
+  size_t                 send_batch_sent_{0};
+  // Whether this client is on its schedule's send-ready list.
+  bool                   send_ready_{false};
   etcpal::Timer          send_timer_{std::chrono::seconds(E133_TCP_HEARTBEAT_INTERVAL_SEC)};
   etcpal::Timer          heartbeat_timer_{std::chrono::seconds(E133_HEARTBEAT_TIMEOUT_SEC)};
 };
@@ -227,9 +275,16 @@ public:
   {
     return ClientPushResult::Error;
   }
+  // Push an RPT message that has already been packed with PackRptMessage(). The packed data is
+  // shared, not copied.
+  virtual ClientPushResult Push(Handle /*from_conn*/, uint32_t /*rpt_vector*/, const MessageRef& /*packed_msg*/)
+  {
+    return ClientPushResult::Error;
+  }
 
   virtual bool             HasRoomToPush() override;
   virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg) override;
+  virtual bool             HasQueuedMessages() const override;
 
   RdmUid            uid_{};
   rpt_client_type_t client_type_{kRPTClientTypeUnknown};
@@ -239,6 +294,9 @@ protected:
   ClientPushResult PushPostSizeCheck(const etcpal::Uuid& sender_cid, const RptHeader& header, const RptStatusMsg& msg);
   virtual void     ClearAllQueues();
 
+  virtual MessageRef* NextQueuedMessage() override;
+  virtual void        PopQueuedMessage() override;
+
   std::deque<MessageRef> status_msgs_;
 };
 
@@ -259,13 +317,18 @@ public:
 
   virtual bool             HasRoomToPush() override;
   virtual ClientPushResult Push(Handle from_conn, const etcpal::Uuid& sender_cid, const RptMessage& msg) override;
+  virtual ClientPushResult Push(Handle from_conn, uint32_t rpt_vector, const MessageRef& packed_msg) override;
   virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg) override;
   virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const RptHeader& header, const RptStatusMsg& msg);
   virtual bool             Send(const etcpal::Uuid& broker_cid) override;
+  virtual bool             HasQueuedMessages() const override;
 
 protected:
   virtual void ClearAllQueues();
 
+  virtual MessageRef* NextQueuedMessage() override;
+  virtual void        PopQueuedMessage() override;
+
   std::deque<MessageRef> rpt_msgs_;
 };
 
@@ -282,12 +345,17 @@ public:
 
   virtual bool             HasRoomToPush() override;
   virtual ClientPushResult Push(Handle from_conn, const etcpal::Uuid& sender_cid, const RptMessage& msg) override;
+  virtual ClientPushResult Push(Handle from_conn, uint32_t rpt_vector, const MessageRef& packed_msg) override;
   virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg) override;
   virtual bool             Send(const etcpal::Uuid& broker_cid) override;
+  virtual bool             HasQueuedMessages() const override;
 
 protected:
   virtual void ClearAllQueues();
 
+  virtual MessageRef* NextQueuedMessage() override;
+  virtual void        PopQueuedMessage() override;
+
   // A special queue-like class that organizes messages by source controller for fair scheduling.
   class RptMsgQ
   {
@@ -305,6 +373,8 @@ protected:
     size_t                                   total_msg_count_{0};
     std::map<Handle, std::deque<MessageRef>> rpt_msgs_;
     Handle                                   current_controller_{kInvalidHandle};
+    // Whether front() has chosen current_controller_ to go next and its message hasn't been popped.
+    bool current_selected_{false};
   };
   RptMsgQ rpt_msgs_;
 };
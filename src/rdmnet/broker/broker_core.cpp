@@ -29,8 +29,10 @@
 #include "etcpal/netint.h"
 #include "etcpal/pack.h"
 #include "rdmnet/version.h"
+#include "rdmnet/core/broker_prot.h"
 #include "rdmnet/core/common.h"
 #include "rdmnet/core/connection.h"
+#include "broker_buffer_pool.h"
 #include "broker_client.h"
 #include "broker_responder.h"
 #include "broker_util.h"
@@ -53,6 +55,10 @@
 
 #define BROKER_CAN_LOG(pri) (log_ && log_->CanLog(pri))
 
+// Client list updates are split so that each packed message fits in the largest pooled buffer.
+static constexpr size_t kMaxClientListUpdateEntries =
+    (BrokerBufferPool::kMaxClassSize - BROKER_PDU_FULL_HEADER_SIZE) / RPT_CLIENT_ENTRY_SIZE;
+
 /*************************** Function definitions ****************************/
 
 BrokerCore::BrokerCore()
@@ -88,6 +94,11 @@ etcpal::Error BrokerCore::Startup(const rdmnet::Broker::Settings& settings,
     components_.handle_generator.SetValueInUseFunc(
         [&](BrokerClient::Handle handle) { return clients_.find(handle) != clients_.end(); });
 
+    // The heartbeat message only depends on our CID, so it is packed once and shared by all clients.
+    null_msg_ = MessageRef(BROKER_NULL_FULL_MSG_SIZE);
+    if (null_msg_.data)
+      null_msg_.size = rc_broker_pack_null(null_msg_.data.get(), BROKER_NULL_FULL_MSG_SIZE, &settings_.cid.get());
+
     // Generate IDs if necessary
     my_uid_ = settings.uid;
     if (settings.uid.IsDynamicUidRequest())
@@ -96,9 +107,29 @@ etcpal::Error BrokerCore::Startup(const rdmnet::Broker::Settings& settings,
       components_.uids.SetNextDeviceId(2);
     }
 
+    components_.uids.SetMaxReservations(settings_.limits.uid_reservations);
+    if (!settings_.uid_reservation_file.empty())
+    {
+      auto num_loaded = components_.uids.LoadReservations(settings_.uid_reservation_file);
+      if (num_loaded)
+      {
+        BROKER_LOG_INFO("Loaded %zu dynamic UID reservations from %s.", *num_loaded,
+                        settings_.uid_reservation_file.c_str());
+      }
+      else if (num_loaded.error() != kEtcPalErrNotFound)
+      {
+        BROKER_LOG_WARNING("Couldn't load dynamic UID reservations from %s: %s. Starting with no reservations.",
+                           settings_.uid_reservation_file.c_str(), etcpal::Error(num_loaded.error()).ToCString());
+      }
+    }
+
+    admission_.Configure(settings_.limits);
+
     if (!RDMNET_ASSERT_VERIFY(components_.socket_mgr))
       return kEtcPalErrSys;
 
+    components_.socket_mgr->SetWorkerThreadConfig(settings_.socket_worker_threads, settings_.pin_socket_worker_threads);
+    components_.socket_mgr->SetRecvBufferSize(settings_.recv_buffer_size);
     if (!components_.socket_mgr->Startup())
       return kEtcPalErrSys;
 
@@ -146,6 +177,7 @@ void BrokerCore::Shutdown(rdmnet_disconnect_reason_t disconnect_reason)
 
     StopBrokerServices(disconnect_reason);
     components_.socket_mgr->Shutdown();
+    SaveUidReservations();
 
     started_ = false;
   }
@@ -174,8 +206,7 @@ bool BrokerCore::IsValidControllerDestinationUID(const RdmUid& uid) const
     return true;
 
   // TODO this should only check devices
-  BrokerClient::Handle tmp;
-  return components_.uids.UidToHandle(uid, tmp);
+  return FindRptClient(uid) != nullptr;
 }
 
 bool BrokerCore::IsValidDeviceDestinationUID(const RdmUid& uid) const
@@ -184,8 +215,7 @@ bool BrokerCore::IsValidDeviceDestinationUID(const RdmUid& uid) const
     return true;
 
   // TODO this should only check controllers
-  BrokerClient::Handle tmp;
-  return components_.uids.UidToHandle(uid, tmp);
+  return FindRptClient(uid) != nullptr;
 }
 
 size_t BrokerCore::GetNumClients() const
@@ -343,6 +373,13 @@ etcpal::Error BrokerCore::StartBrokerServices()
   if (!res)
     return res;
 
+  if (!settings_.uid_reservation_file.empty())
+  {
+    res = components_.threads->AddUidReservationSaveThread();
+    if (!res)
+      return res;
+  }
+
   auto final_listen_addrs = GetInterfaceAddrs(settings_.listen_interfaces);
 
   // Listen on the set of enabled interfaces provided by GetInterfaceAddrs
@@ -402,64 +439,103 @@ void BrokerCore::StopBrokerServices(rdmnet_disconnect_reason_t disconnect_reason
     DestroyMarkedClientsLocked(clients_for_socket_removal);
   }
 
+  {
+    // Nobody is left to tell about the clients that were just removed.
+    etcpal::MutexGuard update_guard(client_update_lock_);
+    pending_client_updates_.clear();
+    new_controller_update_starts_.clear();
+  }
+
+  // The clients waiting for their connect requests to be processed are gone.
+  admission_.Clear();
+  client_schedule_.Clear();
+
   RemoveClientSockets(clients_for_socket_removal);
 }
 
 bool BrokerCore::HandleNewConnection(etcpal_socket_t new_sock, const etcpal::SockAddr& addr)
+{
+  std::vector<AcceptedConnection> connections(1);
+  connections.front().socket = new_sock;
+  connections.front().remote_addr = addr;
+  HandleNewConnections(connections);
+  return connections.front().keep;
+}
+
+// Adds a batch of new connections to the client list under a single write lock.
+void BrokerCore::HandleNewConnections(std::vector<AcceptedConnection>& connections)
 {
   if (!RDMNET_ASSERT_VERIFY(components_.socket_mgr))
-    return false;
+    return;
+
+  std::vector<BrokerClient::Handle> new_handles(connections.size(), BrokerClient::kInvalidHandle);
+  std::vector<bool>                 nonblocking(connections.size(), false);
+  size_t                            num_accepted = 0;
 
-  if (etcpal_setblocking(new_sock, false) != kEtcPalErrOk)
+  for (size_t i = 0; i < connections.size(); ++i)
   {
-    if (BROKER_CAN_LOG(ETCPAL_LOG_ERR))
+    connections[i].keep = false;
+    nonblocking[i] = (etcpal_setblocking(connections[i].socket, false) == kEtcPalErrOk);
+    if (!nonblocking[i] && BROKER_CAN_LOG(ETCPAL_LOG_ERR))
     {
       BROKER_LOG_ERR("Error translating socket into non-blocking socket for new connection from %s",
-                     addr.ToString().c_str());
+                     connections[i].remote_addr.ToString().c_str());
     }
-    return false;
   }
 
-  if (BROKER_CAN_LOG(ETCPAL_LOG_INFO))
-  {
-    BROKER_LOG_INFO("Creating a new connection for address %s", addr.ToString().c_str());
-  }
-
-  BrokerClient::Handle new_handle = BrokerClient::kInvalidHandle;
-  bool                 result = false;
-
   {  // Client write lock scope
     etcpal::WriteGuard client_write(client_lock_);
 
-    new_handle = components_.handle_generator.GetClientHandle();
-
-    if (settings_.limits.connections == 0 ||
-        (clients_.size() <= settings_.limits.connections + settings_.limits.reject_connections))
+    for (size_t i = 0; i < connections.size(); ++i)
     {
-      std::unique_ptr<BrokerClient> client(new BrokerClient(new_handle, new_sock));
+      AcceptedConnection& connection = connections[i];
+      if (!nonblocking[i])
+        continue;
 
-      // Before inserting the connection, make sure we can attach the socket.
-      if (client)
+      if (settings_.limits.connections == 0 ||
+          (clients_.size() <= settings_.limits.connections + settings_.limits.reject_connections))
       {
-        client->addr_ = addr;
-        clients_.insert(std::make_pair(new_handle, std::move(client)));
-        result = true;
+        BrokerClient::Handle          new_handle = components_.handle_generator.GetClientHandle();
+        std::unique_ptr<BrokerClient> client(new BrokerClient(new_handle, connection.socket));
+
+        // Before inserting the connection, make sure we can attach the socket.
+        if (client)
+        {
+          client->addr_ = connection.remote_addr;
+          client->send_batch_size_ = settings_.send_batch_size;
+          client->null_msg_ = null_msg_;
+          client->schedule_ = &client_schedule_;
+          client_schedule_.ScheduleTimer(new_handle, etcpal_getms() + client->TimeUntilNextTimer());
+          clients_.insert(std::make_pair(new_handle, std::move(client)));
+          new_handles[i] = new_handle;
+          connection.keep = true;
+          ++num_accepted;
+        }
       }
     }
   }
 
-  if (result)
-  {
-    // Calling this outside of the client_lock_ to avoid deadlocking.
-    components_.socket_mgr->AddSocket(new_handle, new_sock);
-    BROKER_LOG_DEBUG("New connection created with handle %d", new_handle);
-  }
-  else
+  admission_.CountConnections(num_accepted, connections.size() - num_accepted);
+
+  for (size_t i = 0; i < connections.size(); ++i)
   {
-    BROKER_LOG_ERR("New connection failed");
-  }
+    const AcceptedConnection& connection = connections[i];
+    if (connection.keep)
+    {
+      if (BROKER_CAN_LOG(ETCPAL_LOG_INFO))
+      {
+        BROKER_LOG_INFO("Created a new connection with handle %d for address %s", new_handles[i],
+                        connection.remote_addr.ToString().c_str());
+      }
 
-  return result;
+      // Calling this outside of the client_lock_ to avoid deadlocking.
+      components_.socket_mgr->AddSocket(new_handles[i], connection.socket);
+    }
+    else
+    {
+      BROKER_LOG_ERR("New connection from %s failed", connection.remote_addr.ToString().c_str());
+    }
+  }
 }
 
 // Process each controller queue, sending out the next message from each queue if devices are
@@ -469,22 +545,53 @@ bool BrokerCore::ServiceClients()
 {
   bool result = false;
 
+  if (admission_.HasDeferred())
+    result |= ProcessDeferredConnects();
+
   {
     etcpal::ReadGuard clients_read(client_lock_);
 
-    for (auto& client : clients_)
+    result |= FlushClientListUpdates();
+
+    // Only the clients which have messages queued or whose timers may have expired are visited.
+    // Handles of clients which have since been destroyed are skipped.
+    client_schedule_.TakeSendReady(scheduled_clients_);
+    for (auto handle : scheduled_clients_)
     {
-      if (!RDMNET_ASSERT_VERIFY(client.second))
-        return false;
+      auto client = clients_.find(handle);
+      if (client != clients_.end() && client->second)
+      {
+        ClientWriteGuard client_write(*client->second);
+        result |= client->second->SendReady(settings_.cid);
+      }
+    }
 
-      ClientWriteGuard client_write(*client.second);
-      if (client.second->TcpConnExpired())
-        MarkLockedClientForDestruction(*client.second);
-      else
-        result |= client.second->Send(settings_.cid);
+    uint32_t now = etcpal_getms();
+    client_schedule_.TakeExpiredTimers(now, scheduled_clients_);
+    for (auto handle : scheduled_clients_)
+    {
+      auto client = clients_.find(handle);
+      if (client != clients_.end() && client->second)
+      {
+        ClientWriteGuard client_write(*client->second);
+        if (client->second->TcpConnExpired())
+        {
+          MarkLockedClientForDestruction(*client->second);
+        }
+        else
+        {
+          // Sends a null message if it is due.
+          result |= client->second->Send(settings_.cid);
+          client_schedule_.ScheduleTimer(handle, now + client->second->TimeUntilNextTimer());
+        }
+      }
     }
   }
 
+  // Sending may have made room in queues which were full, so give throttled senders another try.
+  if (result)
+    components_.socket_mgr->ResumeThrottledSockets();
+
   if (client_destroy_timer_.IsExpired())
   {
     std::vector<BrokerClient::Handle> clients_for_socket_removal;
@@ -496,6 +603,16 @@ bool BrokerCore::ServiceClients()
   return result;
 }
 
+// Called periodically from the UID reservation save thread, and once more at shutdown. This must be
+// called outside of client_lock_.
+void BrokerCore::SaveUidReservations()
+{
+  if (!components_.uids.SaveReservations())
+  {
+    BROKER_LOG_WARNING("Couldn't save dynamic UID reservations to %s.", settings_.uid_reservation_file.c_str());
+  }
+}
+
 void BrokerCore::HandleBrokerRegistered(const std::string& assigned_service_name)
 {
   service_registered_ = true;
@@ -695,11 +812,13 @@ void BrokerCore::MarkClientForDestruction(BrokerClient::Handle client_handle, co
 bool BrokerCore::MarkLockedClientForDestruction(BrokerClient& client, const ClientDestroyAction& destroy_action)
 {
   client.MarkForDestruction(settings_.cid, my_uid_, destroy_action);
+  admission_.Remove(client.handle_);
 
   if (client.client_protocol_ == E133_CLIENT_PROTOCOL_RPT)
   {
     RPTClient* rptcli = static_cast<RPTClient*>(&client);
     components_.uids.RemoveUid(rptcli->uid_);
+    rpt_client_uids_.Detach(rptcli->uid_);
 
     std::vector<RdmnetRptClientEntry> rpt_entries;
     rpt_entries.emplace_back();
@@ -712,6 +831,10 @@ bool BrokerCore::MarkLockedClientForDestruction(BrokerClient& client, const Clie
     SendClientsRemoved(rpt_entries);
   }
 
+  // The destroy action and the client removed messages may have queued data.
+  WakeClientService();
+
+  etcpal::MutexGuard destroy_guard(destroy_lock_);
   return clients_to_destroy_.insert(client.handle_).second;
 }
 
@@ -744,6 +867,7 @@ void BrokerCore::DestroyMarkedClientsLocked(std::vector<BrokerClient::Handle>& c
         {
           RPTClient* rptcli = static_cast<RPTClient*>(client->second.get());
           rpt_clients_.erase(to_destroy);
+          rpt_client_uids_.Erase(rptcli->uid_, rptcli);
           if (rptcli->client_type_ == kRPTClientTypeController)
             controllers_.erase(to_destroy);
           else if (rptcli->client_type_ == kRPTClientTypeDevice)
@@ -777,7 +901,9 @@ void BrokerCore::HandleSocketClosed(BrokerClient::Handle client_handle, bool /*g
 }
 
 HandleMessageResult BrokerCore::HandleSocketMessageReceived(BrokerClient::Handle client_handle,
-                                                            const RdmnetMessage& message)
+                                                            const RdmnetMessage& message,
+                                                            const uint8_t*       raw_data,
+                                                            size_t               raw_size)
 {
   // Assume the next message should be received by default. Only certain cases require retrying/throttling.
   HandleMessageResult result = HandleMessageResult::kGetNextMessage;
@@ -822,7 +948,7 @@ HandleMessageResult BrokerCore::HandleSocketMessageReceived(BrokerClient::Handle
     }
 
     case ACN_VECTOR_ROOT_RPT:
-      result = ProcessRPTMessage(client_handle, &message);
+      result = ProcessRPTMessage(client_handle, &message, RawMessage{raw_data, raw_size});
       break;
 
     default:
@@ -830,6 +956,10 @@ HandleMessageResult BrokerCore::HandleSocketMessageReceived(BrokerClient::Handle
       break;
   }
 
+  // Handling a message is the main way data gets queued to clients, so let the client service
+  // thread know there may be something to send.
+  WakeClientService();
+
   return result;
 }
 
@@ -850,7 +980,21 @@ void BrokerCore::ProcessConnectRequest(BrokerClient::Handle client_handle, const
         if (!RDMNET_ASSERT_VERIFY(rpt_client_entry))
           return;
 
-        deny_connection = !ProcessRPTConnectRequest(client_handle, *rpt_client_entry, connect_status);
+        switch (admission_.Admit(client_handle, *rpt_client_entry))
+        {
+          case ConnectAdmission::Decision::kAdmit:
+            deny_connection = !ProcessRPTConnectRequest(client_handle, *rpt_client_entry, connect_status);
+            break;
+          case ConnectAdmission::Decision::kDefer:
+            // Processed later by ProcessDeferredConnects().
+            BROKER_LOG_DEBUG("Deferring connect request from client %d due to the connect rate limit", client_handle);
+            deny_connection = false;
+            break;
+          case ConnectAdmission::Decision::kReject:
+          default:
+            connect_status = kRdmnetConnectCapacityExceeded;
+            break;
+        }
       }
       break;
       // TODO EPT
@@ -861,32 +1005,47 @@ void BrokerCore::ProcessConnectRequest(BrokerClient::Handle client_handle, const
   }
 
   if (deny_connection)
-  {
-    // Clean up this client.
-    BROKER_LOG_INFO("Rejecting connection from client %d: %s", client_handle,
-                    rdmnet_connect_status_to_string(connect_status));
-    MarkClientForDestruction(client_handle, ClientDestroyAction::SendConnectReply(connect_status));
-  }
+    RejectConnectRequest(client_handle, connect_status);
 }
 
+// This function grabs a read lock on client_lock_.
+void BrokerCore::RejectConnectRequest(BrokerClient::Handle client_handle, rdmnet_connect_status_t connect_status)
+{
+  // Clean up this client.
+  BROKER_LOG_INFO("Rejecting connection from client %d: %s", client_handle,
+                  rdmnet_connect_status_to_string(connect_status));
+  MarkClientForDestruction(client_handle, ClientDestroyAction::SendConnectReply(connect_status));
+}
+
+// This function grabs a write lock on client_lock_.
 bool BrokerCore::ProcessRPTConnectRequest(BrokerClient::Handle        client_handle,
                                           const RdmnetRptClientEntry& client_entry,
                                           rdmnet_connect_status_t&    connect_status)
+{
+  etcpal::WriteGuard clients_write(client_lock_);
+  return ProcessRPTConnectRequestLocked(client_handle, client_entry, connect_status);
+}
+
+// Needs write lock on client_lock_
+bool BrokerCore::ProcessRPTConnectRequestLocked(BrokerClient::Handle        client_handle,
+                                                const RdmnetRptClientEntry& client_entry,
+                                                rdmnet_connect_status_t&    connect_status)
 {
   bool continue_adding = true;
   // We need to make a copy of the data because we might be changing the UID value
   RdmnetRptClientEntry updated_client_entry = client_entry;
+  RPTClient*           new_client = nullptr;
 
-  etcpal::WriteGuard clients_write(client_lock_);
-  RPTClient*         new_client = nullptr;
-
-  if ((settings_.limits.connections > 0) && (clients_.size() >= settings_.limits.connections))
+  // Only clients which have completed their connect requests count against the connection limit;
+  // the rest of clients_ are still connecting.
+  if ((settings_.limits.connections > 0) && (rpt_clients_.size() >= settings_.limits.connections))
   {
     connect_status = kRdmnetConnectCapacityExceeded;
     continue_adding = false;
   }
 
-  continue_adding = ResolveNewClientUid(client_handle, updated_client_entry, connect_status);
+  if (continue_adding)
+    continue_adding = ResolveNewClientUid(client_handle, updated_client_entry, connect_status);
 
   if (continue_adding)
   {
@@ -912,6 +1071,7 @@ bool BrokerCore::ProcessRPTConnectRequest(BrokerClient::Handle        client_han
           new_client = controller.get();
           controllers_.insert(std::make_pair(client_handle, controller.get()));
           rpt_clients_.insert(std::make_pair(client_handle, controller.get()));
+          rpt_client_uids_.Insert(updated_client_entry.uid, controller.get());
           clients_[client_handle] = std::move(controller);
         }
       }
@@ -938,6 +1098,7 @@ bool BrokerCore::ProcessRPTConnectRequest(BrokerClient::Handle        client_han
           new_client = device.get();
           devices_.insert(std::make_pair(client_handle, device.get()));
           rpt_clients_.insert(std::make_pair(client_handle, device.get()));
+          rpt_client_uids_.Insert(updated_client_entry.uid, device.get());
           clients_[client_handle] = std::move(device);
         }
       }
@@ -975,6 +1136,44 @@ bool BrokerCore::ProcessRPTConnectRequest(BrokerClient::Handle        client_han
   return continue_adding;
 }
 
+// Processes connect requests which were held by the connect rate limit, as far as the rate now
+// allows. This function grabs a write lock on client_lock_, once for the whole batch.
+bool BrokerCore::ProcessDeferredConnects()
+{
+  std::vector<ConnectAdmission::DeferredConnect> ready = admission_.TakeReady(kMaxDeferredConnectsPerPass);
+  if (ready.empty())
+    return false;
+
+  std::vector<std::pair<BrokerClient::Handle, rdmnet_connect_status_t>> rejected;
+
+  {  // Client write lock scope
+    etcpal::WriteGuard clients_write(client_lock_);
+
+    for (const auto& connect : ready)
+    {
+      // The client may have disconnected, or completed a repeated connect request, while it waited.
+      auto client = clients_.find(connect.handle);
+      if (client == clients_.end() || !client->second || client->second->marked_for_destruction_ ||
+          rpt_clients_.find(connect.handle) != rpt_clients_.end())
+      {
+        continue;
+      }
+
+      rdmnet_connect_status_t connect_status = kRdmnetConnectCapacityExceeded;
+      if (!ProcessRPTConnectRequestLocked(connect.handle, connect.client_entry, connect_status))
+        rejected.push_back(std::make_pair(connect.handle, connect_status));
+    }
+  }
+
+  // Marking clients for destruction takes a read lock, so it must happen outside the write lock.
+  for (const auto& rejection : rejected)
+    RejectConnectRequest(rejection.first, rejection.second);
+
+  // The connect replies have been queued.
+  WakeClientService();
+  return true;
+}
+
 bool BrokerCore::ResolveNewClientUid(BrokerClient::Handle     client_handle,
                                      RdmnetRptClientEntry&    client_entry,
                                      rdmnet_connect_status_t& connect_status)
@@ -1020,7 +1219,9 @@ bool BrokerCore::ResolveNewClientUid(BrokerClient::Handle     client_handle,
   }
 }
 
-HandleMessageResult BrokerCore::ProcessRPTMessage(BrokerClient::Handle client_handle, const RdmnetMessage* msg)
+HandleMessageResult BrokerCore::ProcessRPTMessage(BrokerClient::Handle client_handle,
+                                                  const RdmnetMessage* msg,
+                                                  const RawMessage&    raw)
 {
   etcpal::ReadGuard clients_read(client_lock_);
 
@@ -1139,13 +1340,17 @@ HandleMessageResult BrokerCore::ProcessRPTMessage(BrokerClient::Handle client_ha
   }
 
   if (route_msg)
-    result = RouteRPTMessage(client_handle, msg);
+    result = RouteRPTMessage(client_handle, msg, raw);
 
   return result;
 }
 
 // Needs read lock on client_lock_
-HandleMessageResult BrokerCore::RouteRPTMessage(BrokerClient::Handle client_handle, const RdmnetMessage* msg)
+// The message is forwarded unchanged, so when its raw bytes are available they are copied into the destination queues
+// directly instead of re-packing the parsed message.
+HandleMessageResult BrokerCore::RouteRPTMessage(BrokerClient::Handle client_handle,
+                                                const RdmnetMessage* msg,
+                                                const RawMessage&    raw)
 {
   if (!RDMNET_ASSERT_VERIFY(msg))
     return HandleMessageResult::kGetNextMessage;
@@ -1163,25 +1368,25 @@ HandleMessageResult BrokerCore::RouteRPTMessage(BrokerClient::Handle client_hand
     BROKER_LOG_DEBUG("Broadcasting RPT message from Device %04x:%08x to all Controllers",
                      rptmsg->header.source_uid.manu, rptmsg->header.source_uid.id);
 
-    push_result = PushToAllControllers(client_handle, msg);
+    push_result = PushToAllControllers(client_handle, msg, raw);
   }
   else if (RDMNET_UID_IS_DEVICE_BROADCAST(&rptmsg->header.dest_uid))
   {
     BROKER_LOG_DEBUG("Broadcasting RPT message from Controller %04x:%08x to all Devices",
                      rptmsg->header.source_uid.manu, rptmsg->header.source_uid.id);
 
-    push_result = PushToAllDevices(client_handle, msg);
+    push_result = PushToAllDevices(client_handle, msg, raw);
   }
   else if (IsDeviceManuBroadcastUID(rptmsg->header.dest_uid, device_manu))
   {
     BROKER_LOG_DEBUG("Broadcasting RPT message from Controller %04x:%08x to all Devices from manufacturer %04x",
                      rptmsg->header.source_uid.manu, rptmsg->header.source_uid.id, device_manu);
 
-    push_result = PushToManuSpecificDevices(client_handle, msg, device_manu);
+    push_result = PushToManuSpecificDevices(client_handle, msg, raw, device_manu);
   }
   else
   {
-    push_result = PushToSpecificRptClient(client_handle, msg);
+    push_result = PushToSpecificRptClient(client_handle, msg, raw);
     if (push_result == ClientPushResult::Ok)
     {
       BROKER_LOG_DEBUG("Routing RPT PDU from Client %04x:%08x to Client %04x:%08x", rptmsg->header.source_uid.manu,
@@ -1198,6 +1403,7 @@ HandleMessageResult BrokerCore::RouteRPTMessage(BrokerClient::Handle client_hand
 template <class ClientMap, class FilterFunction>
 ClientPushResult PushToRptClients(BrokerClient::Handle sender_handle,
                                   const RdmnetMessage* msg,
+                                  const RawMessage&    raw,
                                   ClientMap&           dest_clients,
                                   FilterFunction       dest_filter)
 {
@@ -1244,7 +1450,15 @@ ClientPushResult PushToRptClients(BrokerClient::Handle sender_handle,
     }
   }
 
-  // If no queues are full, push to all queues
+  // If no queues are full, pack the message once and share the packed data with all queues
+  MessageRef packed_msg;
+  if (result == ClientPushResult::Ok)
+  {
+    packed_msg = PackForwardedRptMessage(*msg, raw);
+    if (packed_msg.size == 0)
+      result = ClientPushResult::Error;
+  }
+
   if (result == ClientPushResult::Ok)
   {
     for (auto dest = dest_clients.begin(); dest != dest_clients.end(); ++dest)
@@ -1254,7 +1468,7 @@ ClientPushResult PushToRptClients(BrokerClient::Handle sender_handle,
         if (!RDMNET_ASSERT_VERIFY(dest->second))
           return ClientPushResult::Error;
 
-        auto push_res = dest->second->Push(sender_handle, msg->sender_cid, *rptmsg);
+        auto push_res = dest->second->Push(sender_handle, rptmsg->vector, packed_msg);
 
         if (result == ClientPushResult::Ok)
           result = push_res;
@@ -1282,30 +1496,35 @@ ClientPushResult PushToRptClients(BrokerClient::Handle sender_handle,
 }
 
 // Needs read lock on client_lock_
-ClientPushResult BrokerCore::PushToAllControllers(BrokerClient::Handle sender_handle, const RdmnetMessage* msg)
+ClientPushResult BrokerCore::PushToAllControllers(BrokerClient::Handle sender_handle,
+                                                  const RdmnetMessage* msg,
+                                                  const RawMessage&    raw)
 {
   if (!RDMNET_ASSERT_VERIFY(msg))
     return ClientPushResult::Error;
 
   // Push to every controller in controllers_
   auto dest_filter = [](const RptControllerMap::iterator& /*dest*/) { return true; };
-  return PushToRptClients(sender_handle, msg, controllers_, dest_filter);
+  return PushToRptClients(sender_handle, msg, raw, controllers_, dest_filter);
 }
 
 // Needs read lock on client_lock_
-ClientPushResult BrokerCore::PushToAllDevices(BrokerClient::Handle sender_handle, const RdmnetMessage* msg)
+ClientPushResult BrokerCore::PushToAllDevices(BrokerClient::Handle sender_handle,
+                                              const RdmnetMessage* msg,
+                                              const RawMessage&    raw)
 {
   if (!RDMNET_ASSERT_VERIFY(msg))
     return ClientPushResult::Error;
 
   // Push to every device in devices_
   auto dest_filter = [](const RptDeviceMap::iterator& /*dest*/) { return true; };
-  return PushToRptClients(sender_handle, msg, devices_, dest_filter);
+  return PushToRptClients(sender_handle, msg, raw, devices_, dest_filter);
 }
 
 // Needs read lock on client_lock_
 ClientPushResult BrokerCore::PushToManuSpecificDevices(BrokerClient::Handle sender_handle,
                                                        const RdmnetMessage* msg,
+                                                       const RawMessage&    raw,
                                                        uint16_t             manu)
 {
   if (!RDMNET_ASSERT_VERIFY(msg))
@@ -1318,11 +1537,13 @@ ClientPushResult BrokerCore::PushToManuSpecificDevices(BrokerClient::Handle send
 
     return ((dest->second->uid_.manu & 0x7fffu) == manu);
   };
-  return PushToRptClients(sender_handle, msg, devices_, dest_filter);
+  return PushToRptClients(sender_handle, msg, raw, devices_, dest_filter);
 }
 
 // Needs read lock on client_lock_
-ClientPushResult BrokerCore::PushToSpecificRptClient(BrokerClient::Handle sender_handle, const RdmnetMessage* msg)
+ClientPushResult BrokerCore::PushToSpecificRptClient(BrokerClient::Handle sender_handle,
+                                                     const RdmnetMessage* msg,
+                                                     const RawMessage&    raw)
 {
   if (!RDMNET_ASSERT_VERIFY(msg))
     return ClientPushResult::Error;
@@ -1331,28 +1552,33 @@ ClientPushResult BrokerCore::PushToSpecificRptClient(BrokerClient::Handle sender
   if (!RDMNET_ASSERT_VERIFY(rptmsg))
     return ClientPushResult::Error;
 
-  auto dest_client = FindRptClient(rptmsg->header.dest_uid);
-  if (dest_client != rpt_clients_.end())
+  RPTClient* dest_client = FindRptClient(rptmsg->header.dest_uid);
+  if (dest_client)
   {
-    if (!RDMNET_ASSERT_VERIFY(dest_client->second))
+    // For performance, since this is a single client, lock and call Push directly instead of calling PushToRptClients.
+    ClientWriteGuard client_write(*dest_client);
+    if (!raw.data)
+      return dest_client->Push(sender_handle, msg->sender_cid, *rptmsg);
+
+    // Check for room first so that a full queue doesn't cost a copy every time the message is retried.
+    if (!dest_client->HasRoomToPush())
+      return ClientPushResult::QueueFull;
+
+    MessageRef forwarded = PackForwardedRptMessage(*msg, raw);
+    if (forwarded.size == 0)
       return ClientPushResult::Error;
 
-    // For performance, since this is a single client, lock and call Push directly instead of calling PushToRptClients.
-    ClientWriteGuard client_write(*dest_client->second);
-    return dest_client->second->Push(sender_handle, msg->sender_cid, *rptmsg);
+    return dest_client->Push(sender_handle, rptmsg->vector, forwarded);
   }
 
   return ClientPushResult::Error;
 }
 
 // Needs read lock on client_lock_
-BrokerCore::RptClientMap::iterator BrokerCore::FindRptClient(const RdmUid& uid)
+// Returns nullptr if no live client has the UID (including clients already marked for destruction).
+RPTClient* BrokerCore::FindRptClient(const RdmUid& uid) const
 {
-  BrokerClient::Handle handle;
-  if (components_.uids.UidToHandle(uid, handle))
-    return rpt_clients_.find(handle);
-
-  return rpt_clients_.end();
+  return rpt_client_uids_.Find(uid);
 }
 
 // Needs read lock on client_lock_
@@ -1375,19 +1601,16 @@ HandleMessageResult BrokerCore::HandleRPTClientBadPushResult(const RptHeader& he
   }
   else
   {
-    auto dest_client = FindRptClient(header.dest_uid);
-    if (dest_client == rpt_clients_.end())
+    RPTClient* dest_client = FindRptClient(header.dest_uid);
+    if (!dest_client)
     {
       not_found = true;
     }
     else
     {
-      if (!RDMNET_ASSERT_VERIFY(dest_client->second))
-        return HandleMessageResult::kGetNextMessage;
-
-      if (dest_client->second->client_type_ == kRPTClientTypeDevice)
+      if (dest_client->client_type_ == kRPTClientTypeDevice)
         dest_type = "Device";
-      else if (dest_client->second->client_type_ == kRPTClientTypeController)
+      else if (dest_client->client_type_ == kRPTClientTypeController)
         dest_type = "Controller";
     }
   }
@@ -1415,6 +1638,12 @@ HandleMessageResult BrokerCore::HandleRPTClientBadPushResult(const RptHeader& he
   return HandleMessageResult::kGetNextMessage;
 }
 
+void BrokerCore::WakeClientService()
+{
+  if (components_.threads)
+    components_.threads->WakeClientServiceThreads();
+}
+
 void BrokerCore::ResetClientHeartbeatTimer(BrokerClient::Handle client_handle)
 {
   etcpal::ReadGuard clients_read(client_lock_);
@@ -1488,59 +1717,114 @@ void BrokerCore::SendEptClientList(BrokerMessage& /*bmsg*/, EPTClient& /*to_cli*
   // TODO
 }
 
+// Needs write lock on client_lock_
 void BrokerCore::SendClientsAdded(BrokerClient::Handle handle_to_ignore, std::vector<RdmnetRptClientEntry>& entries)
 {
-  BrokerMessage bmsg;
-  bmsg.vector = VECTOR_BROKER_CLIENT_ADD;
+  etcpal::MutexGuard update_guard(client_update_lock_);
+  QueueClientListUpdates(VECTOR_BROKER_CLIENT_ADD, entries);
 
-  auto client_list = BROKER_GET_CLIENT_LIST(&bmsg);
-  if (!RDMNET_ASSERT_VERIFY(client_list))
-    return;
+  // A new controller fetches the full client list, which already reflects the pending updates.
+  if (controllers_.find(handle_to_ignore) != controllers_.end())
+    new_controller_update_starts_[handle_to_ignore] = pending_client_updates_.size();
+}
+
+// Needs read lock on client_lock_
+void BrokerCore::SendClientsRemoved(std::vector<RdmnetRptClientEntry>& entries)
+{
+  etcpal::MutexGuard update_guard(client_update_lock_);
+  QueueClientListUpdates(VECTOR_BROKER_CLIENT_REMOVE, entries);
+}
 
-  auto rpt_client_list = BROKER_GET_RPT_CLIENT_LIST(client_list);
-  if (!RDMNET_ASSERT_VERIFY(rpt_client_list))
+// Needs client_update_lock_
+void BrokerCore::QueueClientListUpdates(uint16_t vector, const std::vector<RdmnetRptClientEntry>& entries)
+{
+  if (entries.empty())
     return;
 
-  client_list->client_protocol = kClientProtocolRPT;
-  rpt_client_list->client_entries = entries.data();
-  rpt_client_list->num_client_entries = entries.size();
+  // The coalescing window starts with the first change after the last flush.
+  if (pending_client_updates_.empty() && settings_.client_list_update_window_ms > 0)
+    client_update_timer_.Start(settings_.client_list_update_window_ms);
+
+  for (const auto& entry : entries)
+    pending_client_updates_.push_back(ClientListUpdate{vector, entry});
+}
+
+// Sends the pending client list updates to all controllers once the coalescing window has passed.
+// The updates are packed once and the packed messages are shared between controllers, except for
+// controllers which connected during the window. Returns whether anything was queued.
+// Needs read lock on client_lock_
+bool BrokerCore::FlushClientListUpdates()
+{
+  std::vector<ClientListUpdate>                    updates;
+  std::unordered_map<BrokerClient::Handle, size_t> new_controller_starts;
+  {
+    etcpal::MutexGuard update_guard(client_update_lock_);
+    if (pending_client_updates_.empty())
+      return false;
+    if (settings_.client_list_update_window_ms > 0 && !client_update_timer_.IsExpired())
+      return false;
 
-  for (const auto controller : controllers_)
+    updates.swap(pending_client_updates_);
+    new_controller_starts.swap(new_controller_update_starts_);
+  }
+
+  const std::vector<MessageRef> shared_msgs = PackClientListUpdates(updates, 0);
+
+  bool result = false;
+  for (const auto& controller : controllers_)
   {
-    if (controller.first != handle_to_ignore)
+    if (!RDMNET_ASSERT_VERIFY(controller.second))
+      return result;
+
+    const std::vector<MessageRef>* msgs = &shared_msgs;
+    std::vector<MessageRef>        own_msgs;
+
+    auto new_controller = new_controller_starts.find(controller.first);
+    if (new_controller != new_controller_starts.end())
     {
-      if (!RDMNET_ASSERT_VERIFY(controller.second))
-        return;
+      if (new_controller->second >= updates.size())
+        continue;
+      own_msgs = PackClientListUpdates(updates, new_controller->second);
+      msgs = &own_msgs;
+    }
 
-      controller.second->Push(settings_.cid, bmsg);
+    ClientWriteGuard client_write(*controller.second);
+    for (const auto& msg : *msgs)
+    {
+      if (controller.second->PushPackedBrokerMessage(msg) == ClientPushResult::Ok)
+        result = true;
     }
   }
+  return result;
 }
 
-void BrokerCore::SendClientsRemoved(std::vector<RdmnetRptClientEntry>& entries)
+// Packs the client list updates starting at first_update, combining each run of consecutive
+// additions or removals into as few messages as possible. Runs are kept in order so that a client
+// which disconnects and reconnects within the window ends up connected.
+std::vector<MessageRef> BrokerCore::PackClientListUpdates(const std::vector<ClientListUpdate>& updates,
+                                                          size_t                               first_update)
 {
-  BrokerMessage bmsg;
-  bmsg.vector = VECTOR_BROKER_CLIENT_REMOVE;
-
-  auto client_list = BROKER_GET_CLIENT_LIST(&bmsg);
-  if (!RDMNET_ASSERT_VERIFY(client_list))
-    return;
-
-  auto rpt_client_list = BROKER_GET_RPT_CLIENT_LIST(client_list);
-  if (!RDMNET_ASSERT_VERIFY(rpt_client_list))
-    return;
-
-  client_list->client_protocol = kClientProtocolRPT;
-  rpt_client_list->client_entries = entries.data();
-  rpt_client_list->num_client_entries = entries.size();
+  std::vector<MessageRef>           packed_msgs;
+  std::vector<RdmnetRptClientEntry> entries;
 
-  for (const auto controller : controllers_)
+  for (size_t i = first_update; i < updates.size();)
   {
-    if (!RDMNET_ASSERT_VERIFY(controller.second))
-      return;
-
-    controller.second->Push(settings_.cid, bmsg);
+    const uint16_t vector = updates[i].vector;
+    entries.clear();
+    for (; i < updates.size() && updates[i].vector == vector && entries.size() < kMaxClientListUpdateEntries; ++i)
+      entries.push_back(updates[i].entry);
+
+    size_t     bufsize = rc_broker_get_rpt_client_list_buffer_size(entries.size());
+    MessageRef packed(bufsize);
+    if (packed.data)
+    {
+      packed.size = rc_broker_pack_rpt_client_list(packed.data.get(), bufsize, &settings_.cid.get(), vector,
+                                                   entries.data(), entries.size());
+      if (packed.size)
+        packed_msgs.push_back(std::move(packed));
+    }
   }
+  return packed_msgs;
 }
 
 // Needs read lock on client_lock_
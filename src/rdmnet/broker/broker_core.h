@@ -28,17 +28,21 @@
 #include <vector>
 #include "etcpal/cpp/error.h"
 #include "etcpal/cpp/inet.h"
+#include "etcpal/cpp/mutex.h"
 #include "etcpal/cpp/rwlock.h"
 #include "etcpal/cpp/timer.h"
 #include "etcpal/socket.h"
 #include "rdm/cpp/uid.h"
 #include "rdmnet/cpp/broker.h"
+#include "broker_admission.h"
 #include "broker_client.h"
 #include "broker_discovery.h"
 #include "broker_responder.h"
+#include "broker_service_schedule.h"
 #include "broker_socket_manager.h"
 #include "broker_threads.h"
 #include "broker_uid_manager.h"
+#include "broker_uid_table.h"
 #include "broker_util.h"
 
 class BrokerComponentNotify : public BrokerSocketNotify, public BrokerThreadNotify, public BrokerDiscoveryNotify
@@ -104,7 +108,8 @@ public:
   bool        IsValidDeviceDestinationUID(const RdmUid& uid) const;
 
   // Test/debug
-  size_t GetNumClients() const;
+  size_t                         GetNumClients() const;
+  rdmnet::Broker::AdmissionStats admission_stats() const { return admission_.stats(); }
 
 private:
   using BrokerClientMap = std::unordered_map<BrokerClient::Handle, std::unique_ptr<BrokerClient>>;
@@ -145,7 +150,42 @@ private:
   RptControllerMap controllers_;
   RptDeviceMap     devices_;
 
+  // Routes unicast RPT messages by destination UID without going through the BrokerUidManager.
+  RptClientUidTable rpt_client_uids_;
+
+  // Clients can be marked for destruction from several socket worker threads at once while holding only a read lock
+  // on client_lock_, so the set of marked clients has its own lock.
   std::unordered_set<BrokerClient::Handle> clients_to_destroy_;
+  etcpal::Mutex                            destroy_lock_;
+
+  // Preencoded heartbeat message, shared by all clients.
+  MessageRef null_msg_;
+
+  // Which clients have messages to send or timers to check on the next pass through the clients.
+  ClientServiceSchedule client_schedule_;
+  // Only used by ServiceClients(), which runs on the single client service thread. Kept as a member
+  // to avoid reallocating on every pass.
+  std::vector<BrokerClient::Handle> scheduled_clients_;
+
+  // Limits the rate of client connect requests and holds those which must wait.
+  ConnectAdmission admission_;
+  // The most held connect requests processed in one pass through the client queues.
+  static constexpr size_t kMaxDeferredConnectsPerPass = 64;
+
+  // Client connects and disconnects which controllers have not been told about yet, in the order
+  // they happened. Updates can be added from several socket worker threads at once while holding
+  // only a read lock on client_lock_, so they have their own lock.
+  struct ClientListUpdate
+  {
+    uint16_t             vector;
+    RdmnetRptClientEntry entry;
+  };
+  std::vector<ClientListUpdate> pending_client_updates_;
+  // Controllers which connected while updates were pending, and how many of the pending updates
+  // happened before they connected (and so are not sent to them).
+  std::unordered_map<BrokerClient::Handle, size_t> new_controller_update_starts_;
+  etcpal::Timer                                    client_update_timer_;
+  etcpal::Mutex                                    client_update_lock_;
 
   std::set<etcpal::IpAddr>          GetInterfaceAddrs(const std::vector<std::string>& interfaces);
   etcpal::Expected<etcpal_socket_t> StartListening(const etcpal::IpAddr& ip, uint16_t& port);
@@ -154,7 +194,9 @@ private:
 
   // BrokerThreadNotify messages
   virtual bool HandleNewConnection(etcpal_socket_t new_sock, const etcpal::SockAddr& addr) override;
+  virtual void HandleNewConnections(std::vector<AcceptedConnection>& connections) override;
   virtual bool ServiceClients() override;
+  virtual void SaveUidReservations() override;
 
   // BrokerDiscoveryManagerNotify messages
   virtual void HandleBrokerRegistered(const std::string& assigned_service_name) override;
@@ -178,27 +220,47 @@ private:
   // BrokerSocketNotify messages
   virtual void                HandleSocketClosed(BrokerClient::Handle client_handle, bool graceful) override;
   virtual HandleMessageResult HandleSocketMessageReceived(BrokerClient::Handle client_handle,
-                                                          const RdmnetMessage& message) override;
+                                                          const RdmnetMessage& message,
+                                                          const uint8_t*       raw_data,
+                                                          size_t               raw_size) override;
 
   // Message processing and sending functions
   void                   ProcessConnectRequest(BrokerClient::Handle client_handle, const BrokerClientConnectMsg* cmsg);
+  void                   RejectConnectRequest(BrokerClient::Handle    client_handle,
+                                              rdmnet_connect_status_t connect_status);
   bool                   ProcessRPTConnectRequest(BrokerClient::Handle        client_handle,
                                                   const RdmnetRptClientEntry& client_entry,
                                                   rdmnet_connect_status_t&    connect_status);
+  bool                   ProcessRPTConnectRequestLocked(BrokerClient::Handle        client_handle,
+                                                        const RdmnetRptClientEntry& client_entry,
+                                                        rdmnet_connect_status_t&    connect_status);
+  bool                   ProcessDeferredConnects();
   bool                   ResolveNewClientUid(BrokerClient::Handle     client_handle,
                                              RdmnetRptClientEntry&    client_entry,
                                              rdmnet_connect_status_t& connect_status);
-  HandleMessageResult    ProcessRPTMessage(BrokerClient::Handle client_handle, const RdmnetMessage* msg);
-  HandleMessageResult    RouteRPTMessage(BrokerClient::Handle client_handle, const RdmnetMessage* msg);
-  ClientPushResult       PushToAllControllers(BrokerClient::Handle sender_handle, const RdmnetMessage* msg);
-  ClientPushResult       PushToAllDevices(BrokerClient::Handle sender_handle, const RdmnetMessage* msg);
+  HandleMessageResult    ProcessRPTMessage(BrokerClient::Handle client_handle,
+                                           const RdmnetMessage* msg,
+                                           const RawMessage&    raw);
+  HandleMessageResult    RouteRPTMessage(BrokerClient::Handle client_handle,
+                                         const RdmnetMessage* msg,
+                                         const RawMessage&    raw);
+  ClientPushResult       PushToAllControllers(BrokerClient::Handle sender_handle,
+                                              const RdmnetMessage* msg,
+                                              const RawMessage&    raw);
+  ClientPushResult       PushToAllDevices(BrokerClient::Handle sender_handle,
+                                          const RdmnetMessage* msg,
+                                          const RawMessage&    raw);
   ClientPushResult       PushToManuSpecificDevices(BrokerClient::Handle sender_handle,
                                                    const RdmnetMessage* msg,
+                                                   const RawMessage&    raw,
                                                    uint16_t             manu);
-  ClientPushResult       PushToSpecificRptClient(BrokerClient::Handle sender_handle, const RdmnetMessage* msg);
-  RptClientMap::iterator FindRptClient(const RdmUid& uid);
+  ClientPushResult       PushToSpecificRptClient(BrokerClient::Handle sender_handle,
+                                                 const RdmnetMessage* msg,
+                                                 const RawMessage&    raw);
+  RPTClient*             FindRptClient(const RdmUid& uid) const;
   HandleMessageResult    HandleRPTClientBadPushResult(const RptHeader& header, ClientPushResult result);
   void                   ResetClientHeartbeatTimer(BrokerClient::Handle client_handle);
+  void                   WakeClientService();
 
   void SendRDMBrokerResponse(BrokerClient::Handle client_handle,
                              const RPTMessageRef& msg,
@@ -212,6 +274,9 @@ private:
   void SendEptClientList(BrokerMessage& bmsg, EPTClient& to_cli);
   void SendClientsAdded(BrokerClient::Handle handle_to_ignore, std::vector<RdmnetRptClientEntry>& entries);
   void SendClientsRemoved(std::vector<RdmnetRptClientEntry>& entries);
+  void QueueClientListUpdates(uint16_t vector, const std::vector<RdmnetRptClientEntry>& entries);
+  bool FlushClientListUpdates();
+  std::vector<MessageRef> PackClientListUpdates(const std::vector<ClientListUpdate>& updates, size_t first_update);
   HandleMessageResult SendStatus(RPTController*     controller,
                                  const RptHeader&   header,
                                  rpt_status_code_t  status_code,
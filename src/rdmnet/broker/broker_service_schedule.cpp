@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "broker_service_schedule.h"
+
+#include <algorithm>
+
+void ClientServiceSchedule::MarkSendReady(BrokerClient::Handle handle)
+{
+  etcpal::MutexGuard guard(send_ready_lock_);
+  send_ready_.push_back(handle);
+}
+
+// Replaces the contents of handles with the clients which have been marked send-ready since the
+// last call, each listed once.
+void ClientServiceSchedule::TakeSendReady(std::vector<BrokerClient::Handle>& handles)
+{
+  handles.clear();
+  {
+    etcpal::MutexGuard guard(send_ready_lock_);
+    send_ready_.swap(handles);
+  }
+
+  // A client can be listed twice if it was replaced (e.g. by an RPTClient after its connect
+  // request) while it was listed.
+  std::sort(handles.begin(), handles.end());
+  handles.erase(std::unique(handles.begin(), handles.end()), handles.end());
+}
+
+void ClientServiceSchedule::ScheduleTimer(BrokerClient::Handle handle, uint32_t due_ms)
+{
+  etcpal::MutexGuard guard(timer_lock_);
+  timers_.push_back(TimerEntry{due_ms, handle});
+  std::push_heap(timers_.begin(), timers_.end(), DueLater{});
+}
+
+// Replaces the contents of handles with the clients whose deadlines are at or before now_ms, and
+// removes them from the schedule. They must be scheduled again with ScheduleTimer() if they still
+// need their timers checked.
+void ClientServiceSchedule::TakeExpiredTimers(uint32_t now_ms, std::vector<BrokerClient::Handle>& handles)
+{
+  handles.clear();
+
+  etcpal::MutexGuard guard(timer_lock_);
+  while (!timers_.empty() && static_cast<int32_t>(now_ms - timers_.front().due_ms) >= 0)
+  {
+    handles.push_back(timers_.front().handle);
+    std::pop_heap(timers_.begin(), timers_.end(), DueLater{});
+    timers_.pop_back();
+  }
+}
+
+void ClientServiceSchedule::Clear()
+{
+  {
+    etcpal::MutexGuard guard(send_ready_lock_);
+    send_ready_.clear();
+  }
+  {
+    etcpal::MutexGuard guard(timer_lock_);
+    timers_.clear();
+  }
+}
+
+size_t ClientServiceSchedule::num_send_ready() const
+{
+  etcpal::MutexGuard guard(send_ready_lock_);
+  return send_ready_.size();
+}
+
+size_t ClientServiceSchedule::num_timers() const
+{
+  etcpal::MutexGuard guard(timer_lock_);
+  return timers_.size();
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+/// @file broker_service_schedule.h
+
+#ifndef BROKER_SERVICE_SCHEDULE_H_
+#define BROKER_SERVICE_SCHEDULE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "etcpal/cpp/mutex.h"
+#include "broker_client.h"
+
+// Tracks which clients the client service thread needs to visit, so that a pass through the
+// clients does not have to lock and check every one of them.
+//
+// Clients are scheduled for two reasons:
+// - Messages have been queued to them. The client adds itself to the send-ready list when its
+//   queues go from empty to non-empty (see BrokerClient::MessageQueued()).
+// - One of their timers (the heartbeat timeout or the null message interval) may have expired.
+//   Deadlines are kept in a min-heap. A client's timers are only ever pushed later (by receiving or
+//   sending a message), so a deadline in the heap can be earlier than the client's real one; the
+//   service thread then checks the client's timers and schedules it again.
+//
+// Entries are keyed by client handle and dropped lazily once the client no longer exists. All
+// functions are safe to call from any thread.
+class ClientServiceSchedule
+{
+public:
+  ClientServiceSchedule() = default;
+  ClientServiceSchedule(const ClientServiceSchedule& other) = delete;
+  ClientServiceSchedule& operator=(const ClientServiceSchedule& other) = delete;
+
+  void MarkSendReady(BrokerClient::Handle handle);
+  void TakeSendReady(std::vector<BrokerClient::Handle>& handles);
+
+  void ScheduleTimer(BrokerClient::Handle handle, uint32_t due_ms);
+  void TakeExpiredTimers(uint32_t now_ms, std::vector<BrokerClient::Handle>& handles);
+
+  void Clear();
+
+  size_t num_send_ready() const;
+  size_t num_timers() const;
+
+private:
+  struct TimerEntry
+  {
+    uint32_t             due_ms;
+    BrokerClient::Handle handle;
+  };
+
+  // Orders the heap with the earliest deadline on top. Deadlines are compared by their difference
+  // so that the millisecond counter wrapping is handled.
+  struct DueLater
+  {
+    bool operator()(const TimerEntry& a, const TimerEntry& b) const
+    {
+      return static_cast<int32_t>(a.due_ms - b.due_ms) > 0;
+    }
+  };
+
+  std::vector<BrokerClient::Handle> send_ready_;
+  mutable etcpal::Mutex             send_ready_lock_;
+
+  std::vector<TimerEntry> timers_;
+  mutable etcpal::Mutex   timer_lock_;
+};
+
+#endif  // BROKER_SERVICE_SCHEDULE_H_
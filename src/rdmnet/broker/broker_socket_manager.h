@@ -49,10 +49,21 @@ public:
   ///
   /// @param[in] handle The client handle on which data was received.
   /// @param[in] message The parsed message which was received on the socket.
+  /// @param[in] raw_data The bytes the message was parsed from, TCP preamble included, or nullptr if they are not
+  ///                     available. Messages which are forwarded unchanged can be queued by copying these directly.
+  /// @param[in] raw_size The size of raw_data.
   /// @return #kRetryLater: The message couldn't be processed and should be delayed to a future notification.
   /// @return #kGetNextMessage: Ready to move on to the next message.
   virtual HandleMessageResult HandleSocketMessageReceived(BrokerClient::Handle handle,
-                                                          const RdmnetMessage& message) = 0;
+                                                          const RdmnetMessage& message,
+                                                          const uint8_t*       raw_data,
+                                                          size_t               raw_size) = 0;
+
+  /// @brief An RDMnet message was received on a socket, and its original bytes are not available.
+  HandleMessageResult HandleSocketMessageReceived(BrokerClient::Handle handle, const RdmnetMessage& message)
+  {
+    return HandleSocketMessageReceived(handle, message, nullptr, 0);
+  }
 
   /// @brief A socket was closed remotely.
   ///
@@ -75,8 +86,19 @@ public:
 
   virtual void SetNotify(BrokerSocketNotify* notify) = 0;
 
+  // Configure the number of worker threads which read from client sockets, and whether each is pinned to its own CPU
+  // core. Called before Startup(). Socket managers which don't support multiple workers ignore this.
+  virtual void SetWorkerThreadConfig(unsigned int /*num_threads*/, bool /*pin_threads*/) {}
+  // Set the size of the buffer allocated to receive data from each socket (0 for the default). Called before Startup().
+  virtual void SetRecvBufferSize(size_t /*size*/) {}
+
   virtual bool AddSocket(BrokerClient::Handle handle, etcpal_socket_t sock) = 0;
   virtual void RemoveSocket(BrokerClient::Handle handle) = 0;
+
+  // Called when the broker has sent queued data to clients, making room for messages previously
+  // refused with HandleMessageResult::kRetryLater. Socket managers which pause reading from a
+  // throttled socket should retry its pending message.
+  virtual void ResumeThrottledSockets() {}
 };
 
 std::unique_ptr<BrokerSocketManager> CreateBrokerSocketManager();
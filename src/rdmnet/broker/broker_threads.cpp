@@ -31,25 +31,41 @@ etcpal::Error ListenThread::Start()
   if (socket_ == ETCPAL_SOCKET_INVALID)
     return kEtcPalErrInvalid;
 
-  terminated_ = false;
+  // The listening socket is non-blocking so that all pending connections can be accepted each time
+  // it becomes readable.
+  etcpal::Error res = etcpal_setblocking(socket_, false);
+  if (res)
+  {
+    res = etcpal_poll_context_init(&poll_context_);
+    if (res)
+    {
+      poll_context_valid_ = true;
+      res = etcpal_poll_add_socket(&poll_context_, socket_, ETCPAL_POLL_IN, nullptr);
+    }
+  }
 
-  auto start_res = thread_.SetName("ListenThread").Start(&ListenThread::Run, this);
-  if (!start_res)
+  if (res)
+  {
+    accepted_.reserve(kMaxAcceptBatch);
+    terminated_ = false;
+    res = thread_.SetName("ListenThread").Start(&ListenThread::Run, this);
+  }
+
+  if (!res)
   {
     terminated_ = true;
-    etcpal_close(socket_);
-    socket_ = ETCPAL_SOCKET_INVALID;
+    CloseSocket();
     if (log_)
       log_->Critical("ListenThread: Failed to start thread.");
   }
 
-  return start_res;
+  return res;
 }
 
 void ListenThread::Run()
 {
-  // Wait on our listening thread for new sockets or timeout. Since we heavily block on the accept,
-  // we'll keep accepting as long as the listen socket is valid.
+  // Wait on our listening socket for new connections. The wait times out periodically so that we
+  // notice when we are stopped.
   while (!terminated_)
   {
     ReadSocket();
@@ -58,35 +74,53 @@ void ListenThread::Run()
 
 void ListenThread::ReadSocket()
 {
-  if (socket_ != ETCPAL_SOCKET_INVALID)
+  if (socket_ == ETCPAL_SOCKET_INVALID)
+  {
+    etcpal::Thread::Sleep(10);
+    return;
+  }
+
+  EtcPalPollEvent event{};
+  etcpal::Error   res = etcpal_poll_wait(&poll_context_, &event, kPollTimeoutMs);
+  if (res.code() == kEtcPalErrTimedOut)
+    return;
+  if (res && (event.events & ETCPAL_POLL_ERR))
+    res = event.err;
+
+  // Accept everything that is pending (up to a limit), so that the whole batch can be added to the
+  // broker at once.
+  accepted_.clear();
+  while (res && accepted_.size() < kMaxAcceptBatch)
   {
     etcpal_socket_t conn_sock;
     EtcPalSockAddr  new_addr;
 
-    etcpal::Error res = etcpal_accept(socket_, &new_addr, &conn_sock);
-
-    if (!res)
+    res = etcpal_accept(socket_, &new_addr, &conn_sock);
+    if (res)
     {
-      // If terminated_ is set, the socket has been closed because the thread is being stopped
-      // externally. Otherwise, it's a real error.
-      if (!terminated_)
-      {
-        if (log_)
-          log_->Critical("ListenThread: Accept failed with error: %s.", res.ToCString());
-        terminated_ = true;
-      }
-      return;
+      accepted_.emplace_back();
+      accepted_.back().socket = conn_sock;
+      accepted_.back().remote_addr = new_addr;
     }
+  }
 
-    bool keep_socket = false;
+  if (!accepted_.empty())
+  {
     if (notify_)
-      keep_socket = notify_->HandleNewConnection(conn_sock, new_addr);
-    if (!keep_socket)
-      etcpal_close(conn_sock);
+      notify_->HandleNewConnections(accepted_);
+    for (const auto& connection : accepted_)
+    {
+      if (!connection.keep)
+        etcpal_close(connection.socket);
+    }
   }
-  else
+
+  // Running out of pending connections is expected. Otherwise, it's a real error.
+  if (!res && res.code() != kEtcPalErrWouldBlock && !terminated_)
   {
-    etcpal::Thread::Sleep(10);
+    if (log_)
+      log_->Critical("ListenThread: Accept failed with error: %s.", res.ToCString());
+    terminated_ = true;
   }
 }
 
@@ -96,16 +130,23 @@ ListenThread::~ListenThread()
   if (!terminated_)
   {
     terminated_ = true;
-
-    if (socket_ != ETCPAL_SOCKET_INVALID)
-    {
-      etcpal_shutdown(socket_, ETCPAL_SHUT_RD);
-      etcpal_close(socket_);
-      socket_ = ETCPAL_SOCKET_INVALID;
-    }
-
     thread_.Join();
   }
+  CloseSocket();
+}
+
+void ListenThread::CloseSocket()
+{
+  if (poll_context_valid_)
+  {
+    etcpal_poll_context_deinit(&poll_context_);
+    poll_context_valid_ = false;
+  }
+  if (socket_ != ETCPAL_SOCKET_INVALID)
+  {
+    etcpal_close(socket_);
+    socket_ = ETCPAL_SOCKET_INVALID;
+  }
 }
 
 etcpal::Error ClientServiceThread::Start()
@@ -116,15 +157,18 @@ etcpal::Error ClientServiceThread::Start()
 
 void ClientServiceThread::Run()
 {
-  if (!notify_)
+  if (!notify_ || !wake_signal_)
     return;
 
   while (!terminated_)
   {
-    // As long as clients need to be processed, we won't sleep.
+    // As long as clients need to be processed, we won't block.
     while (notify_->ServiceClients())
       ;
-    etcpal::Thread::Sleep(kSleepMs);
+
+    // Block until more data is queued for a client. The signal latches, so a wake that arrives
+    // while ServiceClients() is running is not lost.
+    wake_signal_->TryWait(kMaxIdleWaitMs);
   }
 }
 
@@ -133,6 +177,37 @@ ClientServiceThread::~ClientServiceThread()
   if (!terminated_)
   {
     terminated_ = true;
+    if (wake_signal_)
+      wake_signal_->Notify();
+    thread_.Join();
+  }
+}
+
+etcpal::Error UidReservationSaveThread::Start()
+{
+  terminated_ = false;
+  return thread_.SetName("UidReservationSaveThread").Start(&UidReservationSaveThread::Run, this);
+}
+
+void UidReservationSaveThread::Run()
+{
+  if (!notify_)
+    return;
+
+  while (!terminated_)
+  {
+    stop_signal_.TryWait(kSaveIntervalMs);
+    if (!terminated_)
+      notify_->SaveUidReservations();
+  }
+}
+
+UidReservationSaveThread::~UidReservationSaveThread()
+{
+  if (!terminated_)
+  {
+    terminated_ = true;
+    stop_signal_.Notify();
     thread_.Join();
   }
 }
@@ -152,7 +227,20 @@ etcpal::Error BrokerThreadManager::AddListenThread(etcpal_socket_t listen_sock)
 
 etcpal::Error BrokerThreadManager::AddClientServiceThread()
 {
-  std::unique_ptr<ClientServiceThread> new_thread(new ClientServiceThread(notify_));
+  std::unique_ptr<ClientServiceThread> new_thread(new ClientServiceThread(notify_, &client_service_signal_));
+  if (!new_thread)
+    return kEtcPalErrNoMem;
+
+  auto start_res = new_thread->Start();
+  if (start_res)
+    threads_.push_back(std::move(new_thread));
+
+  return start_res;
+}
+
+etcpal::Error BrokerThreadManager::AddUidReservationSaveThread()
+{
+  std::unique_ptr<UidReservationSaveThread> new_thread(new UidReservationSaveThread(notify_));
   if (!new_thread)
     return kEtcPalErrNoMem;
 
@@ -163,6 +251,11 @@ etcpal::Error BrokerThreadManager::AddClientServiceThread()
   return start_res;
 }
 
+void BrokerThreadManager::WakeClientServiceThreads()
+{
+  client_service_signal_.Notify();
+}
+
 void BrokerThreadManager::StopThreads()
 {
   threads_.clear();
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "etcpal/cpp/error.h"
+#include "etcpal/cpp/signal.h"
 #include "etcpal/cpp/thread.h"
 #include "etcpal/inet.h"
 #include "etcpal/socket.h"
@@ -35,6 +36,15 @@
 #include "rdmnet/cpp/broker.h"
 #include "broker_util.h"
 
+// A connection accepted by a listen thread.
+struct AcceptedConnection
+{
+  etcpal_socket_t  socket{ETCPAL_SOCKET_INVALID};
+  etcpal::SockAddr remote_addr;
+  // Set by BrokerThreadNotify::HandleNewConnections() if the connection should be kept open.
+  bool keep{false};
+};
+
 // The interface for callbacks from threads managed by the broker.
 class BrokerThreadNotify
 {
@@ -43,10 +53,25 @@ public:
   // immediately.
   virtual bool HandleNewConnection(etcpal_socket_t new_sock, const etcpal::SockAddr& remote_addr) = 0;
 
+  // Called when a listen thread gets one or more new connections at once. Set keep on each
+  // connection which should stay open; the rest are closed immediately. By default, each
+  // connection is passed to HandleNewConnection() in turn.
+  virtual void HandleNewConnections(std::vector<AcceptedConnection>& connections)
+  {
+    for (auto& connection : connections)
+      connection.keep = HandleNewConnection(connection.socket, connection.remote_addr);
+  }
+
   // A notification from a client service thread to process each client queue, sending out the next
   // message from each queue if one is available. Return false if no messages or partial messages
-  // were sent.
+  // were sent. When this returns false, the client service thread blocks until it is woken (see
+  // BrokerThreadInterface::WakeClientServiceThreads()) or a maximum idle interval elapses.
   virtual bool ServiceClients() = 0;
+
+  // A notification from the UID reservation save thread to write any changed dynamic UID
+  // reservations to disk. This is done on its own thread so that file I/O never delays message
+  // delivery.
+  virtual void SaveUidReservations() {}
 };
 
 class BrokerThread
@@ -80,22 +105,58 @@ public:
 
   void ReadSocket();
 
+  // The most connections accepted before they are handed to the BrokerThreadNotify.
+  static constexpr size_t kMaxAcceptBatch{64};
+  // The longest the thread waits for a new connection before checking whether it has been stopped.
+  static constexpr int kPollTimeoutMs{100};
+
 private:
-  etcpal_socket_t socket_{ETCPAL_SOCKET_INVALID};
-  etcpal::Logger* log_{nullptr};
+  etcpal_socket_t   socket_{ETCPAL_SOCKET_INVALID};
+  EtcPalPollContext poll_context_;
+  bool              poll_context_valid_{false};
+  etcpal::Logger*   log_{nullptr};
+
+  std::vector<AcceptedConnection> accepted_;
+
+  void CloseSocket();
 };
 
 class ClientServiceThread : public BrokerThread
 {
 public:
-  ClientServiceThread(BrokerThreadNotify* notify) : BrokerThread(notify) {}
+  ClientServiceThread(BrokerThreadNotify* notify, etcpal::Signal* wake_signal)
+      : BrokerThread(notify), wake_signal_(wake_signal)
+  {
+  }
   ~ClientServiceThread() override;
 
   etcpal::Error Start() override;
   void          Run() override;
 
+  // The longest the thread will block without work before servicing clients anyway. This bounds
+  // the latency of timer-driven work (heartbeats, connection timeouts, deferred client
+  // destruction), which does not wake the thread.
+  static constexpr int kMaxIdleWaitMs{100};
+
 protected:
-  static constexpr int kSleepMs{1};
+  etcpal::Signal* wake_signal_{nullptr};
+};
+
+class UidReservationSaveThread : public BrokerThread
+{
+public:
+  UidReservationSaveThread(BrokerThreadNotify* notify) : BrokerThread(notify) {}
+  ~UidReservationSaveThread() override;
+
+  etcpal::Error Start() override;
+  void          Run() override;
+
+  // How often changed reservations are saved.
+  static constexpr int kSaveIntervalMs{5000};
+
+protected:
+  // Wakes the thread early when it is stopped.
+  etcpal::Signal stop_signal_;
 };
 
 class BrokerThreadInterface
@@ -108,6 +169,11 @@ public:
   virtual etcpal::Error AddListenThread(etcpal_socket_t listen_sock) = 0;
 
   virtual etcpal::Error AddClientServiceThread() = 0;
+  virtual etcpal::Error AddUidReservationSaveThread() = 0;
+
+  // Wake the client service thread(s) because new outgoing data may be available. Safe to call from
+  // any thread, including before threads are started and after they are stopped.
+  virtual void WakeClientServiceThreads() = 0;
 
   virtual void StopThreads() = 0;
 };
@@ -119,6 +185,9 @@ public:
 
   etcpal::Error AddListenThread(etcpal_socket_t listen_sock) override;
   etcpal::Error AddClientServiceThread() override;
+  etcpal::Error AddUidReservationSaveThread() override;
+
+  void WakeClientServiceThreads() override;
 
   void StopThreads() override;
 
@@ -127,6 +196,9 @@ public:
 private:
   BrokerThreadNotify* notify_{nullptr};
 
+  // Shared by all client service threads; outlives them since it is owned by the manager.
+  etcpal::Signal client_service_signal_;
+
   std::vector<std::unique_ptr<BrokerThread>> threads_;
 
   etcpal::Logger* log_{nullptr};
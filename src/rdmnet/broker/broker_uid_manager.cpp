@@ -19,6 +19,131 @@
 
 #include "broker_uid_manager.h"
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "etcpal/pack.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/*********************** Reservation file format *****************************/
+
+// The reservation file is a header followed by one fixed-size record per reservation, all
+// big-endian:
+//   Header: magic (8 bytes), version (4 bytes), record count (4 bytes)
+//   Record: CID or RID (16 bytes), UID manufacturer ID (2 bytes), UID device ID (4 bytes)
+// Records are stored least recently used first.
+
+namespace
+{
+constexpr uint8_t  kReservationFileMagic[8] = {'R', 'D', 'M', 'n', 'e', 't', 'U', 'R'};
+constexpr uint32_t kReservationFileVersion = 1;
+constexpr size_t   kReservationFileHeaderSize = 16;
+constexpr size_t   kReservationRecordSize = ETCPAL_UUID_BYTES + 6;
+
+struct SavedReservation
+{
+  etcpal::Uuid cid_or_rid;
+  RdmUid       uid;
+};
+
+etcpal::Error ReadReservationFile(const std::string& path, std::vector<SavedReservation>& reservations)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return kEtcPalErrNotFound;
+
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  if (data.size() < kReservationFileHeaderSize ||
+      std::memcmp(data.data(), kReservationFileMagic, sizeof(kReservationFileMagic)) != 0 ||
+      etcpal_unpack_u32b(&data[8]) != kReservationFileVersion)
+  {
+    return kEtcPalErrProtocol;
+  }
+
+  // A file that was cut short is rejected as a whole rather than partially loaded.
+  size_t num_records = etcpal_unpack_u32b(&data[12]);
+  if (data.size() != kReservationFileHeaderSize + num_records * kReservationRecordSize)
+    return kEtcPalErrProtocol;
+
+  reservations.clear();
+  reservations.reserve(num_records);
+  for (const uint8_t* cur_ptr = &data[kReservationFileHeaderSize]; num_records > 0; --num_records)
+  {
+    EtcPalUuid cid_or_rid;
+    std::memcpy(cid_or_rid.data, cur_ptr, ETCPAL_UUID_BYTES);
+    cur_ptr += ETCPAL_UUID_BYTES;
+    RdmUid uid;
+    uid.manu = etcpal_unpack_u16b(cur_ptr);
+    cur_ptr += 2;
+    uid.id = etcpal_unpack_u32b(cur_ptr);
+    cur_ptr += 4;
+    reservations.push_back(SavedReservation{cid_or_rid, uid});
+  }
+  return kEtcPalErrOk;
+}
+
+bool WriteFileDurably(const std::string& path, const std::vector<uint8_t>& data)
+{
+  FILE* file = std::fopen(path.c_str(), "wb");
+  if (!file)
+    return false;
+
+  bool ok = (std::fwrite(data.data(), 1, data.size(), file) == data.size()) && (std::fflush(file) == 0);
+#ifdef _WIN32
+  ok = ok && (_commit(_fileno(file)) == 0);
+#else
+  ok = ok && (fsync(fileno(file)) == 0);
+#endif
+  return (std::fclose(file) == 0) && ok;
+}
+
+// Writes to a temporary file and then renames it over the old one, so that a crash never leaves a
+// partially-written reservation file behind.
+bool WriteReservationFile(const std::string& path, const std::vector<SavedReservation>& reservations)
+{
+  std::vector<uint8_t> data(kReservationFileHeaderSize + reservations.size() * kReservationRecordSize);
+
+  std::memcpy(data.data(), kReservationFileMagic, sizeof(kReservationFileMagic));
+  etcpal_pack_u32b(&data[8], kReservationFileVersion);
+  etcpal_pack_u32b(&data[12], static_cast<uint32_t>(reservations.size()));
+  uint8_t* cur_ptr = &data[kReservationFileHeaderSize];
+  for (const auto& reservation : reservations)
+  {
+    std::memcpy(cur_ptr, reservation.cid_or_rid.get().data, ETCPAL_UUID_BYTES);
+    cur_ptr += ETCPAL_UUID_BYTES;
+    etcpal_pack_u16b(cur_ptr, reservation.uid.manu);
+    cur_ptr += 2;
+    etcpal_pack_u32b(cur_ptr, reservation.uid.id);
+    cur_ptr += 4;
+  }
+
+  const std::string temp_path = path + ".tmp";
+  if (!WriteFileDurably(temp_path, data))
+  {
+    std::remove(temp_path.c_str());
+    return false;
+  }
+
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+  {
+    // Some platforms (e.g. Windows) won't rename over an existing file. If we crash between these
+    // two calls, LoadReservations() falls back to the temporary file.
+    std::remove(path.c_str());
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+      return false;
+  }
+  return true;
+}
+}  // namespace
+
+/*************************** Function definitions ****************************/
+
 BrokerUidManager::AddResult BrokerUidManager::AddStaticUid(BrokerClient::Handle client_handle, const RdmUid& static_uid)
 {
   if (!lock_)
@@ -61,6 +186,7 @@ BrokerUidManager::AddResult BrokerUidManager::AddDynamicUid(BrokerClient::Handle
     {
       new_dynamic_uid = reservation->second.assigned_uid;
       reservation->second.currently_connected = true;
+      disconnected_lru_.erase(reservation->second.lru_pos);
       new_uid_data.reservation = &reservation->second;
     }
   }
@@ -71,8 +197,7 @@ BrokerUidManager::AddResult BrokerUidManager::AddDynamicUid(BrokerClient::Handle
     {
       new_dynamic_uid.id = next_device_id_++;
     } while ((next_device_id_ == 1) || uid_lookup_.find(new_dynamic_uid) != uid_lookup_.end());
-    auto ins_res = reservations_.insert(std::make_pair(cid_or_rid, ReservationData(new_dynamic_uid)));
-    new_uid_data.reservation = &ins_res.first->second;
+    new_uid_data.reservation = AddReservation(cid_or_rid, new_dynamic_uid, true);
   }
   uid_lookup_.insert(std::make_pair(new_dynamic_uid, new_uid_data));
   return AddResult::kOk;
@@ -88,9 +213,12 @@ void BrokerUidManager::RemoveUid(const RdmUid& uid)
   auto uid_data = uid_lookup_.find(uid);
   if (uid_data != uid_lookup_.end())
   {
-    if (uid_data->second.reservation)
+    ReservationData* reservation = uid_data->second.reservation;
+    if (reservation)
     {
-      uid_data->second.reservation->currently_connected = false;
+      reservation->currently_connected = false;
+      reservation->lru_pos = disconnected_lru_.insert(disconnected_lru_.end(), reservation->cid_or_rid);
+      *reservations_dirty_ = true;
     }
     uid_lookup_.erase(uid_data);
   }
@@ -114,3 +242,134 @@ bool BrokerUidManager::UidToHandle(const RdmUid& uid, BrokerClient::Handle& clie
     return false;
   }
 }
+
+void BrokerUidManager::SetMaxReservations(size_t max_reservations)
+{
+  if (!lock_)
+    return;
+
+  etcpal::WriteGuard write_guard(*lock_);
+  max_reservations_ = max_reservations;
+  if (max_reservations_ > 0)
+    TrimReservations(max_reservations_);
+}
+
+size_t BrokerUidManager::GetNumReservations() const
+{
+  if (!lock_)
+    return 0;
+
+  etcpal::ReadGuard read_guard(*lock_);
+  return reservations_.size();
+}
+
+// Sets the file used to save reservations and loads any reservations already saved there. Returns
+// the number of reservations loaded, or kEtcPalErrNotFound if there was no file to load (in which
+// case one will be created the next time reservations are saved).
+etcpal::Expected<size_t> BrokerUidManager::LoadReservations(const std::string& file_path)
+{
+  if (!lock_)
+    return kEtcPalErrSys;
+
+  std::vector<SavedReservation> saved;
+  etcpal::Error                 result = ReadReservationFile(file_path, saved);
+  if (!result)
+  {
+    if (ReadReservationFile(file_path + ".tmp", saved))
+      result = kEtcPalErrOk;
+  }
+
+  etcpal::WriteGuard write_guard(*lock_);
+  reservation_file_ = file_path;
+  if (!result)
+    return result.code();
+
+  size_t num_loaded = 0;
+  for (const auto& reservation : saved)
+  {
+    if (reservations_.find(reservation.cid_or_rid) != reservations_.end())
+      continue;
+
+    AddReservation(reservation.cid_or_rid, reservation.uid, false);
+    ++num_loaded;
+
+    // Don't hand out any of the loaded UIDs to new components.
+    if (reservation.uid.id >= next_device_id_ && reservation.uid.id != 0xffffffffu)
+      next_device_id_ = reservation.uid.id + 1;
+  }
+  *reservations_dirty_ = false;
+  return num_loaded;
+}
+
+// Saves the reservations to the file set by LoadReservations(), if they have changed since they were
+// last saved. Returns false if the file could not be written.
+bool BrokerUidManager::SaveReservations()
+{
+  if (!lock_ || !save_lock_ || !reservations_dirty_)
+    return false;
+
+  etcpal::MutexGuard save_guard(*save_lock_);
+
+  std::string                   file_path;
+  std::vector<SavedReservation> to_save;
+  {
+    // Only a read lock is needed to take the snapshot, so UIDs can still be looked up meanwhile.
+    // Reservations can't change while it is held, so clearing the dirty flag here can't lose one.
+    etcpal::ReadGuard read_guard(*lock_);
+    if (reservation_file_.empty() || !reservations_dirty_->exchange(false))
+      return true;
+
+    file_path = reservation_file_;
+    to_save.reserve(reservations_.size());
+    for (const auto& cid_or_rid : disconnected_lru_)
+    {
+      const auto reservation = reservations_.find(cid_or_rid);
+      if (reservation != reservations_.end())
+        to_save.push_back(SavedReservation{cid_or_rid, reservation->second.assigned_uid});
+    }
+    // Connected components are the most recently used.
+    for (const auto& reservation : reservations_)
+    {
+      if (reservation.second.currently_connected)
+        to_save.push_back(SavedReservation{reservation.first, reservation.second.assigned_uid});
+    }
+  }
+
+  if (!WriteReservationFile(file_path, to_save))
+  {
+    *reservations_dirty_ = true;
+    return false;
+  }
+  return true;
+}
+
+// Needs write lock on lock_
+BrokerUidManager::ReservationData* BrokerUidManager::AddReservation(const etcpal::Uuid& cid_or_rid,
+                                                                    const RdmUid&       uid,
+                                                                    bool                connected)
+{
+  if (max_reservations_ > 0)
+    TrimReservations(max_reservations_ - 1);
+
+  auto             ins_res = reservations_.insert(std::make_pair(cid_or_rid, ReservationData(cid_or_rid, uid)));
+  ReservationData& reservation = ins_res.first->second;
+  reservation.currently_connected = connected;
+  if (!connected)
+    reservation.lru_pos = disconnected_lru_.insert(disconnected_lru_.end(), cid_or_rid);
+
+  *reservations_dirty_ = true;
+  return &reservation;
+}
+
+// Discards the reservations of the components which have been disconnected the longest until no
+// more than max_reservations remain. Reservations of connected components are never discarded.
+// Needs write lock on lock_
+void BrokerUidManager::TrimReservations(size_t max_reservations)
+{
+  while (reservations_.size() > max_reservations && !disconnected_lru_.empty())
+  {
+    reservations_.erase(disconnected_lru_.front());
+    disconnected_lru_.pop_front();
+    *reservations_dirty_ = true;
+  }
+}
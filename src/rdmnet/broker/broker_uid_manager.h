@@ -20,7 +20,14 @@
 #ifndef BROKER_UID_MANAGER_H_
 #define BROKER_UID_MANAGER_H_
 
+#include <atomic>
+#include <list>
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "etcpal/cpp/error.h"
+#include "etcpal/cpp/mutex.h"
 #include "etcpal/cpp/uuid.h"
 #include "etcpal/cpp/rwlock.h"
 #include "rdm/uid.h"
@@ -31,6 +38,11 @@
 ///
 /// This class does very little validation of UIDs - that is expected to be done before this class
 /// is used.
+///
+/// Dynamic UID reservations are bounded: when the maximum number is reached, the reservation of the
+/// component which has been disconnected the longest is discarded. Reservations can optionally be
+/// kept in a file so that they survive a broker restart; the file is only ever replaced as a whole,
+/// by writing a temporary file next to it and renaming it into place.
 class BrokerUidManager
 {
 public:
@@ -38,6 +50,7 @@ public:
   explicit BrokerUidManager(size_t max_uid_capacity) : max_uid_capacity_(max_uid_capacity) {}
 
   static constexpr size_t kDefaultMaxUidCapacity = 1000000;
+  static constexpr size_t kDefaultMaxReservations = 100000;
   enum class AddResult
   {
     kOk,
@@ -52,6 +65,13 @@ public:
 
   bool UidToHandle(const RdmUid& uid, BrokerClient::Handle& client_handle) const;
 
+  // 0 means no limit.
+  void   SetMaxReservations(size_t max_reservations);
+  size_t GetNumReservations() const;
+
+  etcpal::Expected<size_t> LoadReservations(const std::string& file_path);
+  bool                     SaveReservations();
+
   void SetNextDeviceId(uint32_t next_device_id)
   {
     if (lock_)
@@ -62,13 +82,21 @@ public:
   }
 
 private:
+  using ReservationLru = std::list<etcpal::Uuid>;
+
   struct ReservationData
   {
-    explicit ReservationData(const RdmUid& uid) : assigned_uid(uid) {}
+    ReservationData(const etcpal::Uuid& cid_or_rid_in, const RdmUid& uid) : cid_or_rid(cid_or_rid_in), assigned_uid(uid)
+    {
+    }
 
-    RdmUid assigned_uid;
-    bool   currently_connected{true};
+    etcpal::Uuid cid_or_rid;
+    RdmUid       assigned_uid;
+    bool         currently_connected{true};
+    // The position of this reservation in disconnected_lru_, valid only while disconnected.
+    ReservationLru::iterator lru_pos;
   };
+
   struct UidData
   {
     explicit UidData(BrokerClient::Handle client_handle_in) : client_handle(client_handle_in) {}
@@ -80,13 +108,25 @@ private:
   // The uid-keyed lookup table
   std::map<RdmUid, UidData> uid_lookup_;
   // We try to give the same components back their dynamic UIDs when they reconnect.
-  // TODO: scalability/flushing to disk.
   std::map<etcpal::Uuid, ReservationData> reservations_;
+  // The reservations of disconnected components, least recently disconnected first.
+  ReservationLru disconnected_lru_;
+  size_t         max_reservations_{kDefaultMaxReservations};
+  // Where reservations are saved, and whether they have changed since they were last saved. The
+  // dirty flag is set under the write lock and cleared by SaveReservations() under the read lock, so
+  // it is atomic.
+  std::string                        reservation_file_;
+  std::unique_ptr<std::atomic<bool>> reservations_dirty_{new std::atomic<bool>(false)};
   // The next dynamic RDM Device ID that will be assigned
   uint32_t next_device_id_{1};
   size_t   max_uid_capacity_{kDefaultMaxUidCapacity};
   // Protects the members of BrokerUidManager
   mutable std::unique_ptr<etcpal::RwLock> lock_{new etcpal::RwLock};
+  // Serializes writes to the reservation file, which are done outside of lock_.
+  std::unique_ptr<etcpal::Mutex> save_lock_{new etcpal::Mutex};
+
+  ReservationData* AddReservation(const etcpal::Uuid& cid_or_rid, const RdmUid& uid, bool connected);
+  void             TrimReservations(size_t max_reservations);
 };
 
 #endif  // BROKER_UID_MANAGER_H_
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "broker_uid_table.h"
+
+// Adds a client to the table, replacing any existing (normally detached) entry with the same UID.
+// The table is kept at most half full.
+void RptClientUidTable::Insert(const RdmUid& uid, RPTClient* client)
+{
+  if ((size_ + 1) * 2 > capacity_)
+    Grow();
+
+  size_t slot = HomeSlot(uid);
+  while (slots_[slot].in_use)
+  {
+    if (RDM_UID_EQUAL(&slots_[slot].uid, &uid))
+    {
+      slots_[slot].client.store(client, std::memory_order_release);
+      return;
+    }
+    slot = (slot + 1) & (capacity_ - 1);
+  }
+
+  slots_[slot].uid = uid;
+  slots_[slot].client.store(client, std::memory_order_release);
+  slots_[slot].in_use = true;
+  ++size_;
+}
+
+// Removes the entry for a UID, but only if it still belongs to the given client. A new client may
+// have taken over the UID after the old one was detached.
+void RptClientUidTable::Erase(const RdmUid& uid, const RPTClient* client)
+{
+  const Slot* found = FindSlot(uid);
+  if (!found)
+    return;
+
+  RPTClient* current = found->client.load(std::memory_order_relaxed);
+  if (current && current != client)
+    return;
+
+  RemoveSlot(static_cast<size_t>(found - slots_.get()));
+}
+
+RPTClient* RptClientUidTable::Find(const RdmUid& uid) const
+{
+  const Slot* found = FindSlot(uid);
+  return (found ? found->client.load(std::memory_order_acquire) : nullptr);
+}
+
+// Makes a UID unroutable without changing the structure of the table.
+void RptClientUidTable::Detach(const RdmUid& uid)
+{
+  const Slot* found = FindSlot(uid);
+  if (found)
+    const_cast<Slot*>(found)->client.store(nullptr, std::memory_order_release);
+}
+
+size_t RptClientUidTable::HomeSlot(const RdmUid& uid) const noexcept
+{
+  uint32_t hash = (static_cast<uint32_t>(uid.manu) << 16) ^ uid.id ^ (uid.id >> 16);
+  hash *= 2654435761u;
+  return static_cast<size_t>(hash) & (capacity_ - 1);
+}
+
+const RptClientUidTable::Slot* RptClientUidTable::FindSlot(const RdmUid& uid) const
+{
+  if (size_ == 0)
+    return nullptr;
+
+  for (size_t slot = HomeSlot(uid); slots_[slot].in_use; slot = (slot + 1) & (capacity_ - 1))
+  {
+    if (RDM_UID_EQUAL(&slots_[slot].uid, &uid))
+      return &slots_[slot];
+  }
+  return nullptr;
+}
+
+void RptClientUidTable::Grow()
+{
+  std::unique_ptr<Slot[]> old_slots = std::move(slots_);
+  const size_t            old_capacity = capacity_;
+
+  capacity_ = (old_capacity ? old_capacity * 2 : kInitialCapacity);
+  slots_.reset(new Slot[capacity_]);
+  size_ = 0;
+
+  for (size_t i = 0; i < old_capacity; ++i)
+  {
+    if (old_slots[i].in_use)
+    {
+      size_t slot = HomeSlot(old_slots[i].uid);
+      while (slots_[slot].in_use)
+        slot = (slot + 1) & (capacity_ - 1);
+
+      slots_[slot].uid = old_slots[i].uid;
+      slots_[slot].client.store(old_slots[i].client.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      slots_[slot].in_use = true;
+      ++size_;
+    }
+  }
+}
+
+// Backward-shift deletion, so that no tombstones are left behind to lengthen later probes.
+void RptClientUidTable::RemoveSlot(size_t hole)
+{
+  const size_t mask = capacity_ - 1;
+  for (size_t slot = (hole + 1) & mask; slots_[slot].in_use; slot = (slot + 1) & mask)
+  {
+    size_t home = HomeSlot(slots_[slot].uid);
+    if ((slot > hole && (home <= hole || home > slot)) || (slot < hole && (home <= hole && home > slot)))
+    {
+      slots_[hole].uid = slots_[slot].uid;
+      slots_[hole].client.store(slots_[slot].client.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      hole = slot;
+    }
+  }
+  slots_[hole].in_use = false;
+  slots_[hole].client.store(nullptr, std::memory_order_relaxed);
+  --size_;
+}
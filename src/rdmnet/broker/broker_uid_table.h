@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+/// @file broker_uid_table.h
+
+#ifndef BROKER_UID_TABLE_H_
+#define BROKER_UID_TABLE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "rdm/uid.h"
+#include "broker_client.h"
+
+// An open-addressed UID -> RPT client table used to route unicast RPT messages.
+//
+// Structural changes (Insert() and Erase()) require exclusive access to the table, which the
+// BrokerCore provides with a write lock on its client_lock_. Find() and Detach() only need shared
+// access (a read lock): Detach() clears an entry's client pointer atomically but leaves its key in
+// place, so concurrent probes are never disturbed. The key is removed by a later Erase() once the
+// client is destroyed.
+class RptClientUidTable
+{
+public:
+  static constexpr size_t kInitialCapacity = 64;
+
+  RptClientUidTable() = default;
+  RptClientUidTable(const RptClientUidTable& other) = delete;
+  RptClientUidTable& operator=(const RptClientUidTable& other) = delete;
+
+  // Require exclusive access
+  void Insert(const RdmUid& uid, RPTClient* client);
+  void Erase(const RdmUid& uid, const RPTClient* client);
+
+  // Require shared access
+  RPTClient* Find(const RdmUid& uid) const;
+  void       Detach(const RdmUid& uid);
+
+  size_t size() const noexcept { return size_; }
+  size_t capacity() const noexcept { return capacity_; }
+
+private:
+  struct Slot
+  {
+    RdmUid                  uid{};
+    std::atomic<RPTClient*> client{nullptr};
+    bool                    in_use{false};
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t                  capacity_{0};
+  // The number of keys in the table, including detached ones.
+  size_t size_{0};
+
+  size_t      HomeSlot(const RdmUid& uid) const noexcept;
+  const Slot* FindSlot(const RdmUid& uid) const;
+  void        Grow();
+  void        RemoveSlot(size_t hole);
+};
+
+#endif  // BROKER_UID_TABLE_H_
@@ -18,7 +18,8 @@
  *****************************************************************************/
 
 // epoll() is a scalabile mechanism for watching many file descriptors (including sockets) in the
-// Linux kernel. For this app, we use a single thread polling all of the currently-open sockets.
+// Linux kernel. For this app, the currently-open sockets are divided into shards, each polled by
+// its own thread with its own epoll instance.
 //
 // Further reading:
 // "man epoll" from a Linux distribution command line
@@ -27,7 +28,10 @@
 #include "linux_socket_manager.h"
 
 #include <algorithm>
+#include <pthread.h>
+#include <sched.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -36,48 +40,118 @@
 constexpr int kMaxEvents = 100;
 constexpr int kEpollTimeout = 200;
 
-// Function for the worker thread which does all the socket reading.
+// The shard's wake eventfd is registered with the invalid client handle, which never identifies a
+// client socket.
+constexpr BrokerClient::Handle kWakeEventHandle = BrokerClient::kInvalidHandle;
+
+// Function for each worker thread, which does all the socket reading for one shard.
 void* SocketWorkerThread(void* arg)
 {
-  LinuxBrokerSocketManager* sock_mgr = reinterpret_cast<LinuxBrokerSocketManager*>(arg);
-  if (!sock_mgr)
+  SocketShard* shard = reinterpret_cast<SocketShard*>(arg);
+  if (!shard)
     return reinterpret_cast<void*>(1);
 
+  LinuxBrokerSocketManager& sock_mgr = shard->mgr;
+
   std::unique_ptr<struct epoll_event[]> events(new struct epoll_event[kMaxEvents]);
 
-  while (sock_mgr->keep_running())
+  while (sock_mgr.keep_running())
   {
-    int epoll_result = epoll_wait(sock_mgr->epoll_fd(), events.get(), kMaxEvents, kEpollTimeout);
-    for (int i = 0; i < epoll_result && sock_mgr->keep_running(); ++i)
+    int epoll_result = epoll_wait(shard->epoll_fd, events.get(), kMaxEvents, kEpollTimeout);
+    for (int i = 0; i < epoll_result && sock_mgr.keep_running(); ++i)
     {
-      if (events[i].events & EPOLLERR)
+      if (events[i].data.fd == kWakeEventHandle)
+      {
+        // The broker has made room in its queues
+        sock_mgr.WorkerRetryThrottledSockets(*shard);
+      }
+      else if (events[i].events & EPOLLERR)
       {
         // Notify that this socket is bad
-        sock_mgr->WorkerNotifySocketBad(events[i].data.fd);
+        sock_mgr.WorkerNotifySocketBad(*shard, events[i].data.fd);
       }
       else if (events[i].events & EPOLLIN)
       {
         // Do the read on the socket
-        sock_mgr->WorkerNotifySocketReadEvent(events[i].data.fd);
+        sock_mgr.WorkerNotifySocketReadEvent(*shard, events[i].data.fd);
+      }
+      else if (events[i].events & EPOLLHUP)
+      {
+        // Hangups are reported even while reads are paused on a throttled socket
+        sock_mgr.WorkerNotifySocketBad(*shard, events[i].data.fd);
       }
     }
+
+    // As a fallback, retry throttled sockets whenever the shard has been idle for a timeout period.
+    if (epoll_result == 0)
+      sock_mgr.WorkerRetryThrottledSockets(*shard);
   }
   return reinterpret_cast<void*>(0);
 }
 
+SocketData::~SocketData()
+{
+  if (msg_pending)
+    rc_free_message_resources(&recv_buf.msg);
+  if (recv_buf_valid)
+    rc_msg_buf_cleanup(&recv_buf);
+  if (socket >= 0)
+    close(socket);
+}
+
+void LinuxBrokerSocketManager::SetWorkerThreadConfig(unsigned int num_threads, bool pin_threads)
+{
+  num_workers_ = num_threads;
+  pin_workers_ = pin_threads;
+}
+
 bool LinuxBrokerSocketManager::Startup()
 {
-  // Per the man page, the size argument is ignored but must be greater than zero. Random value was
-  // chosen
-  epoll_fd_ = epoll_create(42);
-  if (epoll_fd_ < 0)
-    return false;
+  shutting_down_ = false;
+
+  long         num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  unsigned int num_workers = num_workers_;
+  if (num_workers == 0)
+    num_workers = (num_cpus > 0 ? static_cast<unsigned int>(num_cpus) : 1);
 
-  if (0 != pthread_create(&thread_handle_, NULL, SocketWorkerThread, this))
+  for (unsigned int i = 0; i < num_workers; ++i)
   {
-    close(epoll_fd_);
-    epoll_fd_ = -1;
-    return false;
+    std::unique_ptr<SocketShard> shard(new SocketShard(*this, i));
+
+    // Per the man page, the size argument is ignored but must be greater than zero. Random value was
+    // chosen
+    shard->epoll_fd = epoll_create(42);
+    if (shard->epoll_fd < 0)
+    {
+      Shutdown();
+      return false;
+    }
+
+    struct epoll_event wake_event;
+    wake_event.events = EPOLLIN;
+    wake_event.data.fd = kWakeEventHandle;
+    shard->wake_fd = eventfd(0, EFD_NONBLOCK);
+    if (shard->wake_fd < 0 || 0 != epoll_ctl(shard->epoll_fd, EPOLL_CTL_ADD, shard->wake_fd, &wake_event) ||
+        0 != pthread_create(&shard->thread_handle, NULL, SocketWorkerThread, shard.get()))
+    {
+      if (shard->wake_fd >= 0)
+        close(shard->wake_fd);
+      close(shard->epoll_fd);
+      Shutdown();
+      return false;
+    }
+    shard->thread_started = true;
+
+    if (pin_workers_ && num_cpus > 0)
+    {
+      // Failing to pin a thread is not fatal; it just runs wherever the scheduler puts it.
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(i % static_cast<unsigned int>(num_cpus), &cpu_set);
+      pthread_setaffinity_np(shard->thread_handle, sizeof(cpu_set), &cpu_set);
+    }
+
+    shards_.push_back(std::move(shard));
   }
 
   return true;
@@ -87,136 +161,275 @@ bool LinuxBrokerSocketManager::Shutdown()
 {
   shutting_down_ = true;
 
-  if (epoll_fd_ >= 0)
-    close(epoll_fd_);
+  // Shutdown the worker threads. Each one exits within one epoll timeout of seeing the shutdown
+  // flag, so they are all joined before their epoll fds are closed.
+  for (auto& shard : shards_)
+  {
+    if (!RDMNET_ASSERT_VERIFY(shard))
+      return false;
 
-  // Shutdown the worker thread
-  pthread_join(thread_handle_, NULL);
+    if (shard->thread_started)
+      pthread_join(shard->thread_handle, NULL);
+  }
 
-  etcpal::MutexGuard socket_guard(socket_lock_);
-  for (auto& sock_data : sockets_)
+  bool result = true;
+  for (auto& shard : shards_)
   {
-    if (!RDMNET_ASSERT_VERIFY(sock_data.second))
-      return false;
+    shard->throttled_sockets.clear();
+    shard->num_throttled = 0;
+    if (shard->wake_fd >= 0)
+      close(shard->wake_fd);
+    if (shard->epoll_fd >= 0)
+      close(shard->epoll_fd);
+
+    etcpal::MutexGuard shard_guard(shard->lock);
+    for (auto& sock_data : shard->sockets)
+    {
+      if (!RDMNET_ASSERT_VERIFY(sock_data.second))
+      {
+        result = false;
+        continue;
+      }
 
-    shutdown(sock_data.second->socket, SHUT_RDWR);
-    close(sock_data.second->socket);
+      shutdown(sock_data.second->socket, SHUT_RDWR);
+    }
+    shard->sockets.clear();
   }
-  sockets_.clear();
+  shards_.clear();
 
-  return true;
+  return result;
 }
 
 bool LinuxBrokerSocketManager::AddSocket(BrokerClient::Handle client_handle, etcpal_socket_t socket)
 {
-  etcpal::MutexGuard socket_guard(socket_lock_);
+  if (shards_.empty())
+    return false;
+
+  SocketShard&       shard = ShardForHandle(client_handle);
+  etcpal::MutexGuard shard_guard(shard.lock);
 
   // Create the data structure for the new socket
-  std::unique_ptr<SocketData> new_sock_data(new SocketData(client_handle, socket));
-  if (new_sock_data)
+  std::shared_ptr<SocketData> new_sock_data = std::make_shared<SocketData>(client_handle, socket, recv_buf_size_);
+  if (new_sock_data->recv_buf_valid)
   {
     // Add it to the socket map
-    auto result = sockets_.insert(std::make_pair(client_handle, std::move(new_sock_data)));
+    auto result = shard.sockets.insert(std::make_pair(client_handle, new_sock_data));
     if (result.second)
     {
       // Add the socket to our epoll fd
       struct epoll_event new_event;
       new_event.events = EPOLLIN;
       new_event.data.fd = client_handle;
-      if (0 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, socket, &new_event))
-      {
+      if (0 == epoll_ctl(shard.epoll_fd, EPOLL_CTL_ADD, socket, &new_event))
         return true;
-      }
-      else
-      {
-        sockets_.erase(client_handle);
-      }
+
+      shard.sockets.erase(client_handle);
     }
   }
+
+  // The caller still owns the socket on failure.
+  new_sock_data->socket = -1;
   return false;
 }
 
 void LinuxBrokerSocketManager::RemoveSocket(BrokerClient::Handle client_handle)
 {
-  etcpal::MutexGuard socket_guard(socket_lock_);
+  if (shards_.empty())
+    return;
 
-  auto sock_data = sockets_.find(client_handle);
-  if (sock_data != sockets_.end())
+  SocketShard&       shard = ShardForHandle(client_handle);
+  etcpal::MutexGuard shard_guard(shard.lock);
+
+  auto sock_data = shard.sockets.find(client_handle);
+  if (sock_data != shard.sockets.end())
   {
     if (!RDMNET_ASSERT_VERIFY(sock_data->second))
       return;
 
-    // Per the epoll man page, deregister is not necessary before closing the socket.
+    // Per the epoll man page, deregister is not necessary before closing the socket. The socket is
+    // closed once its worker thread is done with it.
     shutdown(sock_data->second->socket, SHUT_RDWR);
-    close(sock_data->second->socket);
-    sockets_.erase(sock_data);
+    shard.sockets.erase(sock_data);
   }
 }
 
-void LinuxBrokerSocketManager::WorkerNotifySocketBad(BrokerClient::Handle client_handle)
+void LinuxBrokerSocketManager::ResumeThrottledSockets()
 {
-  {  // Lock scope
-    etcpal::MutexGuard socket_guard(socket_lock_);
+  static const uint64_t kWakeValue = 1;
 
-    auto sock_data = sockets_.find(client_handle);
-    if (sock_data != sockets_.end())
+  for (auto& shard : shards_)
+  {
+    if (shard->num_throttled > 0)
     {
-      if (!RDMNET_ASSERT_VERIFY(sock_data->second))
-        return;
-
-      close(sock_data->second->socket);
-      sockets_.erase(sock_data);
+      ssize_t write_result = write(shard->wake_fd, &kWakeValue, sizeof(kWakeValue));
+      (void)write_result;  // The only expected failure is a saturated counter, which still wakes the worker.
     }
   }
+}
+
+void LinuxBrokerSocketManager::WorkerNotifySocketBad(SocketShard& shard, BrokerClient::Handle client_handle)
+{
+  // Drop any throttled reference to the socket so that it is closed and leaves the epoll set.
+  auto& throttled = shard.throttled_sockets;
+  throttled.erase(std::remove_if(throttled.begin(), throttled.end(),
+                                 [client_handle](const std::shared_ptr<SocketData>& sock_data) {
+                                   return sock_data->client_handle == client_handle;
+                                 }),
+                  throttled.end());
+  shard.num_throttled = throttled.size();
+
+  {  // Lock scope
+    etcpal::MutexGuard shard_guard(shard.lock);
+
+    auto sock_data = shard.sockets.find(client_handle);
+    if (sock_data == shard.sockets.end())
+      return;
+
+    shard.sockets.erase(sock_data);
+  }
 
   if (notify_)
     notify_->HandleSocketClosed(client_handle, false);
 }
 
-void LinuxBrokerSocketManager::WorkerNotifySocketReadEvent(BrokerClient::Handle client_handle)
+void LinuxBrokerSocketManager::WorkerNotifySocketReadEvent(SocketShard& shard, BrokerClient::Handle client_handle)
 {
-  etcpal::MutexGuard socket_guard(socket_lock_);
+  // The shard lock is only held while looking up the socket, so that routing this client's messages
+  // doesn't block adding or removing other sockets in the shard. Only this shard's worker thread
+  // reads from the socket, and the shared reference keeps its data valid if it is removed meanwhile.
+  std::shared_ptr<SocketData> sock_data;
+  {  // Lock scope
+    etcpal::MutexGuard shard_guard(shard.lock);
+
+    auto sock_data_iter = shard.sockets.find(client_handle);
+    if (sock_data_iter == shard.sockets.end())
+      return;
+    sock_data = sock_data_iter->second;
+  }
 
-  auto sock_data_iter = sockets_.find(client_handle);
-  if (sock_data_iter == sockets_.end())
+  if (!RDMNET_ASSERT_VERIFY(sock_data))
     return;
 
-  SocketData* sock_data = sock_data_iter->second.get();
-  if (!RDMNET_ASSERT_VERIFY(sock_data) || !RDMNET_ASSERT_VERIFY(sock_data->recv_buf.cur_data_size <= RC_MSG_BUF_SIZE))
+  // Reads stay paused until the pending message is accepted.
+  if (sock_data->throttled)
     return;
 
+  size_t recv_buf_size = rc_msg_buf_make_room(&sock_data->recv_buf);
   void*  recv_buf = &sock_data->recv_buf.buf[sock_data->recv_buf.cur_data_size];
-  size_t recv_buf_size =
-      std::min<size_t>(RDMNET_RECV_DATA_MAX_SIZE, RC_MSG_BUF_SIZE - sock_data->recv_buf.cur_data_size);
 
   ssize_t recv_result = recv(sock_data->socket, recv_buf, recv_buf_size, 0);
   if (recv_result <= 0)
   {
-    // The socket was closed, either gracefully or ungracefully.
-    close(sock_data->socket);
-    sockets_.erase(sock_data_iter);
-    if (notify_)
+    // The socket was closed, either gracefully or ungracefully. If it was already removed, the
+    // client is being destroyed and its handle may be reused, so don't notify.
+    if (EraseSocket(shard, sock_data) && notify_)
       notify_->HandleSocketClosed(client_handle, (recv_result == 0));
   }
   else
   {
     sock_data->recv_buf.cur_data_size += recv_result;
-    etcpal_error_t res = rc_msg_buf_parse_data(&sock_data->recv_buf);
-    while (res == kEtcPalErrOk)
+    if (!DeliverMessages(*sock_data))
+      ThrottleSocket(shard, sock_data);
+  }
+}
+
+// Retry delivering the pending message on each throttled socket in the shard, resuming reads on
+// those which the broker now accepts.
+void LinuxBrokerSocketManager::WorkerRetryThrottledSockets(SocketShard& shard)
+{
+  uint64_t wake_count;
+  ssize_t  read_result = read(shard.wake_fd, &wake_count, sizeof(wake_count));
+  (void)read_result;  // Nothing to drain if the retry was triggered by a timeout.
+
+  auto& throttled = shard.throttled_sockets;
+  for (auto sock_data = throttled.begin(); sock_data != throttled.end();)
+  {
+    if (!IsSocketRegistered(shard, *sock_data))
     {
-      if (notify_)
-      {
-        while (notify_->HandleSocketMessageReceived(client_handle, sock_data->recv_buf.msg) ==
-               HandleMessageResult::kRetryLater)
-        {
-          sleep(10);  // Sleep to avoid busy loop.
-        }
-      }
+      // The socket was removed while throttled; its client is being destroyed.
+      sock_data = throttled.erase(sock_data);
+    }
+    else if (DeliverMessages(**sock_data))
+    {
+      (*sock_data)->throttled = false;
+      SetReadEnabled(shard, **sock_data, true);
+      sock_data = throttled.erase(sock_data);
+    }
+    else
+    {
+      ++sock_data;
+    }
+  }
+  shard.num_throttled = throttled.size();
+}
 
-      rc_free_message_resources(&sock_data->recv_buf.msg);
-      res = rc_msg_buf_parse_data(&sock_data->recv_buf);
+// Pass each complete message in the socket's receive buffer to the broker, starting with any
+// message left pending from a previous attempt. Returns false if the broker asked to retry a
+// message later, in which case it is left pending.
+bool LinuxBrokerSocketManager::DeliverMessages(SocketData& sock_data)
+{
+  etcpal_error_t res = (sock_data.msg_pending ? kEtcPalErrOk : rc_msg_buf_parse_data(&sock_data.recv_buf));
+  while (res == kEtcPalErrOk)
+  {
+    if (notify_ && notify_->HandleSocketMessageReceived(sock_data.client_handle, sock_data.recv_buf.msg,
+                                                        sock_data.recv_buf.raw_msg,
+                                                        sock_data.recv_buf.raw_msg_size) == HandleMessageResult::kRetryLater)
+    {
+      sock_data.msg_pending = true;
+      return false;
     }
+
+    sock_data.msg_pending = false;
+    rc_free_message_resources(&sock_data.recv_buf.msg);
+    res = rc_msg_buf_parse_data(&sock_data.recv_buf);
   }
+  return true;
+}
+
+// Stop reading from a socket whose message the broker can't accept yet. Other sockets keep being
+// read; this one is retried when the broker drains its queues.
+void LinuxBrokerSocketManager::ThrottleSocket(SocketShard& shard, const std::shared_ptr<SocketData>& sock_data)
+{
+  sock_data->throttled = true;
+  SetReadEnabled(shard, *sock_data, false);
+  shard.throttled_sockets.push_back(sock_data);
+  shard.num_throttled = shard.throttled_sockets.size();
+}
+
+bool LinuxBrokerSocketManager::SetReadEnabled(SocketShard& shard, const SocketData& sock_data, bool enabled)
+{
+  struct epoll_event mod_event;
+  mod_event.events = (enabled ? EPOLLIN : 0);
+  mod_event.data.fd = sock_data.client_handle;
+  return (0 == epoll_ctl(shard.epoll_fd, EPOLL_CTL_MOD, sock_data.socket, &mod_event));
+}
+
+// Client handles are assigned sequentially, so they spread evenly across the shards.
+SocketShard& LinuxBrokerSocketManager::ShardForHandle(BrokerClient::Handle client_handle)
+{
+  return *shards_[static_cast<size_t>(client_handle) % shards_.size()];
+}
+
+// Remove a socket from its shard if it is still the one registered for its handle. Returns whether
+// it was removed.
+bool LinuxBrokerSocketManager::EraseSocket(SocketShard& shard, const std::shared_ptr<SocketData>& sock_data)
+{
+  etcpal::MutexGuard shard_guard(shard.lock);
+
+  auto sock_data_iter = shard.sockets.find(sock_data->client_handle);
+  if (sock_data_iter == shard.sockets.end() || sock_data_iter->second != sock_data)
+    return false;
+
+  shard.sockets.erase(sock_data_iter);
+  return true;
+}
+
+bool LinuxBrokerSocketManager::IsSocketRegistered(SocketShard& shard, const std::shared_ptr<SocketData>& sock_data)
+{
+  etcpal::MutexGuard shard_guard(shard.lock);
+
+  auto sock_data_iter = shard.sockets.find(sock_data->client_handle);
+  return (sock_data_iter != shard.sockets.end() && sock_data_iter->second == sock_data);
 }
 
 // Instantiate a LinuxBrokerSocketManager
@@ -24,6 +24,7 @@
 #ifndef LINUX_SOCKET_MANAGER_H_
 #define LINUX_SOCKET_MANAGER_H_
 
+#include <atomic>
 #include <map>
 #include <vector>
 #include <memory>
@@ -61,24 +62,59 @@
 // The set of data allocated per-socket.
 struct SocketData
 {
-  SocketData(BrokerClient::Handle client_handle_in, etcpal_socket_t socket_in)
+  SocketData(BrokerClient::Handle client_handle_in, etcpal_socket_t socket_in, size_t recv_buf_size)
       : client_handle(client_handle_in), socket(socket_in)
   {
-    rc_msg_buf_init(&recv_buf);
+    recv_buf_valid = rc_msg_buf_init(&recv_buf, recv_buf_size);
   }
+  // The socket is closed when the last reference to its data is released, so that a worker thread
+  // still reading from it never sees its descriptor reused by a new connection.
+  ~SocketData();
 
   BrokerClient::Handle client_handle{BrokerClient::kInvalidHandle};
   int                  socket{-1};
 
   // Receive buffer for socket recv operations
   RCMsgBuf recv_buf;
+  bool     recv_buf_valid{false};
+
+  // Whether recv_buf.msg holds a parsed message which the broker couldn't accept yet.
+  bool msg_pending{false};
+  // Whether reading from the socket is paused until the pending message is accepted.
+  bool throttled{false};
+};
+
+class LinuxBrokerSocketManager;
+
+// A subset of the managed sockets, waited on by a single worker thread through its own epoll
+// instance. Each shard has its own lock, so adding, removing and reading sockets in one shard never
+// waits on another.
+struct SocketShard
+{
+  SocketShard(LinuxBrokerSocketManager& mgr_in, unsigned int index_in) : mgr(mgr_in), index(index_in) {}
+
+  LinuxBrokerSocketManager& mgr;
+  unsigned int              index{0};
+  int                       epoll_fd{-1};
+  int                       wake_fd{-1};
+  pthread_t                 thread_handle;
+  bool                      thread_started{false};
+
+  std::map<BrokerClient::Handle, std::shared_ptr<SocketData>> sockets;
+  etcpal::Mutex                                               lock;
+
+  // Sockets whose reads are paused because the broker returned kRetryLater, in the order they were
+  // throttled. Only accessed from the shard's worker thread.
+  std::vector<std::shared_ptr<SocketData>> throttled_sockets;
+  std::atomic<size_t>                      num_throttled{0};
 };
 
 // A class to manage RDMnet Broker sockets on Linux.
 // This handles receiving data on all RDMnet client connections, using epoll for maximum
-// performance. Sending on connections is done in the core Broker library through the EtcPal
-// interface. Other miscellaneous Broker socket operations like LLRP are also handled in the core
-// library.
+// performance. Sockets are sharded by client handle across one or more worker threads, each with
+// its own epoll instance. Sending on connections is done in the core Broker library through the
+// EtcPal interface. Other miscellaneous Broker socket operations like LLRP are also handled in the
+// core library.
 class LinuxBrokerSocketManager : public BrokerSocketManager
 {
 public:
@@ -92,26 +128,37 @@ public:
   bool Startup() override;
   bool Shutdown() override;
   void SetNotify(BrokerSocketNotify* notify) override { notify_ = notify; }
+  void SetWorkerThreadConfig(unsigned int num_threads, bool pin_threads) override;
+  void SetRecvBufferSize(size_t size) override { recv_buf_size_ = size; }
   bool AddSocket(BrokerClient::Handle client_handle, etcpal_socket_t socket) override;
   void RemoveSocket(BrokerClient::Handle client_handle) override;
+  void ResumeThrottledSockets() override;
 
   // Callback functions called from worker threads
-  void WorkerNotifySocketReadEvent(BrokerClient::Handle client_handle);
-  void WorkerNotifySocketBad(BrokerClient::Handle client_handle);
+  void WorkerNotifySocketReadEvent(SocketShard& shard, BrokerClient::Handle client_handle);
+  void WorkerNotifySocketBad(SocketShard& shard, BrokerClient::Handle client_handle);
+  void WorkerRetryThrottledSockets(SocketShard& shard);
 
   // Accessors
-  bool keep_running() const { return !shutting_down_; }
-  int  epoll_fd() const { return epoll_fd_; }
+  bool   keep_running() const { return !shutting_down_; }
+  size_t num_shards() const { return shards_.size(); }
 
 private:
-  bool      shutting_down_{false};
-  pthread_t thread_handle_;
-  int       epoll_fd_{-1};
+  SocketShard& ShardForHandle(BrokerClient::Handle client_handle);
+  bool         EraseSocket(SocketShard& shard, const std::shared_ptr<SocketData>& sock_data);
+  bool         IsSocketRegistered(SocketShard& shard, const std::shared_ptr<SocketData>& sock_data);
+  bool         DeliverMessages(SocketData& sock_data);
+  void         ThrottleSocket(SocketShard& shard, const std::shared_ptr<SocketData>& sock_data);
+  bool         SetReadEnabled(SocketShard& shard, const SocketData& sock_data, bool enabled);
+
+  std::atomic<bool> shutting_down_{false};
+  unsigned int      num_workers_{1};
+  bool              pin_workers_{false};
+  size_t            recv_buf_size_{0};
   // std::unique_ptr<LinuxThreadInterface> thread_interface_;
 
-  // The set of sockets being managed.
-  std::map<BrokerClient::Handle, std::unique_ptr<SocketData>> sockets_;
-  etcpal::Mutex                                               socket_lock_;
+  // The sets of sockets being managed, one per worker thread.
+  std::vector<std::unique_ptr<SocketShard>> shards_;
 
   // The callback instance
   BrokerSocketNotify* notify_{nullptr};
@@ -120,8 +120,8 @@ bool MacBrokerSocketManager::AddSocket(BrokerClient::Handle client_handle, etcpa
   etcpal::WriteGuard socket_write(socket_lock_);
 
   // Create the data structure for the new socket
-  std::unique_ptr<SocketData> new_sock_data(new SocketData(client_handle, socket));
-  if (new_sock_data)
+  std::unique_ptr<SocketData> new_sock_data(new SocketData(client_handle, socket, recv_buf_size_));
+  if (new_sock_data && new_sock_data->recv_buf_valid)
   {
     // Add it to the socket map
     auto result = sockets_.insert(std::make_pair(client_handle, std::move(new_sock_data)));
@@ -191,12 +191,11 @@ void MacBrokerSocketManager::WorkerNotifySocketReadEvent(BrokerClient::Handle cl
     return;
 
   SocketData* sock_data = sock_data_iter->second.get();
-  if (!RDMNET_ASSERT_VERIFY(sock_data) || !RDMNET_ASSERT_VERIFY(sock_data->recv_buf.cur_data_size <= RC_MSG_BUF_SIZE))
+  if (!RDMNET_ASSERT_VERIFY(sock_data))
     return;
 
+  size_t recv_buf_size = rc_msg_buf_make_room(&sock_data->recv_buf);
   void*  recv_buf = &sock_data->recv_buf.buf[sock_data->recv_buf.cur_data_size];
-  size_t recv_buf_size =
-      std::min<size_t>(RDMNET_RECV_DATA_MAX_SIZE, RC_MSG_BUF_SIZE - sock_data->recv_buf.cur_data_size);
 
   ssize_t recv_result = recv(sock_data->socket, recv_buf, recv_buf_size, 0);
   if (recv_result <= 0)
@@ -215,7 +214,8 @@ void MacBrokerSocketManager::WorkerNotifySocketReadEvent(BrokerClient::Handle cl
     {
       if (notify_)
       {
-        while (notify_->HandleSocketMessageReceived(client_handle, sock_data->recv_buf.msg) ==
+        while (notify_->HandleSocketMessageReceived(client_handle, sock_data->recv_buf.msg, sock_data->recv_buf.raw_msg,
+                                                    sock_data->recv_buf.raw_msg_size) ==
                HandleMessageResult::kRetryLater)
         {
           sleep(10);  // Sleep to avoid busy loop.
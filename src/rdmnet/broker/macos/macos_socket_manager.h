@@ -37,10 +37,15 @@
 // The set of data allocated per-socket.
 struct SocketData
 {
-  SocketData(BrokerClient::Handle client_handle_in, etcpal_socket_t socket_in)
+  SocketData(BrokerClient::Handle client_handle_in, etcpal_socket_t socket_in, size_t recv_buf_size)
       : client_handle(client_handle_in), socket(socket_in)
   {
-    rc_msg_buf_init(&recv_buf);
+    recv_buf_valid = rc_msg_buf_init(&recv_buf, recv_buf_size);
+  }
+  ~SocketData()
+  {
+    if (recv_buf_valid)
+      rc_msg_buf_cleanup(&recv_buf);
   }
 
   BrokerClient::Handle client_handle{BrokerClient::kInvalidHandle};
@@ -48,6 +53,7 @@ struct SocketData
 
   // Receive buffer for socket recv operations
   RCMsgBuf recv_buf;
+  bool     recv_buf_valid{false};
 };
 
 // A class to manage RDMnet Broker sockets on Mac.
@@ -64,6 +70,7 @@ public:
   bool Startup() override;
   bool Shutdown() override;
   void SetNotify(BrokerSocketNotify* notify) override { notify_ = notify; }
+  void SetRecvBufferSize(size_t size) override { recv_buf_size_ = size; }
   bool AddSocket(BrokerClient::Handle client_handle, etcpal_socket_t socket) override;
   void RemoveSocket(BrokerClient::Handle client_handle) override;
 
@@ -79,6 +86,7 @@ private:
   bool      shutting_down_{false};
   pthread_t thread_handle_;
   int       kqueue_fd_{-1};
+  size_t    recv_buf_size_{0};
 
   // The set of sockets being managed.
   std::map<BrokerClient::Handle, std::unique_ptr<SocketData>> sockets_;
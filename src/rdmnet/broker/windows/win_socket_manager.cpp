@@ -157,15 +157,14 @@ unsigned __stdcall SocketWorkerThread(void* arg)
             }
           }
         case MessageKey::kStartRecv:
-          if (sock_data && RDMNET_ASSERT_VERIFY(sock_data->recv_buf.cur_data_size <= RC_MSG_BUF_SIZE))
+          if (sock_data)
           {
             // Begin a new overlapped receive operation
             DWORD recv_flags = 0;
 
+            sock_data->ws_recv_buf.len = static_cast<ULONG>(rc_msg_buf_make_room(&sock_data->recv_buf));
             sock_data->ws_recv_buf.buf =
                 reinterpret_cast<char*>(&sock_data->recv_buf.buf[sock_data->recv_buf.cur_data_size]);
-            sock_data->ws_recv_buf.len =
-                std::min<ULONG>(RDMNET_RECV_DATA_MAX_SIZE, RC_MSG_BUF_SIZE - sock_data->recv_buf.cur_data_size);
 
             int recv_result = WSARecv(sock_data->socket, &sock_data->ws_recv_buf, 1, nullptr, &recv_flags,
                                       &sock_data->overlapped, nullptr);
@@ -278,8 +277,8 @@ bool WinBrokerSocketManager::AddSocket(BrokerClient::Handle client_handle, etcpa
   etcpal::WriteGuard socket_write(socket_lock_);
 
   // Create the data structure for the new socket
-  std::unique_ptr<SocketData> new_sock_data(new SocketData(client_handle, socket));
-  if (!new_sock_data)
+  std::unique_ptr<SocketData> new_sock_data(new SocketData(client_handle, socket, recv_buf_size_));
+  if (!new_sock_data || !new_sock_data->recv_buf_valid)
     return false;
 
   // Add it to the socket map
@@ -366,8 +365,9 @@ void WinBrokerSocketManager::WorkerNotifyRecvData(BrokerClient::Handle client_ha
   {
     if (!sock_data->second->close_requested && notify_)
     {
-      while (notify_->HandleSocketMessageReceived(client_handle, sock_data->second->recv_buf.msg) ==
-             HandleMessageResult::kRetryLater)
+      const RCMsgBuf& recv_buf = sock_data->second->recv_buf;
+      while (notify_->HandleSocketMessageReceived(client_handle, recv_buf.msg, recv_buf.raw_msg,
+                                                  recv_buf.raw_msg_size) == HandleMessageResult::kRetryLater)
       {
         Sleep(10);  // Sleep to avoid busy loop.
       }
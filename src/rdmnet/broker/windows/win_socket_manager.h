@@ -68,12 +68,17 @@ public:
 // The set of data allocated per-socket.
 struct SocketData
 {
-  SocketData(BrokerClient::Handle client_handle_in, etcpal_socket_t socket_in)
+  SocketData(BrokerClient::Handle client_handle_in, etcpal_socket_t socket_in, size_t recv_buf_size)
       : client_handle(client_handle_in), socket(socket_in)
   {
-    rc_msg_buf_init(&recv_buf);
+    recv_buf_valid = rc_msg_buf_init(&recv_buf, recv_buf_size);
     ws_recv_buf.buf = reinterpret_cast<char*>(recv_buf.buf);
-    ws_recv_buf.len = RDMNET_RECV_DATA_MAX_SIZE;
+    ws_recv_buf.len = 0;
+  }
+  ~SocketData()
+  {
+    if (recv_buf_valid)
+      rc_msg_buf_cleanup(&recv_buf);
   }
 
   BrokerClient::Handle client_handle{BrokerClient::kInvalidHandle};
@@ -85,6 +90,7 @@ struct SocketData
   WSABUF ws_recv_buf;  // The variable Winsock uses for receive buffers
   // Receive buffer for socket recv operations
   RCMsgBuf recv_buf;
+  bool     recv_buf_valid{false};
 };
 
 // A class to manage RDMnet Broker sockets on Windows.
@@ -105,6 +111,7 @@ public:
   bool Startup() override;
   bool Shutdown() override;
   void SetNotify(BrokerSocketNotify* notify) override { notify_ = notify; }
+  void SetRecvBufferSize(size_t size) override { recv_buf_size_ = size; }
   bool AddSocket(BrokerClient::Handle client_handle, etcpal_socket_t socket) override;
   void RemoveSocket(BrokerClient::Handle client_handle) override;
 
@@ -116,7 +123,8 @@ public:
   HANDLE iocp() const { return iocp_; }
 
 private:
-  bool shutting_down_{false};
+  bool   shutting_down_{false};
+  size_t recv_buf_size_{0};
 
   // Thread pool management
   HANDLE                                  iocp_{nullptr};
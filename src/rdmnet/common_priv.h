@@ -84,6 +84,8 @@ typedef struct RdmnetController
   etcpal_mutex_t            lock;
   RdmnetControllerCallbacks callbacks;
 
+  RdmnetControllerRequestCompleteCallback request_complete;
+
   rdm_handle_method_t rdm_handle_method;
   union
   {
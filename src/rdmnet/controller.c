@@ -74,6 +74,9 @@ static void client_rpt_msg_received(RCClient*               client,
                                     const RptClientMessage* msg,
                                     RdmnetSyncRdmResponse*  response,
                                     bool*                   use_internal_buf_for_response);
+static void client_request_complete(RCClient*                  client,
+                                    rdmnet_client_scope_t      scope_handle,
+                                    const RdmnetRequestResult* result);
 
 static void handle_rdm_command_internally(RdmnetController*       controller,
                                           const RdmCommandHeader* rdm_header,
@@ -115,7 +118,8 @@ static const RCClientCommonCallbacks client_callbacks = {
 
 static const RCRptClientCallbacks rpt_client_callbacks = {
   client_llrp_msg_received,
-  client_rpt_msg_received
+  client_rpt_msg_received,
+  client_request_complete
 };
 
 static uint16_t kControllerInternalSupportedParameters[] = {
@@ -157,6 +161,7 @@ void rdmnet_controller_config_init(RdmnetControllerConfig* config, uint16_t manu
   {
     memset(config, 0, sizeof(RdmnetControllerConfig));
     RDMNET_INIT_DYNAMIC_UID_REQUEST(&config->uid, manufacturer_id);
+    config->request_tracking.timeout_ms = RDMNET_CONTROLLER_DEFAULT_REQUEST_TIMEOUT_MS;
   }
 }
 
@@ -237,6 +242,39 @@ void rdmnet_controller_set_rdm_cmd_callbacks(RdmnetControllerConfig*
   }
 }
 
+/**
+ * @brief Enable tracking of the RDM commands sent by an RDMnet controller until they are answered.
+ *
+ * With request tracking enabled, each RDM command sent to a single RDMnet client is resent if no
+ * response arrives within timeout_ms, up to max_retries times. The outcome of each command is
+ * delivered exactly once through request_complete, which also receives the RDM responses and RPT
+ * status messages that would otherwise go to the rdm_response_received and status_received
+ * callbacks. A response which arrives in several parts is delivered one part at a time, with
+ * more_coming set on every part but the last. Commands sent to broadcast addresses are not tracked.
+ *
+ * @param[out] config Config struct in which to set the request tracking settings.
+ * @param[in] request_complete Callback called when a tracked command completes. NULL disables
+ *                             request tracking.
+ * @param[in] timeout_ms How long to wait for a response to a command before resending it.
+ * @param[in] max_retries How many times to resend an unanswered command before it times out.
+ * @param[in] max_in_flight_per_destination The most commands that can await a response from one
+ *                                          RDMnet client at a time; 0 for no limit.
+ */
+void rdmnet_controller_set_request_tracking(RdmnetControllerConfig*                 config,
+                                            RdmnetControllerRequestCompleteCallback request_complete,
+                                            unsigned int                            timeout_ms,
+                                            unsigned int                            max_retries,
+                                            unsigned int                            max_in_flight_per_destination)
+{
+  if (config)
+  {
+    config->request_tracking.request_complete = request_complete;
+    config->request_tracking.timeout_ms = timeout_ms;
+    config->request_tracking.max_retries = max_retries;
+    config->request_tracking.max_in_flight_per_destination = max_in_flight_per_destination;
+  }
+}
+
 /**
  * @brief Create a new instance of RDMnet controller functionality.
  *
@@ -596,7 +634,9 @@ etcpal_error_t rdmnet_controller_request_responder_ids(rdmnet_controller_t   con
  * @brief Send an RDM command from a controller on a scope.
  *
  * The response will be delivered via either the RdmnetControllerRdmResponseReceived callback or
- * the RdmnetControllerStatusReceivedCallback, depending on the outcome of the command.
+ * the RdmnetControllerStatusReceivedCallback, depending on the outcome of the command. If request
+ * tracking is enabled, the outcome is delivered via the RdmnetControllerRequestCompleteCallback
+ * instead; see rdmnet_controller_set_request_tracking().
  *
  * @param[in] controller_handle Handle to the controller from which to send the RDM command.
  * @param[in] scope_handle Handle to the scope on which to send the RDM command.
@@ -614,6 +654,12 @@ etcpal_error_t rdmnet_controller_request_responder_ids(rdmnet_controller_t   con
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
+ * @return #kEtcPalErrWouldBlock: Too much data is queued for sending on the scope's connection,
+ *                                or request tracking is enabled and the destination already has
+ *                                the maximum number of commands awaiting a response; try again
+ *                                later.
+ * @return #kEtcPalErrNoMem: Request tracking is enabled and no more commands can be tracked on the
+ *                           scope.
  */
 etcpal_error_t rdmnet_controller_send_rdm_command(rdmnet_controller_t          controller_handle,
                                                   rdmnet_client_scope_t        scope_handle,
@@ -645,7 +691,9 @@ etcpal_error_t rdmnet_controller_send_rdm_command(rdmnet_controller_t          c
  * @brief Send an RDM GET command from a controller on a scope.
  *
  * The response will be delivered via either the RdmnetControllerRdmResponseReceived callback or
- * the RdmnetControllerStatusReceivedCallback, depending on the outcome of the command.
+ * the RdmnetControllerStatusReceivedCallback, depending on the outcome of the command. If request
+ * tracking is enabled, the outcome is delivered via the RdmnetControllerRequestCompleteCallback
+ * instead; see rdmnet_controller_set_request_tracking().
  *
  * @param[in] controller_handle Handle to the controller from which to send the GET command.
  * @param[in] scope_handle Handle to the scope on which to send the GET command.
@@ -662,6 +710,12 @@ etcpal_error_t rdmnet_controller_send_rdm_command(rdmnet_controller_t          c
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
+ * @return #kEtcPalErrWouldBlock: Too much data is queued for sending on the scope's connection,
+ *                                or request tracking is enabled and the destination already has
+ *                                the maximum number of commands awaiting a response; try again
+ *                                later.
+ * @return #kEtcPalErrNoMem: Request tracking is enabled and no more commands can be tracked on the
+ *                           scope.
  */
 etcpal_error_t rdmnet_controller_send_get_command(rdmnet_controller_t          controller_handle,
                                                   rdmnet_client_scope_t        scope_handle,
@@ -692,7 +746,9 @@ etcpal_error_t rdmnet_controller_send_get_command(rdmnet_controller_t          c
  * @brief Send an RDM SET command from a controller on a scope.
  *
  * The response will be delivered via either the RdmnetControllerRdmResponseReceived callback or
- * the RdmnetControllerStatusReceivedCallback, depending on the outcome of the command.
+ * the RdmnetControllerStatusReceivedCallback, depending on the outcome of the command. If request
+ * tracking is enabled, the outcome is delivered via the RdmnetControllerRequestCompleteCallback
+ * instead; see rdmnet_controller_set_request_tracking().
  *
  * @param[in] controller_handle Handle to the controller from which to send the SET command.
  * @param[in] scope_handle Handle to the scope on which to send the SET command.
@@ -709,6 +765,12 @@ etcpal_error_t rdmnet_controller_send_get_command(rdmnet_controller_t          c
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
+ * @return #kEtcPalErrWouldBlock: Too much data is queued for sending on the scope's connection,
+ *                                or request tracking is enabled and the destination already has
+ *                                the maximum number of commands awaiting a response; try again
+ *                                later.
+ * @return #kEtcPalErrNoMem: Request tracking is enabled and no more commands can be tracked on the
+ *                           scope.
  */
 etcpal_error_t rdmnet_controller_send_set_command(rdmnet_controller_t          controller_handle,
                                                   rdmnet_client_scope_t        scope_handle,
@@ -735,6 +797,59 @@ etcpal_error_t rdmnet_controller_send_set_command(rdmnet_controller_t          c
   return res;
 }
 
+/**
+ * @brief Send a batch of RDM commands from a controller on a scope.
+ *
+ * This is equivalent to calling rdmnet_controller_send_rdm_command() for each command in turn, but
+ * much cheaper when polling many responders: the controller is locked and the scope looked up only
+ * once, and the commands are packed back-to-back and written to the network in as few send calls
+ * as possible. The commands are assigned consecutive sequence numbers in the order given.
+ *
+ * Sending stops at the first command which cannot be sent, and that command's error is returned.
+ * The commands before it have been sent; num_sent indicates how many, so that the rest can be
+ * submitted again later (for example, after #kEtcPalErrWouldBlock).
+ *
+ * @param[in] controller_handle Handle to the controller from which to send the RDM commands.
+ * @param[in] scope_handle Handle to the scope on which to send the RDM commands.
+ * @param[in] commands Array of RDM commands to send.
+ * @param[in] num_commands Size of the commands array.
+ * @param[out] seq_nums (optional) Array of size num_commands, filled in with the sequence number of
+ *                      each command which was sent.
+ * @param[out] num_sent (optional) Filled in with the number of commands which were sent.
+ * @return #kEtcPalErrOk: All commands sent successfully.
+ * @return #kEtcPalErrInvalid: Invalid argument.
+ * @return #kEtcPalErrNotInit: Module not initialized.
+ * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
+ *                              or scope_handle is not associated with a valid scope instance.
+ * @return #kEtcPalErrSys: An internal library or system call error occurred.
+ * @return Other errors from rdmnet_controller_send_rdm_command(), for the first command which could
+ *         not be sent.
+ */
+etcpal_error_t rdmnet_controller_send_rdm_commands(rdmnet_controller_t          controller_handle,
+                                                   rdmnet_client_scope_t        scope_handle,
+                                                   const RdmnetBatchRdmCommand* commands,
+                                                   size_t                       num_commands,
+                                                   uint32_t*                    seq_nums,
+                                                   size_t*                      num_sent)
+{
+  if (num_sent)
+    *num_sent = 0;
+  if (!commands || num_commands == 0)
+    return kEtcPalErrInvalid;
+
+  RdmnetController* controller = NULL;
+  etcpal_error_t    res = get_controller(controller_handle, &controller);
+  if (res != kEtcPalErrOk)
+    return res;
+
+  if (!RDMNET_ASSERT_VERIFY(controller))
+    return kEtcPalErrSys;
+
+  res = rc_client_send_rdm_commands(&controller->client, scope_handle, commands, num_commands, seq_nums, num_sent);
+  release_controller(controller);
+  return res;
+}
+
 /**
  * @brief Send an RDM ACK response from a controller on a scope.
  *
@@ -953,7 +1068,8 @@ static etcpal_error_t validate_controller_config(const RdmnetControllerConfig* c
 
   if (ETCPAL_UUID_IS_NULL(&config->cid) || !validate_controller_callbacks(&config->callbacks) ||
       (!validate_rdm_handler(&config->rdm_handler) && !validate_rdm_data(&config->rdm_data)) ||
-      (!RDMNET_UID_IS_DYNAMIC_UID_REQUEST(&config->uid) && (config->uid.manu & 0x8000)))
+      (!RDMNET_UID_IS_DYNAMIC_UID_REQUEST(&config->uid) && (config->uid.manu & 0x8000)) ||
+      (config->request_tracking.request_complete && config->request_tracking.timeout_ms == 0))
   {
     return kEtcPalErrInvalid;
   }
@@ -984,6 +1100,11 @@ etcpal_error_t create_new_controller(const RdmnetControllerConfig* config, rdmne
   rpt_client->type = kRPTClientTypeController;
   rpt_client->uid = config->uid;
   rpt_client->callbacks = rpt_client_callbacks;
+  rpt_client->request_tracking.enabled = (config->request_tracking.request_complete != NULL);
+  rpt_client->request_tracking.timeout_ms = config->request_tracking.timeout_ms;
+  rpt_client->request_tracking.max_retries = config->request_tracking.max_retries;
+  rpt_client->request_tracking.max_in_flight_per_dest = config->request_tracking.max_in_flight_per_destination;
+  new_controller->request_complete = config->request_tracking.request_complete;
   if (config->search_domain)
     rdmnet_safe_strncpy(client->search_domain, config->search_domain, E133_DOMAIN_STRING_PADDED_LENGTH);
   else
@@ -1249,6 +1370,18 @@ void client_rpt_msg_received(RCClient*               client,
   }
 }
 
+void client_request_complete(RCClient*                  client,
+                             rdmnet_client_scope_t      scope_handle,
+                             const RdmnetRequestResult* result)
+{
+  if (!RDMNET_ASSERT_VERIFY(client) || !RDMNET_ASSERT_VERIFY(result))
+    return;
+
+  RdmnetController* controller = GET_CONTROLLER_FROM_CLIENT(client);
+  if (controller && RDMNET_ASSERT_VERIFY(controller->request_complete))
+    controller->request_complete(controller->id.handle, scope_handle, result, controller->callbacks.context);
+}
+
 void handle_rdm_command_internally(RdmnetController*       controller,
                                    const RdmCommandHeader* rdm_header,
                                    const uint8_t*          data,
@@ -54,11 +54,7 @@
 
 static size_t calc_client_connect_len(const BrokerClientConnectMsg* data);
 static size_t pack_broker_header_with_rlp(const AcnRootLayerPdu* rlp, uint8_t* buf, size_t buflen, uint16_t vector);
-static etcpal_error_t send_broker_header(RCConnection*          conn,
-                                         const AcnRootLayerPdu* rlp,
-                                         uint8_t*               buf,
-                                         size_t                 buflen,
-                                         uint16_t               vector);
+static etcpal_error_t send_broker_header(RCConnection* conn, const AcnRootLayerPdu* rlp, uint16_t vector);
 
 /*************************** Function definitions ****************************/
 
@@ -92,42 +88,24 @@ size_t pack_broker_header_with_rlp(const AcnRootLayerPdu* rlp, uint8_t* buf, siz
   return (size_t)(cur_ptr - buf);
 }
 
-etcpal_error_t send_broker_header(RCConnection*          conn,
-                                  const AcnRootLayerPdu* rlp,
-                                  uint8_t*               buf,
-                                  size_t                 buflen,
-                                  uint16_t               vector)
+etcpal_error_t send_broker_header(RCConnection* conn, const AcnRootLayerPdu* rlp, uint16_t vector)
 {
-  if (!RDMNET_ASSERT_VERIFY(conn) || !RDMNET_ASSERT_VERIFY(rlp) || !RDMNET_ASSERT_VERIFY(buf))
+  if (!RDMNET_ASSERT_VERIFY(conn) || !RDMNET_ASSERT_VERIFY(rlp))
     return kEtcPalErrSys;
 
-  size_t data_size = acn_root_layer_buf_size(rlp, 1);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
-
-  // Pack and send the TCP preamble.
-  data_size = acn_pack_tcp_preamble(buf, buflen, data_size);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
-  int send_res = rc_send(conn->sock, buf, data_size, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  // Refuse new messages while the connection's outbound queue is backed up.
+  etcpal_error_t res = rc_send_buf_begin_message(&conn->send_buf);
+  if (res != kEtcPalErrOk)
+    return res;
 
-  // Pack and send the Root Layer PDU header.
-  data_size = acn_pack_root_layer_header(buf, buflen, rlp);
+  // Pack the TCP preamble, Root Layer PDU header and Broker PDU header together and queue them in
+  // the connection's send buffer.
+  uint8_t buf[BROKER_PDU_FULL_HEADER_SIZE];
+  size_t  data_size = pack_broker_header_with_rlp(rlp, buf, BROKER_PDU_FULL_HEADER_SIZE, vector);
   if (data_size == 0)
     return kEtcPalErrProtocol;
-  send_res = rc_send(conn->sock, buf, data_size, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
 
-  // Pack and send the Broker PDU header
-  PACK_BROKER_HEADER(rlp->data_len, vector, buf);
-  send_res = rc_send(conn->sock, buf, BROKER_PDU_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  return kEtcPalErrOk;
+  return rc_send_buf_append(&conn->send_buf, conn->sock, buf, data_size);
 }
 
 /******************************* Client Connect ******************************/
@@ -174,7 +152,7 @@ etcpal_error_t rc_broker_send_client_connect(RCConnection* conn, const BrokerCli
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = calc_client_connect_len(data);
 
-  etcpal_error_t res = send_broker_header(conn, &rlp, buf, CLIENT_CONNECT_COMMON_FIELD_SIZE, VECTOR_BROKER_CONNECT);
+  etcpal_error_t res = send_broker_header(conn, &rlp, VECTOR_BROKER_CONNECT);
   if (res != kEtcPalErrOk)
     return res;
 
@@ -187,9 +165,9 @@ etcpal_error_t rc_broker_send_client_connect(RCConnection* conn, const BrokerCli
   rdmnet_safe_strncpy((char*)cur_ptr, data->search_domain, E133_DOMAIN_STRING_PADDED_LENGTH);
   cur_ptr += E133_DOMAIN_STRING_PADDED_LENGTH;
   *cur_ptr++ = data->connect_flags;
-  int send_res = rc_send(conn->sock, buf, (size_t)(cur_ptr - buf), 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, (size_t)(cur_ptr - buf));
+  if (res != kEtcPalErrOk)
+    return res;
 
   // Pack and send the beginning of the Client Entry PDU
   const RdmnetRptClientEntry* rpt_entry = GET_RPT_CLIENT_ENTRY(&data->client_entry);
@@ -200,7 +178,9 @@ etcpal_error_t rc_broker_send_client_connect(RCConnection* conn, const BrokerCli
   const EtcPalUuid* cid = (IS_RPT_CLIENT_ENTRY(&data->client_entry) ? &(rpt_entry->cid) : &(ept_entry->cid));
   PACK_CLIENT_ENTRY_HEADER(rlp.data_len - (BROKER_PDU_HEADER_SIZE + CLIENT_CONNECT_COMMON_FIELD_SIZE),
                            data->client_entry.client_protocol, cid, buf);
-  send_res = rc_send(conn->sock, buf, CLIENT_ENTRY_HEADER_SIZE, 0);
+  res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, CLIENT_ENTRY_HEADER_SIZE);
+  if (res != kEtcPalErrOk)
+    return res;
 
   if (IS_RPT_CLIENT_ENTRY(&data->client_entry))
   {
@@ -213,9 +193,9 @@ etcpal_error_t rc_broker_send_client_connect(RCConnection* conn, const BrokerCli
     *cur_ptr++ = (uint8_t)(rpt_entry->type);
     memcpy(cur_ptr, rpt_entry->binding_cid.data, ETCPAL_UUID_BYTES);
     cur_ptr += ETCPAL_UUID_BYTES;
-    send_res = rc_send(conn->sock, buf, RPT_CLIENT_ENTRY_DATA_SIZE, 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
+    res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, RPT_CLIENT_ENTRY_DATA_SIZE);
+    if (res != kEtcPalErrOk)
+      return res;
   }
   else  // is EPT client entry
   {
@@ -230,13 +210,16 @@ etcpal_error_t rc_broker_send_client_connect(RCConnection* conn, const BrokerCli
       cur_ptr += 2;
       rdmnet_safe_strncpy((char*)cur_ptr, prot->protocol_string, EPT_PROTOCOL_STRING_PADDED_LENGTH);
       cur_ptr += EPT_PROTOCOL_STRING_PADDED_LENGTH;
-      send_res = rc_send(conn->sock, buf, EPT_PROTOCOL_ENTRY_SIZE, 0);
-      if (send_res < 0)
-        return (etcpal_error_t)send_res;
+      res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, EPT_PROTOCOL_ENTRY_SIZE);
+      if (res != kEtcPalErrOk)
+        return res;
     }
   }
-  etcpal_timer_reset(&conn->send_timer);
-  return kEtcPalErrOk;
+
+  res = rc_send_buf_end_message(&conn->send_buf, conn->sock);
+  if (res == kEtcPalErrOk)
+    etcpal_timer_reset(&conn->send_timer);
+  return res;
 }
 
 /******************************* Connect Reply *******************************/
@@ -310,11 +293,11 @@ etcpal_error_t rc_broker_send_fetch_client_list(RCConnection* conn, const EtcPal
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = BROKER_PDU_HEADER_SIZE;
 
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res =
-      send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_FETCH_CLIENT_LIST);
+  etcpal_error_t res = send_broker_header(conn, &rlp, VECTOR_BROKER_FETCH_CLIENT_LIST);
+  if (res != kEtcPalErrOk)
+    return res;
 
-  return res;
+  return rc_send_buf_end_message(&conn->send_buf, conn->sock);
 }
 
 /**************************** Client List Messages ***************************/
@@ -464,13 +447,12 @@ etcpal_error_t rc_broker_send_request_dynamic_uids(RCConnection*     conn,
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = BROKER_PDU_HEADER_SIZE + REQUEST_DYNAMIC_UIDS_DATA_SIZE(num_rids);
 
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res =
-      send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_REQUEST_DYNAMIC_UIDS);
+  etcpal_error_t res = send_broker_header(conn, &rlp, VECTOR_BROKER_REQUEST_DYNAMIC_UIDS);
   if (res != kEtcPalErrOk)
     return res;
 
-  // Pack and send each Dynamic UID Request Pair in turn
+  // Pack and queue each Dynamic UID Request Pair in turn
+  uint8_t buf[DYNAMIC_UID_REQUEST_PAIR_SIZE];
   for (const EtcPalUuid* cur_rid = rids; cur_rid < rids + num_rids; ++cur_rid)
   {
     // Pack the Dynamic UID Request Pair
@@ -478,13 +460,12 @@ etcpal_error_t rc_broker_send_request_dynamic_uids(RCConnection*     conn,
     etcpal_pack_u32b(&buf[2], 0);
     memcpy(&buf[6], cur_rid->data, ETCPAL_UUID_BYTES);
 
-    // Send the segment
-    int send_res = rc_send(conn->sock, buf, DYNAMIC_UID_REQUEST_PAIR_SIZE, 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
+    res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, DYNAMIC_UID_REQUEST_PAIR_SIZE);
+    if (res != kEtcPalErrOk)
+      return res;
   }
 
-  return kEtcPalErrOk;
+  return rc_send_buf_end_message(&conn->send_buf, conn->sock);
 }
 
 /************************ Dynamic UID Assignment List ************************/
@@ -584,26 +565,24 @@ etcpal_error_t rc_broker_send_fetch_uid_assignment_list(RCConnection*     conn,
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = BROKER_PDU_HEADER_SIZE + FETCH_UID_ASSIGNMENT_LIST_DATA_SIZE(num_uids);
 
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res =
-      send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_FETCH_DYNAMIC_UID_LIST);
+  etcpal_error_t res = send_broker_header(conn, &rlp, VECTOR_BROKER_FETCH_DYNAMIC_UID_LIST);
   if (res != kEtcPalErrOk)
     return res;
 
-  // Pack and send each Dynamic UID Request Pair in turn
+  // Pack and queue each Requested UID in turn
+  uint8_t buf[6];
   for (const RdmUid* cur_uid = uids; cur_uid < uids + num_uids; ++cur_uid)
   {
     // Pack the Requested UID
     etcpal_pack_u16b(&buf[0], cur_uid->manu);
     etcpal_pack_u32b(&buf[2], cur_uid->id);
 
-    // Send the segment
-    int send_res = rc_send(conn->sock, buf, 6, 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
+    res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, 6);
+    if (res != kEtcPalErrOk)
+      return res;
   }
 
-  return kEtcPalErrOk;
+  return rc_send_buf_end_message(&conn->send_buf, conn->sock);
 }
 
 /******************************** Disconnect *********************************/
@@ -640,18 +619,20 @@ etcpal_error_t rc_broker_send_disconnect(RCConnection* conn, const BrokerDisconn
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = BROKER_DISCONNECT_MSG_SIZE;
 
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res = send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_DISCONNECT);
+  etcpal_error_t res = send_broker_header(conn, &rlp, VECTOR_BROKER_DISCONNECT);
   if (res != kEtcPalErrOk)
     return res;
 
+  uint8_t buf[2];
   etcpal_pack_u16b(buf, (uint16_t)(data->disconnect_reason));
-  int send_res = rc_send(conn->sock, buf, 2, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, 2);
+  if (res != kEtcPalErrOk)
+    return res;
 
-  etcpal_timer_reset(&conn->send_timer);
-  return kEtcPalErrOk;
+  res = rc_send_buf_end_message(&conn->send_buf, conn->sock);
+  if (res == kEtcPalErrOk)
+    etcpal_timer_reset(&conn->send_timer);
+  return res;
 }
 
 /*********************************** Null ************************************/
@@ -680,8 +661,9 @@ etcpal_error_t rc_broker_send_null(RCConnection* conn)
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = BROKER_NULL_MSG_SIZE;
 
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res = send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_NULL);
+  etcpal_error_t res = send_broker_header(conn, &rlp, VECTOR_BROKER_NULL);
+  if (res == kEtcPalErrOk)
+    res = rc_send_buf_end_message(&conn->send_buf, conn->sock);
 
   if (res == kEtcPalErrOk)
     etcpal_timer_reset(&conn->send_timer);
@@ -38,6 +38,10 @@
 #include "rdmnet/core/opts.h"
 #include "rdmnet/core/util.h"
 
+#if !RDMNET_DYNAMIC_MEM
+#include "etcpal/mempool.h"
+#endif
+
 /***************************** Private types *********************************/
 
 // Represents a supported parameter to add to a SUPPORTED_PARAMETERS RDM response.
@@ -79,6 +83,12 @@ typedef struct SupportedParameter
 
 #define INTERNAL_PD_BUF_INITIAL_CAPACITY 32
 
+// The most tracked requests completed at once while holding the client lock.
+#define REQUEST_COMPLETION_BATCH_SIZE 8
+
+// Only the scopes of controllers track requests.
+#define MAX_REQUEST_TABLES (RDMNET_MAX_CONTROLLERS * RDMNET_MAX_SCOPES_PER_CONTROLLER)
+
 /***************************** Private macros ********************************/
 
 #define GET_CLIENT_FROM_LLRP_TARGET(targetptr) \
@@ -120,8 +130,23 @@ typedef struct SupportedParameter
   }                                           \
   }
 
+#if RDMNET_DYNAMIC_MEM
+#define ALLOC_REQUEST_TABLE() (RCRequestTable*)malloc(sizeof(RCRequestTable))
+#define FREE_REQUEST_TABLE(ptr) free(ptr)
+#elif MAX_REQUEST_TABLES
+#define ALLOC_REQUEST_TABLE() (RCRequestTable*)etcpal_mempool_alloc(request_tables)
+#define FREE_REQUEST_TABLE(ptr) etcpal_mempool_free(request_tables, ptr)
+#else
+#define ALLOC_REQUEST_TABLE() NULL
+#define FREE_REQUEST_TABLE(ptr)
+#endif
+
 /**************************** Private variables ******************************/
 
+#if !RDMNET_DYNAMIC_MEM && MAX_REQUEST_TABLES
+ETCPAL_MEMPOOL_DEFINE(request_tables, RCRequestTable, MAX_REQUEST_TABLES);
+#endif
+
 #if !RDMNET_DYNAMIC_MEM
 static uint8_t internal_pd_buf[INTERNAL_PD_BUF_STATIC_SIZE];
 static uint8_t received_rdm_response_buf[RDM_RESP_BUF_STATIC_SIZE];
@@ -156,6 +181,7 @@ static void                conncb_connect_failed(RCConnection* conn, const RCCon
 static void                conncb_disconnected(RCConnection* conn, const RCDisconnectedInfo* disconn_info);
 static rc_message_action_t conncb_msg_received(RCConnection* conn, const RdmnetMessage* message);
 static void                conncb_destroyed(RCConnection* conn);
+static void                conncb_periodic(RCConnection* conn);
 
 // clang-format off
 static const RCConnectionCallbacks kConnCallbacks =
@@ -164,7 +190,8 @@ static const RCConnectionCallbacks kConnCallbacks =
   conncb_connect_failed,
   conncb_disconnected,
   conncb_msg_received,
-  conncb_destroyed
+  conncb_destroyed,
+  conncb_periodic
 };
 // clang-format on
 
@@ -245,6 +272,37 @@ static etcpal_error_t client_send_update_internal(RCClient*               client
                                                   const uint8_t*          data,
                                                   size_t                  data_len);
 
+// Sending RDM commands
+static etcpal_error_t send_rdm_command_on_scope(RCClient*                    client,
+                                                RCClientScope*               scope,
+                                                const RdmnetDestinationAddr* destination,
+                                                rdmnet_command_class_t       command_class,
+                                                uint16_t                     param_id,
+                                                const uint8_t*               data,
+                                                uint8_t                      data_len,
+                                                uint32_t*                    seq_num);
+
+// Request tracking
+static etcpal_error_t send_rdm_command_internal(RCClient*                    client,
+                                                RCClientScope*               scope,
+                                                uint32_t                     seq_num,
+                                                const RdmnetDestinationAddr* destination,
+                                                rdmnet_command_class_t       command_class,
+                                                uint16_t                     param_id,
+                                                const uint8_t*               data,
+                                                uint8_t                      data_len);
+static etcpal_error_t track_rdm_command(RCClient*                    client,
+                                        RCClientScope*               scope,
+                                        const RdmnetDestinationAddr* destination,
+                                        rdmnet_command_class_t       command_class,
+                                        uint16_t                     param_id,
+                                        const uint8_t*               data,
+                                        uint8_t                      data_len);
+static bool complete_tracked_request(RCClient* client, RCClientScope* scope, const RptClientMessage* msg);
+static void process_tracked_requests(RCClient* client, RCClientScope* scope);
+static void cancel_tracked_requests(RCClient* client, RCClientScope* scope);
+static void free_request_table(RCClientScope* scope);
+
 // Some special functions for handling RDM responses from the application
 static void append_to_supported_parameters(RCClient*               client,
                                            const RdmCommandHeader* received_cmd_header,
@@ -270,6 +328,10 @@ static bool unpack_notification_rdm_buffer(const RdmBuffer*   buffer,
                                            RdmnetRdmResponse* resp,
                                            uint8_t*           resp_data_buf,
                                            bool*              is_first_resp);
+static void append_rdm_response_data(RdmnetRdmResponse* resp,
+                                     uint8_t*           resp_data_buf,
+                                     const uint8_t*     data,
+                                     uint8_t            data_len);
 static void send_rdm_response_if_requested(RCClient*               client,
                                            RCClientScope*          scope,
                                            const RptClientMessage* msg,
@@ -296,6 +358,10 @@ etcpal_error_t rc_client_module_init(void)
     internal_pd_buf_size = INTERNAL_PD_BUF_INITIAL_CAPACITY;
   else
     return kEtcPalErrNoMem;
+#elif MAX_REQUEST_TABLES
+  etcpal_error_t res = etcpal_mempool_init(request_tables);
+  if (res != kEtcPalErrOk)
+    return res;
 #endif
 
   return kEtcPalErrOk;
@@ -649,6 +715,12 @@ etcpal_error_t rc_client_request_responder_ids(RCClient*             client,
  * Send an RDM command from an RPT client on a scope. The response will be delivered via an
  * RcClientRptMsgReceivedCb containing an RdmnetRdmResponse. seq_num is filled in on success with a
  * sequence number which can be used to match the command with a response.
+ *
+ * If the client has request tracking enabled, commands to a single RDMnet client are tracked until
+ * they are answered, retried or time out, and their outcome is delivered via an
+ * RCClientRequestCompleteCb instead. In that case, this fails with kEtcPalErrWouldBlock if the
+ * destination already has the maximum number of commands in flight, or kEtcPalErrNoMem if no more
+ * commands can be tracked on the scope.
  */
 etcpal_error_t rc_client_send_rdm_command(RCClient*                    client,
                                           rdmnet_client_scope_t        scope_handle,
@@ -667,35 +739,66 @@ etcpal_error_t rc_client_send_rdm_command(RCClient*                    client,
   if (!scope)
     return kEtcPalErrNotFound;
 
-  RptHeader header;
-  header.source_uid = scope->uid;
-  header.source_endpoint_id = E133_NULL_ENDPOINT;
-  header.dest_uid = destination->rdmnet_uid;
-  header.dest_endpoint_id = destination->endpoint;
-  header.seqnum = scope->send_seq_num;
+  return send_rdm_command_on_scope(client, scope, destination, command_class, param_id, data, data_len, seq_num);
+}
 
-  RdmCommandHeader rdm_header;
-  rdm_header.source_uid = scope->uid;
-  rdm_header.dest_uid = destination->rdm_uid;
-  rdm_header.port_id = 1;
-  rdm_header.transaction_num = (uint8_t)(header.seqnum & 0xffu);
-  rdm_header.subdevice = destination->subdevice;
-  rdm_header.command_class = (rdm_command_class_t)command_class;
-  rdm_header.param_id = param_id;
+/*
+ * Send a batch of RDM commands from an RPT client on a scope. The commands are assigned
+ * consecutive sequence numbers, which are filled in to seq_nums (if not NULL) as they are sent.
+ * The commands are packed back-to-back into the connection's send buffer and written to the socket
+ * in as few send calls as possible.
+ *
+ * Sending stops at the first command which fails, with the error returned; num_sent (if not NULL)
+ * is filled in with the number of commands which were sent, so that the rest can be retried later.
+ */
+etcpal_error_t rc_client_send_rdm_commands(RCClient*                    client,
+                                           rdmnet_client_scope_t        scope_handle,
+                                           const RdmnetBatchRdmCommand* commands,
+                                           size_t                       num_commands,
+                                           uint32_t*                    seq_nums,
+                                           size_t*                      num_sent)
+{
+  if (!RDMNET_ASSERT_VERIFY(client) || !RDMNET_ASSERT_VERIFY(commands))
+    return kEtcPalErrSys;
 
-  RdmBuffer      buf_to_send;
-  etcpal_error_t res = rdm_pack_command(&rdm_header, data, data_len, &buf_to_send);
-  if (res == kEtcPalErrOk)
+  CHECK_SCOPE_HANDLE(scope_handle);
+  RCClientScope* scope = get_scope(client, scope_handle);
+  if (!scope)
+    return kEtcPalErrNotFound;
+
+  etcpal_error_t res = kEtcPalErrOk;
+  size_t         num_corked = 0;
+  size_t         i = 0;
+
+  rc_conn_cork(&scope->conn);
+  for (; i < num_commands; ++i)
   {
-    res = rc_rpt_send_request(&scope->conn, &client->cid, &header, &buf_to_send);
-    if (res == kEtcPalErrOk)
+    const RdmnetBatchRdmCommand* cmd = &commands[i];
+    uint32_t*                    seq_num = (seq_nums ? &seq_nums[i] : NULL);
+
+    res = send_rdm_command_on_scope(client, scope, &cmd->destination, cmd->command_class, cmd->param_id, cmd->data,
+                                    cmd->data_len, seq_num);
+    if (res == kEtcPalErrWouldBlock && num_corked > 0)
     {
-      if (seq_num)
-        *seq_num = scope->send_seq_num;
-      ++scope->send_seq_num;
+      // The batch has filled the connection's send queue. Push what we have to the socket and try
+      // again; if the socket can't take it all right now, the caller will have to back off.
+      rc_conn_uncork(&scope->conn);
+      rc_conn_cork(&scope->conn);
+      num_corked = 0;
+      res = send_rdm_command_on_scope(client, scope, &cmd->destination, cmd->command_class, cmd->param_id, cmd->data,
+                                      cmd->data_len, seq_num);
     }
+    if (res != kEtcPalErrOk)
+      break;
+    ++num_corked;
   }
 
+  etcpal_error_t uncork_res = rc_conn_uncork(&scope->conn);
+  if (res == kEtcPalErrOk)
+    res = uncork_res;
+
+  if (num_sent)
+    *num_sent = i;
   return res;
 }
 
@@ -1226,6 +1329,10 @@ void conncb_disconnected(RCConnection* conn, const RCDisconnectedInfo* disconn_i
     RC_CLIENT_UNLOCK(client);
   }
 
+  // Responses to any commands awaiting one were lost with the connection.
+  if (client->type == kClientProtocolRPT)
+    cancel_tracked_requests(client, scope);
+
   client->callbacks.disconnected(client, scope->handle, &cli_disconn_info);
 }
 
@@ -1274,6 +1381,12 @@ rc_message_action_t conncb_msg_received(RCConnection* conn, const RdmnetMessage*
           RdmnetSyncRdmResponse resp = RDMNET_SYNC_RDM_RESPONSE_INIT;
           bool                  use_internal_buf_for_response = false;
 
+          if (complete_tracked_request(client, scope, &client_msg))
+          {
+            free_rpt_client_message(&client_msg);
+            break;
+          }
+
           if (handle_rdm_command_internally(client, scope, &client_msg, &resp))
           {
             use_internal_buf_for_response = true;
@@ -1329,6 +1442,7 @@ void conncb_destroyed(RCConnection* conn)
 
   if (RC_CLIENT_LOCK(client))
   {
+    free_request_table(scope);
     scope->handle = RDMNET_CLIENT_SCOPE_INVALID;
     scope->state = kRCScopeStateInactive;
     if (client->marked_for_destruction)
@@ -1340,6 +1454,23 @@ void conncb_destroyed(RCConnection* conn)
     client->callbacks.destroyed(client);
 }
 
+void conncb_periodic(RCConnection* conn)
+{
+  if (!RDMNET_ASSERT_VERIFY(conn))
+    return;
+
+  RCClientScope* scope = GET_CLIENT_SCOPE_FROM_CONN(conn);
+  if (!RDMNET_ASSERT_VERIFY(scope))
+    return;
+
+  RCClient* client = scope->client;
+  if (!RDMNET_ASSERT_VERIFY(client))
+    return;
+
+  if (client->type == kClientProtocolRPT && client->data.rpt.request_tracking.enabled)
+    process_tracked_requests(client, scope);
+}
+
 bool parse_rpt_message(const RCClientScope* scope, const RptMessage* rmsg, RptClientMessage* msg_out)
 {
   if (!RDMNET_ASSERT_VERIFY(scope) || !RDMNET_ASSERT_VERIFY(rmsg) || !RDMNET_ASSERT_VERIFY(msg_out))
@@ -1416,8 +1547,10 @@ bool parse_rpt_notification(const RCClientScope* scope, const RptMessage* rmsg,
   if (!get_rdm_response_data_buf(list, &resp_data_buf))
     return false;
 
-  // Initialize some values
+  // Initialize some values. Without a data buffer, any parameter data is delivered directly from
+  // the RDM buffer it was received in.
   resp->rdm_data = resp_data_buf;
+  msg_out->owns_rdm_data = (resp_data_buf != NULL);
 
   bool good_parse = true;
   bool first_msg = true;
@@ -1497,11 +1630,8 @@ bool unpack_notification_rdm_buffer(const RdmBuffer*   buffer,
         etcpal_error_t unpack_res = rdm_unpack_response(buffer, &resp->rdm_header, &this_data, &this_data_len);
         if (unpack_res == kEtcPalErrOk)
         {
-          if (this_data && this_data_len && RDMNET_ASSERT_VERIFY(resp_data_buf))
-          {
-            memcpy(&resp_data_buf[resp->rdm_data_len], this_data, this_data_len);
-            resp->rdm_data_len += this_data_len;
-          }
+          if (this_data && this_data_len)
+            append_rdm_response_data(resp, resp_data_buf, this_data, this_data_len);
           *is_first_resp = false;
 
           if (resp->rdm_header.resp_type == kRdmResponseTypeAckOverflow)
@@ -1527,11 +1657,8 @@ bool unpack_notification_rdm_buffer(const RdmBuffer*   buffer,
         {
           return false;
         }
-        if (this_data && this_data_len && RDMNET_ASSERT_VERIFY(resp_data_buf))
-        {
-          memcpy(&resp_data_buf[resp->rdm_data_len], this_data, this_data_len);
-          resp->rdm_data_len += this_data_len;
-        }
+        if (this_data && this_data_len)
+          append_rdm_response_data(resp, resp_data_buf, this_data, this_data_len);
         return true;
       }
     }
@@ -1539,6 +1666,27 @@ bool unpack_notification_rdm_buffer(const RdmBuffer*   buffer,
   return false;
 }
 
+void append_rdm_response_data(RdmnetRdmResponse* resp,
+                              uint8_t*           resp_data_buf,
+                              const uint8_t*     data,
+                              uint8_t            data_len)
+{
+  if (!RDMNET_ASSERT_VERIFY(resp) || !RDMNET_ASSERT_VERIFY(data))
+    return;
+
+  if (resp_data_buf)
+  {
+    memcpy(&resp_data_buf[resp->rdm_data_len], data, data_len);
+    resp->rdm_data_len += data_len;
+  }
+  else if (RDMNET_ASSERT_VERIFY(resp->rdm_data_len == 0))
+  {
+    // The data is all in this one RDM buffer, which stays valid while the response is delivered.
+    resp->rdm_data = data;
+    resp->rdm_data_len = data_len;
+  }
+}
+
 void send_rdm_response_if_requested(RCClient*               client,
                                     RCClientScope*          scope,
                                     const RptClientMessage* msg,
@@ -1732,7 +1880,8 @@ void free_rpt_client_message(RptClientMessage* msg)
     if (!RDMNET_ASSERT_VERIFY(rdm_resp))
       return;
 
-    free_rdm_response_data_buf((uint8_t*)rdm_resp->rdm_data);
+    if (msg->owns_rdm_data)
+      free_rdm_response_data_buf((uint8_t*)rdm_resp->rdm_data);
   }
 }
 
@@ -1813,6 +1962,356 @@ bool disconnected_will_retry(rdmnet_disconnect_event_t event, rdmnet_disconnect_
   return true;
 }
 
+/******************************************************************************
+ * Sending RDM commands
+ *****************************************************************************/
+
+/*
+ * Send an RDM command on a scope with the scope's next sequence number, tracking it if the client
+ * has request tracking enabled.
+ */
+etcpal_error_t send_rdm_command_on_scope(RCClient*                    client,
+                                         RCClientScope*               scope,
+                                         const RdmnetDestinationAddr* destination,
+                                         rdmnet_command_class_t       command_class,
+                                         uint16_t                     param_id,
+                                         const uint8_t*               data,
+                                         uint8_t                      data_len,
+                                         uint32_t*                    seq_num)
+{
+  if (!RDMNET_ASSERT_VERIFY(client) || !RDMNET_ASSERT_VERIFY(scope) || !RDMNET_ASSERT_VERIFY(destination))
+    return kEtcPalErrSys;
+
+  // Broadcast commands can be answered any number of times, so they are never tracked.
+  const RCRptClientData* rpt_client_data = RC_RPT_CLIENT_DATA(client);
+  etcpal_error_t         res = kEtcPalErrOk;
+  if (client->type == kClientProtocolRPT && rpt_client_data && rpt_client_data->request_tracking.enabled &&
+      !RDMNET_UID_IS_CONTROLLER_BROADCAST(&destination->rdmnet_uid) &&
+      !RDMNET_UID_IS_DEVICE_BROADCAST(&destination->rdmnet_uid) &&
+      !RDMNET_UID_IS_DEVICE_MANU_BROADCAST(&destination->rdmnet_uid))
+  {
+    res = track_rdm_command(client, scope, destination, command_class, param_id, data, data_len);
+  }
+  else
+  {
+    res = send_rdm_command_internal(client, scope, scope->send_seq_num, destination, command_class, param_id, data,
+                                    data_len);
+  }
+
+  if (res == kEtcPalErrOk)
+  {
+    if (seq_num)
+      *seq_num = scope->send_seq_num;
+    ++scope->send_seq_num;
+  }
+  return res;
+}
+
+/* Pack and send an RDM command on a scope with the given sequence number. */
+etcpal_error_t send_rdm_command_internal(RCClient*                    client,
+                                         RCClientScope*               scope,
+                                         uint32_t                     seq_num,
+                                         const RdmnetDestinationAddr* destination,
+                                         rdmnet_command_class_t       command_class,
+                                         uint16_t                     param_id,
+                                         const uint8_t*               data,
+                                         uint8_t                      data_len)
+{
+  if (!RDMNET_ASSERT_VERIFY(client) || !RDMNET_ASSERT_VERIFY(scope) || !RDMNET_ASSERT_VERIFY(destination))
+    return kEtcPalErrSys;
+
+  RptHeader header;
+  header.source_uid = scope->uid;
+  header.source_endpoint_id = E133_NULL_ENDPOINT;
+  header.dest_uid = destination->rdmnet_uid;
+  header.dest_endpoint_id = destination->endpoint;
+  header.seqnum = seq_num;
+
+  RdmCommandHeader rdm_header;
+  rdm_header.source_uid = scope->uid;
+  rdm_header.dest_uid = destination->rdm_uid;
+  rdm_header.port_id = 1;
+  rdm_header.transaction_num = (uint8_t)(header.seqnum & 0xffu);
+  rdm_header.subdevice = destination->subdevice;
+  rdm_header.command_class = (rdm_command_class_t)command_class;
+  rdm_header.param_id = param_id;
+
+  RdmBuffer      buf_to_send;
+  etcpal_error_t res = rdm_pack_command(&rdm_header, data, data_len, &buf_to_send);
+  if (res == kEtcPalErrOk)
+    res = rc_rpt_send_request(&scope->conn, &client->cid, &header, &buf_to_send);
+  return res;
+}
+
+/******************************************************************************
+ * Request tracking
+ *****************************************************************************/
+
+/*
+ * Send an RDM command with the scope's next sequence number and start tracking it. The command is
+ * saved so that it can be resent if no response arrives in time.
+ */
+etcpal_error_t track_rdm_command(RCClient*                    client,
+                                 RCClientScope*               scope,
+                                 const RdmnetDestinationAddr* destination,
+                                 rdmnet_command_class_t       command_class,
+                                 uint16_t                     param_id,
+                                 const uint8_t*               data,
+                                 uint8_t                      data_len)
+{
+  if (!RDMNET_ASSERT_VERIFY(client) || !RDMNET_ASSERT_VERIFY(scope) || !RDMNET_ASSERT_VERIFY(destination))
+    return kEtcPalErrSys;
+
+  const RCRequestTrackingConfig* config = &client->data.rpt.request_tracking;
+  if (data_len > RDM_MAX_PDL || (data_len && !data))
+    return kEtcPalErrInvalid;
+  if (config->max_in_flight_per_dest != 0 && scope->requests &&
+      rc_request_table_num_in_flight(scope->requests, &destination->rdmnet_uid) >= config->max_in_flight_per_dest)
+  {
+    return kEtcPalErrWouldBlock;
+  }
+
+  // The table is only allocated once a scope has a request to track, so devices and controllers
+  // which don't track requests never hold one.
+  if (!scope->requests)
+  {
+    scope->requests = ALLOC_REQUEST_TABLE();
+    if (!scope->requests)
+      return kEtcPalErrNoMem;
+    rc_request_table_init(scope->requests);
+  }
+
+  RCTrackedRequest* request = rc_request_table_add(scope->requests, scope->send_seq_num, destination);
+  if (!request)
+    return kEtcPalErrNoMem;
+
+  request->command_class = command_class;
+  request->param_id = param_id;
+  if (data_len)
+    memcpy(request->data, data, data_len);
+  request->data_len = data_len;
+  request->retries_left = config->max_retries;
+  etcpal_timer_start(&request->timer, config->timeout_ms);
+
+  etcpal_error_t res = send_rdm_command_internal(client, scope, scope->send_seq_num, destination, command_class,
+                                                 param_id, data, data_len);
+  if (res != kEtcPalErrOk)
+    rc_request_table_remove(scope->requests, scope->send_seq_num, NULL);
+  return res;
+}
+
+/*
+ * If a received RDM response or RPT status completes a tracked request, stop tracking the request
+ * and deliver its outcome. The parts of a response which arrives in several parts are each
+ * delivered as they come, and restart the request's timeout so that it isn't resent while the
+ * rest of the response is on its way. Returns true if the message was consumed.
+ */
+bool complete_tracked_request(RCClient* client, RCClientScope* scope, const RptClientMessage* msg)
+{
+  if (!RDMNET_ASSERT_VERIFY(client) || !RDMNET_ASSERT_VERIFY(scope) || !RDMNET_ASSERT_VERIFY(msg))
+    return false;
+
+  const RCRptClientData* rpt_client_data = RC_RPT_CLIENT_DATA(client);
+  if (!RDMNET_ASSERT_VERIFY(rpt_client_data) || !rpt_client_data->request_tracking.enabled || !scope->requests)
+    return false;
+
+  RdmnetRequestResult result;
+  memset(&result, 0, sizeof(RdmnetRequestResult));
+
+  if (msg->type == kRptClientMsgRdmResp)
+  {
+    const RdmnetRdmResponse* resp = RDMNET_GET_RDM_RESPONSE(msg);
+    if (!RDMNET_ASSERT_VERIFY(resp) || !resp->is_response_to_me)
+      return false;
+    result.seq_num = resp->seq_num;
+    result.outcome = kRdmnetRequestResponseReceived;
+    result.response = resp;
+  }
+  else if (msg->type == kRptClientMsgStatus)
+  {
+    const RdmnetRptStatus* status = RDMNET_GET_RPT_STATUS(msg);
+    if (!RDMNET_ASSERT_VERIFY(status))
+      return false;
+    result.seq_num = status->seq_num;
+    result.outcome = kRdmnetRequestStatusReceived;
+    result.status = status;
+  }
+  else
+  {
+    return false;
+  }
+
+  bool found = false;
+  if (RC_CLIENT_LOCK(client))
+  {
+    if (result.response && result.response->more_coming)
+    {
+      // Only the last part of the response completes the request.
+      RCTrackedRequest* request = rc_request_table_find(scope->requests, result.seq_num);
+      if (request)
+      {
+        etcpal_timer_reset(&request->timer);
+        result.destination = request->destination;
+        found = true;
+      }
+    }
+    else
+    {
+      RCTrackedRequest request;
+      found = rc_request_table_remove(scope->requests, result.seq_num, &request);
+      if (found)
+        result.destination = request.destination;
+    }
+    RC_CLIENT_UNLOCK(client);
+  }
+  if (!found)
+    return false;
+
+  if (RDMNET_ASSERT_VERIFY(rpt_client_data->callbacks.request_complete))
+    rpt_client_data->callbacks.request_complete(client, scope->handle, &result);
+  return true;
+}
+
+/*
+ * Resend the tracked requests on a scope whose timeouts have expired, and complete the ones which
+ * have run out of retries.
+ */
+void process_tracked_requests(RCClient* client, RCClientScope* scope)
+{
+  if (!RDMNET_ASSERT_VERIFY(client) || !RDMNET_ASSERT_VERIFY(scope))
+    return;
+
+  const RCRptClientData* rpt_client_data = RC_RPT_CLIENT_DATA(client);
+  if (!RDMNET_ASSERT_VERIFY(rpt_client_data) || !scope->requests)
+    return;
+
+  bool more_expired = true;
+  while (more_expired)
+  {
+    RdmnetRequestResult results[REQUEST_COMPLETION_BATCH_SIZE];
+    size_t              num_results = 0;
+    more_expired = false;
+
+    if (RC_CLIENT_LOCK(client))
+    {
+      uint32_t expired[REQUEST_COMPLETION_BATCH_SIZE];
+      size_t   index = 0;
+      for (RCTrackedRequest* request = rc_request_table_next(scope->requests, &index); request;
+           request = rc_request_table_next(scope->requests, &index))
+      {
+        if (!etcpal_timer_is_expired(&request->timer))
+          continue;
+
+        if (request->retries_left > 0)
+        {
+          // If the connection can't take the command right now, try again on the next tick.
+          etcpal_error_t res =
+              send_rdm_command_internal(client, scope, request->seq_num, &request->destination,
+                                        request->command_class, request->param_id, request->data, request->data_len);
+          if (res != kEtcPalErrWouldBlock)
+          {
+            --request->retries_left;
+            etcpal_timer_reset(&request->timer);
+          }
+        }
+        else if (num_results < REQUEST_COMPLETION_BATCH_SIZE)
+        {
+          expired[num_results++] = request->seq_num;
+        }
+        else
+        {
+          more_expired = true;
+          break;
+        }
+      }
+
+      for (size_t i = 0; i < num_results; ++i)
+      {
+        RCTrackedRequest request;
+        if (RDMNET_ASSERT_VERIFY(rc_request_table_remove(scope->requests, expired[i], &request)))
+        {
+          memset(&results[i], 0, sizeof(RdmnetRequestResult));
+          results[i].seq_num = request.seq_num;
+          results[i].destination = request.destination;
+          results[i].outcome = kRdmnetRequestTimedOut;
+        }
+      }
+      RC_CLIENT_UNLOCK(client);
+    }
+
+    for (size_t i = 0; i < num_results; ++i)
+    {
+      if (RDMNET_ASSERT_VERIFY(rpt_client_data->callbacks.request_complete))
+        rpt_client_data->callbacks.request_complete(client, scope->handle, &results[i]);
+    }
+  }
+}
+
+/* Stop tracking all of the requests on a scope, delivering each one as cancelled. */
+void cancel_tracked_requests(RCClient* client, RCClientScope* scope)
+{
+  if (!RDMNET_ASSERT_VERIFY(client) || !RDMNET_ASSERT_VERIFY(scope))
+    return;
+
+  const RCRptClientData* rpt_client_data = RC_RPT_CLIENT_DATA(client);
+  if (!RDMNET_ASSERT_VERIFY(rpt_client_data) || !scope->requests)
+    return;
+
+  bool more_pending = true;
+  while (more_pending)
+  {
+    RdmnetRequestResult results[REQUEST_COMPLETION_BATCH_SIZE];
+    size_t              num_results = 0;
+    more_pending = false;
+
+    if (RC_CLIENT_LOCK(client))
+    {
+      uint32_t pending[REQUEST_COMPLETION_BATCH_SIZE];
+      size_t   index = 0;
+      for (RCTrackedRequest* request = rc_request_table_next(scope->requests, &index);
+           request && num_results < REQUEST_COMPLETION_BATCH_SIZE;
+           request = rc_request_table_next(scope->requests, &index))
+      {
+        pending[num_results++] = request->seq_num;
+      }
+
+      for (size_t i = 0; i < num_results; ++i)
+      {
+        RCTrackedRequest request;
+        if (RDMNET_ASSERT_VERIFY(rc_request_table_remove(scope->requests, pending[i], &request)))
+        {
+          memset(&results[i], 0, sizeof(RdmnetRequestResult));
+          results[i].seq_num = request.seq_num;
+          results[i].destination = request.destination;
+          results[i].outcome = kRdmnetRequestCancelled;
+        }
+      }
+      more_pending = (scope->requests->num_requests > 0);
+      RC_CLIENT_UNLOCK(client);
+    }
+
+    for (size_t i = 0; i < num_results; ++i)
+    {
+      if (RDMNET_ASSERT_VERIFY(rpt_client_data->callbacks.request_complete))
+        rpt_client_data->callbacks.request_complete(client, scope->handle, &results[i]);
+    }
+  }
+}
+
+/* Free the request table of a scope, if it has one. */
+void free_request_table(RCClientScope* scope)
+{
+  if (!RDMNET_ASSERT_VERIFY(scope))
+    return;
+
+  if (scope->requests)
+  {
+    rc_request_table_cleanup(scope->requests);
+    FREE_REQUEST_TABLE(scope->requests);
+    scope->requests = NULL;
+  }
+}
+
 /*
  * Allocate a new scope list entry and append it to a client's scope list. If a scope string is
  * already in the list, fails with kEtcPalErrExists. Attempts to create a new connection handle to
@@ -1869,6 +2368,7 @@ etcpal_error_t create_and_add_scope_entry(RCClient* client, const RdmnetScopeCon
   ETCPAL_IP_SET_INVALID(&new_scope->current_broker_addr.ip);
   new_scope->current_broker_addr.port = 0;
   new_scope->unhealthy_counter = 0;
+  new_scope->requests = NULL;
   new_scope->client = client;
 
   *new_entry = new_scope;
@@ -2474,14 +2974,20 @@ bool get_rdm_response_data_buf(const RptRdmBufList* buf_list, uint8_t** buf_ptr)
     return false;
 
   size_t size_needed = 0;
+  size_t num_data_buffers = 0;
 
   for (const RdmBuffer* buf = buf_list->rdm_buffers; buf < buf_list->rdm_buffers + buf_list->num_rdm_buffers; ++buf)
   {
-    if (RDM_CC_IS_NON_DISC_RESPONSE(buf->data[RDM_OFFSET_COMMAND_CLASS]))
+    if (RDM_CC_IS_NON_DISC_RESPONSE(buf->data[RDM_OFFSET_COMMAND_CLASS]) && buf->data[RDM_OFFSET_PARAM_DATA_LEN] > 0)
+    {
       size_needed += buf->data[RDM_OFFSET_PARAM_DATA_LEN];
+      ++num_data_buffers;
+    }
   }
 
-  if (size_needed == 0)
+  // Data from a single response (the common case without ACK_OVERFLOW) is delivered in place, so a
+  // buffer is only needed to join the data of several.
+  if (num_data_buffers <= 1)
   {
     *buf_ptr = NULL;
     return true;
@@ -47,6 +47,8 @@
 #include "rdmnet/core/common.h"
 #include "rdmnet/core/connection.h"
 #include "rdmnet/core/llrp_target.h"
+#include "rdmnet/core/request_table.h"
+#include "rdmnet/core/util.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -76,6 +78,9 @@ typedef struct RptClientMessage
     RdmnetRdmResponse resp;
     RdmnetRptStatus   status;
   } payload;
+  // For RDM responses, whether payload.resp.rdm_data was allocated to join the parameter data of
+  // several RDM buffers, rather than pointing directly into the received message.
+  bool owns_rdm_data;
 } RptClientMessage;
 
 #define RDMNET_GET_RDM_COMMAND(rptclimsgptr) (RDMNET_ASSERT_VERIFY(rptclimsgptr) ? &(rptclimsgptr)->payload.cmd : NULL)
@@ -166,6 +171,14 @@ typedef void (*RCClientEptMsgReceivedCb)(RCClient*               client,
                                          RdmnetSyncRdmResponse*  response,
                                          bool*                   use_internal_buf_for_response);
 
+// An RDM command sent by an RPT client with request tracking enabled has completed: a response or
+// status message was received for it, it timed out or the scope's connection was lost. Responses
+// and status messages which complete a tracked command are delivered here instead of through
+// rpt_msg_received.
+typedef void (*RCClientRequestCompleteCb)(RCClient*                  client,
+                                          rdmnet_client_scope_t      scope_handle,
+                                          const RdmnetRequestResult* result);
+
 // An RDMnet client has been destroyed and unregistered. This is called from the background thread,
 // after the resources associated with the client (e.g. other module structs, sockets, etc) have
 // been cleaned up. It is safe to deallocate the client from this callback.
@@ -186,6 +199,7 @@ typedef struct RCRptClientCallbacks
 {
   RCClientLlrpMsgReceivedCb llrp_msg_received;
   RCClientRptMsgReceivedCb  rpt_msg_received;
+  RCClientRequestCompleteCb request_complete;  // Required if request tracking is enabled.
 } RCRptClientCallbacks;
 
 // The set of possible callbacks that are delivered to an EPT client.
@@ -229,16 +243,30 @@ typedef struct RCClientScope
   EtcPalSockAddr current_broker_addr;
   uint16_t       unhealthy_counter;
 
+  // RDM commands awaiting a response. Allocated when the first command is tracked, so NULL unless
+  // request tracking is enabled.
+  RCRequestTable* requests;
+
   RCConnection conn;
 
   RCClient* client;
 } RCClientScope;
 
+// Settings for tracking the RDM commands sent by an RPT client until they are answered.
+typedef struct RCRequestTrackingConfig
+{
+  bool         enabled;
+  unsigned int timeout_ms;              // How long to wait for a response before each retry.
+  unsigned int max_retries;             // How many times to resend a command before it times out.
+  size_t       max_in_flight_per_dest;  // The most commands awaiting a response from one client; 0 for no limit.
+} RCRequestTrackingConfig;
+
 typedef struct RCRptClientData
 {
-  rpt_client_type_t    type;
-  RdmUid               uid;
-  RCRptClientCallbacks callbacks;
+  rpt_client_type_t       type;
+  RdmUid                  uid;
+  RCRptClientCallbacks    callbacks;
+  RCRequestTrackingConfig request_tracking;
 } RCRptClientData;
 
 typedef struct RCEptClientData
@@ -343,6 +371,12 @@ etcpal_error_t rc_client_send_rdm_command(RCClient*                    client,
                                           const uint8_t*               data,
                                           uint8_t                      data_len,
                                           uint32_t*                    seq_num);
+etcpal_error_t rc_client_send_rdm_commands(RCClient*                    client,
+                                           rdmnet_client_scope_t        scope_handle,
+                                           const RdmnetBatchRdmCommand* commands,
+                                           size_t                       num_commands,
+                                           uint32_t*                    seq_nums,
+                                           size_t*                      num_sent);
 etcpal_error_t rc_client_send_rdm_ack(RCClient*                    client,
                                       rdmnet_client_scope_t        scope_handle,
                                       const RdmnetSavedRdmCommand* received_cmd,
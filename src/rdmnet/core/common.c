@@ -39,6 +39,11 @@
 #define RDMNET_TICK_PERIODIC_INTERVAL 100 /* ms */
 #define RDMNET_POLL_TIMEOUT 120           /* ms */
 
+// Limits on the socket activity serviced in one call to rc_tick(), so that the periodic module
+// functionality is not delayed by a constant stream of incoming data.
+#define RDMNET_TICK_MAX_POLL_EVENTS 32
+#define RDMNET_TICK_POLL_BUDGET 20 /* ms */
+
 #define RDMNET_ETCPAL_FEATURES \
   (ETCPAL_FEATURE_SOCKETS | ETCPAL_FEATURE_TIMERS | ETCPAL_FEATURE_NETINTS | ETCPAL_FEATURE_LOGGING)
 
@@ -94,6 +99,7 @@ static etcpal_rwlock_t rdmnet_lock;
 
 static etcpal_error_t init_etcpal_dependencies(void);
 static void           deinit_etcpal_dependencies(void);
+static bool           socket_in_array(etcpal_socket_t socket, const etcpal_socket_t* array, size_t array_size);
 
 /*************************** Function definitions ****************************/
 
@@ -256,6 +262,19 @@ int rc_send(etcpal_socket_t id, const void* message, size_t length, int flags)
   return res;
 }
 
+/*
+ * Send as much of a message as the socket will currently accept, without blocking. Returns the
+ * number of bytes sent (which may be less than length) or an error code, which is
+ * kEtcPalErrWouldBlock if the socket's send buffer is full.
+ */
+int rc_try_send(etcpal_socket_t id, const void* message, size_t length, int flags)
+{
+  if (!RDMNET_ASSERT_VERIFY(message))
+    return (int)kEtcPalErrSys;
+
+  return etcpal_send(id, message, length, flags);
+}
+
 /*
  * Process RDMnet background tasks.
  *
@@ -264,24 +283,51 @@ int rc_send(etcpal_socket_t id, const void* message, size_t length, int flags)
  */
 void rc_tick(void)
 {
-  EtcPalPollEvent event;
-  etcpal_error_t  poll_res = etcpal_poll_wait(&core_state.poll_context, &event, RDMNET_POLL_TIMEOUT);
-  if (poll_res == kEtcPalErrOk)
+  // Wait for the first socket event, then keep servicing sockets which are already ready until
+  // none remain or this tick's budget is used up. Each socket is serviced at most once per tick, so
+  // one busy connection cannot starve the others. The budget starts when the first wait returns, so
+  // time spent blocked waiting for activity does not count against it.
+  etcpal_socket_t serviced[RDMNET_TICK_MAX_POLL_EVENTS];
+  size_t          num_serviced = 0;
+  int             timeout_ms = RDMNET_POLL_TIMEOUT;
+  uint32_t        start_ms = 0;
+
+  while (num_serviced < RDMNET_TICK_MAX_POLL_EVENTS)
   {
-    RCPolledSocketInfo* info = (RCPolledSocketInfo*)event.user_data;
-    if (info)
+    EtcPalPollEvent event;
+    etcpal_error_t  poll_res = etcpal_poll_wait(&core_state.poll_context, &event, timeout_ms);
+    if (timeout_ms != 0)
+      start_ms = etcpal_getms();
+
+    if (poll_res == kEtcPalErrOk)
     {
-      if (RDMNET_ASSERT_VERIFY(info->callback))
-        info->callback(&event, info->data);
+      if (socket_in_array(event.socket, serviced, num_serviced))
+        break;
+      serviced[num_serviced++] = event.socket;
+
+      RCPolledSocketInfo* info = (RCPolledSocketInfo*)event.user_data;
+      if (info)
+      {
+        if (RDMNET_ASSERT_VERIFY(info->callback))
+          info->callback(&event, info->data);
+      }
     }
-  }
-  else if (poll_res != kEtcPalErrTimedOut)
-  {
-    if (poll_res != kEtcPalErrNoSockets)
+    else
     {
-      RDMNET_LOG_ERR("Error ('%s') while polling sockets.", etcpal_strerror(poll_res));
+      if (poll_res != kEtcPalErrTimedOut && num_serviced == 0)
+      {
+        if (poll_res != kEtcPalErrNoSockets)
+        {
+          RDMNET_LOG_ERR("Error ('%s') while polling sockets.", etcpal_strerror(poll_res));
+        }
+        etcpal_thread_sleep(100);  // Sleep to avoid spinning on errors
+      }
+      break;
     }
-    etcpal_thread_sleep(100);  // Sleep to avoid spinning on errors
+
+    if (etcpal_getms() - start_ms >= RDMNET_TICK_POLL_BUDGET)
+      break;
+    timeout_ms = 0;
   }
 
   if (etcpal_timer_is_expired(&core_state.tick_timer))
@@ -347,3 +393,13 @@ void deinit_etcpal_dependencies(void)
   etcpal_poll_context_deinit(&core_state.poll_context);
   etcpal_deinit(RDMNET_ETCPAL_FEATURES);
 }
+
+bool socket_in_array(etcpal_socket_t socket, const etcpal_socket_t* array, size_t array_size)
+{
+  for (const etcpal_socket_t* cur = array; cur < array + array_size; ++cur)
+  {
+    if (*cur == socket)
+      return true;
+  }
+  return false;
+}
@@ -103,6 +103,7 @@ etcpal_error_t rc_modify_polled_socket(etcpal_socket_t socket, etcpal_poll_event
 void           rc_remove_polled_socket(etcpal_socket_t socket);
 
 int rc_send(etcpal_socket_t id, const void* message, size_t length, int flags);
+int rc_try_send(etcpal_socket_t id, const void* message, size_t length, int flags);
 
 #ifdef __cplusplus
 }
@@ -105,6 +105,7 @@ static void destroy_connection(RCConnection* conn, const void* context);
 
 // Incoming message handling
 static void                socket_activity_callback(const EtcPalPollEvent* event, RCPolledSocketOpaqueData data);
+static void                send_queued_data(RCConnection* conn);
 static void                receive_and_process_messages(RCConnection* conn);
 static rc_message_action_t process_message(RCConnection* conn);
 static void                handle_tcp_connection_established(RCConnection* conn);
@@ -150,10 +151,17 @@ etcpal_error_t rc_conn_register(RCConnection* conn)
   if (!rc_initialized())
     return kEtcPalErrNotInit;
 
+  if (!rc_msg_buf_init(&conn->recv_buf, 0))
+    return kEtcPalErrNoMem;
+
   if (!rc_ref_list_add_ref(&connections.pending, conn))
+  {
+    rc_msg_buf_cleanup(&conn->recv_buf);
     return kEtcPalErrNoMem;
+  }
 
   conn->sock = ETCPAL_SOCKET_INVALID;
+  rc_send_buf_init(&conn->send_buf, &conn->poll_info);
   ETCPAL_IP_SET_INVALID(&conn->remote_addr.ip);
   conn->remote_addr.port = 0;
   conn->poll_info.callback = socket_activity_callback;
@@ -164,7 +172,6 @@ etcpal_error_t rc_conn_register(RCConnection* conn)
   conn->rdmnet_conn_failed = false;
   conn->sent_connected_notification = false;
 
-  rc_msg_buf_init(&conn->recv_buf);
   conn->retry_current_message = false;
 
   return kEtcPalErrOk;
@@ -268,6 +275,35 @@ etcpal_error_t rc_conn_disconnect(RCConnection* conn, rdmnet_disconnect_reason_t
   return kEtcPalErrOk;
 }
 
+/*
+ * Start batching outgoing messages on a connection. Messages sent after this call are held in the
+ * connection's send buffer and written to the socket in as few send calls as possible when
+ * rc_conn_uncork() is called. Must be called with the connection's lock held, and must be paired
+ * with a call to rc_conn_uncork() under the same lock.
+ */
+void rc_conn_cork(RCConnection* conn)
+{
+  if (!RDMNET_ASSERT_VERIFY(conn))
+    return;
+
+  rc_send_buf_cork(&conn->send_buf);
+}
+
+/*
+ * Stop batching outgoing messages on a connection and send any messages held since rc_conn_cork()
+ * was called.
+ */
+etcpal_error_t rc_conn_uncork(RCConnection* conn)
+{
+  if (!RDMNET_ASSERT_VERIFY(conn))
+    return kEtcPalErrSys;
+
+  etcpal_error_t res = rc_send_buf_uncork(&conn->send_buf, conn->sock);
+  if (res == kEtcPalErrOk)
+    etcpal_timer_reset(&conn->send_timer);
+  return res;
+}
+
 /*
  * Handle periodic RDMnet connection functionality.
  */
@@ -349,8 +385,10 @@ void process_connection_state(RCConnection* conn, const void* context)
         }
         break;
       case kRCConnStateReconnectPending:
+        // Give the disconnect message and anything queued before it a last chance to go out.
+        rc_send_buf_flush(&conn->send_buf, conn->sock);
         cleanup_connection_resources(conn);
-        rc_msg_buf_init(&conn->recv_buf);
+        rc_msg_buf_reset(&conn->recv_buf);
         conn->retry_current_message = false;
         if (conn->sent_connected_notification)
         {
@@ -361,6 +399,7 @@ void process_connection_state(RCConnection* conn, const void* context)
         start_connection(conn, &event);
         break;
       case kRCConnStateDisconnectPending:
+        rc_send_buf_flush(&conn->send_buf, conn->sock);
         if (conn->sent_connected_notification)
         {
           event.which = kRCConnEventDisconnected;
@@ -378,6 +417,9 @@ void process_connection_state(RCConnection* conn, const void* context)
     rc_message_action_t action = kRCMessageActionProcessNext;
     deliver_event_callback(conn, &event, &action);
   }
+
+  if (conn->callbacks.periodic)
+    conn->callbacks.periodic(conn);
 }
 
 // Update a backoff timer value using the algorithm specified in E1.33. Returns the new value.
@@ -478,7 +520,7 @@ void reset_connection(RCConnection* conn)
     return;
 
   cleanup_connection_resources(conn);
-  rc_msg_buf_init(&conn->recv_buf);
+  rc_msg_buf_reset(&conn->recv_buf);
   conn->retry_current_message = false;
   conn->state = kRCConnStateNotStarted;
 }
@@ -489,7 +531,7 @@ void retry_connection(RCConnection* conn)
     return;
 
   cleanup_connection_resources(conn);
-  rc_msg_buf_init(&conn->recv_buf);
+  rc_msg_buf_reset(&conn->recv_buf);
   conn->retry_current_message = false;
   conn->state = kRCConnStateConnectPending;
 }
@@ -502,6 +544,8 @@ void destroy_connection(RCConnection* conn, const void* context)
     return;
 
   cleanup_connection_resources(conn);
+  rc_msg_buf_cleanup(&conn->recv_buf);
+  rc_send_buf_cleanup(&conn->send_buf);
   if (conn->callbacks.destroyed)
     conn->callbacks.destroyed(conn);
 }
@@ -517,6 +561,7 @@ void cleanup_connection_resources(RCConnection* conn)
     etcpal_close(conn->sock);
     conn->sock = ETCPAL_SOCKET_INVALID;
   }
+  rc_send_buf_reset(&conn->send_buf);
 
   if (conn->retry_current_message)
   {
@@ -536,11 +581,37 @@ void socket_activity_callback(const EtcPalPollEvent* event, RCPolledSocketOpaque
     return;
 
   if (event->events & ETCPAL_POLL_ERR)
+  {
     handle_socket_error(conn, event->err);
-  else if (event->events & ETCPAL_POLL_IN)
-    receive_and_process_messages(conn);
+  }
+  else if (event->events & (ETCPAL_POLL_IN | ETCPAL_POLL_OUT))
+  {
+    if (event->events & ETCPAL_POLL_OUT)
+      send_queued_data(conn);
+    if (event->events & ETCPAL_POLL_IN)
+      receive_and_process_messages(conn);
+  }
   else if (event->events & ETCPAL_POLL_CONNECT)
+  {
     handle_tcp_connection_established(conn);
+  }
+}
+
+void send_queued_data(RCConnection* conn)
+{
+  if (!RDMNET_ASSERT_VERIFY(conn))
+    return;
+
+  etcpal_error_t send_res = kEtcPalErrOk;
+  if (RC_CONN_LOCK(conn))
+  {
+    if (conn->sock != ETCPAL_SOCKET_INVALID)
+      send_res = rc_send_buf_flush(&conn->send_buf, conn->sock);
+    RC_CONN_UNLOCK(conn);
+  }
+
+  if (send_res != kEtcPalErrOk)
+    handle_socket_error(conn, send_res);
 }
 
 void receive_and_process_messages(RCConnection* conn)
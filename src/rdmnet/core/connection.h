@@ -44,6 +44,7 @@
 #include "rdmnet/core/common.h"
 #include "rdmnet/core/message.h"
 #include "rdmnet/core/msg_buf.h"
+#include "rdmnet/core/send_buf.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -124,6 +125,10 @@ typedef rc_message_action_t (*RCConnMessageReceivedCallback)(RCConnection* conn,
 // It is safe to deallocate the connection from this callback.
 typedef void (*RCConnDestroyedCallback)(RCConnection* conn);
 
+// Called from the background thread each time the connection module processes an RDMnet
+// connection's state, whatever that state is. Used for the periodic work of the connection's owner.
+typedef void (*RCConnPeriodicCallback)(RCConnection* conn);
+
 // The set of callbacks which are called with notifications about RDMnet connections.
 typedef struct RCConnectionCallbacks
 {
@@ -132,6 +137,7 @@ typedef struct RCConnectionCallbacks
   RCConnDisconnectedCallback    disconnected;
   RCConnMessageReceivedCallback message_received;
   RCConnDestroyedCallback       destroyed;
+  RCConnPeriodicCallback        periodic;  // Optional, can be NULL.
 } RCConnectionCallbacks;
 
 // The connection state machine.
@@ -175,8 +181,9 @@ struct RCConnection
   EtcPalTimer            hb_timer;
 
   // Send and receive tracking
-  RCMsgBuf recv_buf;
-  bool     retry_current_message;  // recv_buf.msg couldn't be processed - retry processing it at a later time.
+  RCSendBuf send_buf;               // Outgoing messages are assembled here and sent with one call each.
+  RCMsgBuf  recv_buf;
+  bool      retry_current_message;  // recv_buf.msg couldn't be processed - retry processing it at a later time.
 };
 
 etcpal_error_t rc_conn_module_init(void);
@@ -194,6 +201,9 @@ etcpal_error_t rc_conn_reconnect(RCConnection*                 conn,
                                  rdmnet_disconnect_reason_t    disconnect_reason);
 etcpal_error_t rc_conn_disconnect(RCConnection* conn, rdmnet_disconnect_reason_t disconnect_reason);
 
+void           rc_conn_cork(RCConnection* conn);
+etcpal_error_t rc_conn_uncork(RCConnection* conn);
+
 #ifdef __cplusplus
 }
 #endif
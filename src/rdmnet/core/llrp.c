@@ -105,6 +105,7 @@ static etcpal_error_t create_recv_socket(llrp_socket_t llrp_type, etcpal_iptype_
 static bool           get_netint_id(EtcPalMsgHdr* msg, EtcPalMcastNetintId* netint_id);
 
 static void llrp_socket_activity(const EtcPalPollEvent* event, RCPolledSocketOpaqueData data);
+static void handle_llrp_datagram(llrp_socket_t llrp_type, EtcPalMsgHdr* msg, size_t data_len);
 static void llrp_socket_error(etcpal_error_t err);
 
 /*************************** Function definitions ****************************/
@@ -325,6 +326,11 @@ bool get_netint_id(EtcPalMsgHdr* msg, EtcPalMcastNetintId* netint_id)
   return pktinfo_found;
 }
 
+/*
+ * Drain up to RDMNET_MCAST_RECV_BATCH_SIZE datagrams from a readable LLRP socket. The socket is
+ * non-blocking, so a burst of discovery replies is handled in one pass instead of one datagram per
+ * poll event.
+ */
 void llrp_socket_activity(const EtcPalPollEvent* event, RCPolledSocketOpaqueData data)
 {
   if (!RDMNET_ASSERT_VERIFY(event))
@@ -340,47 +346,61 @@ void llrp_socket_activity(const EtcPalPollEvent* event, RCPolledSocketOpaqueData
   {
     uint8_t control_buf[ETCPAL_MAX_CONTROL_SIZE_PKTINFO];  // Ancillary data
 
-    EtcPalMsgHdr msg;
-    msg.buf = llrp_recv_buf;
-    msg.buflen = LLRP_MAX_MESSAGE_SIZE;
-    msg.control = control_buf;
-    msg.controllen = ETCPAL_MAX_CONTROL_SIZE_PKTINFO;
-
-    int recv_res = etcpal_recvmsg(event->socket, &msg, 0);
-    if (recv_res <= 0)
+    for (size_t i = 0; i < RDMNET_MCAST_RECV_BATCH_SIZE; ++i)
     {
-      if (recv_res != kEtcPalErrMsgSize)
+      EtcPalMsgHdr msg;
+      msg.buf = llrp_recv_buf;
+      msg.buflen = LLRP_MAX_MESSAGE_SIZE;
+      msg.control = control_buf;
+      msg.controllen = ETCPAL_MAX_CONTROL_SIZE_PKTINFO;
+
+      int recv_res = etcpal_recvmsg(event->socket, &msg, 0);
+      if (recv_res > 0)
       {
-        llrp_socket_error((etcpal_error_t)recv_res);
+        handle_llrp_datagram((llrp_socket_t)data.int_val, &msg, (size_t)recv_res);
       }
-    }
-    else if (msg.flags & ETCPAL_MSG_TRUNC)
-    {
-      // No LLRP packets should be bigger than LLRP_MAX_MESSAGE_SIZE.
-      llrp_socket_error(kEtcPalErrProtocol);
-    }
-    else
-    {
-      EtcPalMcastNetintId netint_id;
-      if (!(msg.flags & ETCPAL_MSG_CTRUNC) && get_netint_id(&msg, &netint_id))
+      else if (recv_res == kEtcPalErrWouldBlock)
       {
-        if ((llrp_socket_t)data.int_val == kLlrpSocketTypeManager)
-          rc_llrp_manager_data_received(llrp_recv_buf, (size_t)recv_res, &netint_id);
-        else
-          rc_llrp_target_data_received(llrp_recv_buf, (size_t)recv_res, &netint_id);
+        // The socket has been drained.
+        break;
       }
-      else
+      else if (recv_res < 0 && recv_res != kEtcPalErrMsgSize)
       {
-        char addr_str[ETCPAL_IP_STRING_BYTES];
-        etcpal_ip_to_string(&msg.name.ip, addr_str);
-        RDMNET_LOG_WARNING(
-            "Couldn't receive LLRP message from %s:%u because the network interface couldn't be determined.", addr_str,
-            msg.name.port);
+        llrp_socket_error((etcpal_error_t)recv_res);
+        break;
       }
+      // Otherwise an empty or oversized datagram was discarded; keep draining.
     }
   }
 }
 
+void handle_llrp_datagram(llrp_socket_t llrp_type, EtcPalMsgHdr* msg, size_t data_len)
+{
+  if (msg->flags & ETCPAL_MSG_TRUNC)
+  {
+    // No LLRP packets should be bigger than LLRP_MAX_MESSAGE_SIZE.
+    llrp_socket_error(kEtcPalErrProtocol);
+    return;
+  }
+
+  EtcPalMcastNetintId netint_id;
+  if (!(msg->flags & ETCPAL_MSG_CTRUNC) && get_netint_id(msg, &netint_id))
+  {
+    if (llrp_type == kLlrpSocketTypeManager)
+      rc_llrp_manager_data_received(msg->buf, data_len, &netint_id);
+    else
+      rc_llrp_target_data_received(msg->buf, data_len, &netint_id);
+  }
+  else
+  {
+    char addr_str[ETCPAL_IP_STRING_BYTES];
+    etcpal_ip_to_string(&msg->name.ip, addr_str);
+    RDMNET_LOG_WARNING(
+        "Couldn't receive LLRP message from %s:%u because the network interface couldn't be determined.", addr_str,
+        msg->name.port);
+  }
+}
+
 void llrp_socket_error(etcpal_error_t err)
 {
   RDMNET_LOG_WARNING("Error receiving on an LLRP socket: '%s'", etcpal_strerror(err));
@@ -19,6 +19,8 @@
 
 #include "rdmnet/core/llrp_manager.h"
 
+#include <stdlib.h>
+#include <string.h>
 #include "etcpal/common.h"
 #include "etcpal/inet.h"
 #include "rdm/uid.h"
@@ -70,6 +72,13 @@ typedef struct RCLlrpManagerKeys
 
 /***************************** Private macros ********************************/
 
+// A range is finished once this many consecutive probes of it have discovered no new targets.
+#define PROBE_RANGE_CLEAN_SENDS_TO_FINISH 3
+// A range in which at least this many new targets reply to a single probe is split in two, so that
+// the halves are probed concurrently with shorter Known UID lists.
+#define PROBE_RANGE_SPLIT_THRESHOLD (LLRP_KNOWN_UID_SIZE / 4)
+#define INITIAL_PROBE_RANGES_CAPACITY 8
+
 #define MANAGER_LOCK(mgr_ptr) (RDMNET_ASSERT_VERIFY(mgr_ptr) && etcpal_mutex_lock((mgr_ptr)->lock))
 #define MANAGER_UNLOCK(mgr_ptr)           \
   if (RDMNET_ASSERT_VERIFY(mgr_ptr))      \
@@ -90,8 +99,18 @@ static void           cleanup_manager_resources(RCLlrpManager* manager, const vo
 
 // Periodic state processing
 static void process_manager_state(RCLlrpManager* manager, const void* context);
-static bool send_next_probe(RCLlrpManager* manager);
-static bool update_probe_range(RCLlrpManager* manager);
+
+// Discovery
+static bool process_discovery(RCLlrpManager* manager);
+static bool send_probe(RCLlrpManager* manager, RCLlrpProbeRange* range);
+static void init_probe_range(RCLlrpProbeRange* range, const RdmUid* low, const RdmUid* high);
+static void remove_probe_range(RCLlrpManager* manager, size_t index);
+static bool split_probe_range(RCLlrpManager* manager, size_t index);
+static void narrow_probe_range(RCLlrpProbeRange* range);
+static void resume_probe_range(RCLlrpManager* manager, RCLlrpProbeRange* range);
+static bool find_probe_range(const RCLlrpManager* manager, const RdmUid* uid, size_t* index);
+static void add_known_uid(RCLlrpManager* manager, const RdmUid* uid);
+static void count_new_reply(RCLlrpManager* manager, const RdmUid* uid);
 
 // Incoming message handling
 static void handle_llrp_message(RCLlrpManager* manager, const LlrpMessage* msg, RCLlrpManagerEvent* event);
@@ -103,6 +122,8 @@ static void           discovered_target_node_dealloc(EtcPalRbNode* node);
 static int            discovered_target_compare(const EtcPalRbTree* self, const void* value_a, const void* value_b);
 static void           discovered_target_clear_cb(const EtcPalRbTree* self, EtcPalRbNode* node);
 static RCLlrpManager* find_manager_by_message_keys(const RCRefList* list, const RCLlrpManagerKeys* keys);
+static int            uid_compare(const void* a, const void* b);
+static RdmUid         uid_after(const RdmUid* uid);
 
 /*************************** Function definitions ****************************/
 
@@ -127,22 +148,29 @@ etcpal_error_t rc_llrp_manager_register(RCLlrpManager* manager)
   if (!rc_initialized())
     return kEtcPalErrNotInit;
 
+  if (!RC_INIT_BUF(manager, RCLlrpProbeRange, probe_ranges, INITIAL_PROBE_RANGES_CAPACITY,
+                   RDMNET_LLRP_MANAGER_MAX_PROBE_RANGES))
+  {
+    return kEtcPalErrNoMem;
+  }
+
   if (!rc_ref_list_add_ref(&managers.pending, manager))
+  {
+    RC_DEINIT_BUF(manager, probe_ranges);
     return kEtcPalErrNoMem;
+  }
 
   etcpal_error_t res = get_manager_sockets(manager);
   if (res != kEtcPalErrOk)
   {
     rc_ref_list_remove_ref(&managers.pending, manager);
+    RC_DEINIT_BUF(manager, probe_ranges);
     return res;
   }
 
   manager->transaction_number = 0;
   manager->discovery_active = false;
-  manager->target_discovered_since_last_probe = false;
-  manager->num_clean_sends = 0;
   manager->disc_filter = 0;
-  manager->num_known_uids = 0;
   etcpal_rbtree_init(&manager->discovered_targets, discovered_target_compare, discovered_target_node_alloc,
                      discovered_target_node_dealloc);
   return kEtcPalErrOk;
@@ -163,20 +191,22 @@ etcpal_error_t rc_llrp_manager_start_discovery(RCLlrpManager* manager, uint16_t
 
   if (!manager->discovery_active)
   {
-    manager->cur_range_low.manu = 0;
-    manager->cur_range_low.id = 0;
-    manager->cur_range_high = kRdmBroadcastUid;
-    manager->target_discovered_since_last_probe = false;
-    manager->num_clean_sends = 0;
+    // Discovery starts with a single range covering the entire UID space, which is split up as
+    // targets are discovered.
+    const RdmUid lowest_uid = {0, 0};
+    init_probe_range(&manager->probe_ranges[0], &lowest_uid, &kRdmBroadcastUid);
+    manager->num_probe_ranges = 1;
+    manager->next_probe_range = 0;
     manager->discovery_active = true;
     manager->disc_filter = filter;
 
-    if (send_next_probe(manager))
+    if (send_probe(manager, &manager->probe_ranges[0]))
     {
       return kEtcPalErrOk;
     }
     else
     {
+      manager->num_probe_ranges = 0;
       manager->discovery_active = false;
       return kEtcPalErrSys;
     }
@@ -195,6 +225,7 @@ etcpal_error_t rc_llrp_manager_stop_discovery(RCLlrpManager* manager)
   if (manager->discovery_active)
   {
     etcpal_rbtree_clear_with_cb(&manager->discovered_targets, discovered_target_clear_cb);
+    manager->num_probe_ranges = 0;
     manager->discovery_active = false;
     return kEtcPalErrOk;
   }
@@ -330,6 +361,7 @@ void cleanup_manager_resources(RCLlrpManager* manager, const void* context)
   {
     etcpal_rbtree_clear_with_cb(&manager->discovered_targets, discovered_target_clear_cb);
   }
+  RC_DEINIT_BUF(manager, probe_ranges);
   if (manager->callbacks.destroyed)
     manager->callbacks.destroyed(manager);
 }
@@ -345,133 +377,305 @@ void process_manager_state(RCLlrpManager* manager, const void* context)
   {
     RCLlrpManagerEvent event = RC_LLRP_MANAGER_EVENT_INIT;
 
-    if (manager->discovery_active)
+    if (manager->discovery_active && !process_discovery(manager))
     {
-      if (etcpal_timer_is_expired(&manager->disc_timer))
-      {
-        if (manager->target_discovered_since_last_probe)
-        {
-          manager->target_discovered_since_last_probe = false;
-          manager->num_clean_sends = 0;
-        }
-        else
-        {
-          ++manager->num_clean_sends;
-        }
-
-        if (!send_next_probe(manager))
-        {
-          event.which = kRCLlrpManagerEventDiscoveryFinished;
-          etcpal_rbtree_clear_with_cb(&manager->discovered_targets, discovered_target_clear_cb);
-          manager->discovery_active = false;
-        }
-      }
+      event.which = kRCLlrpManagerEventDiscoveryFinished;
+      etcpal_rbtree_clear_with_cb(&manager->discovered_targets, discovered_target_clear_cb);
+      manager->num_probe_ranges = 0;
+      manager->discovery_active = false;
     }
     MANAGER_UNLOCK(manager);
     deliver_event_callback(manager, &event);
   }
 }
 
-bool send_next_probe(RCLlrpManager* manager)
+/*
+ * Advance LLRP discovery. Each probe range is probed, and once LLRP_TIMEOUT_MS has passed, the
+ * result is recorded; ranges are finished after PROBE_RANGE_CLEAN_SENDS_TO_FINISH consecutive
+ * probes discover nothing new, or move on to the part of the UID space they deferred if they were
+ * narrowed. Ranges are independent, so up to
+ * RDMNET_LLRP_MANAGER_MAX_PROBES_IN_FLIGHT of them are probed at the same time.
+ *
+ * Returns false when discovery is finished.
+ */
+bool process_discovery(RCLlrpManager* manager)
 {
-  if (!RDMNET_ASSERT_VERIFY(manager) || !RDMNET_ASSERT_VERIFY(kLlrpBroadcastCid))
+  if (!RDMNET_ASSERT_VERIFY(manager))
     return false;
 
-  if (update_probe_range(manager))
+  size_t num_in_flight = 0;
+
+  // Iterate backwards so that finished ranges can be removed, and split ranges inserted, without
+  // revisiting any range.
+  for (size_t i = manager->num_probe_ranges; i > 0; --i)
   {
-    LlrpHeader header;
-    header.sender_cid = manager->cid;
-    header.dest_cid = *kLlrpBroadcastCid;
-    header.transaction_number = manager->transaction_number++;
-
-    LocalProbeRequest request;
-    request.filter = manager->disc_filter;
-    request.lower_uid = manager->cur_range_low;
-    request.upper_uid = manager->cur_range_high;
-    request.known_uids = manager->known_uids;
-    request.num_known_uids = manager->num_known_uids;
-
-    etcpal_error_t send_res = rc_send_llrp_probe_request(
-        manager->send_sock, manager->send_buf, (manager->netint.ip_type == kEtcPalIpTypeV6), &header, &request);
-    if (send_res == kEtcPalErrOk)
+    RCLlrpProbeRange* range = &manager->probe_ranges[i - 1];
+    if (!range->probe_outstanding)
+      continue;
+
+    if (!etcpal_timer_is_expired(&range->probe_timer))
     {
-      etcpal_timer_start(&manager->disc_timer, LLRP_TIMEOUT_MS);
-      return true;
+      ++num_in_flight;
+      continue;
+    }
+
+    range->probe_outstanding = false;
+    if (range->num_new_replies == 0)
+    {
+      if (++range->num_clean_sends >= PROBE_RANGE_CLEAN_SENDS_TO_FINISH)
+      {
+        if (range->narrowed)
+          resume_probe_range(manager, range);
+        else
+          remove_probe_range(manager, i - 1);
+      }
     }
     else
     {
-      RDMNET_LOG_WARNING("Sending LLRP probe request failed with error: '%s'", etcpal_strerror(send_res));
-      return false;
+      bool split = (range->num_new_replies >= PROBE_RANGE_SPLIT_THRESHOLD);
+      range->num_clean_sends = 0;
+      range->num_new_replies = 0;
+      if (split)
+        split_probe_range(manager, i - 1);
+    }
+  }
+
+  // Send probes for waiting ranges. When there are more than the in-flight limit, start where the
+  // last pass left off so that no range is starved.
+  size_t num_ranges = manager->num_probe_ranges;
+  for (size_t n = 0; n < num_ranges && num_in_flight < RDMNET_LLRP_MANAGER_MAX_PROBES_IN_FLIGHT; ++n)
+  {
+    size_t            index = (manager->next_probe_range + n) % num_ranges;
+    RCLlrpProbeRange* range = &manager->probe_ranges[index];
+    if (!range->probe_outstanding)
+    {
+      if (!send_probe(manager, range))
+        return false;
+      ++num_in_flight;
+      manager->next_probe_range = index + 1;
     }
   }
+
+  return (manager->num_probe_ranges != 0);
+}
+
+bool send_probe(RCLlrpManager* manager, RCLlrpProbeRange* range)
+{
+  if (!RDMNET_ASSERT_VERIFY(manager) || !RDMNET_ASSERT_VERIFY(range) || !RDMNET_ASSERT_VERIFY(kLlrpBroadcastCid))
+    return false;
+
+  LlrpHeader header;
+  header.sender_cid = manager->cid;
+  header.dest_cid = *kLlrpBroadcastCid;
+  header.transaction_number = manager->transaction_number++;
+
+  LocalProbeRequest request;
+  request.filter = manager->disc_filter;
+  request.lower_uid = range->low;
+  request.upper_uid = range->high;
+  request.known_uids = range->known_uids;
+  request.num_known_uids = range->num_known_uids;
+
+  etcpal_error_t send_res = rc_send_llrp_probe_request(
+      manager->send_sock, manager->send_buf, (manager->netint.ip_type == kEtcPalIpTypeV6), &header, &request);
+  if (send_res == kEtcPalErrOk)
+  {
+    range->probe_outstanding = true;
+    etcpal_timer_start(&range->probe_timer, LLRP_TIMEOUT_MS);
+    return true;
+  }
   else
   {
-    // We are done with discovery.
+    RDMNET_LOG_WARNING("Sending LLRP probe request failed with error: '%s'", etcpal_strerror(send_res));
     return false;
   }
 }
 
-bool update_probe_range(RCLlrpManager* manager)
+void init_probe_range(RCLlrpProbeRange* range, const RdmUid* low, const RdmUid* high)
 {
-  if (!RDMNET_ASSERT_VERIFY(manager))
+  if (!RDMNET_ASSERT_VERIFY(range) || !RDMNET_ASSERT_VERIFY(low) || !RDMNET_ASSERT_VERIFY(high))
+    return;
+
+  range->low = *low;
+  range->high = *high;
+  range->probe_outstanding = false;
+  range->num_clean_sends = 0;
+  range->num_new_replies = 0;
+  range->num_known_uids = 0;
+  range->narrowed = false;
+}
+
+void remove_probe_range(RCLlrpManager* manager, size_t index)
+{
+  if (!RDMNET_ASSERT_VERIFY(manager) || !RDMNET_ASSERT_VERIFY(index < manager->num_probe_ranges))
+    return;
+
+  if (index + 1 < manager->num_probe_ranges)
+  {
+    memmove(&manager->probe_ranges[index], &manager->probe_ranges[index + 1],
+            (manager->num_probe_ranges - index - 1) * sizeof(RCLlrpProbeRange));
+  }
+  --manager->num_probe_ranges;
+}
+
+/*
+ * Split a probe range in two at the median of its Known UIDs, so that each half has half of the
+ * Known UID list. The new upper half is inserted directly after the lower half and inherits its
+ * probe state. Returns false if the range can't be split or there is no room for another range.
+ */
+bool split_probe_range(RCLlrpManager* manager, size_t index)
+{
+  if (!RDMNET_ASSERT_VERIFY(manager) || !RDMNET_ASSERT_VERIFY(index < manager->num_probe_ranges))
     return false;
 
-  if (manager->num_clean_sends >= 3)
+  if (manager->probe_ranges[index].num_known_uids < 2 ||
+      !RC_CHECK_BUF_CAPACITY(manager, RCLlrpProbeRange, probe_ranges, RDMNET_LLRP_MANAGER_MAX_PROBE_RANGES, 1))
   {
-    // We are finished with a range; move on to the next range.
-    if (RDM_UID_IS_BROADCAST(&manager->cur_range_high))
-    {
-      // We're done with discovery.
-      return false;
-    }
-    else
-    {
-      // The new range starts at the old upper limit + 1, and ends at the top of the UID space.
-      if (manager->cur_range_high.id == 0xffffffffu)
-      {
-        manager->cur_range_low.manu = (uint16_t)(manager->cur_range_high.manu + 1u);
-        manager->cur_range_low.id = 0;
-      }
-      else
-      {
-        manager->cur_range_low.manu = manager->cur_range_high.manu;
-        manager->cur_range_low.id = (uint32_t)(manager->cur_range_high.id + 1u);
-      }
-      manager->cur_range_high = kRdmBroadcastUid;
-      manager->num_clean_sends = 0;
-    }
+    return false;
+  }
+
+  if (index + 1 < manager->num_probe_ranges)
+  {
+    memmove(&manager->probe_ranges[index + 2], &manager->probe_ranges[index + 1],
+            (manager->num_probe_ranges - index - 1) * sizeof(RCLlrpProbeRange));
   }
+  ++manager->num_probe_ranges;
 
-  // Determine how many known UIDs are in the current range
-  manager->num_known_uids = 0;
+  RCLlrpProbeRange* lower = &manager->probe_ranges[index];
+  RCLlrpProbeRange* upper = &manager->probe_ranges[index + 1];
+  qsort(lower->known_uids, lower->num_known_uids, sizeof(RdmUid), uid_compare);
+  *upper = *lower;
+
+  size_t num_lower_uids = lower->num_known_uids / 2;
+  lower->high = lower->known_uids[num_lower_uids - 1];
+  lower->num_known_uids = num_lower_uids;
+  lower->narrowed = false;  // Any deferred part of the range now belongs to the upper half.
+
+  upper->low = uid_after(&lower->high);
+  upper->num_known_uids -= num_lower_uids;
+  memmove(upper->known_uids, &upper->known_uids[num_lower_uids], upper->num_known_uids * sizeof(RdmUid));
+  return true;
+}
+
+/*
+ * Used when a probe range's Known UID list is full but the range can't be split. Shrinks the range
+ * to the lower half of its Known UIDs; the rest of it is deferred until the narrowed range is
+ * finished.
+ */
+void narrow_probe_range(RCLlrpProbeRange* range)
+{
+  if (!RDMNET_ASSERT_VERIFY(range) || !RDMNET_ASSERT_VERIFY(range->num_known_uids >= 2))
+    return;
+
+  qsort(range->known_uids, range->num_known_uids, sizeof(RdmUid), uid_compare);
+  if (!range->narrowed)
+  {
+    range->deferred_high = range->high;
+    range->narrowed = true;
+  }
+  range->num_known_uids /= 2;
+  range->high = range->known_uids[range->num_known_uids - 1];
+}
+
+/*
+ * Restart a finished, narrowed probe range on the part of the UID space it deferred. Targets there
+ * that have already been discovered are added to its Known UID list, narrowing it again if they
+ * don't all fit.
+ */
+void resume_probe_range(RCLlrpManager* manager, RCLlrpProbeRange* range)
+{
+  if (!RDMNET_ASSERT_VERIFY(manager) || !RDMNET_ASSERT_VERIFY(range) || !RDMNET_ASSERT_VERIFY(range->narrowed))
+    return;
+
+  RdmUid low = uid_after(&range->high);
+  RdmUid high = range->deferred_high;
+  init_probe_range(range, &low, &high);
 
   EtcPalRbIter iter;
   etcpal_rbiter_init(&iter);
-  DiscoveredTargetInternal* cur_target =
-      (DiscoveredTargetInternal*)etcpal_rbiter_first(&iter, &manager->discovered_targets);
-  while (cur_target && (rdm_uid_compare(&cur_target->uid, &manager->cur_range_high) <= 0))
+  for (const DiscoveredTargetInternal* target = etcpal_rbiter_first(&iter, &manager->discovered_targets); target;
+       target = etcpal_rbiter_next(&iter))
+  {
+    // The tree is sorted by UID.
+    if (rdm_uid_compare(&target->uid, &range->low) < 0)
+      continue;
+
+    if (range->num_known_uids >= LLRP_KNOWN_UID_SIZE)
+      narrow_probe_range(range);
+    if (rdm_uid_compare(&target->uid, &range->high) > 0)
+      break;
+
+    range->known_uids[range->num_known_uids++] = target->uid;
+  }
+}
+
+/*
+ * Find the probe range that contains a UID. The ranges are disjoint and sorted, so this is a binary
+ * search.
+ */
+bool find_probe_range(const RCLlrpManager* manager, const RdmUid* uid, size_t* index)
+{
+  if (!RDMNET_ASSERT_VERIFY(manager) || !RDMNET_ASSERT_VERIFY(uid) || !RDMNET_ASSERT_VERIFY(index))
+    return false;
+
+  size_t low = 0;
+  size_t high = manager->num_probe_ranges;
+  while (low < high)
   {
-    if (manager->num_known_uids != 0)
+    size_t                  mid = low + (high - low) / 2;
+    const RCLlrpProbeRange* range = &manager->probe_ranges[mid];
+    if (rdm_uid_compare(uid, &range->low) < 0)
     {
-      if (manager->num_known_uids + 1 <= LLRP_KNOWN_UID_SIZE)
-      {
-        manager->known_uids[manager->num_known_uids++] = cur_target->uid;
-      }
-      else
-      {
-        // Put the high point of the current range in the middle of the list of Known UIDs.
-        manager->cur_range_high = manager->known_uids[(LLRP_KNOWN_UID_SIZE / 2) - 1];
-        manager->num_known_uids = LLRP_KNOWN_UID_SIZE / 2;
-        break;
-      }
+      high = mid;
     }
-    else if (rdm_uid_compare(&cur_target->uid, &manager->cur_range_low) >= 0)
+    else if (rdm_uid_compare(uid, &range->high) > 0)
     {
-      manager->known_uids[manager->num_known_uids++] = cur_target->uid;
+      low = mid + 1;
+    }
+    else
+    {
+      *index = mid;
+      return true;
     }
-    cur_target = (DiscoveredTargetInternal*)etcpal_rbiter_next(&iter);
   }
-  return true;
+  return false;
+}
+
+/*
+ * Add a newly-discovered UID to the Known UID list of the range it falls in, first splitting the
+ * range if its list is full, or narrowing it if there is no room for another range.
+ */
+void add_known_uid(RCLlrpManager* manager, const RdmUid* uid)
+{
+  if (!RDMNET_ASSERT_VERIFY(manager) || !RDMNET_ASSERT_VERIFY(uid))
+    return;
+
+  size_t index;
+  if (!find_probe_range(manager, uid, &index))
+    return;  // The range has already finished.
+
+  if (manager->probe_ranges[index].num_known_uids >= LLRP_KNOWN_UID_SIZE)
+  {
+    if (!split_probe_range(manager, index))
+      narrow_probe_range(&manager->probe_ranges[index]);
+
+    // If the UID is now in a deferred part of the range, it will be added when that part is probed.
+    if (!find_probe_range(manager, uid, &index))
+      return;
+  }
+
+  RCLlrpProbeRange* range = &manager->probe_ranges[index];
+  range->known_uids[range->num_known_uids++] = *uid;
+}
+
+void count_new_reply(RCLlrpManager* manager, const RdmUid* uid)
+{
+  if (!RDMNET_ASSERT_VERIFY(manager) || !RDMNET_ASSERT_VERIFY(uid))
+    return;
+
+  size_t index;
+  if (find_probe_range(manager, uid, &index))
+    ++manager->probe_ranges[index].num_new_replies;
 }
 
 void handle_llrp_message(RCLlrpManager* manager, const LlrpMessage* msg, RCLlrpManagerEvent* event)
@@ -536,13 +740,14 @@ void handle_llrp_message(RCLlrpManager* manager, const LlrpMessage* msg, RCLlrpM
             {
               // Newly discovered Target with a new UID.
               etcpal_rbtree_insert(&manager->discovered_targets, new_target);
+              add_known_uid(manager, &new_target->uid);
             }
 
             if (new_target)
             {
               event->which = kRCLlrpManagerEventTargetDiscovered;
               event->args.discovered_target = &msg->data.probe_reply;
-              manager->target_discovered_since_last_probe = true;
+              count_new_reply(manager, &new_target->uid);
             }
           }
         }
@@ -665,3 +870,24 @@ RCLlrpManager* find_manager_by_message_keys(const RCRefList* list, const RCLlrpM
 
   return (RCLlrpManager*)rc_ref_list_find_ref(list, cid_and_netint_equal_predicate, keys);
 }
+
+int uid_compare(const void* a, const void* b)
+{
+  return rdm_uid_compare((const RdmUid*)a, (const RdmUid*)b);
+}
+
+RdmUid uid_after(const RdmUid* uid)
+{
+  RdmUid next;
+  if (uid->id == 0xffffffffu)
+  {
+    next.manu = (uint16_t)(uid->manu + 1u);
+    next.id = 0;
+  }
+  else
+  {
+    next.manu = uid->manu;
+    next.id = uid->id + 1u;
+  }
+  return next;
+}
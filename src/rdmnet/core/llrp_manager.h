@@ -29,6 +29,8 @@
 #include "rdmnet/llrp.h"
 #include "rdmnet/message.h"
 #include "rdmnet/core/llrp_prot.h"
+#include "rdmnet/core/opts.h"
+#include "rdmnet/core/util.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -49,6 +51,25 @@ typedef void (*RCLlrpManagerDiscoveryFinishedCallback)(RCLlrpManager* manager);
 // after the resources associated with the LLRP manager (e.g. sockets) have been cleaned up.
 typedef void (*RCLlrpManagerDestroyedCallback)(RCLlrpManager* manager);
 
+// A range of the UID space which is probed independently during LLRP discovery.
+typedef struct RCLlrpProbeRange
+{
+  RdmUid       low;
+  RdmUid       high;
+  bool         probe_outstanding;
+  EtcPalTimer  probe_timer;
+  unsigned int num_clean_sends;
+  size_t       num_new_replies;  // Targets newly discovered in this range since it was last probed
+  // Targets already discovered in this range, which are told not to reply again. Appended to as
+  // targets are discovered.
+  RdmUid known_uids[LLRP_KNOWN_UID_SIZE];
+  size_t num_known_uids;
+  // Set when the Known UID list filled up and the range couldn't be split. The range was shrunk,
+  // and the UIDs above high up to deferred_high are probed once it finishes.
+  bool   narrowed;
+  RdmUid deferred_high;
+} RCLlrpProbeRange;
+
 typedef struct RCLlrpManagerCallbacks
 {
   RCLlrpManagerTargetDiscoveredCallback    target_discovered;
@@ -76,15 +97,11 @@ struct RCLlrpManager
 
   // Discovery tracking
   bool         discovery_active;
-  bool         target_discovered_since_last_probe;
-  unsigned int num_clean_sends;
-  EtcPalTimer  disc_timer;
   uint16_t     disc_filter;
   EtcPalRbTree discovered_targets;
-  RdmUid       cur_range_low;
-  RdmUid       cur_range_high;
-  RdmUid       known_uids[LLRP_KNOWN_UID_SIZE];
-  size_t       num_known_uids;
+  // Disjoint UID ranges that are still being probed, sorted by UID.
+  RC_DECLARE_BUF(RCLlrpProbeRange, probe_ranges, RDMNET_LLRP_MANAGER_MAX_PROBE_RANGES);
+  size_t next_probe_range;
 };
 
 etcpal_error_t rc_llrp_manager_module_init(void);
@@ -193,48 +193,63 @@ bool parse_llrp_probe_request(const uint8_t*             buf,
   if (vector != VECTOR_PROBE_REQUEST_DATA)
     return false;
 
-  RdmUid lower_uid_bound;
-  lower_uid_bound.manu = etcpal_unpack_u16b(cur_ptr);
+  request->lower_uid.manu = etcpal_unpack_u16b(cur_ptr);
   cur_ptr += 2;
-  lower_uid_bound.id = etcpal_unpack_u32b(cur_ptr);
+  request->lower_uid.id = etcpal_unpack_u32b(cur_ptr);
   cur_ptr += 4;
-
-  RdmUid upper_uid_bound;
-  upper_uid_bound.manu = etcpal_unpack_u16b(cur_ptr);
+  request->upper_uid.manu = etcpal_unpack_u16b(cur_ptr);
   cur_ptr += 2;
-  upper_uid_bound.id = etcpal_unpack_u32b(cur_ptr);
+  request->upper_uid.id = etcpal_unpack_u32b(cur_ptr);
   cur_ptr += 4;
   request->filter = etcpal_unpack_u16b(cur_ptr);
   cur_ptr += 2;
 
-  // If our UID is not in the range, there is no need to check the Known UIDs.
-  if (rdm_uid_compare(&interest->my_uid, &lower_uid_bound) >= 0 &&
-      rdm_uid_compare(&interest->my_uid, &upper_uid_bound) <= 0)
-  {
-    request->contains_my_uid = true;
+  // The Known UIDs are left packed; they are only unpacked when checking a UID that is in range.
+  request->known_uids = cur_ptr;
+  request->num_known_uids = (size_t)(buf_end - cur_ptr) / 6;
 
-    // Check the Known UIDs to see if the registered UID is in it.
-    while (cur_ptr + 6 <= buf_end)
-    {
-      RdmUid cur_uid;
-      cur_uid.manu = etcpal_unpack_u16b(cur_ptr);
-      cur_ptr += 2;
-      cur_uid.id = etcpal_unpack_u32b(cur_ptr);
-      cur_ptr += 4;
-
-      if (RDM_UID_EQUAL(&interest->my_uid, &cur_uid))
-      {
-        // The registered uid is suppressed.
-        request->contains_my_uid = false;
-        break;
-      }
-    }
-  }
-  else
+  request->contains_my_uid = rc_llrp_probe_request_contains_uid(request, &interest->my_uid);
+  return true;
+}
+
+/*
+ * Get the Known UID at the given index of a parsed probe request. index must be less than
+ * request->num_known_uids.
+ */
+void rc_llrp_probe_request_get_known_uid(const RemoteProbeRequest* request, size_t index, RdmUid* uid)
+{
+  if (!RDMNET_ASSERT_VERIFY(request) || !RDMNET_ASSERT_VERIFY(request->known_uids) ||
+      !RDMNET_ASSERT_VERIFY(index < request->num_known_uids) || !RDMNET_ASSERT_VERIFY(uid))
   {
-    request->contains_my_uid = false;
+    return;
   }
 
+  const uint8_t* cur_ptr = &request->known_uids[index * 6];
+  uid->manu = etcpal_unpack_u16b(cur_ptr);
+  uid->id = etcpal_unpack_u32b(cur_ptr + 2);
+}
+
+/*
+ * Determine whether a UID is within the range of a parsed probe request and is not suppressed by
+ * its Known UID list.
+ */
+bool rc_llrp_probe_request_contains_uid(const RemoteProbeRequest* request, const RdmUid* uid)
+{
+  if (!RDMNET_ASSERT_VERIFY(request) || !RDMNET_ASSERT_VERIFY(uid))
+    return false;
+
+  // If the UID is not in the range, there is no need to check the Known UIDs.
+  if (rdm_uid_compare(uid, &request->lower_uid) < 0 || rdm_uid_compare(uid, &request->upper_uid) > 0)
+    return false;
+
+  // Check the Known UIDs to see if the UID is suppressed.
+  for (size_t i = 0; i < request->num_known_uids; ++i)
+  {
+    RdmUid known_uid;
+    rc_llrp_probe_request_get_known_uid(request, i, &known_uid);
+    if (RDM_UID_EQUAL(uid, &known_uid))
+      return false;
+  }
   return true;
 }
 
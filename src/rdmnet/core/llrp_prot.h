@@ -91,6 +91,12 @@ typedef struct RemoteProbeRequest
    * it is not suppressed by the Known UID list. */
   bool     contains_my_uid;
   uint16_t filter;
+  RdmUid   lower_uid;
+  RdmUid   upper_uid;
+  /* The Known UID list, still in packed form. Points into the buffer that was parsed, and is only
+   * valid as long as that buffer is. Use rc_llrp_probe_request_get_known_uid() to access it. */
+  const uint8_t* known_uids;
+  size_t         num_known_uids;
 } RemoteProbeRequest;
 
 typedef struct LocalProbeRequest
@@ -127,6 +133,8 @@ extern const EtcPalUuid* kLlrpBroadcastCid;
 
 bool rc_get_llrp_destination_cid(const uint8_t* buf, size_t buflen, EtcPalUuid* dest_cid);
 bool rc_parse_llrp_message(const uint8_t* buf, size_t buflen, const LlrpMessageInterest* interest, LlrpMessage* msg);
+void rc_llrp_probe_request_get_known_uid(const RemoteProbeRequest* request, size_t index, RdmUid* uid);
+bool rc_llrp_probe_request_contains_uid(const RemoteProbeRequest* request, const RdmUid* uid);
 
 etcpal_error_t rc_send_llrp_probe_request(etcpal_socket_t          sock,
                                           uint8_t*                 buf,
@@ -19,6 +19,8 @@
 
 #include "rdmnet/core/llrp_target.h"
 
+#include <stdlib.h>
+#include <string.h>
 #include "etcpal/inet.h"
 #include "rdm/responder.h"
 #include "rdmnet/core/common.h"
@@ -44,12 +46,24 @@ typedef struct RCLlrpTargetEvent
     kRCLlrpTargetEventNone        \
   }
 
-typedef struct LlrpTargetIncomingMessage
+/*
+ * Indexes of the active target list, rebuilt each time it changes. A received LLRP message is
+ * parsed once and dispatched using these, instead of being parsed separately by each target.
+ */
+typedef struct TargetIndex
 {
-  const uint8_t*             data;
-  size_t                     data_len;
-  const EtcPalMcastNetintId* netint;
-} LlrpTargetIncomingMessage;
+#if RDMNET_DYNAMIC_MEM
+  RCLlrpTarget** by_cid;
+  RCLlrpTarget** by_uid;
+  bool*          probe_suppressed;  // Scratch space parallel to by_uid
+  size_t         capacity;
+#else
+  RCLlrpTarget* by_cid[RC_MAX_LLRP_TARGETS];
+  RCLlrpTarget* by_uid[RC_MAX_LLRP_TARGETS];
+  bool          probe_suppressed[RC_MAX_LLRP_TARGETS];
+#endif
+  size_t num_targets;
+} TargetIndex;
 
 /***************************** Private macros ********************************/
 
@@ -63,6 +77,7 @@ typedef struct LlrpTargetIncomingMessage
 /**************************** Private variables ******************************/
 
 RC_DECLARE_REF_LISTS(targets, RC_MAX_LLRP_TARGETS);
+static TargetIndex target_index;
 
 /*********************** Private function prototypes *************************/
 
@@ -76,8 +91,24 @@ static void                    cleanup_target_resources(RCLlrpTarget* target, co
 // Periodic state processing
 static void process_target_state(RCLlrpTarget* target, const void* context);
 
+// Target indexing
+static bool          rebuild_target_index(void);
+static void          cleanup_target_index(void);
+static int           compare_targets_by_cid(const void* a, const void* b);
+static int           compare_targets_by_uid(const void* a, const void* b);
+static RCLlrpTarget* find_target_by_cid(const EtcPalUuid* cid);
+static size_t        first_target_with_uid_not_less_than(const RdmUid* uid, size_t begin, size_t end);
+static size_t        first_target_with_uid_greater_than(const RdmUid* uid, size_t begin, size_t end);
+
 // Incoming message handling
-static void           target_handle_llrp_message(RCLlrpTarget* target, const LlrpTargetIncomingMessage* message);
+static void           handle_broadcast_probe_request(const LlrpMessage* msg, const EtcPalMcastNetintId* netint);
+static void           target_handle_probe_request(RCLlrpTarget*              target,
+                                                  const LlrpHeader*          header,
+                                                  uint16_t                   filter,
+                                                  const EtcPalMcastNetintId* netint);
+static void           target_handle_rdm_command(RCLlrpTarget*              target,
+                                                const LlrpRdmCommand*      cmd,
+                                                const EtcPalMcastNetintId* netint);
 static void           deliver_event_callback(RCLlrpTarget* target, RCLlrpTargetEvent* event);
 static void           send_response_if_requested(RCLlrpTarget*                target,
                                                  const RCLlrpTargetEvent*     event,
@@ -97,10 +128,9 @@ static etcpal_error_t target_send_nack_internal(RCLlrpTarget*              targe
                                                 rdm_nack_reason_t          nack_reason);
 
 // Utilities
-static RCLlrpTarget* find_target_by_cid(const RCRefList* list, const EtcPalUuid* cid);
-static int           netint_id_index_in_llrp_array(const EtcPalMcastNetintId*    id,
-                                                   const RCLlrpTargetNetintInfo* array,
-                                                   size_t                        array_size);
+static int netint_id_index_in_llrp_array(const EtcPalMcastNetintId*    id,
+                                         const RCLlrpTargetNetintInfo* array,
+                                         size_t                        array_size);
 
 /*************************** Function definitions ****************************/
 
@@ -124,6 +154,7 @@ void rc_llrp_target_module_deinit(void)
 {
   rc_ref_lists_remove_all(&targets, (RCRefFunction)cleanup_target_resources, NULL);
   rc_ref_lists_cleanup(&targets);
+  cleanup_target_index();
 }
 
 /*
@@ -207,8 +238,13 @@ void rc_llrp_target_module_tick(void)
 {
   if (rdmnet_writelock())
   {
+    bool targets_changed = (targets.pending.num_refs != 0 || targets.to_remove.num_refs != 0);
     rc_ref_lists_remove_marked(&targets, (RCRefFunction)cleanup_target_resources, NULL);
     rc_ref_lists_add_pending(&targets);
+
+    // A failed rebuild leaves the index empty, so it is retried on the next tick.
+    if ((targets_changed || target_index.num_targets != targets.active.num_refs) && !rebuild_target_index())
+      RDMNET_LOG_ERR("Couldn't allocate memory to index LLRP targets; LLRP messages will be ignored.");
     rdmnet_writeunlock();
   }
 
@@ -221,36 +257,85 @@ void rc_llrp_target_data_received(const uint8_t* data, size_t data_len, const Et
     return;
 
   EtcPalUuid dest_cid;
-  if (rc_get_llrp_destination_cid(data, data_len, &dest_cid))
-  {
-    bool                      target_found = false;
-    LlrpTargetIncomingMessage msg;
-    msg.data = data;
-    msg.data_len = data_len;
-    msg.netint = netint;
+  if (!rc_get_llrp_destination_cid(data, data_len, &dest_cid))
+    return;
 
-    if (0 == ETCPAL_UUID_CMP(&dest_cid, kLlrpBroadcastCid))
-    {
-      // Broadcast LLRP message - handle with all targets
-      target_found = true;
-      rc_ref_list_for_each(&targets.active, (RCRefFunction)target_handle_llrp_message, &msg);
-    }
-    else
+  // A NULL target means the message is broadcast to all targets.
+  RCLlrpTarget* target = NULL;
+  if (0 != ETCPAL_UUID_CMP(&dest_cid, kLlrpBroadcastCid))
+  {
+    target = find_target_by_cid(&dest_cid);
+    if (!target)
     {
-      RCLlrpTarget* target = find_target_by_cid(&targets.active, &dest_cid);
-      if (target)
+      if (RDMNET_CAN_LOG(ETCPAL_LOG_DEBUG))
       {
-        target_found = true;
-        target_handle_llrp_message(target, &msg);
+        char cid_str[ETCPAL_UUID_STRING_BYTES];
+        etcpal_uuid_to_string(&dest_cid, cid_str);
+        RDMNET_LOG_DEBUG("Ignoring LLRP message addressed to unknown LLRP Target %s", cid_str);
       }
+      return;
     }
+  }
+  else if (target_index.num_targets == 0)
+  {
+    return;
+  }
 
-    if (!target_found && RDMNET_CAN_LOG(ETCPAL_LOG_DEBUG))
-    {
-      char cid_str[ETCPAL_UUID_STRING_BYTES];
-      etcpal_uuid_to_string(&dest_cid, cid_str);
-      RDMNET_LOG_DEBUG("Ignoring LLRP message addressed to unknown LLRP Target %s", cid_str);
+  // The message is parsed once, no matter how many targets it is addressed to. msg being static is
+  // a stack-saving optimization; this is only called from the tick thread.
+  static LlrpMessage msg;
+
+  LlrpMessageInterest interest;
+  interest.my_cid = dest_cid;
+  interest.interested_in_probe_reply = false;
+  interest.interested_in_probe_request = true;
+  if (target)
+  {
+    interest.my_uid = target->uid;
+  }
+  else
+  {
+    // Broadcast probe requests are checked against every target's UID below.
+    interest.my_uid.manu = 0;
+    interest.my_uid.id = 0;
+  }
+
+  if (!rc_parse_llrp_message(data, data_len, &interest, &msg))
+    return;
+
+  switch (msg.vector)
+  {
+    case VECTOR_LLRP_PROBE_REQUEST: {
+      const RemoteProbeRequest* request = LLRP_MSG_GET_PROBE_REQUEST(&msg);
+      if (!RDMNET_ASSERT_VERIFY(request))
+        return;
+
+      if (!target)
+        handle_broadcast_probe_request(&msg, netint);
+      else if (request->contains_my_uid)
+        target_handle_probe_request(target, &msg.header, request->filter, netint);
+      break;
     }
+    case VECTOR_LLRP_RDM_CMD: {
+      LlrpRdmCommand cmd;
+      if (kEtcPalErrOk != rdm_unpack_command(LLRP_MSG_GET_RDM(&msg), &cmd.rdm_header, &cmd.data, &cmd.data_len))
+        break;
+      cmd.source_cid = msg.header.sender_cid;
+      cmd.seq_num = msg.header.transaction_number;
+
+      if (target)
+      {
+        target_handle_rdm_command(target, &cmd, netint);
+      }
+      else
+      {
+        for (size_t i = 0; i < target_index.num_targets; ++i)
+          target_handle_rdm_command(target_index.by_cid[i], &cmd, netint);
+      }
+      break;
+    }
+    default:
+      break;
   }
 }
 
@@ -408,74 +493,99 @@ void process_target_state(RCLlrpTarget* target, const void* context)
   }
 }
 
-void target_handle_llrp_message(RCLlrpTarget* target, const LlrpTargetIncomingMessage* message)
+/*
+ * Evaluate a broadcast probe request against all targets in one pass. Targets are sorted by UID, so
+ * the probe range narrows them to a contiguous run, and each Known UID is looked up within that run
+ * rather than each target scanning the Known UID list.
+ */
+void handle_broadcast_probe_request(const LlrpMessage* msg, const EtcPalMcastNetintId* netint)
 {
-  if (!RDMNET_ASSERT_VERIFY(target) || !RDMNET_ASSERT_VERIFY(message))
+  if (!RDMNET_ASSERT_VERIFY(msg) || !RDMNET_ASSERT_VERIFY(netint))
     return;
 
-  if (TARGET_LOCK(target))
+  const RemoteProbeRequest* request = LLRP_MSG_GET_PROBE_REQUEST(msg);
+  if (!RDMNET_ASSERT_VERIFY(request))
+    return;
+
+  size_t begin = first_target_with_uid_not_less_than(&request->lower_uid, 0, target_index.num_targets);
+  size_t end = first_target_with_uid_greater_than(&request->upper_uid, begin, target_index.num_targets);
+  if (begin >= end)
+    return;
+
+  memset(&target_index.probe_suppressed[begin], 0, (end - begin) * sizeof(bool));
+  for (size_t i = 0; i < request->num_known_uids; ++i)
   {
-    RCLlrpTargetEvent event = RC_LLRP_TARGET_EVENT_INIT;
+    RdmUid known_uid;
+    rc_llrp_probe_request_get_known_uid(request, i, &known_uid);
 
-    RCLlrpTargetNetintInfo* target_netint = get_target_netint(target, message->netint);
-    if (target_netint)
+    // More than one target can share a UID, so mark every match.
+    for (size_t j = first_target_with_uid_not_less_than(&known_uid, begin, end);
+         j < end && RDM_UID_EQUAL(&target_index.by_uid[j]->uid, &known_uid); ++j)
     {
-      // msg being static is a stack-saving optimization. It's unlikely that the LLRP target code
-      // will become multithreaded, but if it does this will need to be revisited.
-      static LlrpMessage msg;
+      target_index.probe_suppressed[j] = true;
+    }
+  }
 
-      LlrpMessageInterest interest;
-      interest.my_cid = target->cid;
-      interest.interested_in_probe_reply = false;
-      interest.interested_in_probe_request = true;
-      interest.my_uid = target->uid;
+  for (size_t i = begin; i < end; ++i)
+  {
+    if (!target_index.probe_suppressed[i])
+      target_handle_probe_request(target_index.by_uid[i], &msg->header, request->filter, netint);
+  }
+}
 
-      if (rc_parse_llrp_message(message->data, message->data_len, &interest, &msg))
+/*
+ * Handle a probe request which has already been determined to contain the target's UID.
+ */
+void target_handle_probe_request(RCLlrpTarget*              target,
+                                 const LlrpHeader*          header,
+                                 uint16_t                   filter,
+                                 const EtcPalMcastNetintId* netint)
+{
+  if (!RDMNET_ASSERT_VERIFY(target) || !RDMNET_ASSERT_VERIFY(header) || !RDMNET_ASSERT_VERIFY(netint))
+    return;
+
+  if (TARGET_LOCK(target))
+  {
+    RCLlrpTargetNetintInfo* target_netint = get_target_netint(target, netint);
+
+    // TODO allow multiple probe replies to be queued
+    if (target_netint && !target_netint->reply_pending)
+    {
+      // Check the filter values.
+      if (!((filter & LLRP_FILTERVAL_BROKERS_ONLY) && target->component_type != kLlrpCompBroker) &&
+          !(filter & LLRP_FILTERVAL_CLIENT_CONN_INACTIVE && target->connected_to_broker))
       {
-        switch (msg.vector)
-        {
-          case VECTOR_LLRP_PROBE_REQUEST: {
-            const RemoteProbeRequest* request = LLRP_MSG_GET_PROBE_REQUEST(&msg);
-            if (!RDMNET_ASSERT_VERIFY(request))
-              return;
-
-            // TODO allow multiple probe replies to be queued
-            if (request->contains_my_uid && !target_netint->reply_pending)
-            {
-              uint32_t backoff_ms;
-
-              // Check the filter values.
-              if (!((request->filter & LLRP_FILTERVAL_BROKERS_ONLY) && target->component_type != kLlrpCompBroker) &&
-                  !(request->filter & LLRP_FILTERVAL_CLIENT_CONN_INACTIVE && target->connected_to_broker))
-              {
-                target_netint->reply_pending = true;
-                target_netint->pending_reply_cid = msg.header.sender_cid;
-                target_netint->pending_reply_trans_num = msg.header.transaction_number;
-                backoff_ms = (uint32_t)(rand() * LLRP_MAX_BACKOFF_MS / RAND_MAX);
-                etcpal_timer_start(&target_netint->reply_backoff, backoff_ms);
-              }
-            }
-            // Even if we got a valid probe request, we are starting a backoff timer, so there's nothing
-            // else to do at this time.
-            break;
-          }
-          case VECTOR_LLRP_RDM_CMD: {
-            LlrpRdmCommand* cmd = &event.rdm_cmd;
-            if (kEtcPalErrOk ==
-                rdm_unpack_command(LLRP_MSG_GET_RDM(&msg), &cmd->rdm_header, &cmd->data, &cmd->data_len))
-            {
-              cmd->source_cid = msg.header.sender_cid;
-              cmd->seq_num = msg.header.transaction_number;
-              cmd->netint_id = target_netint->id;
-
-              event.which = kRCLlrpTargetEventRdmCmdReceived;
-            }
-          }
-          default:
-            break;
-        }
+        target_netint->reply_pending = true;
+        target_netint->pending_reply_cid = header->sender_cid;
+        target_netint->pending_reply_trans_num = header->transaction_number;
+        uint32_t backoff_ms = (uint32_t)(rand() * LLRP_MAX_BACKOFF_MS / RAND_MAX);
+        etcpal_timer_start(&target_netint->reply_backoff, backoff_ms);
       }
     }
+    // Even if we got a valid probe request, we are starting a backoff timer, so there's nothing
+    // else to do at this time.
+    TARGET_UNLOCK(target);
+  }
+}
+
+void target_handle_rdm_command(RCLlrpTarget*              target,
+                               const LlrpRdmCommand*      cmd,
+                               const EtcPalMcastNetintId* netint)
+{
+  if (!RDMNET_ASSERT_VERIFY(target) || !RDMNET_ASSERT_VERIFY(cmd) || !RDMNET_ASSERT_VERIFY(netint))
+    return;
+
+  if (TARGET_LOCK(target))
+  {
+    RCLlrpTargetEvent event = RC_LLRP_TARGET_EVENT_INIT;
+
+    RCLlrpTargetNetintInfo* target_netint = get_target_netint(target, netint);
+    if (target_netint)
+    {
+      event.rdm_cmd = *cmd;
+      event.rdm_cmd.netint_id = target_netint->id;
+      event.which = kRCLlrpTargetEventRdmCmdReceived;
+    }
     TARGET_UNLOCK(target);
     deliver_event_callback(target, &event);
   }
@@ -648,22 +758,130 @@ etcpal_error_t target_send_nack_internal(RCLlrpTarget*              target,
   }
 }
 
-static bool cid_is_equal_predicate(void* ref, const void* context)
+/*
+ * Rebuild the CID and UID indexes from the active target list. On failure, the index is left empty.
+ */
+bool rebuild_target_index(void)
+{
+  size_t num_targets = targets.active.num_refs;
+  target_index.num_targets = 0;
+
+#if RDMNET_DYNAMIC_MEM
+  if (num_targets > target_index.capacity)
+  {
+    size_t new_capacity = (target_index.capacity == 0 ? 8 : target_index.capacity * 2);
+    while (new_capacity < num_targets)
+      new_capacity *= 2;
+
+    // Each array that is successfully reallocated is kept, so that a partial failure doesn't leak.
+    RCLlrpTarget** new_by_cid = (RCLlrpTarget**)realloc(target_index.by_cid, new_capacity * sizeof(RCLlrpTarget*));
+    if (new_by_cid)
+      target_index.by_cid = new_by_cid;
+    RCLlrpTarget** new_by_uid = (RCLlrpTarget**)realloc(target_index.by_uid, new_capacity * sizeof(RCLlrpTarget*));
+    if (new_by_uid)
+      target_index.by_uid = new_by_uid;
+    bool* new_suppressed = (bool*)realloc(target_index.probe_suppressed, new_capacity * sizeof(bool));
+    if (new_suppressed)
+      target_index.probe_suppressed = new_suppressed;
+
+    if (!new_by_cid || !new_by_uid || !new_suppressed)
+      return false;
+    target_index.capacity = new_capacity;
+  }
+#endif
+
+  if (num_targets == 0)
+    return true;
+
+  memcpy(target_index.by_cid, targets.active.refs, num_targets * sizeof(RCLlrpTarget*));
+  memcpy(target_index.by_uid, targets.active.refs, num_targets * sizeof(RCLlrpTarget*));
+  qsort(target_index.by_cid, num_targets, sizeof(RCLlrpTarget*), compare_targets_by_cid);
+  qsort(target_index.by_uid, num_targets, sizeof(RCLlrpTarget*), compare_targets_by_uid);
+  target_index.num_targets = num_targets;
+  return true;
+}
+
+void cleanup_target_index(void)
 {
-  if (!RDMNET_ASSERT_VERIFY(ref) || !RDMNET_ASSERT_VERIFY(context))
-    return false;
+#if RDMNET_DYNAMIC_MEM
+  free(target_index.by_cid);
+  free(target_index.by_uid);
+  free(target_index.probe_suppressed);
+  target_index.by_cid = NULL;
+  target_index.by_uid = NULL;
+  target_index.probe_suppressed = NULL;
+  target_index.capacity = 0;
+#endif
+  target_index.num_targets = 0;
+}
 
-  RCLlrpTarget* target = (RCLlrpTarget*)ref;
-  EtcPalUuid*   cid = (EtcPalUuid*)context;
-  return (ETCPAL_UUID_CMP(&target->cid, cid) == 0);
+int compare_targets_by_cid(const void* a, const void* b)
+{
+  const RCLlrpTarget* target_a = *(RCLlrpTarget* const*)a;
+  const RCLlrpTarget* target_b = *(RCLlrpTarget* const*)b;
+  return ETCPAL_UUID_CMP(&target_a->cid, &target_b->cid);
 }
 
-RCLlrpTarget* find_target_by_cid(const RCRefList* list, const EtcPalUuid* cid)
+int compare_targets_by_uid(const void* a, const void* b)
 {
-  if (!RDMNET_ASSERT_VERIFY(list) || !RDMNET_ASSERT_VERIFY(cid))
+  const RCLlrpTarget* target_a = *(RCLlrpTarget* const*)a;
+  const RCLlrpTarget* target_b = *(RCLlrpTarget* const*)b;
+  return rdm_uid_compare(&target_a->uid, &target_b->uid);
+}
+
+RCLlrpTarget* find_target_by_cid(const EtcPalUuid* cid)
+{
+  if (!RDMNET_ASSERT_VERIFY(cid))
     return NULL;
 
-  return (RCLlrpTarget*)rc_ref_list_find_ref(list, cid_is_equal_predicate, cid);
+  size_t low = 0;
+  size_t high = target_index.num_targets;
+  while (low < high)
+  {
+    size_t mid = low + (high - low) / 2;
+    int    cmp = ETCPAL_UUID_CMP(&target_index.by_cid[mid]->cid, cid);
+    if (cmp == 0)
+      return target_index.by_cid[mid];
+    else if (cmp < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return NULL;
+}
+
+/*
+ * Binary search the range [begin, end) of the UID index for the first target whose UID is not less
+ * than uid. Returns end if there is none.
+ */
+size_t first_target_with_uid_not_less_than(const RdmUid* uid, size_t begin, size_t end)
+{
+  while (begin < end)
+  {
+    size_t mid = begin + (end - begin) / 2;
+    if (rdm_uid_compare(&target_index.by_uid[mid]->uid, uid) < 0)
+      begin = mid + 1;
+    else
+      end = mid;
+  }
+  return begin;
+}
+
+/*
+ * Binary search the range [begin, end) of the UID index for the first target whose UID is greater
+ * than uid. Returns end if there is none.
+ */
+size_t first_target_with_uid_greater_than(const RdmUid* uid, size_t begin, size_t end)
+{
+  while (begin < end)
+  {
+    size_t mid = begin + (end - begin) / 2;
+    if (rdm_uid_compare(&target_index.by_uid[mid]->uid, uid) <= 0)
+      begin = mid + 1;
+    else
+      end = mid;
+  }
+  return begin;
 }
 
 int netint_id_index_in_llrp_array(const EtcPalMcastNetintId* id, const RCLlrpTargetNetintInfo* array, size_t array_size)
@@ -353,6 +353,20 @@ etcpal_error_t rc_mcast_create_recv_socket(const EtcPalIpAddr* group, uint16_t p
     const int value = 1;
     etcpal_setsockopt(sock, ETCPAL_SOL_SOCKET, ETCPAL_SO_REUSEPORT, &value, sizeof value);
 
+#if RDMNET_MCAST_RECV_SOCKET_BUF_SIZE > 0
+    // A larger receive buffer absorbs bursts of discovery replies. This is best-effort; some
+    // platforms cap or ignore it.
+    const int buf_size = RDMNET_MCAST_RECV_SOCKET_BUF_SIZE;
+    etcpal_setsockopt(sock, ETCPAL_SOL_SOCKET, ETCPAL_SO_RCVBUF, &buf_size, sizeof buf_size);
+#endif
+
+    // Receive sockets are drained in batches each time they are readable, so they must not block
+    // once they are empty.
+    res = etcpal_setblocking(sock, false);
+  }
+
+  if (res == kEtcPalErrOk)
+  {
     EtcPalSockAddr bind_addr;
 #if RDMNET_BIND_MCAST_SOCKETS_TO_MCAST_ADDRESS
     // Bind socket to multicast address
@@ -18,8 +18,15 @@
  *****************************************************************************/
 
 #include "rdmnet/core/message.h"
+
+#include "etcpal/common.h"
 #include "rdmnet/core/opts.h"
 
+/*************************** Private constants *******************************/
+
+// The size of a message buffer's list storage when it is first needed; enough for a few RDM buffers.
+#define RC_MSG_ARENA_INITIAL_SIZE 1024
+
 /**************************** Private variables ******************************/
 
 #if !RDMNET_DYNAMIC_MEM
@@ -30,14 +37,13 @@ char                rpt_status_string_buffer[RPT_STATUS_STRING_MAXLEN + 1];
 /*********************** Private function prototypes *************************/
 
 static void free_broker_message(BrokerMessage* bmsg);
-#if RDMNET_DYNAMIC_MEM
-static void free_rpt_message(RptMessage* rmsg);
-#endif
 
 /*************************** Function definitions ****************************/
 
 /*
- * Free the resources held by an RdmnetMessage returned from another API function.
+ * Free the resources held by an RdmnetMessage returned from another API function. The message's
+ * lists are held by the arena of the message buffer which parsed it and are reused for the next
+ * message rather than freed.
  * [in] msg Pointer to message to free.
  */
 void rc_free_message_resources(RdmnetMessage* msg)
@@ -54,16 +60,6 @@ void rc_free_message_resources(RdmnetMessage* msg)
         free_broker_message(broker_msg);
       }
       break;
-#if RDMNET_DYNAMIC_MEM
-      case ACN_VECTOR_ROOT_RPT: {
-        RptMessage* rpt_msg = RDMNET_GET_RPT_MSG(msg);
-        if (!RDMNET_ASSERT_VERIFY(rpt_msg))
-          return;
-
-        free_rpt_message(rpt_msg);
-      }
-      break;
-#endif
       default:
         break;
     }
@@ -101,89 +97,72 @@ void free_broker_message(BrokerMessage* bmsg)
         {
           FREE_EPT_SUBPROT_LIST(ept_entry->protocols);
         }
-#if RDMNET_DYNAMIC_MEM
-        free(ept_entry_list);
-#endif
-      }
-#if RDMNET_DYNAMIC_MEM
-      else if (BROKER_IS_RPT_CLIENT_LIST(clist))
-      {
-        RdmnetRptClientList* rpt_client_list = BROKER_GET_RPT_CLIENT_LIST(clist);
-        if (!RDMNET_ASSERT_VERIFY(rpt_client_list))
-          return;
-
-        if (rpt_client_list->client_entries)
-          free(rpt_client_list->client_entries);
       }
-#endif
       break;
     }
-#if RDMNET_DYNAMIC_MEM
-    case VECTOR_BROKER_REQUEST_DYNAMIC_UIDS: {
-      BrokerDynamicUidRequestList* req_list = BROKER_GET_DYNAMIC_UID_REQUEST_LIST(bmsg);
-      if (!RDMNET_ASSERT_VERIFY(req_list))
-        return;
-
-      if (req_list->requests)
-        free(req_list->requests);
-    }
-    break;
-    case VECTOR_BROKER_ASSIGNED_DYNAMIC_UIDS: {
-      RdmnetDynamicUidAssignmentList* assignment_list = BROKER_GET_DYNAMIC_UID_ASSIGNMENT_LIST(bmsg);
-      if (!RDMNET_ASSERT_VERIFY(assignment_list))
-        return;
-
-      if (assignment_list->mappings)
-        free(assignment_list->mappings);
-    }
-    break;
-    case VECTOR_BROKER_FETCH_DYNAMIC_UID_LIST: {
-      BrokerFetchUidAssignmentList* fetch_list = BROKER_GET_FETCH_DYNAMIC_UID_ASSIGNMENT_LIST(bmsg);
-      if (!RDMNET_ASSERT_VERIFY(fetch_list))
-        return;
-
-      if (fetch_list->uids)
-        free(fetch_list->uids);
-    }
-    break;
-#endif
     default:
       break;
   }
 }
 
+/*
+ * Initialize the storage used for the lists of messages parsed by one message buffer.
+ */
+void rc_msg_arena_init(RCMsgArena* arena)
+{
+  if (!RDMNET_ASSERT_VERIFY(arena))
+    return;
+
 #if RDMNET_DYNAMIC_MEM
-void free_rpt_message(RptMessage* rmsg)
+  arena->data = NULL;
+  arena->capacity = 0;
+#else
+  arena->storage = &rdmnet_static_msg_buf;
+#endif
+}
+
+/*
+ * Free the storage held by an arena. Any message lists stored in it are no longer valid.
+ */
+void rc_msg_arena_cleanup(RCMsgArena* arena)
 {
-  if (!RDMNET_ASSERT_VERIFY(rmsg))
+  if (!RDMNET_ASSERT_VERIFY(arena))
     return;
 
-  switch (rmsg->vector)
-  {
-    case VECTOR_RPT_REQUEST:
-    case VECTOR_RPT_NOTIFICATION: {
-      RptRdmBufList* buf_list = RPT_GET_RDM_BUF_LIST(rmsg);
-      if (!RDMNET_ASSERT_VERIFY(buf_list))
-        return;
+#if RDMNET_DYNAMIC_MEM
+  free(arena->data);
+  arena->data = NULL;
+  arena->capacity = 0;
+#endif
+}
 
-      if (buf_list->rdm_buffers)
-        free(buf_list->rdm_buffers);
-    }
-    break;
-    case VECTOR_RPT_STATUS: {
-      RptStatusMsg* status = RPT_GET_STATUS_MSG(rmsg);
-      if (!RDMNET_ASSERT_VERIFY(status))
-        return;
+/*
+ * Make room for size bytes at the start of the arena, keeping its current contents, and return
+ * the start of the arena. Capacity is at least doubled when the arena grows, so a list which is
+ * grown one element at a time is copied a constant number of times per element on average.
+ * Returns NULL if the memory could not be allocated, or always without dynamic memory.
+ */
+void* rc_msg_arena_reserve(RCMsgArena* arena, size_t size)
+{
+  if (!RDMNET_ASSERT_VERIFY(arena))
+    return NULL;
 
-      if (status->status_string)
-      {
-        free((char*)status->status_string);
-        status->status_string = NULL;
-      }
-      break;
-    }
-    default:
-      break;
+#if RDMNET_DYNAMIC_MEM
+  if (size > arena->capacity)
+  {
+    size_t new_capacity = (arena->capacity > 0 ? arena->capacity * 2 : RC_MSG_ARENA_INITIAL_SIZE);
+    if (new_capacity < size)
+      new_capacity = size;
+
+    uint8_t* new_data = (uint8_t*)realloc(arena->data, new_capacity);
+    if (!new_data)
+      return NULL;
+    arena->data = new_data;
+    arena->capacity = new_capacity;
   }
-}
+  return arena->data;
+#else
+  ETCPAL_UNUSED_ARG(size);
+  return NULL;
 #endif
+}
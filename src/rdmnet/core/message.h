@@ -115,26 +115,46 @@ typedef union
 extern StaticMessageBuffer rdmnet_static_msg_buf;
 extern char                rpt_status_string_buffer[RPT_STATUS_STRING_MAXLEN + 1];
 
+// Storage for the variable-length lists of a parsed message: RDM buffers, client entries, dynamic
+// UID lists and status strings. A message holds at most one of these at a time, so each message
+// buffer keeps a single block which is grown geometrically and reused for each message it parses,
+// rather than allocating and freeing the list for every message. Without dynamic memory, the lists
+// are held in rdmnet_static_msg_buf instead.
+typedef struct RCMsgArena
+{
+#if RDMNET_DYNAMIC_MEM
+  uint8_t* data;
+  size_t   capacity;
+#else
+  StaticMessageBuffer* storage;
+#endif
+} RCMsgArena;
+
 #if RDMNET_DYNAMIC_MEM
 
-#define ALLOC_RPT_CLIENT_ENTRY() malloc(sizeof(RdmnetRptClientEntry))
-#define ALLOC_EPT_CLIENT_ENTRY() malloc(sizeof(RdmnetEptClientEntry))
-#define ALLOC_DYNAMIC_UID_REQUEST_ENTRY() malloc(sizeof(BrokerDynamicUidRequest))
-#define ALLOC_DYNAMIC_UID_MAPPING() malloc(sizeof(RdmnetDynamicUidMapping))
-#define ALLOC_FETCH_UID_ASSIGNMENT() malloc(sizeof(RdmUid))
-#define ALLOC_RDM_BUFFER() malloc(sizeof(RdmBuffer))
-
-#define REALLOC_RPT_CLIENT_ENTRY(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), realloc((ptr), ((new_size) * sizeof(RdmnetRptClientEntry))))
-#define REALLOC_EPT_CLIENT_ENTRY(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), realloc((ptr), ((new_size) * sizeof(RdmnetEptClientEntry))))
-#define REALLOC_DYNAMIC_UID_REQUEST_ENTRY(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), realloc((ptr), ((new_size) * sizeof(BrokerDynamicUidRequest))))
-#define REALLOC_DYNAMIC_UID_MAPPING(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), realloc((ptr), ((new_size) * sizeof(RdmnetDynamicUidMapping))))
-#define REALLOC_FETCH_UID_ASSIGNMENT(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), realloc((ptr), ((new_size) * sizeof(RdmUid))))
-#define REALLOC_RDM_BUFFER(ptr, new_size) (RDMNET_ASSERT_VERIFY(ptr), realloc((ptr), ((new_size) * sizeof(RdmBuffer))))
+#define ALLOC_RPT_CLIENT_ENTRY(arena) rc_msg_arena_reserve((arena), sizeof(RdmnetRptClientEntry))
+#define ALLOC_EPT_CLIENT_ENTRY(arena) rc_msg_arena_reserve((arena), sizeof(RdmnetEptClientEntry))
+#define ALLOC_DYNAMIC_UID_REQUEST_ENTRY(arena) rc_msg_arena_reserve((arena), sizeof(BrokerDynamicUidRequest))
+#define ALLOC_DYNAMIC_UID_MAPPING(arena) rc_msg_arena_reserve((arena), sizeof(RdmnetDynamicUidMapping))
+#define ALLOC_FETCH_UID_ASSIGNMENT(arena) rc_msg_arena_reserve((arena), sizeof(RdmUid))
+#define ALLOC_RDM_BUFFER(arena) rc_msg_arena_reserve((arena), sizeof(RdmBuffer))
+
+// The list being grown is always the one at the start of the arena.
+#define REALLOC_FROM_ARENA(arena, ptr, new_size)                                                               \
+  (RDMNET_ASSERT_VERIFY((ptr) && (uint8_t*)(ptr) == (arena)->data) ? rc_msg_arena_reserve((arena), (new_size)) \
+                                                                   : NULL)
+
+#define REALLOC_RPT_CLIENT_ENTRY(arena, ptr, new_size) \
+  REALLOC_FROM_ARENA(arena, ptr, ((new_size) * sizeof(RdmnetRptClientEntry)))
+#define REALLOC_EPT_CLIENT_ENTRY(arena, ptr, new_size) \
+  REALLOC_FROM_ARENA(arena, ptr, ((new_size) * sizeof(RdmnetEptClientEntry)))
+#define REALLOC_DYNAMIC_UID_REQUEST_ENTRY(arena, ptr, new_size) \
+  REALLOC_FROM_ARENA(arena, ptr, ((new_size) * sizeof(BrokerDynamicUidRequest)))
+#define REALLOC_DYNAMIC_UID_MAPPING(arena, ptr, new_size) \
+  REALLOC_FROM_ARENA(arena, ptr, ((new_size) * sizeof(RdmnetDynamicUidMapping)))
+#define REALLOC_FETCH_UID_ASSIGNMENT(arena, ptr, new_size) \
+  REALLOC_FROM_ARENA(arena, ptr, ((new_size) * sizeof(RdmUid)))
+#define REALLOC_RDM_BUFFER(arena, ptr, new_size) REALLOC_FROM_ARENA(arena, ptr, ((new_size) * sizeof(RdmBuffer)))
 
 #define ALLOC_EPT_SUBPROT_LIST() malloc(sizeof(RdmnetEptSubProtocol))
 #define REALLOC_EPT_SUBPROT_LIST(ptr, new_size) \
@@ -145,54 +165,51 @@ extern char                rpt_status_string_buffer[RPT_STATUS_STRING_MAXLEN + 1
     free(ptr);                     \
   }
 
-#define ALLOC_RPT_STATUS_STR(size) malloc(size)
-
-#define FREE_MESSAGE_BUFFER(ptr) \
-  if (ptr)                       \
-  {                              \
-    free(ptr);                   \
-  }
+#define ALLOC_RPT_STATUS_STR(arena, size) (char*)rc_msg_arena_reserve((arena), (size))
 
 #else
 
 // Static buffer space for RDMnet messages is held in a union. Only one field can be used at a
 // time.
-#define ALLOC_FROM_ARRAY(array, array_size) rdmnet_static_msg_buf.array
-#define REALLOC_FROM_ARRAY(ptr, new_size, array, array_size)     \
-  (RDMNET_ASSERT_VERIFY((ptr) == (rdmnet_static_msg_buf.array)), \
-   ((new_size) <= (array_size) ? rdmnet_static_msg_buf.array : NULL))
-
-#define ALLOC_RPT_CLIENT_ENTRY() ALLOC_FROM_ARRAY(rpt_client_entries, RPT_CLIENT_ENTRIES_MAX_SIZE)
-#define ALLOC_EPT_CLIENT_ENTRY() ALLOC_FROM_ARRAY(ept_client_entries, EPT_CLIENT_ENTRIES_MAX_SIZE)
-#define ALLOC_DYNAMIC_UID_REQUEST_ENTRY() ALLOC_FROM_ARRAY(dynamic_uid_requests, DYNAMIC_UID_REQUESTS_MAX_SIZE)
-#define ALLOC_DYNAMIC_UID_MAPPING() ALLOC_FROM_ARRAY(dynamic_uid_mappings, DYNAMIC_UID_MAPPINGS_MAX_SIZE)
-#define ALLOC_FETCH_UID_ASSIGNMENT() ALLOC_FROM_ARRAY(fetch_uid_assignments, FETCH_UID_ASSIGNMENTS_MAX_SIZE)
-#define ALLOC_RDM_BUFFER() ALLOC_FROM_ARRAY(rdm_buffers, RDM_BUFFERS_MAX_SIZE)
-
-#define REALLOC_RPT_CLIENT_ENTRY(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), REALLOC_FROM_ARRAY(ptr, new_size, rpt_client_entries, RPT_CLIENT_ENTRIES_MAX_SIZE))
-#define REALLOC_EPT_CLIENT_ENTRY(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), REALLOC_FROM_ARRAY(ptr, new_size, ept_client_entries, EPT_CLIENT_ENTRIES_MAX_SIZE))
-#define REALLOC_DYNAMIC_UID_REQUEST_ENTRY(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), REALLOC_FROM_ARRAY(ptr, new_size, dynamic_uid_requests, DYNAMIC_UID_REQUESTS_MAX_SIZE))
-#define REALLOC_DYNAMIC_UID_MAPPING(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), REALLOC_FROM_ARRAY(ptr, new_size, dynamic_uid_mappings, DYNAMIC_UID_MAPPINGS_MAX_SIZE))
-#define REALLOC_FETCH_UID_ASSIGNMENT(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), REALLOC_FROM_ARRAY(ptr, new_size, fetch_uid_assignments, FETCH_UID_ASSIGNMENTS_MAX_SIZE))
-#define REALLOC_RDM_BUFFER(ptr, new_size) \
-  (RDMNET_ASSERT_VERIFY(ptr), REALLOC_FROM_ARRAY(ptr, new_size, rdm_buffers, RDM_BUFFERS_MAX_SIZE))
-
-#define ALLOC_RPT_STATUS_STR(size) rpt_status_string_buffer
+#define ALLOC_FROM_ARRAY(arena, array, array_size) (arena)->storage->array
+#define REALLOC_FROM_ARRAY(arena, ptr, new_size, array, array_size) \
+  (RDMNET_ASSERT_VERIFY((ptr) == ((arena)->storage->array)),        \
+   ((new_size) <= (array_size) ? (arena)->storage->array : NULL))
+
+#define ALLOC_RPT_CLIENT_ENTRY(arena) ALLOC_FROM_ARRAY(arena, rpt_client_entries, RPT_CLIENT_ENTRIES_MAX_SIZE)
+#define ALLOC_EPT_CLIENT_ENTRY(arena) ALLOC_FROM_ARRAY(arena, ept_client_entries, EPT_CLIENT_ENTRIES_MAX_SIZE)
+#define ALLOC_DYNAMIC_UID_REQUEST_ENTRY(arena) \
+  ALLOC_FROM_ARRAY(arena, dynamic_uid_requests, DYNAMIC_UID_REQUESTS_MAX_SIZE)
+#define ALLOC_DYNAMIC_UID_MAPPING(arena) ALLOC_FROM_ARRAY(arena, dynamic_uid_mappings, DYNAMIC_UID_MAPPINGS_MAX_SIZE)
+#define ALLOC_FETCH_UID_ASSIGNMENT(arena) \
+  ALLOC_FROM_ARRAY(arena, fetch_uid_assignments, FETCH_UID_ASSIGNMENTS_MAX_SIZE)
+#define ALLOC_RDM_BUFFER(arena) ALLOC_FROM_ARRAY(arena, rdm_buffers, RDM_BUFFERS_MAX_SIZE)
+
+#define REALLOC_RPT_CLIENT_ENTRY(arena, ptr, new_size) \
+  REALLOC_FROM_ARRAY(arena, ptr, new_size, rpt_client_entries, RPT_CLIENT_ENTRIES_MAX_SIZE)
+#define REALLOC_EPT_CLIENT_ENTRY(arena, ptr, new_size) \
+  REALLOC_FROM_ARRAY(arena, ptr, new_size, ept_client_entries, EPT_CLIENT_ENTRIES_MAX_SIZE)
+#define REALLOC_DYNAMIC_UID_REQUEST_ENTRY(arena, ptr, new_size) \
+  REALLOC_FROM_ARRAY(arena, ptr, new_size, dynamic_uid_requests, DYNAMIC_UID_REQUESTS_MAX_SIZE)
+#define REALLOC_DYNAMIC_UID_MAPPING(arena, ptr, new_size) \
+  REALLOC_FROM_ARRAY(arena, ptr, new_size, dynamic_uid_mappings, DYNAMIC_UID_MAPPINGS_MAX_SIZE)
+#define REALLOC_FETCH_UID_ASSIGNMENT(arena, ptr, new_size) \
+  REALLOC_FROM_ARRAY(arena, ptr, new_size, fetch_uid_assignments, FETCH_UID_ASSIGNMENTS_MAX_SIZE)
+#define REALLOC_RDM_BUFFER(arena, ptr, new_size) \
+  REALLOC_FROM_ARRAY(arena, ptr, new_size, rdm_buffers, RDM_BUFFERS_MAX_SIZE)
+
+#define ALLOC_RPT_STATUS_STR(arena, size) ((void)(arena), rpt_status_string_buffer)
 
 // TODO
 #define ALLOC_EPT_SUBPROT_LIST() NULL
 #define REALLOC_EPT_SUBPROT_LIST() NULL
 #define FREE_EPT_SUBPROT_LIST(ptr)
 
-#define FREE_MESSAGE_BUFFER(ptr)
-
 #endif
 
+void  rc_msg_arena_init(RCMsgArena* arena);
+void  rc_msg_arena_cleanup(RCMsgArena* arena);
+void* rc_msg_arena_reserve(RCMsgArena* arena, size_t size);
 void rc_free_message_resources(RdmnetMessage* msg);
 
 #ifdef __cplusplus
@@ -21,6 +21,8 @@
 
 #include <assert.h>
 #include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
 #include "etcpal/acn_rlp.h"
 #include "etcpal/common.h"
 #include "etcpal/pack.h"
@@ -33,6 +35,7 @@
 /*********************** Private function prototypes *************************/
 
 static size_t            locate_tcp_preamble(RCMsgBuf* msg_buf);
+static void              discard_data(RCMsgBuf* msg_buf, size_t size);
 static size_t            consume_bad_block(PduBlockState* block, size_t data_len, rc_parse_result_t* parse_res);
 static rc_parse_result_t check_for_full_parse(rc_parse_result_t prev_res, PduBlockState* block);
 
@@ -44,6 +47,7 @@ static size_t parse_rlp_block(RlpState*          rlpstate,
                               const uint8_t*     data,
                               size_t             data_size,
                               RdmnetMessage*     msg,
+                              RCMsgArena*        arena,
                               rc_parse_result_t* result);
 
 // RDMnet layer
@@ -52,11 +56,13 @@ static size_t parse_broker_block(BrokerState*       bstate,
                                  const uint8_t*     data,
                                  size_t             data_len,
                                  BrokerMessage*     bmsg,
+                                 RCMsgArena*        arena,
                                  rc_parse_result_t* result);
 static size_t parse_rpt_block(RptState*          rstate,
                               const uint8_t*     data,
                               size_t             data_len,
                               RptMessage*        rmsg,
+                              RCMsgArena*        arena,
                               rc_parse_result_t* result);
 
 // RPT layer
@@ -65,11 +71,13 @@ static size_t parse_rdm_list(RdmListState*      rlstate,
                              const uint8_t*     data,
                              size_t             data_len,
                              RptRdmBufList*     cmd_list,
+                             RCMsgArena*        arena,
                              rc_parse_result_t* result);
 static size_t parse_rpt_status(RptStatusState*    rsstate,
                                const uint8_t*     data,
                                size_t             data_len,
                                RptStatusMsg*      smsg,
+                               RCMsgArena*        arena,
                                rc_parse_result_t* result);
 
 // Broker layer
@@ -95,21 +103,25 @@ static size_t parse_client_list(ClientListState*   clstate,
                                 const uint8_t*     data,
                                 size_t             data_len,
                                 BrokerClientList*  clist,
+                                RCMsgArena*        arena,
                                 rc_parse_result_t* result);
 static size_t parse_request_dynamic_uid_assignment(GenericListState*            lstate,
                                                    const uint8_t*               data,
                                                    size_t                       data_len,
                                                    BrokerDynamicUidRequestList* rlist,
+                                                   RCMsgArena*                  arena,
                                                    rc_parse_result_t*           result);
 static size_t parse_dynamic_uid_assignment_list(GenericListState*               lstate,
                                                 const uint8_t*                  data,
                                                 size_t                          data_len,
                                                 RdmnetDynamicUidAssignmentList* alist,
+                                                RCMsgArena*                     arena,
                                                 rc_parse_result_t*              result);
 static size_t parse_fetch_dynamic_uid_assignment_list(GenericListState*             lstate,
                                                       const uint8_t*                data,
                                                       size_t                        data_len,
                                                       BrokerFetchUidAssignmentList* alist,
+                                                      RCMsgArena*                   arena,
                                                       rc_parse_result_t*            result);
 
 // Helpers for parsing client list messages
@@ -117,34 +129,117 @@ static size_t                parse_rpt_client_list(ClientListState*     clstate,
                                                    const uint8_t*       data,
                                                    size_t               data_len,
                                                    RdmnetRptClientList* clist,
+                                                   RCMsgArena*          arena,
                                                    rc_parse_result_t*   result);
-static RdmnetRptClientEntry* alloc_next_rpt_client_entry(RdmnetRptClientList* clist);
+static RdmnetRptClientEntry* alloc_next_rpt_client_entry(RdmnetRptClientList* clist, RCMsgArena* arena);
 #if 0
-static RdmnetEptClientEntry* alloc_next_ept_client_entry(RdmnetEptClientList* clist);
+static RdmnetEptClientEntry* alloc_next_ept_client_entry(RdmnetEptClientList* clist, RCMsgArena* arena);
 #endif
 
 /*************************** Function definitions ****************************/
 
-void rc_msg_buf_init(RCMsgBuf* msg_buf)
+/*
+ * Allocate a receive buffer of the given size (0 for #RDMNET_RECV_BUF_DEFAULT_SIZE) and reset its
+ * parse state. Without dynamic memory, the size is ignored and the fixed-size buffer is used.
+ * Returns false if the buffer could not be allocated.
+ */
+bool rc_msg_buf_init(RCMsgBuf* msg_buf, size_t size)
+{
+  if (!RDMNET_ASSERT_VERIFY(msg_buf))
+    return false;
+
+#if RDMNET_DYNAMIC_MEM
+  if (size == 0)
+    size = RDMNET_RECV_BUF_DEFAULT_SIZE;
+  if (size < RC_MSG_BUF_SIZE)
+    size = RC_MSG_BUF_SIZE;
+
+  msg_buf->buf = (uint8_t*)malloc(size);
+  if (!msg_buf->buf)
+    return false;
+  msg_buf->buf_size = size;
+#else
+  ETCPAL_UNUSED_ARG(size);
+  msg_buf->buf_size = RC_MSG_BUF_SIZE;
+#endif
+
+  rc_msg_arena_init(&msg_buf->arena);
+  rc_msg_buf_reset(msg_buf);
+  return true;
+}
+
+/*
+ * Free the storage allocated by rc_msg_buf_init().
+ */
+void rc_msg_buf_cleanup(RCMsgBuf* msg_buf)
+{
+  if (!RDMNET_ASSERT_VERIFY(msg_buf))
+    return;
+
+#if RDMNET_DYNAMIC_MEM
+  free(msg_buf->buf);
+  msg_buf->buf = NULL;
+  msg_buf->buf_size = 0;
+#endif
+  rc_msg_arena_cleanup(&msg_buf->arena);
+  msg_buf->cur_data_offset = 0;
+  msg_buf->cur_data_size = 0;
+  msg_buf->raw_msg = NULL;
+  msg_buf->raw_msg_size = 0;
+}
+
+/*
+ * Discard any data in the buffer and the state of any message being parsed, keeping the storage.
+ */
+void rc_msg_buf_reset(RCMsgBuf* msg_buf)
 {
   if (!RDMNET_ASSERT_VERIFY(msg_buf))
     return;
 
+  msg_buf->cur_data_offset = 0;
   msg_buf->cur_data_size = 0;
+  msg_buf->raw_msg = NULL;
+  msg_buf->raw_msg_size = 0;
   msg_buf->have_preamble = false;
 }
 
+/*
+ * Prepare to receive more data at &buf[cur_data_size], moving the unparsed data to the front of the
+ * buffer if it has gotten too close to the end. Returns the number of bytes which can be received.
+ */
+size_t rc_msg_buf_make_room(RCMsgBuf* msg_buf)
+{
+  if (!RDMNET_ASSERT_VERIFY(msg_buf) || !RDMNET_ASSERT_VERIFY(msg_buf->cur_data_size <= msg_buf->buf_size) ||
+      !RDMNET_ASSERT_VERIFY(msg_buf->cur_data_offset <= msg_buf->cur_data_size))
+  {
+    return 0;
+  }
+
+  // Compacting is deferred until less than half the buffer is free at the end, so that it is rare
+  // and usually moves only the tail of a partially-received message.
+  size_t remaining_length = msg_buf->buf_size - msg_buf->cur_data_size;
+  if (msg_buf->cur_data_offset > 0 && remaining_length < msg_buf->buf_size / 2)
+  {
+    size_t unparsed_size = msg_buf->cur_data_size - msg_buf->cur_data_offset;
+    memmove(msg_buf->buf, &msg_buf->buf[msg_buf->cur_data_offset], unparsed_size);
+    msg_buf->cur_data_offset = 0;
+    msg_buf->cur_data_size = unparsed_size;
+    remaining_length = msg_buf->buf_size - unparsed_size;
+  }
+  return remaining_length;
+}
+
 etcpal_error_t rc_msg_buf_recv(RCMsgBuf* msg_buf, etcpal_socket_t socket)
 {
-  if (!RDMNET_ASSERT_VERIFY(msg_buf) || !RDMNET_ASSERT_VERIFY(msg_buf->cur_data_size <= RC_MSG_BUF_SIZE))
+  if (!RDMNET_ASSERT_VERIFY(msg_buf) || !RDMNET_ASSERT_VERIFY(msg_buf->cur_data_size <= msg_buf->buf_size))
     return kEtcPalErrSys;
 
-  size_t original_data_size = msg_buf->cur_data_size;
+  size_t original_data_size = msg_buf->cur_data_size - msg_buf->cur_data_offset;
 
   int recv_res = 0;
   do
   {
-    size_t remaining_length = RC_MSG_BUF_SIZE - msg_buf->cur_data_size;
+    size_t remaining_length = rc_msg_buf_make_room(msg_buf);
     if (remaining_length > 0)
       recv_res = etcpal_recv(socket, &msg_buf->buf[msg_buf->cur_data_size], remaining_length, 0);
     else
@@ -158,7 +253,7 @@ etcpal_error_t rc_msg_buf_recv(RCMsgBuf* msg_buf, etcpal_socket_t socket)
   {
     if ((etcpal_error_t)recv_res != kEtcPalErrWouldBlock)
       return (etcpal_error_t)recv_res;
-    if (msg_buf->cur_data_size == original_data_size)
+    if (msg_buf->cur_data_size - msg_buf->cur_data_offset == original_data_size)
       return kEtcPalErrWouldBlock;
   }
   else if (recv_res == 0)
@@ -178,9 +273,13 @@ etcpal_error_t rc_msg_buf_parse_data(RCMsgBuf* msg_buf)
   // that the parse is still in progress.
   etcpal_error_t res = kEtcPalErrNoData;
 
+  msg_buf->raw_msg = NULL;
+  msg_buf->raw_msg_size = 0;
+
   do
   {
     size_t consumed = 0;
+    size_t new_block_size = 0;
 
     if (!msg_buf->have_preamble)
     {
@@ -189,6 +288,7 @@ etcpal_error_t rc_msg_buf_parse_data(RCMsgBuf* msg_buf)
       {
         INIT_RLP_STATE(&msg_buf->rlp_state, pdu_block_size);
         msg_buf->have_preamble = true;
+        new_block_size = pdu_block_size;
       }
       else
       {
@@ -199,13 +299,23 @@ etcpal_error_t rc_msg_buf_parse_data(RCMsgBuf* msg_buf)
     if (msg_buf->have_preamble)
     {
       rc_parse_result_t parse_res;
-      consumed = parse_rlp_block(&msg_buf->rlp_state, msg_buf->buf, msg_buf->cur_data_size, &msg_buf->msg, &parse_res);
+      size_t            block_offset = msg_buf->cur_data_offset;
+      consumed = parse_rlp_block(&msg_buf->rlp_state, &msg_buf->buf[block_offset],
+                                 msg_buf->cur_data_size - block_offset, &msg_buf->msg, &msg_buf->arena, &parse_res);
       switch (parse_res)
       {
         case kRCParseResFullBlockParseOk:
         case kRCParseResFullBlockProtErr:
           msg_buf->have_preamble = false;
           res = (parse_res == kRCParseResFullBlockProtErr ? kEtcPalErrProtocol : kEtcPalErrOk);
+          // If the whole block was parsed at once, the preamble which was just located is still in
+          // the buffer right before it, so the message's original bytes can be handed out as-is.
+          if (res == kEtcPalErrOk && new_block_size != 0 && consumed == new_block_size &&
+              block_offset >= ACN_TCP_PREAMBLE_SIZE)
+          {
+            msg_buf->raw_msg = &msg_buf->buf[block_offset - ACN_TCP_PREAMBLE_SIZE];
+            msg_buf->raw_msg_size = ACN_TCP_PREAMBLE_SIZE + consumed;
+          }
           break;
         case kRCParseResPartialBlockParseOk:
         case kRCParseResPartialBlockProtErr:
@@ -220,15 +330,11 @@ etcpal_error_t rc_msg_buf_parse_data(RCMsgBuf* msg_buf)
 
     if (consumed > 0)
     {
-      // Roll the buffer to discard the data we have already parsed.
-      if (!RDMNET_ASSERT_VERIFY(msg_buf->cur_data_size >= consumed))
+      // Discard the data we have already parsed.
+      if (!RDMNET_ASSERT_VERIFY(msg_buf->cur_data_size - msg_buf->cur_data_offset >= consumed))
         return kEtcPalErrSys;
 
-      if (msg_buf->cur_data_size > consumed)
-      {
-        memmove(msg_buf->buf, &msg_buf->buf[consumed], msg_buf->cur_data_size - consumed);
-      }
-      msg_buf->cur_data_size -= consumed;
+      discard_data(msg_buf, consumed);
     }
   } while (res == kEtcPalErrProtocol);
 
@@ -259,6 +365,7 @@ size_t parse_rlp_block(RlpState*          rlpstate,
                        const uint8_t*     data,
                        size_t             data_len,
                        RdmnetMessage*     msg,
+                       RCMsgArena*        arena,
                        rc_parse_result_t* result)
 {
   if (!RDMNET_ASSERT_VERIFY(rlpstate) || !RDMNET_ASSERT_VERIFY(msg) || !RDMNET_ASSERT_VERIFY(result))
@@ -329,11 +436,11 @@ size_t parse_rlp_block(RlpState*          rlpstate,
     {
       case ACN_VECTOR_ROOT_BROKER:
         next_layer_bytes_parsed = parse_broker_block(&rlpstate->data.broker, &data[bytes_parsed],
-                                                     data_len - bytes_parsed, RDMNET_GET_BROKER_MSG(msg), &res);
+                                                     data_len - bytes_parsed, RDMNET_GET_BROKER_MSG(msg), arena, &res);
         break;
       case ACN_VECTOR_ROOT_RPT:
         next_layer_bytes_parsed = parse_rpt_block(&rlpstate->data.rpt, &data[bytes_parsed], data_len - bytes_parsed,
-                                                  RDMNET_GET_RPT_MSG(msg), &res);
+                                                  RDMNET_GET_RPT_MSG(msg), arena, &res);
         break;
       default:
         next_layer_bytes_parsed = consume_bad_block(&rlpstate->data.unknown, data_len - bytes_parsed, &res);
@@ -487,6 +594,7 @@ size_t parse_broker_block(BrokerState*       bstate,
                           const uint8_t*     data,
                           size_t             data_len,
                           BrokerMessage*     bmsg,
+                          RCMsgArena*        arena,
                           rc_parse_result_t* result)
 {
   if (!RDMNET_ASSERT_VERIFY(bstate) || !RDMNET_ASSERT_VERIFY(bmsg) || !RDMNET_ASSERT_VERIFY(result))
@@ -630,7 +738,7 @@ size_t parse_broker_block(BrokerState*       bstate,
           return 0;
 
         next_layer_bytes_parsed =
-            parse_client_list(&bstate->data.client_list, &data[bytes_parsed], remaining_len, clist, &res);
+            parse_client_list(&bstate->data.client_list, &data[bytes_parsed], remaining_len, clist, arena, &res);
       }
       break;
       case VECTOR_BROKER_REQUEST_DYNAMIC_UIDS: {
@@ -639,7 +747,7 @@ size_t parse_broker_block(BrokerState*       bstate,
           return 0;
 
         next_layer_bytes_parsed = parse_request_dynamic_uid_assignment(&bstate->data.data_list, &data[bytes_parsed],
-                                                                       remaining_len, rlist, &res);
+                                                                       remaining_len, rlist, arena, &res);
       }
       break;
       case VECTOR_BROKER_ASSIGNED_DYNAMIC_UIDS: {
@@ -648,7 +756,7 @@ size_t parse_broker_block(BrokerState*       bstate,
           return 0;
 
         next_layer_bytes_parsed = parse_dynamic_uid_assignment_list(&bstate->data.data_list, &data[bytes_parsed],
-                                                                    remaining_len, dualist, &res);
+                                                                    remaining_len, dualist, arena, &res);
       }
       break;
       case VECTOR_BROKER_FETCH_DYNAMIC_UID_LIST: {
@@ -657,7 +765,7 @@ size_t parse_broker_block(BrokerState*       bstate,
           return 0;
 
         next_layer_bytes_parsed = parse_fetch_dynamic_uid_assignment_list(&bstate->data.data_list, &data[bytes_parsed],
-                                                                          remaining_len, ualist, &res);
+                                                                          remaining_len, ualist, arena, &res);
       }
       break;
       case VECTOR_BROKER_NULL:
@@ -913,6 +1021,7 @@ size_t parse_client_list(ClientListState*   clstate,
                          const uint8_t*     data,
                          size_t             data_len,
                          BrokerClientList*  clist,
+                         RCMsgArena*        arena,
                          rc_parse_result_t* result)
 {
   if (!RDMNET_ASSERT_VERIFY(clstate) || !RDMNET_ASSERT_VERIFY(clist) || !RDMNET_ASSERT_VERIFY(result))
@@ -941,7 +1050,7 @@ size_t parse_client_list(ClientListState*   clstate,
       if (!RDMNET_ASSERT_VERIFY(rclist))
         return 0;
 
-      bytes_parsed += parse_rpt_client_list(clstate, data, data_len, rclist, &res);
+      bytes_parsed += parse_rpt_client_list(clstate, data, data_len, rclist, arena, &res);
     }
     else if (clist->client_protocol == kClientProtocolEPT)
     {
@@ -963,6 +1072,7 @@ size_t parse_rpt_client_list(ClientListState*     clstate,
                              const uint8_t*       data,
                              size_t               data_len,
                              RdmnetRptClientList* clist,
+                             RCMsgArena*          arena,
                              rc_parse_result_t*   result)
 {
   if (!RDMNET_ASSERT_VERIFY(clstate) || !RDMNET_ASSERT_VERIFY(data) || !RDMNET_ASSERT_VERIFY(clist) ||
@@ -992,7 +1102,7 @@ size_t parse_rpt_client_list(ClientListState*     clstate,
           break;
         }
 
-        next_entry = alloc_next_rpt_client_entry(clist);
+        next_entry = alloc_next_rpt_client_entry(clist, arena);
         if (next_entry)
         {
           clstate->block.parsed_header = true;
@@ -1065,14 +1175,15 @@ size_t parse_rpt_client_list(ClientListState*     clstate,
   return bytes_parsed;
 }
 
-RdmnetRptClientEntry* alloc_next_rpt_client_entry(RdmnetRptClientList* clist)
+RdmnetRptClientEntry* alloc_next_rpt_client_entry(RdmnetRptClientList* clist, RCMsgArena* arena)
 {
   if (!RDMNET_ASSERT_VERIFY(clist))
     return NULL;
 
   if (clist->client_entries)
   {
-    RdmnetRptClientEntry* new_arr = REALLOC_RPT_CLIENT_ENTRY(clist->client_entries, clist->num_client_entries + 1);
+    RdmnetRptClientEntry* new_arr =
+        REALLOC_RPT_CLIENT_ENTRY(arena, clist->client_entries, clist->num_client_entries + 1);
     if (new_arr)
     {
       clist->client_entries = new_arr;
@@ -1085,7 +1196,7 @@ RdmnetRptClientEntry* alloc_next_rpt_client_entry(RdmnetRptClientList* clist)
   }
   else
   {
-    clist->client_entries = ALLOC_RPT_CLIENT_ENTRY();
+    clist->client_entries = ALLOC_RPT_CLIENT_ENTRY(arena);
     if (clist->client_entries)
       clist->num_client_entries = 1;
     return clist->client_entries;
@@ -1093,14 +1204,15 @@ RdmnetRptClientEntry* alloc_next_rpt_client_entry(RdmnetRptClientList* clist)
 }
 
 #if 0
-RdmnetEptClientEntry* alloc_next_ept_client_entry(RdmnetEptClientList* clist)
+RdmnetEptClientEntry* alloc_next_ept_client_entry(RdmnetEptClientList* clist, RCMsgArena* arena)
 {
   if (!RDMNET_ASSERT_VERIFY(clist))
     return NULL;
 
   if (clist->client_entries)
   {
-    RdmnetEptClientEntry* new_arr = REALLOC_EPT_CLIENT_ENTRY(clist->client_entries, clist->num_client_entries + 1);
+    RdmnetEptClientEntry* new_arr =
+        REALLOC_EPT_CLIENT_ENTRY(arena, clist->client_entries, clist->num_client_entries + 1);
     if (new_arr)
     {
       clist->client_entries = new_arr;
@@ -1113,7 +1225,7 @@ RdmnetEptClientEntry* alloc_next_ept_client_entry(RdmnetEptClientList* clist)
   }
   else
   {
-    clist->client_entries = ALLOC_EPT_CLIENT_ENTRY();
+    clist->client_entries = ALLOC_EPT_CLIENT_ENTRY(arena);
     if (clist->client_entries)
       clist->num_client_entries = 1;
     return clist->client_entries;
@@ -1125,6 +1237,7 @@ size_t parse_request_dynamic_uid_assignment(GenericListState*            lstate,
                                             const uint8_t*               data,
                                             size_t                       data_len,
                                             BrokerDynamicUidRequestList* rlist,
+                                            RCMsgArena*                  arena,
                                             rc_parse_result_t*           result)
 {
   ETCPAL_UNUSED_ARG(rdmnet_log_params);
@@ -1144,7 +1257,8 @@ size_t parse_request_dynamic_uid_assignment(GenericListState*            lstate,
     // Make room for a new struct at the end of the current array.
     if (rlist->requests)
     {
-      BrokerDynamicUidRequest* new_arr = REALLOC_DYNAMIC_UID_REQUEST_ENTRY(rlist->requests, rlist->num_requests + 1);
+      BrokerDynamicUidRequest* new_arr =
+          REALLOC_DYNAMIC_UID_REQUEST_ENTRY(arena, rlist->requests, rlist->num_requests + 1);
       if (new_arr)
       {
         rlist->requests = new_arr;
@@ -1159,7 +1273,7 @@ size_t parse_request_dynamic_uid_assignment(GenericListState*            lstate,
     }
     else
     {
-      rlist->requests = ALLOC_DYNAMIC_UID_REQUEST_ENTRY();
+      rlist->requests = ALLOC_DYNAMIC_UID_REQUEST_ENTRY(arena);
       if (!rlist->requests)
       {
         res = kRCParseResNoData;
@@ -1189,6 +1303,7 @@ size_t parse_dynamic_uid_assignment_list(GenericListState*               lstate,
                                          const uint8_t*                  data,
                                          size_t                          data_len,
                                          RdmnetDynamicUidAssignmentList* alist,
+                                         RCMsgArena*                     arena,
                                          rc_parse_result_t*              result)
 {
   ETCPAL_UNUSED_ARG(rdmnet_log_params);
@@ -1208,7 +1323,7 @@ size_t parse_dynamic_uid_assignment_list(GenericListState*               lstate,
     // Make room for a new struct at the end of the current array.
     if (alist->mappings)
     {
-      RdmnetDynamicUidMapping* new_arr = REALLOC_DYNAMIC_UID_MAPPING(alist->mappings, alist->num_mappings + 1);
+      RdmnetDynamicUidMapping* new_arr = REALLOC_DYNAMIC_UID_MAPPING(arena, alist->mappings, alist->num_mappings + 1);
       if (new_arr)
       {
         alist->mappings = new_arr;
@@ -1223,7 +1338,7 @@ size_t parse_dynamic_uid_assignment_list(GenericListState*               lstate,
     }
     else
     {
-      alist->mappings = ALLOC_DYNAMIC_UID_MAPPING();
+      alist->mappings = ALLOC_DYNAMIC_UID_MAPPING(arena);
       if (!alist->mappings)
       {
         res = kRCParseResNoData;
@@ -1261,6 +1376,7 @@ size_t parse_fetch_dynamic_uid_assignment_list(GenericListState*             lst
                                                const uint8_t*                data,
                                                size_t                        data_len,
                                                BrokerFetchUidAssignmentList* alist,
+                                               RCMsgArena*                   arena,
                                                rc_parse_result_t*            result)
 {
   if (!RDMNET_ASSERT_VERIFY(lstate) || !RDMNET_ASSERT_VERIFY(alist) || !RDMNET_ASSERT_VERIFY(result))
@@ -1280,7 +1396,7 @@ size_t parse_fetch_dynamic_uid_assignment_list(GenericListState*             lst
     // Make room for a new struct at the end of the current array.
     if (alist->uids)
     {
-      RdmUid* new_arr = REALLOC_FETCH_UID_ASSIGNMENT(alist->uids, alist->num_uids + 1);
+      RdmUid* new_arr = REALLOC_FETCH_UID_ASSIGNMENT(arena, alist->uids, alist->num_uids + 1);
       if (new_arr)
       {
         alist->uids = new_arr;
@@ -1295,7 +1411,7 @@ size_t parse_fetch_dynamic_uid_assignment_list(GenericListState*             lst
     }
     else
     {
-      alist->uids = ALLOC_FETCH_UID_ASSIGNMENT();
+      alist->uids = ALLOC_FETCH_UID_ASSIGNMENT(arena);
       if (!alist->uids)
       {
         res = kRCParseResNoData;
@@ -1368,6 +1484,7 @@ size_t parse_rpt_block(RptState*          rstate,
                        const uint8_t*     data,
                        size_t             data_len,
                        RptMessage*        rmsg,
+                       RCMsgArena*        arena,
                        rc_parse_result_t* result)
 {
   if (!RDMNET_ASSERT_VERIFY(rstate) || !RDMNET_ASSERT_VERIFY(rmsg) || !RDMNET_ASSERT_VERIFY(result))
@@ -1448,7 +1565,7 @@ size_t parse_rpt_block(RptState*          rstate,
           return 0;
 
         next_layer_bytes_parsed =
-            parse_rdm_list(&rstate->data.rdm_list, &data[bytes_parsed], remaining_len, cmd_list, &res);
+            parse_rdm_list(&rstate->data.rdm_list, &data[bytes_parsed], remaining_len, cmd_list, arena, &res);
       }
       break;
       case VECTOR_RPT_STATUS: {
@@ -1457,7 +1574,7 @@ size_t parse_rpt_block(RptState*          rstate,
           return 0;
 
         next_layer_bytes_parsed =
-            parse_rpt_status(&rstate->data.status, &data[bytes_parsed], remaining_len, smsg, &res);
+            parse_rpt_status(&rstate->data.status, &data[bytes_parsed], remaining_len, smsg, arena, &res);
       }
       break;
       default:
@@ -1483,6 +1600,7 @@ size_t parse_rdm_list(RdmListState*      rlstate,
                       const uint8_t*     data,
                       size_t             data_len,
                       RptRdmBufList*     cmd_list,
+                      RCMsgArena*        arena,
                       rc_parse_result_t* result)
 {
   if (!RDMNET_ASSERT_VERIFY(rlstate) || !RDMNET_ASSERT_VERIFY(cmd_list) || !RDMNET_ASSERT_VERIFY(result))
@@ -1540,7 +1658,7 @@ size_t parse_rdm_list(RdmListState*      rlstate,
             // Make room for a new struct at the end of the current array.
             if (cmd_list->rdm_buffers)
             {
-              RdmBuffer* new_arr = REALLOC_RDM_BUFFER(cmd_list->rdm_buffers, cmd_list->num_rdm_buffers + 1);
+              RdmBuffer* new_arr = REALLOC_RDM_BUFFER(arena, cmd_list->rdm_buffers, cmd_list->num_rdm_buffers + 1);
               if (new_arr)
               {
                 cmd_list->rdm_buffers = new_arr;
@@ -1555,7 +1673,7 @@ size_t parse_rdm_list(RdmListState*      rlstate,
             }
             else
             {
-              cmd_list->rdm_buffers = ALLOC_RDM_BUFFER();
+              cmd_list->rdm_buffers = ALLOC_RDM_BUFFER(arena);
               if (!cmd_list->rdm_buffers)
               {
                 res = kRCParseResNoData;
@@ -1593,6 +1711,7 @@ size_t parse_rpt_status(RptStatusState*    rsstate,
                         const uint8_t*     data,
                         size_t             data_len,
                         RptStatusMsg*      smsg,
+                        RCMsgArena*        arena,
                         rc_parse_result_t* result)
 {
   if (!RDMNET_ASSERT_VERIFY(rsstate) || !RDMNET_ASSERT_VERIFY(data) || !RDMNET_ASSERT_VERIFY(smsg) ||
@@ -1686,7 +1805,7 @@ size_t parse_rpt_status(RptStatusState*    rsstate,
         }
         else if ((remaining_len >= str_len) && RDMNET_ASSERT_VERIFY(data))
         {
-          char* str_buf = ALLOC_RPT_STATUS_STR(str_len + 1);
+          char* str_buf = ALLOC_RPT_STATUS_STR(arena, str_len + 1);
           if (str_buf)
           {
             memcpy(str_buf, &data[bytes_parsed], str_len);
@@ -1719,22 +1838,19 @@ size_t locate_tcp_preamble(RCMsgBuf* msg_buf)
   if (!RDMNET_ASSERT_VERIFY(msg_buf))
     return 0;
 
-  if (msg_buf->cur_data_size < ACN_TCP_PREAMBLE_SIZE)
+  const uint8_t* data = &msg_buf->buf[msg_buf->cur_data_offset];
+  size_t         data_size = msg_buf->cur_data_size - msg_buf->cur_data_offset;
+  if (data_size < ACN_TCP_PREAMBLE_SIZE)
     return 0;
 
   size_t i = 0;
-  for (; i < (msg_buf->cur_data_size - ACN_TCP_PREAMBLE_SIZE); ++i)
+  for (; i < (data_size - ACN_TCP_PREAMBLE_SIZE); ++i)
   {
     AcnTcpPreamble preamble;
-    if (acn_parse_tcp_preamble(&msg_buf->buf[i], msg_buf->cur_data_size - i, &preamble))
+    if (acn_parse_tcp_preamble(&data[i], data_size - i, &preamble))
     {
       // Discard the data before and including the TCP preamble.
-      if (msg_buf->cur_data_size > i + ACN_TCP_PREAMBLE_SIZE)
-      {
-        memmove(msg_buf->buf, &msg_buf->buf[i + ACN_TCP_PREAMBLE_SIZE],
-                msg_buf->cur_data_size - (i + ACN_TCP_PREAMBLE_SIZE));
-      }
-      msg_buf->cur_data_size -= (i + ACN_TCP_PREAMBLE_SIZE);
+      discard_data(msg_buf, i + ACN_TCP_PREAMBLE_SIZE);
       return preamble.rlp_block_len;
     }
   }
@@ -1742,12 +1858,23 @@ size_t locate_tcp_preamble(RCMsgBuf* msg_buf)
   {
     // Discard data from the range that has been determined definitively to not contain a TCP
     // preamble.
-    memmove(msg_buf->buf, &msg_buf->buf[i], msg_buf->cur_data_size - i);
-    msg_buf->cur_data_size -= i;
+    discard_data(msg_buf, i);
   }
   return 0;
 }
 
+// Skip over data at the front of the buffer. The buffer is rewound to the beginning when it
+// becomes empty.
+void discard_data(RCMsgBuf* msg_buf, size_t size)
+{
+  msg_buf->cur_data_offset += size;
+  if (msg_buf->cur_data_offset >= msg_buf->cur_data_size)
+  {
+    msg_buf->cur_data_offset = 0;
+    msg_buf->cur_data_size = 0;
+  }
+}
+
 size_t consume_bad_block(PduBlockState* block, size_t data_len, rc_parse_result_t* parse_res)
 {
   if (!RDMNET_ASSERT_VERIFY(block) || !RDMNET_ASSERT_VERIFY(parse_res))
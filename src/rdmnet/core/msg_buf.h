@@ -234,13 +234,29 @@ typedef struct RlpState
     INIT_PDU_BLOCK_STATE(&(rlpstateptr)->block, blocksize); \
   }
 
+// The size of a statically-allocated receive buffer, and the minimum size of a dynamic one.
 #define RC_MSG_BUF_SIZE (RDMNET_RECV_DATA_MAX_SIZE * 2)
 
+// A receive buffer and the state of the message being parsed from it. Valid data lies between
+// cur_data_offset and cur_data_size; parsed data is skipped over and the buffer is only compacted
+// when more room is needed at the end.
 typedef struct RCMsgBuf
 {
-  uint8_t       buf[RC_MSG_BUF_SIZE];
+#if RDMNET_DYNAMIC_MEM
+  uint8_t* buf;
+#else
+  uint8_t buf[RC_MSG_BUF_SIZE];
+#endif
+  size_t        buf_size;
+  size_t        cur_data_offset;
   size_t        cur_data_size;
   RdmnetMessage msg;
+  RCMsgArena    arena;
+
+  // The bytes that msg was parsed from (TCP preamble included), when it was received and parsed as
+  // a single contiguous Root Layer PDU block. NULL otherwise. Valid until more data is received.
+  const uint8_t* raw_msg;
+  size_t         raw_msg_size;
 
   bool     have_preamble;
   RlpState rlp_state;
@@ -252,7 +268,10 @@ typedef struct RCMsgBuf
 extern "C" {
 #endif
 
-void           rc_msg_buf_init(RCMsgBuf* msg_buf);
+bool           rc_msg_buf_init(RCMsgBuf* msg_buf, size_t size);
+void           rc_msg_buf_cleanup(RCMsgBuf* msg_buf);
+void           rc_msg_buf_reset(RCMsgBuf* msg_buf);
+size_t         rc_msg_buf_make_room(RCMsgBuf* msg_buf);
 etcpal_error_t rc_msg_buf_recv(RCMsgBuf* buf, etcpal_socket_t socket);
 etcpal_error_t rc_msg_buf_parse_data(RCMsgBuf* msg_buf);
 
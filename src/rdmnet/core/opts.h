@@ -95,6 +95,47 @@ extern "C" {
 #define RDMNET_DYNAMIC_MEM RDMNET_FULL_OS_AVAILABLE_HINT
 #endif
 
+/**
+ * @brief The default size in bytes of the receive buffer for each RDMnet TCP connection.
+ *
+ * A larger buffer lets bursts of messages (e.g. a long connected client list or a flood of
+ * notifications) be pulled from the network stack in fewer reads. Meaningful only if
+ * #RDMNET_DYNAMIC_MEM is defined nonzero; otherwise each connection uses a small fixed-size buffer.
+ */
+#ifndef RDMNET_RECV_BUF_DEFAULT_SIZE
+#define RDMNET_RECV_BUF_DEFAULT_SIZE 65536
+#endif
+
+/**
+ * @brief The size in bytes of the outbound queue used to coalesce outgoing messages on each RDMnet
+ *        TCP connection.
+ *
+ * Each outgoing message is assembled in this queue and handed to the network stack with a single
+ * send call; data the socket cannot accept immediately stays queued and is sent from the
+ * background thread. If #RDMNET_DYNAMIC_MEM is defined nonzero, this is the initial size of the
+ * queue, which grows as needed. Otherwise it is the fixed size of the queue, and message pieces
+ * which do not fit even after the queue is emptied are sent directly.
+ */
+#ifndef RDMNET_CONN_SEND_BUF_SIZE
+#define RDMNET_CONN_SEND_BUF_SIZE 1400
+#endif
+
+/**
+ * @brief The number of queued outbound bytes at which an RDMnet TCP connection stops accepting new
+ *        messages.
+ *
+ * Once this many bytes are waiting for the socket to become writable, attempts to send further
+ * messages on the connection fail with #kEtcPalErrWouldBlock until the queue drains, so that a
+ * sender outpacing the network is told to back off instead of blocking.
+ */
+#ifndef RDMNET_CONN_SEND_QUEUE_HIGH_WATER
+#if RDMNET_DYNAMIC_MEM
+#define RDMNET_CONN_SEND_QUEUE_HIGH_WATER 65536
+#else
+#define RDMNET_CONN_SEND_QUEUE_HIGH_WATER RDMNET_CONN_SEND_BUF_SIZE
+#endif
+#endif
+
 /**
  * @brief A string which will be prepended to all log messages from the RDMnet library.
  */
@@ -184,6 +225,19 @@ bool rdmnet_assert_verify_fail(const char* exp, const char* file, const char* fu
 #define RDMNET_MAX_SCOPES_PER_CONTROLLER 1
 #endif
 
+/**
+ * @brief The maximum number of RDM commands awaiting a response that can be tracked on each scope
+ *        of a controller instance with request tracking enabled.
+ *
+ * Meaningful only if #RDMNET_DYNAMIC_MEM is defined to 0. Once this many commands are outstanding
+ * on a scope, sending further commands fails with #kEtcPalErrNoMem until some of them complete.
+ * Space for this many commands is reserved for each of the #RDMNET_MAX_SCOPES_PER_CONTROLLER scopes
+ * of each of the #RDMNET_MAX_CONTROLLERS controller instances; devices and EPT clients reserve none.
+ */
+#ifndef RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE
+#define RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE 8
+#endif
+
 /**
  * @brief The maximum number of nonzero endpoints that can be added to each device instance.
  *
@@ -252,6 +306,11 @@ bool rdmnet_assert_verify_fail(const char* exp, const char* file, const char* fu
 #define RDMNET_MAX_SENT_ACK_OVERFLOW_RESPONSES 1
 #endif
 
+#if RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE < 1
+#undef RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE
+#define RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE 1
+#endif
+
 #ifndef RDMNET_MAX_CONNECTIONS
 #define RDMNET_MAX_CONNECTIONS RDMNET_MAX_CLIENTS
 #endif
@@ -366,6 +425,35 @@ bool rdmnet_assert_verify_fail(const char* exp, const char* file, const char* fu
 #define RDMNET_BIND_MCAST_SOCKETS_TO_MCAST_ADDRESS !RDMNET_WINDOWS_HINT
 #endif
 
+/**
+ * @brief The maximum number of datagrams read from a multicast (LLRP or mDNS) socket each time it
+ *        is reported readable.
+ *
+ * Multicast receive sockets are non-blocking; each time one becomes readable, it is drained until
+ * it has no more data or this many datagrams have been processed. Larger values let discovery on
+ * large networks keep up with bursts of replies; smaller values bound the time spent on a single
+ * socket before other sockets are serviced.
+ */
+#ifndef RDMNET_MCAST_RECV_BATCH_SIZE
+#define RDMNET_MCAST_RECV_BATCH_SIZE 32
+#endif
+
+#if RDMNET_MCAST_RECV_BATCH_SIZE < 1
+#undef RDMNET_MCAST_RECV_BATCH_SIZE
+#define RDMNET_MCAST_RECV_BATCH_SIZE 1
+#endif
+
+/**
+ * @brief The receive buffer size (SO_RCVBUF) requested for multicast (LLRP and mDNS) sockets.
+ *
+ * Bursts of discovery replies on large networks can overflow the system's default socket receive
+ * buffer before they are read. Define to 0 to leave the system default in place. Some platforms
+ * cap or ignore this value.
+ */
+#ifndef RDMNET_MCAST_RECV_SOCKET_BUF_SIZE
+#define RDMNET_MCAST_RECV_SOCKET_BUF_SIZE 262144
+#endif
+
 /**
  * @brief The priority of the tick thread.
  *
@@ -475,6 +563,39 @@ bool rdmnet_assert_verify_fail(const char* exp, const char* file, const char* fu
 
 /** @endcond */
 
+/**
+ * @brief The maximum number of LLRP probe requests an LLRP manager keeps outstanding at once during
+ *        discovery.
+ *
+ * LLRP discovery divides the UID space into disjoint ranges, splitting ranges as targets are
+ * discovered in them. Each range is probed independently, so several probe requests can be
+ * awaiting replies at the same time.
+ */
+#ifndef RDMNET_LLRP_MANAGER_MAX_PROBES_IN_FLIGHT
+#define RDMNET_LLRP_MANAGER_MAX_PROBES_IN_FLIGHT 32
+#endif
+
+#if RDMNET_LLRP_MANAGER_MAX_PROBES_IN_FLIGHT < 1
+#undef RDMNET_LLRP_MANAGER_MAX_PROBES_IN_FLIGHT
+#define RDMNET_LLRP_MANAGER_MAX_PROBES_IN_FLIGHT 1
+#endif
+
+/**
+ * @brief The maximum number of UID ranges an LLRP manager can divide discovery into.
+ *
+ * Meaningful only if #RDMNET_DYNAMIC_MEM is defined to 0. Each range stores a Known UID list of up
+ * to #LLRP_KNOWN_UID_SIZE UIDs. If a range fills its Known UID list and no more ranges can be
+ * created, the range is narrowed and the rest of it is probed afterwards, so discovery takes longer.
+ */
+#ifndef RDMNET_LLRP_MANAGER_MAX_PROBE_RANGES
+#define RDMNET_LLRP_MANAGER_MAX_PROBE_RANGES 4
+#endif
+
+#if RDMNET_LLRP_MANAGER_MAX_PROBE_RANGES < 1
+#undef RDMNET_LLRP_MANAGER_MAX_PROBE_RANGES
+#define RDMNET_LLRP_MANAGER_MAX_PROBE_RANGES 1
+#endif
+
 /**
  * @}
  */
@@ -0,0 +1,314 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "rdmnet/core/request_table.h"
+
+#include <string.h>
+#include "rdmnet/core/common.h"
+
+#if RDMNET_DYNAMIC_MEM
+#include <stdlib.h>
+#endif
+
+/*************************** Private constants *******************************/
+
+#define INITIAL_REQUEST_TABLE_CAPACITY 16
+
+#if RDMNET_DYNAMIC_MEM
+#define REQUEST_TABLE_CAPACITY(table) ((table)->capacity)
+#else
+#define REQUEST_TABLE_CAPACITY(table) RC_REQUEST_TABLE_STATIC_CAPACITY
+#endif
+
+/*********************** Private function prototypes *************************/
+
+static size_t                request_slot(const RCRequestTable* table, uint32_t seq_num);
+static size_t                destination_slot(const RCRequestTable* table, const RdmUid* uid);
+static bool                  make_request_table_room(RCRequestTable* table);
+static RCTrackedRequest*     insert_request(RCRequestTable* table, uint32_t seq_num);
+static RCRequestDestination* find_destination(const RCRequestTable* table, const RdmUid* uid);
+static RCRequestDestination* insert_destination(RCRequestTable* table, const RdmUid* uid);
+static void                  remove_destination_slot(RCRequestTable* table, size_t hole);
+
+/*************************** Function definitions ****************************/
+
+/*
+ * Initialize a request table. If RDMNET_DYNAMIC_MEM=1, no memory is allocated until the first
+ * request is added.
+ */
+void rc_request_table_init(RCRequestTable* table)
+{
+  if (!RDMNET_ASSERT_VERIFY(table))
+    return;
+
+#if RDMNET_DYNAMIC_MEM
+  table->requests = NULL;
+  table->destinations = NULL;
+  table->capacity = 0;
+#else
+  memset(table->requests, 0, sizeof(table->requests));
+  memset(table->destinations, 0, sizeof(table->destinations));
+#endif
+  table->num_requests = 0;
+}
+
+/* Remove all requests from a request table and free any memory associated with it. */
+void rc_request_table_cleanup(RCRequestTable* table)
+{
+  if (!RDMNET_ASSERT_VERIFY(table))
+    return;
+
+#if RDMNET_DYNAMIC_MEM
+  if (table->requests)
+    free(table->requests);
+  if (table->destinations)
+    free(table->destinations);
+#endif
+  rc_request_table_init(table);
+}
+
+/*
+ * Add a request with the given sequence number and destination to a request table, counting it as
+ * in flight to the destination's RDMnet client. Returns the new entry, for the caller to fill in
+ * the rest of the request, or NULL if there is no room or the sequence number is already tracked.
+ */
+RCTrackedRequest* rc_request_table_add(RCRequestTable*              table,
+                                       uint32_t                     seq_num,
+                                       const RdmnetDestinationAddr* destination)
+{
+  if (!RDMNET_ASSERT_VERIFY(table) || !RDMNET_ASSERT_VERIFY(destination))
+    return NULL;
+
+  if (rc_request_table_find(table, seq_num) || !make_request_table_room(table))
+    return NULL;
+
+  RCRequestDestination* dest = find_destination(table, &destination->rdmnet_uid);
+  if (!dest)
+    dest = insert_destination(table, &destination->rdmnet_uid);
+  if (!RDMNET_ASSERT_VERIFY(dest))
+    return NULL;
+  ++dest->num_in_flight;
+
+  RCTrackedRequest* request = insert_request(table, seq_num);
+  if (!RDMNET_ASSERT_VERIFY(request))
+    return NULL;
+  request->destination = *destination;
+  return request;
+}
+
+/* Find the request with the given sequence number. Returns NULL if it is not being tracked. */
+RCTrackedRequest* rc_request_table_find(RCRequestTable* table, uint32_t seq_num)
+{
+  if (!RDMNET_ASSERT_VERIFY(table))
+    return NULL;
+
+  if (table->num_requests == 0)
+    return NULL;
+
+  for (size_t slot = request_slot(table, seq_num); table->requests[slot].in_use;
+       slot = (slot + 1) % REQUEST_TABLE_CAPACITY(table))
+  {
+    if (table->requests[slot].seq_num == seq_num)
+      return &table->requests[slot];
+  }
+  return NULL;
+}
+
+/*
+ * Remove the request with the given sequence number from a request table, copying it to removed
+ * if removed is non-NULL. Returns false if no such request was being tracked.
+ */
+bool rc_request_table_remove(RCRequestTable* table, uint32_t seq_num, RCTrackedRequest* removed)
+{
+  if (!RDMNET_ASSERT_VERIFY(table))
+    return false;
+
+  RCTrackedRequest* request = rc_request_table_find(table, seq_num);
+  if (!request)
+    return false;
+
+  if (removed)
+    *removed = *request;
+
+  RCRequestDestination* dest = find_destination(table, &request->destination.rdmnet_uid);
+  if (RDMNET_ASSERT_VERIFY(dest) && --dest->num_in_flight == 0)
+    remove_destination_slot(table, (size_t)(dest - table->destinations));
+
+  // Backward-shift deletion: move later entries of the probe sequence up into the hole so that
+  // lookups never need tombstones.
+  const size_t capacity = REQUEST_TABLE_CAPACITY(table);
+  size_t       hole = (size_t)(request - table->requests);
+  for (size_t slot = (hole + 1) % capacity; table->requests[slot].in_use; slot = (slot + 1) % capacity)
+  {
+    size_t home = request_slot(table, table->requests[slot].seq_num);
+    if ((slot > hole && (home <= hole || home > slot)) || (slot < hole && (home <= hole && home > slot)))
+    {
+      table->requests[hole] = table->requests[slot];
+      hole = slot;
+    }
+  }
+  table->requests[hole].in_use = false;
+  --table->num_requests;
+  return true;
+}
+
+/*
+ * Iterate over the requests in a request table. Start with *index at 0; returns the next request
+ * at or after *index and advances *index past it, or NULL when there are no more. The table must
+ * not be modified while iterating.
+ */
+RCTrackedRequest* rc_request_table_next(RCRequestTable* table, size_t* index)
+{
+  if (!RDMNET_ASSERT_VERIFY(table) || !RDMNET_ASSERT_VERIFY(index))
+    return NULL;
+
+  if (table->num_requests == 0)
+    return NULL;
+
+  for (; *index < REQUEST_TABLE_CAPACITY(table); ++(*index))
+  {
+    if (table->requests[*index].in_use)
+      return &table->requests[(*index)++];
+  }
+  return NULL;
+}
+
+/* Get the number of requests in flight to the RDMnet client with the given UID. */
+size_t rc_request_table_num_in_flight(const RCRequestTable* table, const RdmUid* dest_uid)
+{
+  if (!RDMNET_ASSERT_VERIFY(table) || !RDMNET_ASSERT_VERIFY(dest_uid))
+    return 0;
+
+  const RCRequestDestination* dest = find_destination(table, dest_uid);
+  return (dest ? dest->num_in_flight : 0);
+}
+
+size_t request_slot(const RCRequestTable* table, uint32_t seq_num)
+{
+  // Sequence numbers are assigned consecutively, so they spread evenly over the table as they are.
+  return (size_t)(seq_num % REQUEST_TABLE_CAPACITY(table));
+}
+
+size_t destination_slot(const RCRequestTable* table, const RdmUid* uid)
+{
+  uint32_t hash = ((uint32_t)uid->manu << 16) ^ uid->id ^ (uid->id >> 16);
+  hash *= 2654435761u;
+  return (size_t)(hash % REQUEST_TABLE_CAPACITY(table));
+}
+
+/*
+ * Make sure there is room in a request table for one more request (and its destination), keeping
+ * the table at most half full. Rehashes into a larger table if necessary.
+ */
+bool make_request_table_room(RCRequestTable* table)
+{
+#if RDMNET_DYNAMIC_MEM
+  if ((table->num_requests + 1) * 2 <= table->capacity)
+    return true;
+
+  RCRequestTable new_table;
+  new_table.capacity = (table->capacity ? table->capacity * 2 : INITIAL_REQUEST_TABLE_CAPACITY);
+  new_table.requests = (RCTrackedRequest*)calloc(new_table.capacity, sizeof(RCTrackedRequest));
+  new_table.destinations = (RCRequestDestination*)calloc(new_table.capacity, sizeof(RCRequestDestination));
+  new_table.num_requests = 0;
+  if (!new_table.requests || !new_table.destinations)
+  {
+    rc_request_table_cleanup(&new_table);
+    return false;
+  }
+
+  for (size_t i = 0; i < table->capacity; ++i)
+  {
+    if (table->requests[i].in_use)
+    {
+      RCTrackedRequest* request = insert_request(&new_table, table->requests[i].seq_num);
+      if (RDMNET_ASSERT_VERIFY(request))
+        *request = table->requests[i];
+    }
+    if (table->destinations[i].num_in_flight > 0)
+    {
+      RCRequestDestination* dest = insert_destination(&new_table, &table->destinations[i].uid);
+      if (RDMNET_ASSERT_VERIFY(dest))
+        dest->num_in_flight = table->destinations[i].num_in_flight;
+    }
+  }
+
+  rc_request_table_cleanup(table);
+  *table = new_table;
+  return true;
+#else
+  return ((table->num_requests + 1) <= RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE);
+#endif
+}
+
+RCTrackedRequest* insert_request(RCRequestTable* table, uint32_t seq_num)
+{
+  size_t slot = request_slot(table, seq_num);
+  while (table->requests[slot].in_use)
+    slot = (slot + 1) % REQUEST_TABLE_CAPACITY(table);
+
+  RCTrackedRequest* request = &table->requests[slot];
+  memset(request, 0, sizeof(RCTrackedRequest));
+  request->in_use = true;
+  request->seq_num = seq_num;
+  ++table->num_requests;
+  return request;
+}
+
+RCRequestDestination* find_destination(const RCRequestTable* table, const RdmUid* uid)
+{
+  if (table->num_requests == 0)
+    return NULL;
+
+  for (size_t slot = destination_slot(table, uid); table->destinations[slot].num_in_flight > 0;
+       slot = (slot + 1) % REQUEST_TABLE_CAPACITY(table))
+  {
+    if (RDM_UID_EQUAL(&table->destinations[slot].uid, uid))
+      return (RCRequestDestination*)&table->destinations[slot];
+  }
+  return NULL;
+}
+
+RCRequestDestination* insert_destination(RCRequestTable* table, const RdmUid* uid)
+{
+  // There are never more destinations than requests, so this always finds an empty slot.
+  size_t slot = destination_slot(table, uid);
+  while (table->destinations[slot].num_in_flight > 0)
+    slot = (slot + 1) % REQUEST_TABLE_CAPACITY(table);
+
+  RCRequestDestination* dest = &table->destinations[slot];
+  dest->uid = *uid;
+  dest->num_in_flight = 0;
+  return dest;
+}
+
+void remove_destination_slot(RCRequestTable* table, size_t hole)
+{
+  const size_t capacity = REQUEST_TABLE_CAPACITY(table);
+  for (size_t slot = (hole + 1) % capacity; table->destinations[slot].num_in_flight > 0; slot = (slot + 1) % capacity)
+  {
+    size_t home = destination_slot(table, &table->destinations[slot].uid);
+    if ((slot > hole && (home <= hole || home > slot)) || (slot < hole && (home <= hole && home > slot)))
+    {
+      table->destinations[hole] = table->destinations[slot];
+      hole = slot;
+    }
+  }
+  table->destinations[hole].num_in_flight = 0;
+}
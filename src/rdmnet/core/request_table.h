@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+/**
+ * @file rdmnet/core/request_table.h
+ * @brief Tracking of the RDM commands a controller has sent and is awaiting responses to.
+ */
+
+#ifndef RDMNET_CORE_REQUEST_TABLE_H_
+#define RDMNET_CORE_REQUEST_TABLE_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "rdm/message.h"
+#include "rdm/uid.h"
+#include "rdmnet/client.h"
+#include "rdmnet/core/opts.h"
+#include "etcpal/timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * An RCRequestTable holds the RDM commands that have been sent on a scope and are awaiting a
+ * response. Requests are found by their RPT sequence number in constant time, and the table keeps
+ * a count of the requests in flight to each destination RDMnet client so that the load placed on
+ * any one device or gateway can be limited without searching the whole table.
+ *
+ * Both lookups are open-addressed hash tables with linear probing, kept at most half full. If
+ * RDMNET_DYNAMIC_MEM=1, the table is allocated on first use and grows as needed; otherwise it
+ * holds at most RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE requests.
+ */
+typedef struct RCTrackedRequest
+{
+  bool                   in_use;
+  uint32_t               seq_num;
+  RdmnetDestinationAddr  destination;
+  rdmnet_command_class_t command_class;
+  uint16_t               param_id;
+  uint8_t                data[RDM_MAX_PDL];
+  uint8_t                data_len;
+  EtcPalTimer            timer;
+  unsigned int           retries_left;
+} RCTrackedRequest;
+
+typedef struct RCRequestDestination
+{
+  RdmUid uid;
+  size_t num_in_flight;  // An unused slot has no requests in flight.
+} RCRequestDestination;
+
+#define RC_REQUEST_TABLE_STATIC_CAPACITY (RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE * 2)
+
+typedef struct RCRequestTable
+{
+#if RDMNET_DYNAMIC_MEM
+  RCTrackedRequest*     requests;
+  RCRequestDestination* destinations;
+  size_t                capacity;
+#else
+  RCTrackedRequest     requests[RC_REQUEST_TABLE_STATIC_CAPACITY];
+  RCRequestDestination destinations[RC_REQUEST_TABLE_STATIC_CAPACITY];
+#endif
+  size_t num_requests;
+} RCRequestTable;
+
+void              rc_request_table_init(RCRequestTable* table);
+void              rc_request_table_cleanup(RCRequestTable* table);
+RCTrackedRequest* rc_request_table_add(RCRequestTable*              table,
+                                       uint32_t                     seq_num,
+                                       const RdmnetDestinationAddr* destination);
+RCTrackedRequest* rc_request_table_find(RCRequestTable* table, uint32_t seq_num);
+bool              rc_request_table_remove(RCRequestTable* table, uint32_t seq_num, RCTrackedRequest* removed);
+RCTrackedRequest* rc_request_table_next(RCRequestTable* table, size_t* index);
+size_t            rc_request_table_num_in_flight(const RCRequestTable* table, const RdmUid* dest_uid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RDMNET_CORE_REQUEST_TABLE_H_ */
@@ -66,9 +66,7 @@ static void           pack_rpt_header(size_t length, uint32_t vector, const RptH
 static etcpal_error_t send_rpt_header(RCConnection*          conn,
                                       const AcnRootLayerPdu* rlp,
                                       uint32_t               rc_rpt_vector,
-                                      const RptHeader*       header,
-                                      uint8_t*               buf,
-                                      size_t                 buflen);
+                                      const RptHeader*       header);
 static size_t         calc_request_pdu_size(const RdmBuffer* cmd);
 static size_t         calc_status_pdu_size(const RptStatusMsg* status);
 static size_t         calc_notification_pdu_size(const RdmBuffer* cmd_arr, size_t num_cmds);
@@ -128,45 +126,24 @@ size_t pack_rpt_header_with_rlp(const AcnRootLayerPdu* rlp,
 etcpal_error_t send_rpt_header(RCConnection*          conn,
                                const AcnRootLayerPdu* rlp,
                                uint32_t               rc_rpt_vector,
-                               const RptHeader*       header,
-                               uint8_t*               buf,
-                               size_t                 buflen)
+                               const RptHeader*       header)
 {
-  if (!RDMNET_ASSERT_VERIFY(conn) || !RDMNET_ASSERT_VERIFY(rlp) || !RDMNET_ASSERT_VERIFY(header) ||
-      !RDMNET_ASSERT_VERIFY(buf))
-  {
+  if (!RDMNET_ASSERT_VERIFY(conn) || !RDMNET_ASSERT_VERIFY(rlp) || !RDMNET_ASSERT_VERIFY(header))
     return kEtcPalErrSys;
-  }
-
-  size_t data_size = acn_root_layer_buf_size(rlp, 1);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
 
-  // Pack and send the TCP preamble.
-  data_size = acn_pack_tcp_preamble(buf, buflen, data_size);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
-
-  int send_res = rc_send(conn->sock, buf, data_size, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  // Refuse new messages while the connection's outbound queue is backed up.
+  etcpal_error_t res = rc_send_buf_begin_message(&conn->send_buf);
+  if (res != kEtcPalErrOk)
+    return res;
 
-  // Pack and send the Root Layer PDU header
-  data_size = acn_pack_root_layer_header(buf, buflen, rlp);
+  // Pack the TCP preamble, Root Layer PDU header and RPT PDU header together and queue them in the
+  // connection's send buffer.
+  uint8_t buf[RPT_PDU_FULL_HEADER_SIZE];
+  size_t  data_size = pack_rpt_header_with_rlp(rlp, buf, RPT_PDU_FULL_HEADER_SIZE, rc_rpt_vector, header);
   if (data_size == 0)
     return kEtcPalErrProtocol;
 
-  send_res = rc_send(conn->sock, buf, data_size, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  // Pack and send the RPT PDU header
-  pack_rpt_header(rlp->data_len, rc_rpt_vector, header, buf);
-  send_res = rc_send(conn->sock, buf, RPT_PDU_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  return kEtcPalErrOk;
+  return rc_send_buf_append(&conn->send_buf, conn->sock, buf, data_size);
 }
 
 size_t calc_request_pdu_size(const RdmBuffer* cmd)
@@ -234,6 +211,7 @@ size_t rc_rpt_pack_request(uint8_t*          buf,
  *  @return #kEtcPalErrOk: Send success.\n
  *          #kEtcPalErrInvalid: Invalid argument provided.\n
  *          #kEtcPalErrSys: An internal library or system call error occurred.\n
+ *          #kEtcPalErrWouldBlock: The connection's outbound queue is full; try again later.\n
  *          Note: Other error codes might be propagated from underlying socket calls.\n
  */
 etcpal_error_t rc_rpt_send_request(RCConnection*     conn,
@@ -252,22 +230,22 @@ etcpal_error_t rc_rpt_send_request(RCConnection*     conn,
   rlp.vector = ACN_VECTOR_ROOT_RPT;
   rlp.data_len = RPT_PDU_HEADER_SIZE + calc_request_pdu_size(cmd);
 
-  uint8_t        buf[RDM_CMD_PDU_MAX_SIZE];
-  etcpal_error_t res = send_rpt_header(conn, &rlp, VECTOR_RPT_REQUEST, header, buf, RDM_CMD_PDU_MAX_SIZE);
+  etcpal_error_t res = send_rpt_header(conn, &rlp, VECTOR_RPT_REQUEST, header);
   if (res != kEtcPalErrOk)
     return res;
 
+  uint8_t buf[RDM_CMD_PDU_MAX_SIZE];
   PACK_REQUEST_HEADER(rlp.data_len - RPT_PDU_HEADER_SIZE, buf);
-  int send_res = rc_send(conn->sock, buf, REQUEST_NOTIF_PDU_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, REQUEST_NOTIF_PDU_HEADER_SIZE);
+  if (res != kEtcPalErrOk)
+    return res;
 
   PACK_RDM_CMD_PDU(cmd, buf);
-  send_res = rc_send(conn->sock, buf, RDM_CMD_PDU_LEN(cmd), 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, RDM_CMD_PDU_LEN(cmd));
+  if (res != kEtcPalErrOk)
+    return res;
 
-  return kEtcPalErrOk;
+  return rc_send_buf_end_message(&conn->send_buf, conn->sock);
 }
 
 size_t calc_status_pdu_size(const RptStatusMsg* status)
@@ -337,6 +315,7 @@ size_t rc_rpt_pack_status(uint8_t*            buf,
  *  @return #kEtcPalErrOk: Send success.\n
  *          #kEtcPalErrInvalid: Invalid argument provided.\n
  *          #kEtcPalErrSys: An internal library or system call error occurred.\n
+ *          #kEtcPalErrWouldBlock: The connection's outbound queue is full; try again later.\n
  *          Note: Other error codes might be propagated from underlying socket calls.\n
  */
 etcpal_error_t rc_rpt_send_status(RCConnection*       conn,
@@ -357,24 +336,25 @@ etcpal_error_t rc_rpt_send_status(RCConnection*       conn,
   rlp.vector = ACN_VECTOR_ROOT_RPT;
   rlp.data_len = RPT_PDU_HEADER_SIZE + status_pdu_size;
 
-  uint8_t        buf[RPT_PDU_HEADER_SIZE];
-  etcpal_error_t res = send_rpt_header(conn, &rlp, VECTOR_RPT_STATUS, header, buf, RPT_PDU_HEADER_SIZE);
+  etcpal_error_t res = send_rpt_header(conn, &rlp, VECTOR_RPT_STATUS, header);
   if (res != kEtcPalErrOk)
     return res;
 
+  uint8_t buf[RPT_STATUS_HEADER_SIZE];
   PACK_STATUS_HEADER(status_pdu_size, (uint16_t)(status->status_code), buf);
-  int send_res = rc_send(conn->sock, buf, RPT_STATUS_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, RPT_STATUS_HEADER_SIZE);
+  if (res != kEtcPalErrOk)
+    return res;
 
   if (status_pdu_size > RPT_STATUS_HEADER_SIZE)
   {
-    send_res = rc_send(conn->sock, (uint8_t*)status->status_string, status_pdu_size - RPT_STATUS_HEADER_SIZE, 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
+    res = rc_send_buf_append(&conn->send_buf, conn->sock, status->status_string,
+                             status_pdu_size - RPT_STATUS_HEADER_SIZE);
+    if (res != kEtcPalErrOk)
+      return res;
   }
 
-  return kEtcPalErrOk;
+  return rc_send_buf_end_message(&conn->send_buf, conn->sock);
 }
 
 size_t calc_notification_pdu_size(const RdmBuffer* cmd_arr, size_t cmd_arr_size)
@@ -456,6 +436,7 @@ size_t rc_rpt_pack_notification(uint8_t*          buf,
  *  @return #kEtcPalErrOk: Send success.\n
  *          #kEtcPalErrInvalid: Invalid argument provided.\n
  *          #kEtcPalErrSys: An internal library or system call error occurred.\n
+ *          #kEtcPalErrWouldBlock: The connection's outbound queue is full; try again later.\n
  *          Note: Other error codes might be propagated from underlying socket calls.\n
  */
 etcpal_error_t rc_rpt_send_notification(RCConnection*     conn,
@@ -477,23 +458,23 @@ etcpal_error_t rc_rpt_send_notification(RCConnection*     conn,
   rlp.vector = ACN_VECTOR_ROOT_RPT;
   rlp.data_len = RPT_PDU_HEADER_SIZE + notif_pdu_size;
 
-  uint8_t        buf[RDM_CMD_PDU_MAX_SIZE];
-  etcpal_error_t res = send_rpt_header(conn, &rlp, VECTOR_RPT_NOTIFICATION, header, buf, RDM_CMD_PDU_MAX_SIZE);
+  etcpal_error_t res = send_rpt_header(conn, &rlp, VECTOR_RPT_NOTIFICATION, header);
   if (res != kEtcPalErrOk)
     return res;
 
+  uint8_t buf[RDM_CMD_PDU_MAX_SIZE];
   PACK_NOTIFICATION_HEADER(notif_pdu_size, buf);
-  int send_res = rc_send(conn->sock, buf, REQUEST_NOTIF_PDU_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, REQUEST_NOTIF_PDU_HEADER_SIZE);
+  if (res != kEtcPalErrOk)
+    return res;
 
   for (const RdmBuffer* cur_cmd = cmd_arr; cur_cmd < cmd_arr + cmd_arr_size; ++cur_cmd)
   {
     PACK_RDM_CMD_PDU(cur_cmd, buf);
-    send_res = rc_send(conn->sock, buf, RDM_CMD_PDU_LEN(cur_cmd), 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
+    res = rc_send_buf_append(&conn->send_buf, conn->sock, buf, RDM_CMD_PDU_LEN(cur_cmd));
+    if (res != kEtcPalErrOk)
+      return res;
   }
 
-  return kEtcPalErrOk;
+  return rc_send_buf_end_message(&conn->send_buf, conn->sock);
 }
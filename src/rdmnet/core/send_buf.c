@@ -0,0 +1,303 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "rdmnet/core/send_buf.h"
+
+#include <string.h>
+#include "etcpal/common.h"
+
+#if RDMNET_DYNAMIC_MEM
+#include <stdlib.h>
+#endif
+
+/*********************** Private function prototypes *************************/
+
+static bool make_send_buf_room(RCSendBuf* send_buf, size_t size);
+static void update_write_interest(RCSendBuf* send_buf, etcpal_socket_t sock);
+#if !RDMNET_DYNAMIC_MEM
+static etcpal_error_t send_queued_data_blocking(RCSendBuf* send_buf, etcpal_socket_t sock);
+#endif
+
+/*************************** Function definitions ****************************/
+
+/*
+ * Initialize a send buffer. If poll_info is non-NULL, write interest is registered with it while
+ * data is queued.
+ */
+void rc_send_buf_init(RCSendBuf* send_buf, RCPolledSocketInfo* poll_info)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf))
+    return;
+
+#if RDMNET_DYNAMIC_MEM
+  send_buf->data = NULL;
+  send_buf->data_capacity = 0;
+#endif
+  send_buf->poll_info = poll_info;
+  rc_send_buf_reset(send_buf);
+}
+
+/*
+ * Free any memory held by a send buffer.
+ */
+void rc_send_buf_cleanup(RCSendBuf* send_buf)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf))
+    return;
+
+#if RDMNET_DYNAMIC_MEM
+  if (send_buf->data)
+    free(send_buf->data);
+  send_buf->data = NULL;
+  send_buf->data_capacity = 0;
+#endif
+  rc_send_buf_reset(send_buf);
+}
+
+/*
+ * Discard any data pending in a send buffer and clear its corked state. Used when the associated
+ * socket is closed, so any registered write interest is forgotten rather than removed.
+ */
+void rc_send_buf_reset(RCSendBuf* send_buf)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf))
+    return;
+
+  send_buf->data_len = 0;
+  send_buf->sent_len = 0;
+  send_buf->message_start = 0;
+  send_buf->corked = false;
+  send_buf->write_pending = false;
+}
+
+/*
+ * Get the number of bytes in a send buffer which have not yet been sent.
+ */
+size_t rc_send_buf_queued_size(const RCSendBuf* send_buf)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf))
+    return 0;
+
+  return send_buf->data_len - send_buf->sent_len;
+}
+
+/*
+ * Start a new message on a send buffer. Returns kEtcPalErrWouldBlock if the queued data has
+ * reached RDMNET_CONN_SEND_QUEUE_HIGH_WATER.
+ */
+etcpal_error_t rc_send_buf_begin_message(RCSendBuf* send_buf)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf))
+    return kEtcPalErrSys;
+
+  if (rc_send_buf_queued_size(send_buf) >= RDMNET_CONN_SEND_QUEUE_HIGH_WATER)
+    return kEtcPalErrWouldBlock;
+
+  send_buf->message_start = send_buf->data_len;
+  return kEtcPalErrOk;
+}
+
+/*
+ * Append a piece of an outgoing message to a send buffer. On failure, the rest of the message
+ * begun with rc_send_buf_begin_message() is discarded.
+ */
+etcpal_error_t rc_send_buf_append(RCSendBuf* send_buf, etcpal_socket_t sock, const void* data, size_t data_len)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf) || !RDMNET_ASSERT_VERIFY(data))
+    return kEtcPalErrSys;
+
+  if (!make_send_buf_room(send_buf, data_len))
+  {
+#if RDMNET_DYNAMIC_MEM
+    ETCPAL_UNUSED_ARG(sock);
+    send_buf->data_len = send_buf->message_start;
+    return kEtcPalErrNoMem;
+#else
+    // The fixed-size queue is full; fall back to sending the queued data, blocking as necessary.
+    etcpal_error_t res = send_queued_data_blocking(send_buf, sock);
+    if (res != kEtcPalErrOk)
+      return res;
+
+    // A piece larger than the entire queue is sent directly.
+    if (data_len > RDMNET_CONN_SEND_BUF_SIZE)
+    {
+      int send_res = rc_send(sock, data, data_len, 0);
+      return (send_res < 0 ? (etcpal_error_t)send_res : kEtcPalErrOk);
+    }
+#endif
+  }
+
+  memcpy(&send_buf->data[send_buf->data_len], data, data_len);
+  send_buf->data_len += data_len;
+  return kEtcPalErrOk;
+}
+
+/*
+ * Mark the end of an outgoing message. The queued data is sent immediately (as far as the socket
+ * allows) unless the send buffer is corked.
+ */
+etcpal_error_t rc_send_buf_end_message(RCSendBuf* send_buf, etcpal_socket_t sock)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf))
+    return kEtcPalErrSys;
+
+  return (send_buf->corked ? kEtcPalErrOk : rc_send_buf_flush(send_buf, sock));
+}
+
+/*
+ * Send as much of the data queued in a send buffer as the socket will accept without blocking, and
+ * register or remove write interest depending on whether any data remains queued. On failure, the
+ * queued data is discarded.
+ */
+etcpal_error_t rc_send_buf_flush(RCSendBuf* send_buf, etcpal_socket_t sock)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf))
+    return kEtcPalErrSys;
+
+  while (send_buf->sent_len < send_buf->data_len)
+  {
+    int send_res =
+        rc_try_send(sock, &send_buf->data[send_buf->sent_len], send_buf->data_len - send_buf->sent_len, 0);
+    if (send_res > 0)
+    {
+      send_buf->sent_len += (size_t)send_res;
+    }
+    else if (send_res == 0 || (etcpal_error_t)send_res == kEtcPalErrWouldBlock)
+    {
+      break;
+    }
+    else
+    {
+      send_buf->data_len = 0;
+      send_buf->sent_len = 0;
+      send_buf->message_start = 0;
+      return (etcpal_error_t)send_res;
+    }
+  }
+
+  if (send_buf->sent_len == send_buf->data_len)
+  {
+    send_buf->data_len = 0;
+    send_buf->sent_len = 0;
+    send_buf->message_start = 0;
+  }
+  update_write_interest(send_buf, sock);
+  return kEtcPalErrOk;
+}
+
+/*
+ * Hold finished messages in a send buffer until rc_send_buf_uncork() is called.
+ */
+void rc_send_buf_cork(RCSendBuf* send_buf)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf))
+    return;
+
+  send_buf->corked = true;
+}
+
+/*
+ * Resume sending each message as it is finished, sending any messages held since
+ * rc_send_buf_cork() was called.
+ */
+etcpal_error_t rc_send_buf_uncork(RCSendBuf* send_buf, etcpal_socket_t sock)
+{
+  if (!RDMNET_ASSERT_VERIFY(send_buf))
+    return kEtcPalErrSys;
+
+  send_buf->corked = false;
+  return rc_send_buf_flush(send_buf, sock);
+}
+
+/*
+ * Ensure a send buffer has room to append size bytes, first by discarding data which has already
+ * been sent and then, if RDMNET_DYNAMIC_MEM=1, by growing the buffer. Returns false if the room
+ * could not be made.
+ */
+bool make_send_buf_room(RCSendBuf* send_buf, size_t size)
+{
+#if RDMNET_DYNAMIC_MEM
+  const size_t capacity = send_buf->data_capacity;
+#else
+  const size_t capacity = RDMNET_CONN_SEND_BUF_SIZE;
+#endif
+
+  if (size <= capacity - send_buf->data_len)
+    return true;
+
+  if (send_buf->sent_len > 0)
+  {
+    memmove(send_buf->data, &send_buf->data[send_buf->sent_len], send_buf->data_len - send_buf->sent_len);
+    send_buf->data_len -= send_buf->sent_len;
+    send_buf->message_start =
+        (send_buf->message_start > send_buf->sent_len ? send_buf->message_start - send_buf->sent_len : 0);
+    send_buf->sent_len = 0;
+    if (size <= capacity - send_buf->data_len)
+      return true;
+  }
+
+#if RDMNET_DYNAMIC_MEM
+  size_t new_capacity = (capacity == 0 ? RDMNET_CONN_SEND_BUF_SIZE : capacity * 2);
+  while (new_capacity - send_buf->data_len < size)
+    new_capacity *= 2;
+
+  uint8_t* new_data = (uint8_t*)realloc(send_buf->data, new_capacity);
+  if (!new_data)
+    return false;
+
+  send_buf->data = new_data;
+  send_buf->data_capacity = new_capacity;
+  return true;
+#else
+  return false;
+#endif
+}
+
+#if !RDMNET_DYNAMIC_MEM
+/*
+ * Send all data queued in a send buffer, blocking as necessary. Only used when a fixed-size send
+ * buffer overflows.
+ */
+etcpal_error_t send_queued_data_blocking(RCSendBuf* send_buf, etcpal_socket_t sock)
+{
+  etcpal_error_t res = kEtcPalErrOk;
+  if (send_buf->sent_len < send_buf->data_len)
+  {
+    int send_res = rc_send(sock, &send_buf->data[send_buf->sent_len], send_buf->data_len - send_buf->sent_len, 0);
+    if (send_res < 0)
+      res = (etcpal_error_t)send_res;
+  }
+  send_buf->data_len = 0;
+  send_buf->sent_len = 0;
+  send_buf->message_start = 0;
+  update_write_interest(send_buf, sock);
+  return res;
+}
+#endif
+
+void update_write_interest(RCSendBuf* send_buf, etcpal_socket_t sock)
+{
+  bool write_pending = (send_buf->sent_len < send_buf->data_len);
+  if (send_buf->poll_info && write_pending != send_buf->write_pending)
+  {
+    etcpal_poll_events_t events = (write_pending ? (ETCPAL_POLL_IN | ETCPAL_POLL_OUT) : ETCPAL_POLL_IN);
+    if (rc_modify_polled_socket(sock, events, send_buf->poll_info) == kEtcPalErrOk)
+      send_buf->write_pending = write_pending;
+  }
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+/**
+ * @file rdmnet/core/send_buf.h
+ * @brief Outbound data queueing for RDMnet TCP connections.
+ */
+
+#ifndef RDMNET_CORE_SEND_BUF_H_
+#define RDMNET_CORE_SEND_BUF_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "rdmnet/core/common.h"
+#include "rdmnet/core/opts.h"
+#include "etcpal/error.h"
+#include "etcpal/socket.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * An RCSendBuf is the outbound byte queue of an RDMnet TCP connection. It coalesces the pieces of
+ * each outgoing message so that the message reaches the network stack in a single send call, and
+ * holds whatever the socket cannot accept yet so that senders never block.
+ *
+ * Message senders call rc_send_buf_begin_message(), append each piece of the message with
+ * rc_send_buf_append() and finish with rc_send_buf_end_message(), which sends as much of the queue
+ * as the socket will accept without blocking. If data remains queued, write interest is
+ * registered on the send buffer's polled socket info (if any) and the remainder is sent by calling
+ * rc_send_buf_flush() again from the socket's ETCPAL_POLL_OUT handler. Once the queued data reaches
+ * RDMNET_CONN_SEND_QUEUE_HIGH_WATER bytes, rc_send_buf_begin_message() refuses new messages with
+ * kEtcPalErrWouldBlock until the queue drains. If rc_send_buf_append() fails, the pieces of the
+ * message already appended are discarded, so a partial message is never sent.
+ *
+ * While the buffer is corked, finished messages accumulate until rc_send_buf_uncork() is called,
+ * which allows several back-to-back messages to be batched into as few send calls as possible.
+ *
+ * If a send fails, any data pending in the buffer is discarded; the connection is not usable after
+ * a send failure in any case.
+ */
+typedef struct RCSendBuf
+{
+#if RDMNET_DYNAMIC_MEM
+  uint8_t* data;
+  size_t   data_capacity;
+#else
+  uint8_t data[RDMNET_CONN_SEND_BUF_SIZE];
+#endif
+  size_t              data_len;       // Bytes in data, including those which have already been sent.
+  size_t              sent_len;       // Bytes at the front of data which have already been sent.
+  size_t              message_start;  // Where in data the message being built begins.
+  bool                corked;
+  RCPolledSocketInfo* poll_info;      // Socket info with which to register write interest, or NULL.
+  bool                write_pending;  // Write interest is currently registered.
+} RCSendBuf;
+
+void           rc_send_buf_init(RCSendBuf* send_buf, RCPolledSocketInfo* poll_info);
+void           rc_send_buf_cleanup(RCSendBuf* send_buf);
+void           rc_send_buf_reset(RCSendBuf* send_buf);
+size_t         rc_send_buf_queued_size(const RCSendBuf* send_buf);
+etcpal_error_t rc_send_buf_begin_message(RCSendBuf* send_buf);
+etcpal_error_t rc_send_buf_append(RCSendBuf* send_buf, etcpal_socket_t sock, const void* data, size_t data_len);
+etcpal_error_t rc_send_buf_end_message(RCSendBuf* send_buf, etcpal_socket_t sock);
+etcpal_error_t rc_send_buf_flush(RCSendBuf* send_buf, etcpal_socket_t sock);
+void           rc_send_buf_cork(RCSendBuf* send_buf);
+etcpal_error_t rc_send_buf_uncork(RCSendBuf* send_buf, etcpal_socket_t sock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RDMNET_CORE_SEND_BUF_H_ */
@@ -277,15 +277,24 @@ void mdns_socket_activity(const EtcPalPollEvent* event, RCPolledSocketOpaqueData
   }
   else if (event->events & ETCPAL_POLL_IN)
   {
-    EtcPalSockAddr from_addr;
-    int            recv_res = etcpal_recvfrom(event->socket, mdns_recv_buf, MDNS_RECV_BUF_SIZE, 0, &from_addr);
-    if (recv_res > 0)
+    // The socket is non-blocking; drain a batch of queued responses before returning to the poll.
+    for (size_t i = 0; i < RDMNET_MCAST_RECV_BATCH_SIZE; ++i)
     {
-      handle_mdns_message(recv_res);
-    }
-    else if (recv_res < 0)
-    {
-      RDMNET_LOG_ERR("Error occurred when receiving on mDNS receive socket: '%s'", etcpal_strerror(recv_res));
+      EtcPalSockAddr from_addr;
+      int            recv_res = etcpal_recvfrom(event->socket, mdns_recv_buf, MDNS_RECV_BUF_SIZE, 0, &from_addr);
+      if (recv_res > 0)
+      {
+        handle_mdns_message(recv_res);
+      }
+      else if (recv_res == kEtcPalErrWouldBlock)
+      {
+        break;
+      }
+      else if (recv_res < 0)
+      {
+        RDMNET_LOG_ERR("Error occurred when receiving on mDNS receive socket: '%s'", etcpal_strerror(recv_res));
+        break;
+      }
     }
   }
 }
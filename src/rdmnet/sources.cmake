@@ -27,6 +27,7 @@ set(RDMNET_API_PUBLIC_HEADERS
   ${RDMNET_INCLUDE}/rdmnet/cpp/message_types/llrp_rdm_response.h
   ${RDMNET_INCLUDE}/rdmnet/cpp/message_types/rdm_command.h
   ${RDMNET_INCLUDE}/rdmnet/cpp/message_types/rdm_response.h
+  ${RDMNET_INCLUDE}/rdmnet/cpp/message_types/request_result.h
   ${RDMNET_INCLUDE}/rdmnet/cpp/message_types/rpt_client.h
   ${RDMNET_INCLUDE}/rdmnet/cpp/message_types/rpt_status.h
   ${RDMNET_INCLUDE}/rdmnet/cpp/client.h
@@ -67,8 +68,10 @@ set(RDMNET_CORE_HEADERS
   ${RDMNET_SRC}/rdmnet/core/message.h
   ${RDMNET_SRC}/rdmnet/core/msg_buf.h
   ${RDMNET_SRC}/rdmnet/core/opts.h
+  ${RDMNET_SRC}/rdmnet/core/request_table.h
   ${RDMNET_SRC}/rdmnet/core/rpt_message.h
   ${RDMNET_SRC}/rdmnet/core/rpt_prot.h
+  ${RDMNET_SRC}/rdmnet/core/send_buf.h
   ${RDMNET_SRC}/rdmnet/core/util.h
 )
 set(RDMNET_CORE_SOURCES
@@ -84,7 +87,9 @@ set(RDMNET_CORE_SOURCES
   ${RDMNET_SRC}/rdmnet/core/mcast.c
   ${RDMNET_SRC}/rdmnet/core/message.c
   ${RDMNET_SRC}/rdmnet/core/msg_buf.c
+  ${RDMNET_SRC}/rdmnet/core/request_table.c
   ${RDMNET_SRC}/rdmnet/core/rpt_prot.c
+  ${RDMNET_SRC}/rdmnet/core/send_buf.c
   ${RDMNET_SRC}/rdmnet/core/util.c
 )
 
@@ -106,23 +111,31 @@ set(RDMNET_BROKER_PUBLIC_HEADERS
   ${RDMNET_INCLUDE}/rdmnet/cpp/broker.h
 )
 set(RDMNET_BROKER_PRIVATE_HEADERS
+  ${RDMNET_SRC}/rdmnet/broker/broker_admission.h
+  ${RDMNET_SRC}/rdmnet/broker/broker_buffer_pool.h
   ${RDMNET_SRC}/rdmnet/broker/broker_core.h
   ${RDMNET_SRC}/rdmnet/broker/broker_client.h
   ${RDMNET_SRC}/rdmnet/broker/broker_discovery.h
   ${RDMNET_SRC}/rdmnet/broker/broker_responder.h
+  ${RDMNET_SRC}/rdmnet/broker/broker_service_schedule.h
   ${RDMNET_SRC}/rdmnet/broker/broker_socket_manager.h
   ${RDMNET_SRC}/rdmnet/broker/broker_threads.h
   ${RDMNET_SRC}/rdmnet/broker/broker_uid_manager.h
+  ${RDMNET_SRC}/rdmnet/broker/broker_uid_table.h
   ${RDMNET_SRC}/rdmnet/broker/broker_util.h
 )
 set(RDMNET_BROKER_SOURCES
+  ${RDMNET_SRC}/rdmnet/broker/broker_admission.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_api.cpp
+  ${RDMNET_SRC}/rdmnet/broker/broker_buffer_pool.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_core.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_client.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_discovery.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_responder.cpp
+  ${RDMNET_SRC}/rdmnet/broker/broker_service_schedule.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_threads.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_uid_manager.cpp
+  ${RDMNET_SRC}/rdmnet/broker/broker_uid_table.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_util.cpp
 )
 
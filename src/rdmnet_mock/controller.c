@@ -43,6 +43,12 @@ DEFINE_FAKE_VOID_FUNC(rdmnet_controller_set_rdm_cmd_callbacks,
                       RdmnetControllerLlrpRdmCommandReceivedCallback,
                       uint8_t*,
                       void*);
+DEFINE_FAKE_VOID_FUNC(rdmnet_controller_set_request_tracking,
+                      RdmnetControllerConfig*,
+                      RdmnetControllerRequestCompleteCallback,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int);
 
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rdmnet_controller_create, const RdmnetControllerConfig*, rdmnet_controller_t*);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rdmnet_controller_destroy, rdmnet_controller_t, rdmnet_disconnect_reason_t);
@@ -104,6 +110,14 @@ DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
                        const uint8_t*,
                        uint8_t,
                        uint32_t*);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
+                       rdmnet_controller_send_rdm_commands,
+                       rdmnet_controller_t,
+                       rdmnet_client_scope_t,
+                       const RdmnetBatchRdmCommand*,
+                       size_t,
+                       uint32_t*,
+                       size_t*);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
                        rdmnet_controller_send_rdm_ack,
                        rdmnet_controller_t,
@@ -143,6 +157,7 @@ void rdmnet_controller_reset_all_fakes(void)
   RESET_FAKE(rdmnet_controller_set_callbacks);
   RESET_FAKE(rdmnet_controller_set_rdm_data);
   RESET_FAKE(rdmnet_controller_set_rdm_cmd_callbacks);
+  RESET_FAKE(rdmnet_controller_set_request_tracking);
   RESET_FAKE(rdmnet_controller_create);
   RESET_FAKE(rdmnet_controller_destroy);
   RESET_FAKE(rdmnet_controller_add_scope);
@@ -154,6 +169,7 @@ void rdmnet_controller_reset_all_fakes(void)
   RESET_FAKE(rdmnet_controller_send_rdm_command);
   RESET_FAKE(rdmnet_controller_send_get_command);
   RESET_FAKE(rdmnet_controller_send_set_command);
+  RESET_FAKE(rdmnet_controller_send_rdm_commands);
   RESET_FAKE(rdmnet_controller_send_rdm_ack);
   RESET_FAKE(rdmnet_controller_send_rdm_nack);
   RESET_FAKE(rdmnet_controller_send_rdm_update);
@@ -69,6 +69,14 @@ DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
                        const uint8_t*,
                        uint8_t,
                        uint32_t*);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
+                       rc_client_send_rdm_commands,
+                       RCClient*,
+                       rdmnet_client_scope_t,
+                       const RdmnetBatchRdmCommand*,
+                       size_t,
+                       uint32_t*,
+                       size_t*);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
                        rc_client_send_rdm_ack,
                        RCClient*,
@@ -151,6 +159,7 @@ void rc_client_reset_all_fakes(void)
   RESET_FAKE(rc_client_request_dynamic_uids);
   RESET_FAKE(rc_client_request_responder_ids);
   RESET_FAKE(rc_client_send_rdm_command);
+  RESET_FAKE(rc_client_send_rdm_commands);
   RESET_FAKE(rc_client_send_rdm_ack);
   RESET_FAKE(rc_client_send_rdm_nack);
   RESET_FAKE(rc_client_send_rdm_update);
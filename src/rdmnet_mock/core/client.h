@@ -82,6 +82,14 @@ DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
                         const uint8_t*,
                         uint8_t,
                         uint32_t*);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
+                        rc_client_send_rdm_commands,
+                        RCClient*,
+                        rdmnet_client_scope_t,
+                        const RdmnetBatchRdmCommand*,
+                        size_t,
+                        uint32_t*,
+                        size_t*);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
                         rc_client_send_rdm_ack,
                         RCClient*,
@@ -36,6 +36,8 @@ DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
                        const BrokerClientConnectMsg*,
                        rdmnet_disconnect_reason_t);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rc_conn_disconnect, RCConnection*, rdmnet_disconnect_reason_t);
+DEFINE_FAKE_VOID_FUNC(rc_conn_cork, RCConnection*);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rc_conn_uncork, RCConnection*);
 
 void rc_connection_reset_all_fakes(void)
 {
@@ -47,4 +49,6 @@ void rc_connection_reset_all_fakes(void)
   RESET_FAKE(rc_conn_connect);
   RESET_FAKE(rc_conn_reconnect);
   RESET_FAKE(rc_conn_disconnect);
+  RESET_FAKE(rc_conn_cork);
+  RESET_FAKE(rc_conn_uncork);
 }
@@ -49,6 +49,8 @@ DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
                         const BrokerClientConnectMsg*,
                         rdmnet_disconnect_reason_t);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rc_conn_disconnect, RCConnection*, rdmnet_disconnect_reason_t);
+DECLARE_FAKE_VOID_FUNC(rc_conn_cork, RCConnection*);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rc_conn_uncork, RCConnection*);
 
 void rc_connection_reset_all_fakes(void);
 
@@ -19,13 +19,21 @@
 
 #include "rdmnet_mock/core/msg_buf.h"
 
-DEFINE_FAKE_VOID_FUNC(rc_msg_buf_init, RCMsgBuf*);
+DEFINE_FAKE_VALUE_FUNC(bool, rc_msg_buf_init, RCMsgBuf*, size_t);
+DEFINE_FAKE_VOID_FUNC(rc_msg_buf_cleanup, RCMsgBuf*);
+DEFINE_FAKE_VOID_FUNC(rc_msg_buf_reset, RCMsgBuf*);
+DEFINE_FAKE_VALUE_FUNC(size_t, rc_msg_buf_make_room, RCMsgBuf*);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rc_msg_buf_recv, RCMsgBuf*, etcpal_socket_t);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rc_msg_buf_parse_data, RCMsgBuf*);
 
 void rc_msg_buf_reset_all_fakes(void)
 {
   RESET_FAKE(rc_msg_buf_init);
+  RESET_FAKE(rc_msg_buf_cleanup);
+  RESET_FAKE(rc_msg_buf_reset);
+  RESET_FAKE(rc_msg_buf_make_room);
   RESET_FAKE(rc_msg_buf_recv);
   RESET_FAKE(rc_msg_buf_parse_data);
+
+  rc_msg_buf_init_fake.return_val = true;
 }
@@ -32,7 +32,10 @@
 extern "C" {
 #endif
 
-DECLARE_FAKE_VOID_FUNC(rc_msg_buf_init, RCMsgBuf*);
+DECLARE_FAKE_VALUE_FUNC(bool, rc_msg_buf_init, RCMsgBuf*, size_t);
+DECLARE_FAKE_VOID_FUNC(rc_msg_buf_cleanup, RCMsgBuf*);
+DECLARE_FAKE_VOID_FUNC(rc_msg_buf_reset, RCMsgBuf*);
+DECLARE_FAKE_VALUE_FUNC(size_t, rc_msg_buf_make_room, RCMsgBuf*);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rc_msg_buf_recv, RCMsgBuf*, etcpal_socket_t);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rc_msg_buf_parse_data, RCMsgBuf*);
 
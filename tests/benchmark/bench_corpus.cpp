@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// Loads the message corpus in tests/data and synthesizes messages larger than any it contains.
+
+#include "bench_harness.h"
+
+#include <fstream>
+#include "rdm/message.h"
+#include "rdm/responder.h"
+#include "rdmnet/core/broker_prot.h"
+#include "rdmnet/core/rpt_prot.h"
+#include "test_file_manifest.h"
+#include "load_test_data.h"
+
+namespace rdmnet
+{
+namespace bench
+{
+static const RdmUid kSyntheticControllerUid = {0x6574, 0x00000001};
+static const RdmUid kSyntheticDeviceUid = {0x6574, 0x00000002};
+
+static EtcPalUuid MakeSyntheticCid(uint32_t index)
+{
+  EtcPalUuid cid = {{0x9e, 0xfb, 0x97, 0x13, 0x2b, 0x82, 0x41, 0x21, 0x8a, 0xe0}};
+  cid.data[12] = static_cast<uint8_t>(index >> 24);
+  cid.data[13] = static_cast<uint8_t>(index >> 16);
+  cid.data[14] = static_cast<uint8_t>(index >> 8);
+  cid.data[15] = static_cast<uint8_t>(index);
+  return cid;
+}
+
+std::vector<CorpusMessage> LoadMessageCorpus()
+{
+  std::vector<CorpusMessage> corpus;
+  corpus.reserve(kRdmnetTestDataFiles.size());
+
+  for (const auto& file : kRdmnetTestDataFiles)
+  {
+    std::string name = file.first;
+    auto        last_sep = name.find_last_of("/\\");
+    if (last_sep != std::string::npos)
+      name.erase(0, last_sep + 1);
+    auto ext = name.find(".data.txt");
+    if (ext != std::string::npos)
+      name.erase(ext);
+
+    std::ifstream test_data_file(file.first);
+    corpus.push_back(CorpusMessage{name, rdmnet::testing::LoadTestData(test_data_file)});
+  }
+  return corpus;
+}
+
+// A Connected Client List with num_entries RPT devices, as sent to a controller which has just
+// connected to a large system.
+CorpusMessage MakeLargeRptClientList(size_t num_entries)
+{
+  std::vector<RdmnetRptClientEntry> entries(num_entries);
+  for (size_t i = 0; i < num_entries; ++i)
+  {
+    entries[i].cid = MakeSyntheticCid(static_cast<uint32_t>(i));
+    entries[i].uid = RdmUid{0x6574, static_cast<uint32_t>(0x1000 + i)};
+    entries[i].type = kRPTClientTypeDevice;
+    entries[i].binding_cid = kEtcPalNullUuid;
+  }
+
+  CorpusMessage msg;
+  msg.name = "synthetic_client_list_" + std::to_string(num_entries);
+  msg.data.resize(rc_broker_get_rpt_client_list_buffer_size(num_entries));
+
+  EtcPalUuid broker_cid = MakeSyntheticCid(0xffffffff);
+  msg.data.resize(rc_broker_pack_rpt_client_list(msg.data.data(), msg.data.size(), &broker_cid,
+                                                 VECTOR_BROKER_CONNECTED_CLIENT_LIST, entries.data(), num_entries));
+  return msg;
+}
+
+// An RPT Notification containing a GET command and the ACK_OVERFLOW responses needed to carry
+// response_data_len bytes of parameter data.
+CorpusMessage MakeAckOverflowNotification(size_t response_data_len)
+{
+  RdmCommandHeader cmd_header;
+  cmd_header.source_uid = kSyntheticControllerUid;
+  cmd_header.dest_uid = kSyntheticDeviceUid;
+  cmd_header.transaction_num = 1;
+  cmd_header.port_id = 1;
+  cmd_header.subdevice = 0;
+  cmd_header.command_class = kRdmCCGetCommand;
+  cmd_header.param_id = 0x8000;
+
+  std::vector<uint8_t> response_data(response_data_len);
+  for (size_t i = 0; i < response_data_len; ++i)
+    response_data[i] = static_cast<uint8_t>(i);
+
+  size_t                 num_responses = rdm_get_num_responses_needed(cmd_header.param_id, response_data_len);
+  std::vector<RdmBuffer> bufs(num_responses + 1);
+
+  CorpusMessage msg;
+  msg.name = "synthetic_ack_overflow_" + std::to_string(num_responses);
+  if (rdm_pack_command(&cmd_header, nullptr, 0, &bufs[0]) != kEtcPalErrOk ||
+      rdm_pack_full_response(&cmd_header, response_data.data(), response_data_len, &bufs[1], num_responses) !=
+          kEtcPalErrOk)
+  {
+    return msg;
+  }
+
+  RptHeader header;
+  header.source_uid = kSyntheticDeviceUid;
+  header.source_endpoint_id = E133_NULL_ENDPOINT;
+  header.dest_uid = kSyntheticControllerUid;
+  header.dest_endpoint_id = E133_NULL_ENDPOINT;
+  header.seqnum = 1;
+
+  EtcPalUuid device_cid = MakeSyntheticCid(0);
+  msg.data.resize(rc_rpt_get_notification_buffer_size(bufs.data(), bufs.size()));
+  msg.data.resize(
+      rc_rpt_pack_notification(msg.data.data(), msg.data.size(), &device_cid, &header, bufs.data(), bufs.size()));
+  return msg;
+}
+
+};  // namespace bench
+};  // namespace rdmnet
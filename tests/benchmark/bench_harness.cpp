@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "bench_harness.h"
+
+#include <cstdio>
+
+#if RDMNET_BENCH_COUNT_ALLOCATIONS
+
+// The benchmark is linked with --wrap for each of these, so calls made from the RDMnet, EtcPal and
+// RDM sources land here. Allocations made inside the C++ runtime (e.g. by the harness's containers)
+// are not counted.
+static uint64_t alloc_count;
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t num, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size)
+{
+  ++alloc_count;
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t num, size_t size)
+{
+  ++alloc_count;
+  return __real_calloc(num, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+  ++alloc_count;
+  return __real_realloc(ptr, size);
+}
+}
+
+#endif  // RDMNET_BENCH_COUNT_ALLOCATIONS
+
+namespace rdmnet
+{
+namespace bench
+{
+uint64_t AllocationCount()
+{
+#if RDMNET_BENCH_COUNT_ALLOCATIONS
+  return alloc_count;
+#else
+  return 0;
+#endif
+}
+
+bool AllocationsCounted()
+{
+  return RDMNET_BENCH_COUNT_ALLOCATIONS;
+}
+
+void Runner::Run(const std::string& name, size_t num_bytes, size_t num_messages, const std::function<bool()>& op)
+{
+  if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos)
+    return;
+
+  // Run once untimed, both to check that the operation works and to warm up any storage it reuses.
+  if (!op())
+  {
+    std::printf("FAILED: %s\n", name.c_str());
+    failed_ = true;
+    return;
+  }
+
+  // Double the number of iterations until a batch runs for at least the minimum time.
+  uint64_t iterations = (options_.iterations > 0 ? options_.iterations : 1);
+  for (;;)
+  {
+    uint64_t allocs_before = AllocationCount();
+    auto     start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+      if (!op())
+      {
+        std::printf("FAILED: %s (on iteration %llu)\n", name.c_str(), static_cast<unsigned long long>(i));
+        failed_ = true;
+        return;
+      }
+    }
+    auto     elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocs = AllocationCount() - allocs_before;
+
+    if (options_.iterations > 0 || elapsed >= options_.min_time)
+    {
+      double total_messages = static_cast<double>(iterations) * static_cast<double>(num_messages);
+      double elapsed_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+      Result result;
+      result.name = name;
+      result.num_messages = iterations * num_messages;
+      result.ns_per_msg = elapsed_ns / total_messages;
+      result.mb_per_sec = (elapsed_ns > 0.0 ? (static_cast<double>(iterations) * static_cast<double>(num_bytes) * 1000.0 /
+                                               elapsed_ns)
+                                            : 0.0);
+      result.allocs_per_msg = static_cast<double>(allocs) / total_messages;
+      results_.push_back(result);
+      return;
+    }
+    iterations *= 2;
+  }
+}
+
+void Runner::PrintResults() const
+{
+  std::printf("%-56s %12s %12s %10s %12s\n", "Benchmark", "Messages", "ns/msg", "MB/s", "allocs/msg");
+  for (const auto& result : results_)
+  {
+    std::printf("%-56s %12llu %12.1f %10.1f ", result.name.c_str(), static_cast<unsigned long long>(result.num_messages),
+                result.ns_per_msg, result.mb_per_sec);
+    if (AllocationsCounted())
+      std::printf("%12.2f\n", result.allocs_per_msg);
+    else
+      std::printf("%12s\n", "n/a");
+  }
+}
+
+};  // namespace bench
+};  // namespace rdmnet
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#ifndef BENCH_HARNESS_H_
+#define BENCH_HARNESS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Defined to 1 by the build when the toolchain supports wrapping the C allocation functions.
+#ifndef RDMNET_BENCH_COUNT_ALLOCATIONS
+#define RDMNET_BENCH_COUNT_ALLOCATIONS 0
+#endif
+
+namespace rdmnet
+{
+namespace bench
+{
+// The number of calls to malloc(), calloc() and realloc() made by the RDMnet sources linked into
+// the benchmark so far. Only counted when the toolchain supports wrapping those functions; see
+// AllocationsCounted().
+uint64_t AllocationCount();
+bool     AllocationsCounted();
+
+struct Options
+{
+  std::string               filter;       // Only run benchmarks whose names contain this string
+  std::chrono::milliseconds min_time{200};  // Minimum time to run each benchmark for
+  uint64_t                  iterations{0};  // Run each benchmark exactly this many times, if nonzero
+};
+
+// Runs benchmarks and collects their results.
+class Runner
+{
+public:
+  explicit Runner(const Options& options) : options_(options) {}
+
+  // Time op, which handles num_messages messages totalling num_bytes bytes per call and returns
+  // false on failure. Results are reported per message.
+  void Run(const std::string& name, size_t num_bytes, size_t num_messages, const std::function<bool()>& op);
+
+  void PrintResults() const;
+  bool failed() const { return failed_; }
+
+private:
+  struct Result
+  {
+    std::string name;
+    uint64_t    num_messages;
+    double      ns_per_msg;
+    double      mb_per_sec;
+    double      allocs_per_msg;
+  };
+
+  Options             options_;
+  std::vector<Result> results_;
+  bool                failed_{false};
+};
+
+// The benchmark groups. Each runs all of its benchmarks with the given runner.
+void RunMsgBufBenchmarks(Runner& runner);
+void RunPackBenchmarks(Runner& runner);
+void RunLlrpBenchmarks(Runner& runner);
+#if RDMNET_BENCH_LWMDNS
+void RunLwMdnsBenchmarks(Runner& runner);
+#endif
+
+// Message corpus helpers shared by the benchmark groups.
+struct CorpusMessage
+{
+  std::string          name;
+  std::vector<uint8_t> data;
+};
+
+// Load each message in tests/data/messages. The returned order matches kRdmnetTestDataFiles.
+std::vector<CorpusMessage> LoadMessageCorpus();
+
+// Synthetic messages which are larger than anything in the corpus.
+CorpusMessage MakeLargeRptClientList(size_t num_entries);
+CorpusMessage MakeAckOverflowNotification(size_t response_data_len);
+
+};  // namespace bench
+};  // namespace rdmnet
+
+#endif  // BENCH_HARNESS_H_
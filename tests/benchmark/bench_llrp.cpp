@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// Benchmarks for the LLRP datagram parser in rdmnet/core/llrp_prot.c.
+//
+// The test data corpus only contains TCP messages, so LLRP datagrams are built with the library's
+// own send functions, capturing what they would have sent from the EtcPal socket mock.
+
+#include "bench_harness.h"
+
+#include "etcpal_mock/common.h"
+#include "etcpal_mock/socket.h"
+#include "rdm/defs.h"
+#include "rdm/message.h"
+#include "rdmnet/core/llrp.h"
+#include "rdmnet/core/llrp_prot.h"
+
+namespace rdmnet
+{
+namespace bench
+{
+static const EtcPalUuid kManagerCid = {{0x1b, 0x6a, 0x2b, 0x4c, 0x12, 0x44, 0x4e, 0x2f, 0x9a, 0x61, 0x3b, 0x75, 0x0d,
+                                        0xd2, 0x59, 0x01}};
+static const EtcPalUuid kTargetCid = {{0x1b, 0x6a, 0x2b, 0x4c, 0x12, 0x44, 0x4e, 0x2f, 0x9a, 0x61, 0x3b, 0x75, 0x0d,
+                                       0xd2, 0x59, 0x02}};
+static const RdmUid     kManagerUid = {0x6574, 0x00000001};
+static const RdmUid     kTargetUid = {0x6574, 0x00000002};
+
+static std::vector<uint8_t> CaptureSentDatagram(uint8_t* buf, etcpal_error_t send_res)
+{
+  if (send_res != kEtcPalErrOk || etcpal_sendto_fake.call_count == 0)
+    return std::vector<uint8_t>();
+  return std::vector<uint8_t>(buf, buf + etcpal_sendto_fake.arg2_val);
+}
+
+// A probe request covering the whole UID space, with num_known_uids UIDs in its Known UID list.
+// The target's UID is not in the list, so it is checked against every entry.
+static std::vector<uint8_t> MakeProbeRequest(size_t num_known_uids)
+{
+  std::vector<RdmUid> known_uids(num_known_uids);
+  for (size_t i = 0; i < num_known_uids; ++i)
+    known_uids[i] = RdmUid{0x6574, static_cast<uint32_t>(0x1000 + i)};
+
+  LlrpHeader header;
+  header.sender_cid = kManagerCid;
+  header.dest_cid = *kLlrpBroadcastCid;
+  header.transaction_number = 1;
+
+  LocalProbeRequest request;
+  request.lower_uid = RdmUid{0, 0};
+  request.upper_uid = RdmUid{0xffff, 0xfffffffe};
+  request.filter = 0;
+  request.known_uids = known_uids.data();
+  request.num_known_uids = num_known_uids;
+
+  static RdmUid no_known_uids;
+  if (num_known_uids == 0)
+    request.known_uids = &no_known_uids;
+
+  uint8_t buf[LLRP_MANAGER_MAX_MESSAGE_SIZE];
+  etcpal_reset_all_fakes();
+  return CaptureSentDatagram(buf, rc_send_llrp_probe_request(ETCPAL_SOCKET_INVALID, buf, false, &header, &request));
+}
+
+// An RDM GET command addressed to the target.
+static std::vector<uint8_t> MakeRdmCommand()
+{
+  RdmCommandHeader cmd_header;
+  cmd_header.source_uid = kManagerUid;
+  cmd_header.dest_uid = kTargetUid;
+  cmd_header.transaction_num = 1;
+  cmd_header.port_id = 1;
+  cmd_header.subdevice = 0;
+  cmd_header.command_class = kRdmCCGetCommand;
+  cmd_header.param_id = E120_DEVICE_LABEL;
+
+  RdmBuffer cmd;
+  if (rdm_pack_command(&cmd_header, nullptr, 0, &cmd) != kEtcPalErrOk)
+    return std::vector<uint8_t>();
+
+  LlrpHeader header;
+  header.sender_cid = kManagerCid;
+  header.dest_cid = kTargetCid;
+  header.transaction_number = 2;
+
+  uint8_t buf[LLRP_MANAGER_MAX_MESSAGE_SIZE];
+  etcpal_reset_all_fakes();
+  return CaptureSentDatagram(buf, rc_send_llrp_rdm_command(ETCPAL_SOCKET_INVALID, buf, false, &header, &cmd));
+}
+
+void RunLlrpBenchmarks(Runner& runner)
+{
+  etcpal_reset_all_fakes();
+  if (rc_llrp_module_init() != kEtcPalErrOk)
+  {
+    runner.Run("llrp/init", 0, 1, []() { return false; });
+    return;
+  }
+
+  struct Datagram
+  {
+    std::string          name;
+    std::vector<uint8_t> data;
+    uint32_t             vector;
+  };
+  std::vector<Datagram> datagrams;
+  datagrams.push_back(Datagram{"probe_request", MakeProbeRequest(0), VECTOR_LLRP_PROBE_REQUEST});
+  datagrams.push_back(Datagram{"probe_request_known_uids_" + std::to_string(LLRP_KNOWN_UID_SIZE),
+                               MakeProbeRequest(LLRP_KNOWN_UID_SIZE), VECTOR_LLRP_PROBE_REQUEST});
+  datagrams.push_back(Datagram{"rdm_command", MakeRdmCommand(), VECTOR_LLRP_RDM_CMD});
+
+  LlrpMessageInterest interest;
+  interest.interested_in_probe_request = true;
+  interest.interested_in_probe_reply = false;
+  interest.my_cid = kTargetCid;
+  interest.my_uid = kTargetUid;
+
+  for (const auto& datagram : datagrams)
+  {
+    const uint8_t* data = datagram.data.data();
+    size_t         size = datagram.data.size();
+
+    // What the LLRP receive path does for every datagram before deciding whether to dispatch it.
+    runner.Run("llrp/destination_cid/" + datagram.name, size, 1, [&]() {
+      EtcPalUuid dest_cid;
+      return !datagram.data.empty() && rc_get_llrp_destination_cid(data, size, &dest_cid);
+    });
+
+    runner.Run("llrp/parse/" + datagram.name, size, 1, [&]() {
+      LlrpMessage msg;
+      return !datagram.data.empty() && rc_parse_llrp_message(data, size, &interest, &msg) &&
+             msg.vector == datagram.vector;
+    });
+  }
+
+  rc_llrp_module_deinit();
+}
+
+};  // namespace bench
+};  // namespace rdmnet
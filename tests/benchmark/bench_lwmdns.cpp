@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// Benchmarks for the mDNS message parsing functions of the lightweight DNS querier in
+// rdmnet/disc/lightweight/lwmdns_common.c.
+
+#include "bench_harness.h"
+
+#include "etcpal_mock/common.h"
+#include "lwmdns_common.h"
+
+namespace rdmnet
+{
+namespace bench
+{
+static void AppendU16(std::vector<uint8_t>& msg, uint16_t val)
+{
+  msg.push_back(static_cast<uint8_t>(val >> 8));
+  msg.push_back(static_cast<uint8_t>(val));
+}
+
+static void AppendU32(std::vector<uint8_t>& msg, uint32_t val)
+{
+  AppendU16(msg, static_cast<uint16_t>(val >> 16));
+  AppendU16(msg, static_cast<uint16_t>(val));
+}
+
+// Returns the offset of the label in the message, for use in later compression pointers.
+static uint16_t AppendLabel(std::vector<uint8_t>& msg, const std::string& label)
+{
+  uint16_t offset = static_cast<uint16_t>(msg.size());
+  msg.push_back(static_cast<uint8_t>(label.size()));
+  msg.insert(msg.end(), label.begin(), label.end());
+  return offset;
+}
+
+static void AppendPointer(std::vector<uint8_t>& msg, uint16_t offset)
+{
+  AppendU16(msg, static_cast<uint16_t>(0xc000u | offset));
+}
+
+// Append the fixed part of a resource record after its name. Returns the offset of the data
+// length field, to be filled in by EndResourceRecord().
+static size_t BeginResourceRecord(std::vector<uint8_t>& msg, dns_record_type_t type, uint32_t ttl)
+{
+  AppendU16(msg, static_cast<uint16_t>(type));
+  AppendU16(msg, DNS_CLASS_IN | DNS_CLASS_CACHE_FLUSH_MASK);
+  AppendU32(msg, ttl);
+  size_t data_len_offset = msg.size();
+  AppendU16(msg, 0);
+  return data_len_offset;
+}
+
+static void EndResourceRecord(std::vector<uint8_t>& msg, size_t data_len_offset)
+{
+  size_t data_len = msg.size() - data_len_offset - 2;
+  msg[data_len_offset] = static_cast<uint8_t>(data_len >> 8);
+  msg[data_len_offset + 1] = static_cast<uint8_t>(data_len);
+}
+
+// The response a broker sends when queried for the default scope: a PTR answer with SRV, TXT and A
+// additional records, using name compression the way common mDNS responders do.
+static std::vector<uint8_t> MakeBrokerResponse()
+{
+  std::vector<uint8_t> msg = {
+      0,    0,     // Transaction ID: 0
+      0x84, 0x00,  // Flags: Standard query response, authoritative
+      0,    0,     // Question count: 0
+      0,    1,     // Answer count: 1
+      0,    0,     // Authority count: 0
+      0,    3,     // Additional count: 3
+  };
+
+  // _default._sub._rdmnet._tcp.local PTR Test Broker._rdmnet._tcp.local
+  AppendLabel(msg, "_default");
+  AppendLabel(msg, "_sub");
+  uint16_t service_offset = AppendLabel(msg, "_rdmnet");
+  AppendLabel(msg, "_tcp");
+  uint16_t local_offset = AppendLabel(msg, "local");
+  msg.push_back(0);
+  size_t   rr_start = BeginResourceRecord(msg, kDnsRecordTypePTR, 4500);
+  uint16_t instance_offset = AppendLabel(msg, "Test Broker");
+  AppendPointer(msg, service_offset);
+  EndResourceRecord(msg, rr_start);
+
+  // Test Broker._rdmnet._tcp.local SRV 0 0 8888 test-host.local
+  AppendPointer(msg, instance_offset);
+  rr_start = BeginResourceRecord(msg, kDnsRecordTypeSRV, 120);
+  AppendU16(msg, 0);     // Priority
+  AppendU16(msg, 0);     // Weight
+  AppendU16(msg, 8888);  // Port
+  uint16_t host_offset = AppendLabel(msg, "test-host");
+  AppendPointer(msg, local_offset);
+  EndResourceRecord(msg, rr_start);
+
+  // Test Broker._rdmnet._tcp.local TXT
+  AppendPointer(msg, instance_offset);
+  rr_start = BeginResourceRecord(msg, kDnsRecordTypeTXT, 4500);
+  AppendLabel(msg, "TxtVers=1");
+  AppendLabel(msg, "ConfScope=default");
+  AppendLabel(msg, "E133Vers=1");
+  AppendLabel(msg, "CID=9efb97132b8241218ae09ca045086fe6");
+  AppendLabel(msg, "UID=6574deadbeef");
+  AppendLabel(msg, "Model=Test Broker");
+  AppendLabel(msg, "Manuf=ETC");
+  EndResourceRecord(msg, rr_start);
+
+  // test-host.local A 192.168.1.10
+  AppendPointer(msg, host_offset);
+  rr_start = BeginResourceRecord(msg, kDnsRecordTypeA, 120);
+  msg.insert(msg.end(), {192, 168, 1, 10});
+  EndResourceRecord(msg, rr_start);
+
+  return msg;
+}
+
+// Parses a response the way the lightweight querier's receive path does, including the names
+// embedded in PTR and SRV record data.
+static bool ParseResponse(const std::vector<uint8_t>& msg)
+{
+  const uint8_t* buf = msg.data();
+  DnsHeader      header;
+  const uint8_t* cur_ptr = lwmdns_parse_dns_header(buf, static_cast<int>(msg.size()), &header);
+  if (!cur_ptr)
+    return false;
+
+  int remaining_length = static_cast<int>(msg.size()) - static_cast<int>(cur_ptr - buf);
+  for (int i = 0; i < header.answer_count + header.authority_count + header.additional_count; ++i)
+  {
+    DnsResourceRecord rr;
+    const uint8_t*    next_ptr = lwmdns_parse_resource_record(buf, cur_ptr, remaining_length, &rr);
+    if (!next_ptr)
+      return false;
+
+    if (rr.record_type == kDnsRecordTypePTR && !lwmdns_parse_domain_name(buf, rr.data_ptr, rr.data_len))
+      return false;
+    if (rr.record_type == kDnsRecordTypeSRV && !lwmdns_parse_domain_name(buf, rr.data_ptr + 6, rr.data_len - 6))
+      return false;
+
+    remaining_length -= static_cast<int>(next_ptr - cur_ptr);
+    cur_ptr = next_ptr;
+  }
+  return remaining_length == 0;
+}
+
+void RunLwMdnsBenchmarks(Runner& runner)
+{
+  etcpal_reset_all_fakes();
+  if (lwmdns_common_module_init() != kEtcPalErrOk)
+  {
+    runner.Run("lwmdns/init", 0, 1, []() { return false; });
+    return;
+  }
+
+  auto response = MakeBrokerResponse();
+  runner.Run("lwmdns/parse/broker_response", response.size(), 1, [&]() { return ParseResponse(response); });
+
+  lwmdns_common_module_deinit();
+}
+
+};  // namespace bench
+};  // namespace rdmnet
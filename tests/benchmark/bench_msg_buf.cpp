@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// Benchmarks for the TCP stream parser in rdmnet/core/msg_buf.c.
+
+#include "bench_harness.h"
+
+#include <algorithm>
+#include <cstring>
+#include "rdm/defs.h"
+#include "rdmnet/core/message.h"
+#include "rdmnet/core/msg_buf.h"
+
+namespace rdmnet
+{
+namespace bench
+{
+// The sizes in which data is handed to the parser when replaying a stream. 1460 is a typical TCP
+// segment payload on Ethernet; the smaller sizes stress resumption of partially-parsed messages.
+static const size_t kChunkSizes[] = {1460, 256, 64, 16, 1};
+
+// Feeds a byte stream to the parser the way rc_msg_buf_recv() does, chunk_size bytes at a time
+// (or all at once if chunk_size is 0), parsing after each chunk.
+class StreamReplayer
+{
+public:
+  StreamReplayer() { rc_msg_buf_init(&buf_, 0); }
+  ~StreamReplayer() { rc_msg_buf_cleanup(&buf_); }
+
+  bool Replay(const std::vector<uint8_t>& stream, size_t chunk_size);
+
+private:
+  RCMsgBuf buf_;
+};
+
+bool StreamReplayer::Replay(const std::vector<uint8_t>& stream, size_t chunk_size)
+{
+  size_t pos = 0;
+  size_t num_parsed = 0;
+  while (pos < stream.size())
+  {
+    size_t room = rc_msg_buf_make_room(&buf_);
+    size_t to_copy = std::min(room, stream.size() - pos);
+    if (chunk_size > 0)
+      to_copy = std::min(to_copy, chunk_size);
+    if (to_copy == 0)
+      return false;
+
+    std::memcpy(&buf_.buf[buf_.cur_data_size], &stream[pos], to_copy);
+    buf_.cur_data_size += to_copy;
+    pos += to_copy;
+
+    etcpal_error_t res;
+    while ((res = rc_msg_buf_parse_data(&buf_)) == kEtcPalErrOk)
+    {
+      rc_free_message_resources(&buf_.msg);
+      ++num_parsed;
+    }
+    if (res != kEtcPalErrNoData)
+      return false;
+  }
+  return num_parsed > 0 && buf_.cur_data_offset == buf_.cur_data_size;
+}
+
+static std::string ChunkName(size_t chunk_size)
+{
+  return (chunk_size == 0 ? std::string("full") : "chunk=" + std::to_string(chunk_size));
+}
+
+void RunMsgBufBenchmarks(Runner& runner)
+{
+  auto corpus = LoadMessageCorpus();
+
+  // Each corpus message on its own, received in full.
+  for (const auto& msg : corpus)
+  {
+    StreamReplayer replayer;
+    runner.Run("msg_buf/" + msg.name, msg.data.size(), 1, [&]() { return replayer.Replay(msg.data, 0); });
+  }
+
+  // The whole corpus as one stream, received in chunks of varying size.
+  std::vector<uint8_t> corpus_stream;
+  for (const auto& msg : corpus)
+    corpus_stream.insert(corpus_stream.end(), msg.data.begin(), msg.data.end());
+
+  std::vector<size_t> chunk_sizes(1, 0);
+  chunk_sizes.insert(chunk_sizes.end(), std::begin(kChunkSizes), std::end(kChunkSizes));
+
+  for (size_t chunk_size : chunk_sizes)
+  {
+    StreamReplayer replayer;
+    runner.Run("msg_buf/corpus_stream/" + ChunkName(chunk_size), corpus_stream.size(), corpus.size(),
+               [&]() { return replayer.Replay(corpus_stream, chunk_size); });
+  }
+
+  // Messages much larger than anything in the corpus. Lists which do not fit in the receive buffer
+  // are delivered to the caller in parts.
+  std::vector<CorpusMessage> large_msgs;
+  large_msgs.push_back(MakeLargeRptClientList(1000));
+  large_msgs.push_back(MakeAckOverflowNotification(32 * RDM_MAX_PDL));
+
+  for (const auto& msg : large_msgs)
+  {
+    for (size_t chunk_size : chunk_sizes)
+    {
+      StreamReplayer replayer;
+      runner.Run("msg_buf/" + msg.name + "/" + ChunkName(chunk_size), msg.data.size(), 1,
+                 [&]() { return replayer.Replay(msg.data, chunk_size); });
+    }
+  }
+}
+
+};  // namespace bench
+};  // namespace rdmnet
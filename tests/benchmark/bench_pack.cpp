@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// Benchmarks for the Broker and RPT message packers in rdmnet/core/broker_prot.c and
+// rdmnet/core/rpt_prot.c.
+
+#include "bench_harness.h"
+
+#include <cstring>
+#include "rdm/defs.h"
+#include "rdmnet/core/broker_prot.h"
+#include "rdmnet/core/msg_buf.h"
+#include "rdmnet/core/rpt_prot.h"
+#include "test_file_manifest.h"
+
+namespace rdmnet
+{
+namespace bench
+{
+using PackFunction = std::function<size_t(uint8_t*, size_t)>;
+
+// Get a function which packs msg, or an empty function if the library only sends this type of
+// message directly to a connection rather than packing it into a caller-supplied buffer.
+static PackFunction GetPackFunction(const RdmnetMessage& msg)
+{
+  const EtcPalUuid* cid = &msg.sender_cid;
+
+  if (msg.vector == ACN_VECTOR_ROOT_BROKER)
+  {
+    const BrokerMessage* broker_msg = &msg.data.broker;
+    switch (broker_msg->vector)
+    {
+      case VECTOR_BROKER_CONNECT_REPLY:
+        return [=](uint8_t* buf, size_t buflen) {
+          return rc_broker_pack_connect_reply(buf, buflen, cid, &broker_msg->data.connect_reply);
+        };
+      case VECTOR_BROKER_CONNECTED_CLIENT_LIST:
+      case VECTOR_BROKER_CLIENT_ADD:
+      case VECTOR_BROKER_CLIENT_REMOVE:
+      case VECTOR_BROKER_CLIENT_ENTRY_CHANGE:
+        if (broker_msg->data.client_list.client_protocol != kClientProtocolRPT)
+          return PackFunction();
+        return [=](uint8_t* buf, size_t buflen) {
+          const RdmnetRptClientList* list = &broker_msg->data.client_list.data.rpt;
+          return rc_broker_pack_rpt_client_list(buf, buflen, cid, broker_msg->vector, list->client_entries,
+                                                list->num_client_entries);
+        };
+      case VECTOR_BROKER_ASSIGNED_DYNAMIC_UIDS:
+        return [=](uint8_t* buf, size_t buflen) {
+          const RdmnetDynamicUidAssignmentList* list = &broker_msg->data.dynamic_uid_assignment_list;
+          return rc_broker_pack_uid_assignment_list(buf, buflen, cid, list->mappings, list->num_mappings);
+        };
+      case VECTOR_BROKER_DISCONNECT:
+        return [=](uint8_t* buf, size_t buflen) {
+          return rc_broker_pack_disconnect(buf, buflen, cid, &broker_msg->data.disconnect);
+        };
+      case VECTOR_BROKER_NULL:
+        return [=](uint8_t* buf, size_t buflen) { return rc_broker_pack_null(buf, buflen, cid); };
+      default:
+        return PackFunction();
+    }
+  }
+  else if (msg.vector == ACN_VECTOR_ROOT_RPT)
+  {
+    const RptMessage* rpt_msg = &msg.data.rpt;
+    switch (rpt_msg->vector)
+    {
+      case VECTOR_RPT_REQUEST:
+        return [=](uint8_t* buf, size_t buflen) {
+          return rc_rpt_pack_request(buf, buflen, cid, &rpt_msg->header, rpt_msg->data.rdm.rdm_buffers);
+        };
+      case VECTOR_RPT_STATUS:
+        return [=](uint8_t* buf, size_t buflen) {
+          return rc_rpt_pack_status(buf, buflen, cid, &rpt_msg->header, &rpt_msg->data.status);
+        };
+      case VECTOR_RPT_NOTIFICATION:
+        return [=](uint8_t* buf, size_t buflen) {
+          return rc_rpt_pack_notification(buf, buflen, cid, &rpt_msg->header, rpt_msg->data.rdm.rdm_buffers,
+                                          rpt_msg->data.rdm.num_rdm_buffers);
+        };
+      default:
+        return PackFunction();
+    }
+  }
+  return PackFunction();
+}
+
+// Pack a message repeatedly into a buffer of exactly the expected size. The message must pack to
+// the expected bytes once before timing starts, so that the benchmark cannot pass while packing
+// something other than what was intended.
+static void RunPackBenchmark(Runner&                     runner,
+                             const std::string&          name,
+                             const PackFunction&         pack,
+                             const std::vector<uint8_t>& expected)
+{
+  std::vector<uint8_t> buf(expected.size());
+  bool                 first = true;
+
+  runner.Run("pack/" + name, expected.size(), 1, [&]() {
+    size_t packed_size = pack(buf.data(), buf.size());
+    if (first)
+    {
+      first = false;
+      return packed_size == expected.size() && buf == expected;
+    }
+    return packed_size == expected.size();
+  });
+}
+
+void RunPackBenchmarks(Runner& runner)
+{
+  // Pack each message in the corpus from its validation structure.
+  auto corpus = LoadMessageCorpus();
+  for (size_t i = 0; i < corpus.size(); ++i)
+  {
+    auto pack = GetPackFunction(kRdmnetTestDataFiles[i].second);
+    if (pack)
+      RunPackBenchmark(runner, corpus[i].name, pack, corpus[i].data);
+  }
+
+  // Re-pack the synthetic messages after parsing them, the way the broker re-sends a client list to
+  // each controller and a device's notification to each controller.
+  std::vector<CorpusMessage> large_msgs;
+  large_msgs.push_back(MakeLargeRptClientList(1000));
+  large_msgs.push_back(MakeAckOverflowNotification(32 * RDM_MAX_PDL));
+
+  for (const auto& large_msg : large_msgs)
+  {
+    RCMsgBuf msg_buf;
+    rc_msg_buf_init(&msg_buf, large_msg.data.size());
+    std::memcpy(msg_buf.buf, large_msg.data.data(), large_msg.data.size());
+    msg_buf.cur_data_size = large_msg.data.size();
+
+    if (rc_msg_buf_parse_data(&msg_buf) == kEtcPalErrOk)
+    {
+      auto pack = GetPackFunction(msg_buf.msg);
+      if (pack)
+        RunPackBenchmark(runner, large_msg.name, pack, large_msg.data);
+      rc_free_message_resources(&msg_buf.msg);
+    }
+    else
+    {
+      runner.Run("pack/" + large_msg.name, large_msg.data.size(), 1, []() { return false; });
+    }
+    rc_msg_buf_cleanup(&msg_buf);
+  }
+}
+
+};  // namespace bench
+};  // namespace rdmnet
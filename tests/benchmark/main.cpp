@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// The entry point for the RDMnet parser and packer microbenchmarks.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "fff.h"
+#include "bench_harness.h"
+
+DEFINE_FFF_GLOBALS;
+
+static bool assertion_failed;
+
+extern "C" bool RdmnetTestingAssertHandler(const char*  expression,
+                                           const char*  file,
+                                           const char*  func,
+                                           unsigned int line)
+{
+  std::printf("Assertion failure from inside RDMnet library. Expression: %s File: %s Function: %s Line: %u\n",
+              expression, file, func, line);
+  assertion_failed = true;
+  return false;
+}
+
+static void PrintUsage(const char* app_name)
+{
+  std::printf("Usage: %s [OPTION]...\n\n", app_name);
+  std::printf("Time the RDMnet message parsers and packers using the messages in tests/data.\n\n");
+  std::printf("Options:\n");
+  std::printf("  --filter=STRING      Only run benchmarks whose names contain STRING.\n");
+  std::printf("  --min-time-ms=MS     Run each benchmark for at least MS milliseconds (default 200).\n");
+  std::printf("  --iterations=N       Run each benchmark exactly N times, ignoring --min-time-ms.\n");
+  std::printf("  --help               Display this help and exit.\n");
+}
+
+static bool ParseOption(const char* arg, const char* name, std::string& value)
+{
+  size_t name_len = std::strlen(name);
+  if (std::strncmp(arg, name, name_len) == 0 && arg[name_len] == '=')
+  {
+    value = &arg[name_len + 1];
+    return true;
+  }
+  return false;
+}
+
+int main(int argc, char* argv[])
+{
+  rdmnet::bench::Options options;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string value;
+    if (std::strcmp(argv[i], "--help") == 0)
+    {
+      PrintUsage(argv[0]);
+      return 0;
+    }
+    else if (ParseOption(argv[i], "--filter", value))
+    {
+      options.filter = value;
+    }
+    else if (ParseOption(argv[i], "--min-time-ms", value))
+    {
+      options.min_time = std::chrono::milliseconds(std::strtoul(value.c_str(), nullptr, 10));
+    }
+    else if (ParseOption(argv[i], "--iterations", value))
+    {
+      options.iterations = std::strtoull(value.c_str(), nullptr, 10);
+    }
+    else
+    {
+      std::printf("Unknown option: %s\n\n", argv[i]);
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  rdmnet::bench::Runner runner(options);
+  rdmnet::bench::RunMsgBufBenchmarks(runner);
+  rdmnet::bench::RunPackBenchmarks(runner);
+  rdmnet::bench::RunLlrpBenchmarks(runner);
+#if RDMNET_BENCH_LWMDNS
+  rdmnet::bench::RunLwMdnsBenchmarks(runner);
+#endif
+  runner.PrintResults();
+
+  return (runner.failed() || assertion_failed) ? 1 : 0;
+}
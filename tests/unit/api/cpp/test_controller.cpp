@@ -184,3 +184,33 @@ TEST_F(TestCppControllerApi, SendSetCommandFailsOnError)
   EXPECT_FALSE(seq_num);
   EXPECT_EQ(seq_num.error_code(), kEtcPalErrSys);
 }
+
+TEST_F(TestCppControllerApi, SendRdmCommandsReturnsSeqNumsOfSentCommands)
+{
+  StartControllerDefault();
+
+  rdmnet_controller_send_rdm_commands_fake.custom_fake =
+      [](rdmnet_controller_t, rdmnet_client_scope_t, const RdmnetBatchRdmCommand* commands, size_t num_commands,
+         uint32_t* seq_nums, size_t* num_sent) {
+        EXPECT_EQ(num_commands, 3u);
+        EXPECT_EQ(commands[1].destination.rdmnet_uid.id, 0x1235u);
+        EXPECT_EQ(commands[1].param_id, E120_DEVICE_LABEL);
+        seq_nums[0] = 1;
+        seq_nums[1] = 2;
+        *num_sent = 2;
+        return kEtcPalErrWouldBlock;
+      };
+
+  std::vector<rdmnet::Controller::BatchRdmCommand> commands;
+  for (uint32_t id = 0x1234; id < 0x1237; ++id)
+  {
+    commands.emplace_back(rdmnet::DestinationAddr::ToDefaultResponder(0x6574, id), kRdmnetCCGetCommand,
+                          E120_DEVICE_LABEL);
+  }
+
+  auto result = controller_.SendRdmCommands(rdmnet::ScopeHandle(1), commands);
+  EXPECT_FALSE(result);
+  EXPECT_EQ(result.error.code(), kEtcPalErrWouldBlock);
+  EXPECT_EQ(result.num_sent(), 2u);
+  EXPECT_THAT(result.seq_nums, testing::ElementsAre(1u, 2u));
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "rdmnet/cpp/message_types/request_result.h"
+
+TEST(TestRequestResult, RefConstructorWorks)
+{
+  RdmnetRequestResult   c_result{};
+  rdmnet::RequestResult result(c_result);
+}
+
+TEST(TestRequestResult, TimedOutHasNoResponseOrStatus)
+{
+  const RdmnetDestinationAddr kDest = RDMNET_ADDR_TO_DEFAULT_RESPONDER(0x6574, 1);
+
+  RdmnetRequestResult c_result{};
+  c_result.seq_num = 42;
+  c_result.destination = kDest;
+  c_result.outcome = kRdmnetRequestTimedOut;
+
+  rdmnet::RequestResult result(c_result);
+  EXPECT_EQ(result.seq_num(), 42u);
+  EXPECT_EQ(result.outcome(), kRdmnetRequestTimedOut);
+  EXPECT_EQ(result.rdmnet_dest_uid(), rdm::Uid(0x6574, 1));
+  EXPECT_EQ(result.dest_endpoint(), E133_NULL_ENDPOINT);
+  EXPECT_FALSE(result.HasResponse());
+  EXPECT_FALSE(result.HasStatus());
+}
+
+TEST(TestRequestResult, StatusIsWrapped)
+{
+  RdmnetRptStatus c_status{};
+  c_status.seq_num = 42;
+  c_status.status_code = kRptStatusUnknownRdmUid;
+
+  RdmnetRequestResult c_result{};
+  c_result.seq_num = 42;
+  c_result.outcome = kRdmnetRequestStatusReceived;
+  c_result.status = &c_status;
+
+  rdmnet::RequestResult result(c_result);
+  ASSERT_TRUE(result.HasStatus());
+  EXPECT_FALSE(result.HasResponse());
+  EXPECT_EQ(result.status().seq_num(), 42u);
+  EXPECT_EQ(result.status().status_code(), kRptStatusUnknownRdmUid);
+}
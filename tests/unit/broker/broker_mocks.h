@@ -35,8 +35,11 @@ public:
   MOCK_METHOD(bool, Startup, (), (override));
   MOCK_METHOD(bool, Shutdown, (), (override));
   MOCK_METHOD(void, SetNotify, (BrokerSocketNotify * notify), (override));
+  MOCK_METHOD(void, SetWorkerThreadConfig, (unsigned int num_threads, bool pin_threads), (override));
+  MOCK_METHOD(void, SetRecvBufferSize, (size_t size), (override));
   MOCK_METHOD(bool, AddSocket, (BrokerClient::Handle conn_handle, etcpal_socket_t sock), (override));
   MOCK_METHOD(void, RemoveSocket, (BrokerClient::Handle conn_handle), (override));
+  MOCK_METHOD(void, ResumeThrottledSockets, (), (override));
 };
 
 class MockBrokerThreadManager : public BrokerThreadInterface
@@ -45,6 +48,8 @@ public:
   MOCK_METHOD(void, SetNotify, (BrokerThreadNotify * notify), (override));
   MOCK_METHOD(etcpal::Error, AddListenThread, (etcpal_socket_t listen_sock), (override));
   MOCK_METHOD(etcpal::Error, AddClientServiceThread, (), (override));
+  MOCK_METHOD(etcpal::Error, AddUidReservationSaveThread, (), (override));
+  MOCK_METHOD(void, WakeClientServiceThreads, (), (override));
   MOCK_METHOD(void, StopThreads, (), (override));
 };
 
@@ -94,6 +99,7 @@ struct BrokerMocks
     ON_CALL(*socket_mgr, Startup()).WillByDefault(testing::Return(true));
     ON_CALL(*threads, AddListenThread(testing::_)).WillByDefault(testing::Return(etcpal::Error::Ok()));
     ON_CALL(*threads, AddClientServiceThread()).WillByDefault(testing::Return(etcpal::Error::Ok()));
+    ON_CALL(*threads, AddUidReservationSaveThread()).WillByDefault(testing::Return(etcpal::Error::Ok()));
     ON_CALL(*disc, RegisterBroker(testing::_, testing::_, testing::_))
         .WillByDefault(testing::Return(etcpal::Error::Ok()));
   }
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "broker_admission.h"
+
+#include "gmock/gmock.h"
+#include "etcpal_mock/timer.h"
+
+class TestConnectAdmission : public testing::Test
+{
+protected:
+  static constexpr unsigned int kConnectRate = 10;  // One token every 100 ms
+
+  ConnectAdmission admission_;
+
+  void SetUp() override { etcpal_timer_reset_all_fakes(); }
+
+  void Configure(unsigned int rate, unsigned int burst, unsigned int max_deferred = 0)
+  {
+    rdmnet::Broker::Limits limits;
+    limits.connect_rate = rate;
+    limits.connect_burst = burst;
+    limits.deferred_connects = max_deferred;
+    admission_.Configure(limits);
+  }
+
+  static RdmnetRptClientEntry Entry(rpt_client_type_t type, uint32_t id = 1)
+  {
+    RdmnetRptClientEntry entry{};
+    entry.type = type;
+    entry.uid = RdmUid{0x6574, id};
+    return entry;
+  }
+};
+
+TEST_F(TestConnectAdmission, AdmitsEverythingWithoutRate)
+{
+  Configure(0, 1);
+
+  for (BrokerClient::Handle handle = 0; handle < 100; ++handle)
+    EXPECT_EQ(admission_.Admit(handle, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kAdmit);
+  EXPECT_FALSE(admission_.HasDeferred());
+}
+
+TEST_F(TestConnectAdmission, DefersDevicesBeyondBurst)
+{
+  Configure(kConnectRate, 2);
+
+  EXPECT_EQ(admission_.Admit(0, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kAdmit);
+  EXPECT_EQ(admission_.Admit(1, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kAdmit);
+  EXPECT_EQ(admission_.Admit(2, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kDefer);
+  EXPECT_TRUE(admission_.HasDeferred());
+  EXPECT_TRUE(admission_.TakeReady(10).empty());
+
+  auto stats = admission_.stats();
+  EXPECT_EQ(stats.connects_deferred, 1u);
+  EXPECT_EQ(stats.connects_queued, 1u);
+}
+
+TEST_F(TestConnectAdmission, ReleasesDeferredInOrderAsTokensRefill)
+{
+  Configure(kConnectRate, 1);
+
+  EXPECT_EQ(admission_.Admit(0, Entry(kRPTClientTypeDevice, 0)), ConnectAdmission::Decision::kAdmit);
+  for (BrokerClient::Handle handle = 1; handle <= 3; ++handle)
+    EXPECT_EQ(admission_.Admit(handle, Entry(kRPTClientTypeDevice, handle)), ConnectAdmission::Decision::kDefer);
+
+  etcpal_getms_fake.return_val += 1000 / kConnectRate;
+  auto ready = admission_.TakeReady(10);
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0].handle, 1);
+  EXPECT_EQ(ready[0].client_entry.uid.id, 1u);
+
+  // The bucket never holds more than the burst, however long it has been.
+  etcpal_getms_fake.return_val += 10000;
+  ready = admission_.TakeReady(10);
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0].handle, 2);
+
+  etcpal_getms_fake.return_val += 1000 / kConnectRate;
+  ready = admission_.TakeReady(10);
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0].handle, 3);
+  EXPECT_FALSE(admission_.HasDeferred());
+}
+
+TEST_F(TestConnectAdmission, DevicesWaitBehindDeferredDevices)
+{
+  Configure(kConnectRate, 1);
+
+  EXPECT_EQ(admission_.Admit(0, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kAdmit);
+  EXPECT_EQ(admission_.Admit(1, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kDefer);
+
+  // A token is available again, but the device which arrived first gets it.
+  etcpal_getms_fake.return_val += 1000 / kConnectRate;
+  EXPECT_EQ(admission_.Admit(2, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kDefer);
+  auto ready = admission_.TakeReady(10);
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0].handle, 1);
+}
+
+TEST_F(TestConnectAdmission, ControllersAreAlwaysAdmitted)
+{
+  Configure(kConnectRate, 1);
+
+  EXPECT_EQ(admission_.Admit(0, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kAdmit);
+  EXPECT_EQ(admission_.Admit(1, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kDefer);
+  EXPECT_EQ(admission_.Admit(2, Entry(kRPTClientTypeController)), ConnectAdmission::Decision::kAdmit);
+  EXPECT_EQ(admission_.Admit(3, Entry(kRPTClientTypeController)), ConnectAdmission::Decision::kAdmit);
+}
+
+TEST_F(TestConnectAdmission, RejectsBeyondDeferredLimit)
+{
+  Configure(kConnectRate, 1, 2);
+
+  EXPECT_EQ(admission_.Admit(0, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kAdmit);
+  EXPECT_EQ(admission_.Admit(1, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kDefer);
+  EXPECT_EQ(admission_.Admit(2, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kDefer);
+  EXPECT_EQ(admission_.Admit(3, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kReject);
+
+  auto stats = admission_.stats();
+  EXPECT_EQ(stats.connects_deferred, 2u);
+  EXPECT_EQ(stats.connects_rejected, 1u);
+  EXPECT_EQ(stats.connects_queued, 2u);
+}
+
+TEST_F(TestConnectAdmission, TakeReadyIsLimited)
+{
+  Configure(kConnectRate, 10);
+
+  for (BrokerClient::Handle handle = 0; handle < 10; ++handle)
+    admission_.Admit(handle, Entry(kRPTClientTypeDevice));
+  for (BrokerClient::Handle handle = 10; handle < 20; ++handle)
+    EXPECT_EQ(admission_.Admit(handle, Entry(kRPTClientTypeDevice)), ConnectAdmission::Decision::kDefer);
+
+  etcpal_getms_fake.return_val += 1000;
+  EXPECT_EQ(admission_.TakeReady(4).size(), 4u);
+  EXPECT_EQ(admission_.TakeReady(100).size(), 6u);
+}
+
+TEST_F(TestConnectAdmission, ClearDropsDeferred)
+{
+  Configure(kConnectRate, 1);
+
+  admission_.Admit(0, Entry(kRPTClientTypeDevice));
+  admission_.Admit(1, Entry(kRPTClientTypeDevice));
+  ASSERT_TRUE(admission_.HasDeferred());
+
+  admission_.Clear();
+  EXPECT_FALSE(admission_.HasDeferred());
+  EXPECT_EQ(admission_.stats().connects_queued, 0u);
+}
+
+TEST_F(TestConnectAdmission, RemoveDropsDeferred)
+{
+  Configure(kConnectRate, 1);
+
+  admission_.Admit(0, Entry(kRPTClientTypeDevice));
+  admission_.Admit(1, Entry(kRPTClientTypeDevice));
+  admission_.Admit(2, Entry(kRPTClientTypeDevice));
+  admission_.Remove(1);
+  EXPECT_EQ(admission_.stats().connects_queued, 1u);
+
+  // The removed connect doesn't use up the next token.
+  etcpal_getms_fake.return_val += 1000 / kConnectRate;
+  auto ready = admission_.TakeReady(100);
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0].handle, 2);
+  EXPECT_FALSE(admission_.HasDeferred());
+}
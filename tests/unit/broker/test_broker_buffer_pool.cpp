@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "broker_buffer_pool.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+#include "gmock/gmock.h"
+
+TEST(TestBrokerBufferPool, SizeClassesCoverRequestedSize)
+{
+  EXPECT_EQ(BrokerBufferPool::SizeClassIndex(0), 0u);
+  EXPECT_EQ(BrokerBufferPool::SizeClassIndex(BrokerBufferPool::kMinClassSize), 0u);
+  EXPECT_EQ(BrokerBufferPool::SizeClassIndex(BrokerBufferPool::kMinClassSize + 1), 1u);
+  EXPECT_EQ(BrokerBufferPool::SizeClassIndex(BrokerBufferPool::kMaxClassSize), BrokerBufferPool::kNumSizeClasses - 1);
+  EXPECT_EQ(BrokerBufferPool::SizeClassIndex(BrokerBufferPool::kMaxClassSize + 1), BrokerBufferPool::kNumSizeClasses);
+
+  PooledBuffer buf(300);
+  ASSERT_TRUE(buf);
+  EXPECT_EQ(buf.capacity(), 512u);
+}
+
+TEST(TestBrokerBufferPool, RecyclesReleasedBuffers)
+{
+  PooledBuffer first(200);
+  ASSERT_TRUE(first);
+  uint8_t* first_data = first.get();
+  first.reset();
+  EXPECT_FALSE(first);
+
+  auto         stats_before = BrokerBufferPool::Get().stats();
+  PooledBuffer second(200);
+  auto         stats_after = BrokerBufferPool::Get().stats();
+
+  EXPECT_EQ(second.get(), first_data);
+  EXPECT_EQ(stats_after.pool_hits, stats_before.pool_hits + 1);
+  EXPECT_EQ(stats_after.heap_allocations, stats_before.heap_allocations);
+}
+
+TEST(TestBrokerBufferPool, CopiesShareBuffer)
+{
+  auto stats_before = BrokerBufferPool::Get().stats();
+  {
+    PooledBuffer buf(1000);
+    PooledBuffer copy = buf;
+    PooledBuffer moved(std::move(copy));
+
+    EXPECT_EQ(moved.get(), buf.get());
+    EXPECT_FALSE(copy);
+    EXPECT_EQ(BrokerBufferPool::Get().stats().buffers_in_use, stats_before.buffers_in_use + 1);
+
+    buf.reset();
+    EXPECT_EQ(BrokerBufferPool::Get().stats().buffers_in_use, stats_before.buffers_in_use + 1);
+  }
+  EXPECT_EQ(BrokerBufferPool::Get().stats().buffers_in_use, stats_before.buffers_in_use);
+}
+
+TEST(TestBrokerBufferPool, OversizedBuffersBypassPool)
+{
+  auto stats_before = BrokerBufferPool::Get().stats();
+  {
+    PooledBuffer big(BrokerBufferPool::kMaxClassSize + 1);
+    ASSERT_TRUE(big);
+    EXPECT_EQ(big.capacity(), BrokerBufferPool::kMaxClassSize + 1);
+  }
+  auto stats_after = BrokerBufferPool::Get().stats();
+  EXPECT_EQ(stats_after.heap_allocations, stats_before.heap_allocations + 1);
+  EXPECT_EQ(stats_after.buffers_free, stats_before.buffers_free);
+}
+
+TEST(TestBrokerBufferPool, ManyBuffersAreReused)
+{
+  static constexpr size_t kNumBuffers = 200;
+
+  std::vector<PooledBuffer> bufs;
+  for (size_t i = 0; i < kNumBuffers; ++i)
+    bufs.emplace_back(100);
+  bufs.clear();
+
+  auto stats_before = BrokerBufferPool::Get().stats();
+  for (size_t i = 0; i < kNumBuffers; ++i)
+    bufs.emplace_back(100);
+  auto stats_after = BrokerBufferPool::Get().stats();
+
+  EXPECT_EQ(stats_after.heap_allocations, stats_before.heap_allocations);
+  EXPECT_EQ(stats_after.pool_hits, stats_before.pool_hits + kNumBuffers);
+}
+
+TEST(TestBrokerBufferPool, FreeLargeBuffersAreCappedByBytes)
+{
+  const size_t kLargestClass = BrokerBufferPool::kNumSizeClasses - 1;
+  const size_t kLargestSize = BrokerBufferPool::SizeClassCapacity(kLargestClass);
+  const size_t kMaxFree = BrokerBufferPool::MaxSharedFreeBuffers(kLargestClass) + BrokerBufferPool::kThreadCacheSize;
+  EXPECT_LE(BrokerBufferPool::MaxSharedFreeBuffers(kLargestClass) * kLargestSize,
+            BrokerBufferPool::kMaxSharedFreeBytes);
+  EXPECT_EQ(BrokerBufferPool::MaxSharedFreeBuffers(0), BrokerBufferPool::kMaxSharedFreeBuffers);
+
+  auto stats_before = BrokerBufferPool::Get().stats();
+
+  std::vector<PooledBuffer> bufs;
+  for (size_t i = 0; i < kMaxFree * 2; ++i)
+    bufs.emplace_back(kLargestSize);
+  bufs.clear();
+
+  EXPECT_LE(BrokerBufferPool::Get().stats().buffers_free, stats_before.buffers_free + kMaxFree);
+}
+
+// Stands in for a thread-local or static object that releases a buffer after the releasing
+// thread's cache is gone.
+struct LateReleaser
+{
+  PooledBuffer buf;
+};
+
+TEST(TestBrokerBufferPool, ReleaseAfterThreadCacheIsDestroyed)
+{
+  auto stats_before = BrokerBufferPool::Get().stats();
+
+  std::thread thread([]() {
+    // Constructed before this thread's cache, so destroyed after it.
+    static thread_local LateReleaser late_releaser;
+    late_releaser.buf = PooledBuffer(100);
+  });
+  thread.join();
+
+  auto stats_after = BrokerBufferPool::Get().stats();
+  EXPECT_EQ(stats_after.allocations, stats_before.allocations + 1);
+  EXPECT_EQ(stats_after.buffers_in_use, stats_before.buffers_in_use);
+}
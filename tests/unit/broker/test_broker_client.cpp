@@ -28,7 +28,9 @@
 #include "etcpal_mock/timer.h"
 #include "etcpal_mock/socket.h"
 #include "rdmnet_mock/core/common.h"
+#include "rdmnet/core/broker_prot.h"
 #include "rdm/cpp/uid.h"
+#include "broker_service_schedule.h"
 
 // A generic broker message to be used for filling up queues of clients.
 // We use the CLIENT_ADD vector.
@@ -98,6 +100,29 @@ TEST_F(TestBaseBrokerClient, SendsHeartbeat)
   EXPECT_EQ(rc_send_fake.call_count, 1u);
 }
 
+TEST_F(TestBaseBrokerClient, SendsSharedPreencodedHeartbeat)
+{
+  client_->null_msg_ = MessageRef(BROKER_NULL_FULL_MSG_SIZE);
+  client_->null_msg_.size =
+      rc_broker_pack_null(client_->null_msg_.data.get(), BROKER_NULL_FULL_MSG_SIZE, &broker_cid_.get());
+  ASSERT_EQ(client_->null_msg_.size, 44u);
+
+  static const uint8_t* null_data;
+  null_data = client_->null_msg_.data.get();
+
+  // Advance time so that the heartbeat send interval has passed
+  etcpal_getms_fake.return_val = (E133_TCP_HEARTBEAT_INTERVAL_SEC * 1000) + 500;
+
+  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+    EXPECT_EQ(data, null_data);
+    EXPECT_EQ(size, 44u);
+    return 44;
+  };
+
+  EXPECT_TRUE(client_->Send(broker_cid_));
+  EXPECT_EQ(rc_send_fake.call_count, 1u);
+}
+
 TEST_F(TestBaseBrokerClient, HandlesHeartbeatTimeout)
 {
   // Advance time so that the heartbeat timeout has passed.
@@ -232,6 +257,55 @@ TEST_F(TestBaseBrokerClient, MarkForDestructionMarkSocketInvalidWorks)
   EXPECT_EQ(client_->socket_, ETCPAL_SOCKET_INVALID);
 }
 
+TEST_F(TestBaseBrokerClient, QueuedMessageMarksClientSendReady)
+{
+  ClientServiceSchedule schedule;
+  client_->schedule_ = &schedule;
+
+  // Only the first message queued to a client with empty queues puts it on the send-ready list.
+  GenericBrokerMessage msg;
+  EXPECT_EQ(client_->Push(broker_cid_, msg.msg), ClientPushResult::Ok);
+  EXPECT_EQ(client_->Push(broker_cid_, msg.msg), ClientPushResult::Ok);
+  EXPECT_EQ(schedule.num_send_ready(), 1u);
+}
+
+TEST_F(TestBaseBrokerClient, SendReadyKeepsClientReadyUntilQueuesAreEmpty)
+{
+  ClientServiceSchedule schedule;
+  client_->schedule_ = &schedule;
+
+  rc_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t size, int) { return static_cast<int>(size); };
+
+  GenericBrokerMessage msg;
+  client_->Push(broker_cid_, msg.msg);
+  client_->Push(broker_cid_, msg.msg);
+
+  std::vector<BrokerClient::Handle> handles;
+  schedule.TakeSendReady(handles);
+  EXPECT_TRUE(client_->SendReady(broker_cid_));
+  EXPECT_EQ(schedule.num_send_ready(), 1u);
+
+  schedule.TakeSendReady(handles);
+  EXPECT_TRUE(client_->SendReady(broker_cid_));
+  EXPECT_EQ(schedule.num_send_ready(), 0u);
+  EXPECT_EQ(rc_send_fake.call_count, 2u);
+
+  // The next message queued puts the client back on the list.
+  client_->Push(broker_cid_, msg.msg);
+  EXPECT_EQ(schedule.num_send_ready(), 1u);
+}
+
+TEST_F(TestBaseBrokerClient, TimeUntilNextTimerTracksNullInterval)
+{
+  EXPECT_EQ(client_->TimeUntilNextTimer(), E133_TCP_HEARTBEAT_INTERVAL_SEC * 1000u);
+
+  etcpal_getms_fake.return_val = 5000;
+  EXPECT_EQ(client_->TimeUntilNextTimer(), (E133_TCP_HEARTBEAT_INTERVAL_SEC * 1000u) - 5000);
+
+  etcpal_getms_fake.return_val = (E133_TCP_HEARTBEAT_INTERVAL_SEC * 1000) + 500;
+  EXPECT_EQ(client_->TimeUntilNextTimer(), 0u);
+}
+
 class TestBrokerClientRptController : public testing::Test
 {
 protected:
@@ -338,6 +412,120 @@ TEST_F(TestBrokerClientRptController, InfiniteMaxQSize)
   }
 }
 
+TEST_F(TestBrokerClientRptController, SharesPackedMessageBetweenQueues)
+{
+  BrokerClient  bc(kClientHandle + 1, kClientSocket);
+  RPTController controller_2(kMaxQSize, client_entry_, bc);
+
+  MessageRef packed = PackRptMessage(broker_cid_, request_);
+  ASSERT_NE(packed.size, 0u);
+  ASSERT_EQ(controller_->Push(sending_controller_handle_, VECTOR_RPT_REQUEST, packed), ClientPushResult::Ok);
+  ASSERT_EQ(controller_2.Push(sending_controller_handle_, VECTOR_RPT_REQUEST, packed), ClientPushResult::Ok);
+
+  static const uint8_t* packed_data;
+  static size_t         packed_size;
+  packed_data = packed.data.get();
+  packed_size = packed.size;
+
+  // The first controller only gets half of the message out.
+  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+    EXPECT_EQ(data, packed_data);
+    EXPECT_EQ(size, packed_size);
+    return static_cast<int>(size / 2);
+  };
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+
+  // The second controller's progress is tracked separately, and the data was not copied.
+  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+    EXPECT_EQ(data, packed_data);
+    EXPECT_EQ(size, packed_size);
+    return static_cast<int>(size);
+  };
+  EXPECT_TRUE(controller_2.Send(broker_cid_));
+
+  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+    EXPECT_EQ(data, packed_data + packed_size / 2);
+    EXPECT_EQ(size, packed_size - packed_size / 2);
+    return static_cast<int>(size);
+  };
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_EQ(rc_send_fake.call_count, 3u);
+}
+
+TEST_F(TestBrokerClientRptController, BatchedSendCoalescesAllQueues)
+{
+  controller_->send_batch_size_ = 65536;
+
+  GenericBrokerMessage broker_msg;
+  ASSERT_EQ(controller_->Push(sending_controller_handle_, broker_cid_, request_), ClientPushResult::Ok);
+  ASSERT_EQ(controller_->Push(broker_cid_, rpt_header_, status_msg_), ClientPushResult::Ok);
+  ASSERT_EQ(controller_->Push(broker_cid_, broker_msg.msg), ClientPushResult::Ok);
+
+  static size_t expected_size;
+  expected_size = rc_broker_get_rpt_client_list_buffer_size(1) + rc_rpt_get_status_buffer_size(&status_msg_) +
+                  rc_rpt_get_request_buffer_size(&rdm_buf_);
+
+  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+    EXPECT_EQ(size, expected_size);
+    // The broker message must come first, regardless of the order in which messages were queued.
+    EXPECT_EQ(etcpal_unpack_u16b(&(reinterpret_cast<const uint8_t*>(data))[42]), VECTOR_BROKER_CLIENT_ADD);
+    return static_cast<int>(size);
+  };
+
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_EQ(rc_send_fake.call_count, 1u);
+
+  // Everything was sent in one call.
+  EXPECT_FALSE(controller_->Send(broker_cid_));
+  EXPECT_EQ(rc_send_fake.call_count, 1u);
+}
+
+TEST_F(TestBrokerClientRptController, BatchedSendTracksPartialWrites)
+{
+  controller_->send_batch_size_ = 65536;
+
+  for (int i = 0; i < 4; ++i)
+    ASSERT_EQ(controller_->Push(sending_controller_handle_, broker_cid_, request_), ClientPushResult::Ok);
+
+  static size_t total_size;
+  static size_t total_sent;
+  total_size = 4 * rc_rpt_get_request_buffer_size(&rdm_buf_);
+  total_sent = 0;
+
+  // Only accept half of what is offered on the first call.
+  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* /*data*/, size_t size, int /*flags*/) {
+    EXPECT_EQ(size, total_size - total_sent);
+    size_t accepted = (total_sent == 0 ? size / 2 : size);
+    total_sent += accepted;
+    return static_cast<int>(accepted);
+  };
+
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_EQ(total_sent, total_size);
+  EXPECT_FALSE(controller_->Send(broker_cid_));
+  EXPECT_EQ(rc_send_fake.call_count, 2u);
+}
+
+TEST_F(TestBrokerClientRptController, BatchedSendHonorsBatchSize)
+{
+  // Room for two requests per batch.
+  controller_->send_batch_size_ = 2 * rc_rpt_get_request_buffer_size(&rdm_buf_);
+
+  for (int i = 0; i < 5; ++i)
+    ASSERT_EQ(controller_->Push(sending_controller_handle_, broker_cid_, request_), ClientPushResult::Ok);
+
+  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* /*data*/, size_t size, int /*flags*/) {
+    return static_cast<int>(size);
+  };
+
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_FALSE(controller_->Send(broker_cid_));
+  EXPECT_EQ(rc_send_fake.call_count, 3u);
+}
+
 class TestBrokerClientRptDevice : public testing::Test
 {
 public:
@@ -562,3 +750,42 @@ TEST_F(TestBrokerClientRptDevice, FairScheduler)
   SendAndVerify<1>(device_.get(), broker_cid_);
   SendAndVerify<1>(device_.get(), broker_cid_);
 }
+
+// A batch boundary falls between each message here, so every batch peeks at a message it then
+// leaves for the next batch. That message's controller must not lose its turn.
+TEST_F(TestBrokerClientRptDevice, BatchedSendKeepsFairSchedule)
+{
+  RptMessage request{};
+  request.vector = VECTOR_RPT_REQUEST;
+
+  request.header.dest_uid = kDeviceUid.get();
+  request.header.dest_endpoint_id = E133_NULL_ENDPOINT;
+  request.header.source_endpoint_id = E133_NULL_ENDPOINT;
+  request.header.seqnum = 1;
+
+  RdmBuffer rdm{{}, 100};
+  RPT_GET_RDM_BUF_LIST(&request)->rdm_buffers = &rdm;
+  RPT_GET_RDM_BUF_LIST(&request)->num_rdm_buffers = 1;
+
+  // Room for one request per batch.
+  device_->send_batch_size_ = rc_rpt_get_request_buffer_size(&rdm);
+
+  const auto controller_1_handle = kClientHandle + 1;
+  const auto controller_2_handle = kClientHandle + 2;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    request.header.source_uid = RdmUid{0x6574, 1};
+    EXPECT_EQ(device_->Push(controller_1_handle, kController1Cid, request), ClientPushResult::Ok);
+    request.header.source_uid = RdmUid{0x6574, 2};
+    EXPECT_EQ(device_->Push(controller_2_handle, kController2Cid, request), ClientPushResult::Ok);
+    ++request.header.seqnum;
+  }
+
+  SendAndVerify<1>(device_.get(), broker_cid_);
+  SendAndVerify<2>(device_.get(), broker_cid_);
+  SendAndVerify<1>(device_.get(), broker_cid_);
+  SendAndVerify<2>(device_.get(), broker_cid_);
+  SendAndVerify<1>(device_.get(), broker_cid_);
+  SendAndVerify<2>(device_.get(), broker_cid_);
+  EXPECT_FALSE(device_->HasQueuedMessages());
+}
@@ -22,6 +22,7 @@
 #include "broker_core.h"
 
 #include <set>
+#include <vector>
 #include "gmock/gmock.h"
 #include "etcpal/cpp/inet.h"
 #include "etcpal/pack.h"
@@ -29,6 +30,7 @@
 #include "etcpal_mock/socket.h"
 #include "etcpal_mock/timer.h"
 #include "rdmnet_mock/core/common.h"
+#include "rdmnet/core/broker_prot.h"
 #include "test_broker_messages.h"
 #include "broker_mocks.h"
 
@@ -92,6 +94,17 @@ TEST_F(TestBrokerCoreConnectHandling, HandlesConnect)
   RESET_FAKE(rc_send);
 }
 
+TEST_F(TestBrokerCoreConnectHandling, ConnectWakesClientServiceThread)
+{
+  auto                 client_cid = etcpal::Uuid::OsPreferred();
+  BrokerClient::Handle conn_handle = AddTcpConn();
+  RdmnetMessage        connect_msg = testmsgs::ClientConnect(client_cid);
+
+  // The connect reply is queued by the message handler, so the service thread must be woken to send it.
+  EXPECT_CALL(*mocks_.threads, WakeClientServiceThreads()).Times(testing::AtLeast(1));
+  mocks_.broker_callbacks->HandleSocketMessageReceived(conn_handle, connect_msg);
+}
+
 TEST_F(TestBrokerCoreConnectHandling, RejectsScopeMismatch)
 {
   auto                 client_cid = etcpal::Uuid::OsPreferred();
@@ -133,3 +146,253 @@ TEST_F(TestBrokerCoreConnectHandling, HandlesRemoveUidOnDisconnect)
   mocks_.broker_callbacks->HandleSocketMessageReceived(conn_handle, disconnect_msg);
   EXPECT_FALSE(broker_.IsValidControllerDestinationUID(rdm::Uid(0xe574, 0x00000002).get()));
 }
+
+class TestBrokerCoreClientListUpdates : public testing::Test
+{
+protected:
+  static constexpr unsigned int kUpdateWindowMs = 100;
+
+  struct SentBrokerMessage
+  {
+    uint16_t vector;
+    size_t   size;
+  };
+  static std::vector<SentBrokerMessage> sent_msgs_;
+
+  BrokerMocks mocks_{BrokerMocks::Nice()};
+  BrokerCore  broker_;
+
+  const etcpal::SockAddr kDefaultClientAddr{etcpal::IpAddr::FromString("192.168.20.30"), 49000};
+  const etcpal_socket_t  kDefaultClientSocket{(etcpal_socket_t)1};
+
+  void SetUp() override
+  {
+    etcpal_reset_all_fakes();
+    rdmnet_mock_core_reset_and_init();
+    sent_msgs_.clear();
+
+    rc_send_fake.custom_fake = [](etcpal_socket_t, const void* data, size_t data_size, int) -> int {
+      const uint8_t* byte_data = reinterpret_cast<const uint8_t*>(data);
+      if (data_size >= kBrokerVectorOffset + 2 &&
+          etcpal_unpack_u32b(&byte_data[kRootVectorOffset]) == ACN_VECTOR_ROOT_BROKER)
+      {
+        sent_msgs_.push_back(SentBrokerMessage{etcpal_unpack_u16b(&byte_data[kBrokerVectorOffset]), data_size});
+      }
+      return static_cast<int>(data_size);
+    };
+
+    auto settings = DefaultBrokerSettings();
+    settings.client_list_update_window_ms = kUpdateWindowMs;
+    ASSERT_TRUE(StartBroker(broker_, settings, mocks_));
+  }
+
+  void Connect(rpt_client_type_t type)
+  {
+    BrokerClient::Handle new_conn_handle;
+    EXPECT_CALL(*mocks_.socket_mgr, AddSocket(_, kDefaultClientSocket))
+        .WillOnce(DoAll(SaveArg<0>(&new_conn_handle), Return(true)));
+    EXPECT_TRUE(mocks_.broker_callbacks->HandleNewConnection(kDefaultClientSocket, kDefaultClientAddr));
+
+    RdmnetMessage connect_msg = testmsgs::ClientConnect(etcpal::Uuid::OsPreferred(), E133_DEFAULT_SCOPE, type);
+    mocks_.broker_callbacks->HandleSocketMessageReceived(new_conn_handle, connect_msg);
+    mocks_.broker_callbacks->ServiceClients();
+  }
+
+  std::vector<SentBrokerMessage> SentClientAdds() const
+  {
+    std::vector<SentBrokerMessage> adds;
+    for (const auto& msg : sent_msgs_)
+    {
+      if (msg.vector == VECTOR_BROKER_CLIENT_ADD)
+        adds.push_back(msg);
+    }
+    return adds;
+  }
+};
+
+std::vector<TestBrokerCoreClientListUpdates::SentBrokerMessage> TestBrokerCoreClientListUpdates::sent_msgs_;
+
+TEST_F(TestBrokerCoreClientListUpdates, CoalescesClientAddsWithinWindow)
+{
+  Connect(kRPTClientTypeController);
+  for (int i = 0; i < 3; ++i)
+    Connect(kRPTClientTypeDevice);
+
+  EXPECT_TRUE(SentClientAdds().empty());
+
+  etcpal_getms_fake.return_val += kUpdateWindowMs + 1;
+  mocks_.broker_callbacks->ServiceClients();
+
+  auto adds = SentClientAdds();
+  ASSERT_EQ(adds.size(), 1u);
+  EXPECT_EQ(adds[0].size, rc_broker_get_rpt_client_list_buffer_size(3));
+}
+
+TEST_F(TestBrokerCoreClientListUpdates, NewControllerOnlyGetsLaterUpdates)
+{
+  // The controller learns about the first device from the client list it fetches after connecting.
+  Connect(kRPTClientTypeDevice);
+  Connect(kRPTClientTypeController);
+  Connect(kRPTClientTypeDevice);
+
+  etcpal_getms_fake.return_val += kUpdateWindowMs + 1;
+  mocks_.broker_callbacks->ServiceClients();
+
+  auto adds = SentClientAdds();
+  ASSERT_EQ(adds.size(), 1u);
+  EXPECT_EQ(adds[0].size, rc_broker_get_rpt_client_list_buffer_size(1));
+}
+
+class TestBrokerCoreConnectAdmission : public testing::Test
+{
+protected:
+  static constexpr unsigned int kConnectRate = 10;  // One connect every 100 ms
+
+  static std::vector<uint16_t> connect_reply_codes_;
+
+  BrokerMocks mocks_{BrokerMocks::Nice()};
+  BrokerCore  broker_;
+
+  const etcpal::SockAddr kDefaultClientAddr{etcpal::IpAddr::FromString("192.168.20.30"), 49000};
+  const etcpal_socket_t  kDefaultClientSocket{(etcpal_socket_t)1};
+
+  void SetUp() override
+  {
+    etcpal_reset_all_fakes();
+    rdmnet_mock_core_reset_and_init();
+    connect_reply_codes_.clear();
+
+    rc_send_fake.custom_fake = [](etcpal_socket_t, const void* data, size_t data_size, int) -> int {
+      const uint8_t* byte_data = reinterpret_cast<const uint8_t*>(data);
+      if (data_size == BROKER_CONNECT_REPLY_FULL_MSG_SIZE &&
+          etcpal_unpack_u16b(&byte_data[kBrokerVectorOffset]) == VECTOR_BROKER_CONNECT_REPLY)
+      {
+        connect_reply_codes_.push_back(etcpal_unpack_u16b(&byte_data[kConnectReplyCodeOffset]));
+      }
+      return static_cast<int>(data_size);
+    };
+  }
+
+  void StartWithLimits(const rdmnet::Broker::Limits& limits)
+  {
+    auto settings = DefaultBrokerSettings();
+    settings.limits = limits;
+    ASSERT_TRUE(StartBroker(broker_, settings, mocks_));
+  }
+
+  static rdmnet::Broker::Limits RateLimits(unsigned int burst)
+  {
+    rdmnet::Broker::Limits limits;
+    limits.connect_rate = kConnectRate;
+    limits.connect_burst = burst;
+    return limits;
+  }
+
+  BrokerClient::Handle AddTcpConn()
+  {
+    BrokerClient::Handle new_conn_handle;
+    EXPECT_CALL(*mocks_.socket_mgr, AddSocket(_, kDefaultClientSocket))
+        .WillOnce(DoAll(SaveArg<0>(&new_conn_handle), Return(true)));
+    EXPECT_TRUE(mocks_.broker_callbacks->HandleNewConnection(kDefaultClientSocket, kDefaultClientAddr));
+    return new_conn_handle;
+  }
+
+  BrokerClient::Handle Connect(rpt_client_type_t type)
+  {
+    BrokerClient::Handle conn_handle = AddTcpConn();
+
+    RdmnetMessage connect_msg = testmsgs::ClientConnect(etcpal::Uuid::OsPreferred(), E133_DEFAULT_SCOPE, type);
+    mocks_.broker_callbacks->HandleSocketMessageReceived(conn_handle, connect_msg);
+    mocks_.broker_callbacks->ServiceClients();
+    return conn_handle;
+  }
+};
+
+std::vector<uint16_t> TestBrokerCoreConnectAdmission::connect_reply_codes_;
+
+TEST_F(TestBrokerCoreConnectAdmission, DefersDeviceConnectsOverRate)
+{
+  StartWithLimits(RateLimits(1));
+
+  Connect(kRPTClientTypeDevice);
+  Connect(kRPTClientTypeDevice);
+
+  EXPECT_EQ(connect_reply_codes_, std::vector<uint16_t>({E133_CONNECT_OK}));
+  EXPECT_EQ(broker_.admission_stats().connects_deferred, 1u);
+  EXPECT_EQ(broker_.admission_stats().connects_queued, 1u);
+
+  etcpal_getms_fake.return_val += 1000 / kConnectRate;
+  mocks_.broker_callbacks->ServiceClients();
+  mocks_.broker_callbacks->ServiceClients();
+
+  EXPECT_EQ(connect_reply_codes_, std::vector<uint16_t>({E133_CONNECT_OK, E133_CONNECT_OK}));
+  EXPECT_EQ(broker_.admission_stats().connects_queued, 0u);
+}
+
+TEST_F(TestBrokerCoreConnectAdmission, DisconnectedDeferredClientsDoNotUseTokens)
+{
+  StartWithLimits(RateLimits(1));
+
+  Connect(kRPTClientTypeDevice);
+  BrokerClient::Handle gone_handle = Connect(kRPTClientTypeDevice);
+  Connect(kRPTClientTypeDevice);
+  EXPECT_EQ(broker_.admission_stats().connects_queued, 2u);
+
+  mocks_.broker_callbacks->HandleSocketClosed(gone_handle, true);
+  EXPECT_EQ(broker_.admission_stats().connects_queued, 1u);
+
+  // The one new token goes to the client which is still connected.
+  etcpal_getms_fake.return_val += 1000 / kConnectRate;
+  mocks_.broker_callbacks->ServiceClients();
+  mocks_.broker_callbacks->ServiceClients();
+
+  EXPECT_EQ(connect_reply_codes_, std::vector<uint16_t>({E133_CONNECT_OK, E133_CONNECT_OK}));
+  EXPECT_EQ(broker_.admission_stats().connects_queued, 0u);
+}
+
+TEST_F(TestBrokerCoreConnectAdmission, ControllersAreNotDeferred)
+{
+  StartWithLimits(RateLimits(1));
+
+  Connect(kRPTClientTypeDevice);
+  Connect(kRPTClientTypeDevice);
+  Connect(kRPTClientTypeController);
+
+  EXPECT_EQ(connect_reply_codes_, std::vector<uint16_t>({E133_CONNECT_OK, E133_CONNECT_OK}));
+  EXPECT_EQ(broker_.admission_stats().connects_deferred, 1u);
+}
+
+TEST_F(TestBrokerCoreConnectAdmission, RejectsConnectsOverDeferredLimit)
+{
+  auto limits = RateLimits(1);
+  limits.deferred_connects = 1;
+  StartWithLimits(limits);
+
+  Connect(kRPTClientTypeDevice);
+  Connect(kRPTClientTypeDevice);
+  Connect(kRPTClientTypeDevice);
+
+  EXPECT_EQ(connect_reply_codes_, std::vector<uint16_t>({E133_CONNECT_OK, E133_CONNECT_CAPACITY_EXCEEDED}));
+  EXPECT_EQ(broker_.admission_stats().connects_deferred, 1u);
+  EXPECT_EQ(broker_.admission_stats().connects_rejected, 1u);
+}
+
+TEST_F(TestBrokerCoreConnectAdmission, ConnectionLimitCountsConnectedClients)
+{
+  rdmnet::Broker::Limits limits;
+  limits.connections = 1;
+  StartWithLimits(limits);
+
+  // Both TCP connections are accepted, but only one client can complete its connect request.
+  BrokerClient::Handle first_handle = AddTcpConn();
+  BrokerClient::Handle second_handle = AddTcpConn();
+  EXPECT_EQ(broker_.admission_stats().connections_accepted, 2u);
+
+  mocks_.broker_callbacks->HandleSocketMessageReceived(first_handle,
+                                                       testmsgs::ClientConnect(etcpal::Uuid::OsPreferred()));
+  mocks_.broker_callbacks->HandleSocketMessageReceived(second_handle,
+                                                       testmsgs::ClientConnect(etcpal::Uuid::OsPreferred()));
+  mocks_.broker_callbacks->ServiceClients();
+
+  EXPECT_EQ(connect_reply_codes_, std::vector<uint16_t>({E133_CONNECT_OK, E133_CONNECT_CAPACITY_EXCEEDED}));
+}
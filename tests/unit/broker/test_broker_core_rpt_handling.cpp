@@ -21,6 +21,8 @@
 
 #include "broker_core.h"
 
+#include <algorithm>
+#include <vector>
 #include "gmock/gmock.h"
 #include "etcpal_mock/common.h"
 #include "etcpal_mock/socket.h"
@@ -180,3 +182,45 @@ TEST_F(TestBrokerCoreRptHandling, DeviceManuBroadcastThrottlesAtMaxLimit)
 
   testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
 }
+
+TEST_F(TestBrokerCoreRptHandling, ResumesThrottledSocketsWhenQueuesDrain)
+{
+  AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  auto test_cmd = TestRdmCommand::GetBroadcast(E120_DEVICE_INFO);
+  TestMessageLimit(sender_handle, test_cmd.msg, kMaxDeviceMessages);
+
+  // Sending queued data makes room for the throttled sender, so the socket manager should be told to retry it.
+  EXPECT_CALL(*mocks_.socket_mgr, ResumeThrottledSockets()).Times(testing::AtLeast(1));
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+}
+
+TEST_F(TestBrokerCoreRptHandling, ForwardsReceivedBytesWithoutRepacking)
+{
+  static std::vector<uint8_t> sent_data;
+  sent_data.clear();
+
+  AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  // Stand-in for the bytes the message was received as, which differ from what re-packing it would produce so that
+  // it's clear which were queued.
+  const std::vector<uint8_t> raw_msg(100, 0x5a);
+
+  auto test_cmd = TestRdmCommand::GetBroadcast(E120_DEVICE_INFO);
+  EXPECT_EQ(mocks_.broker_callbacks->HandleSocketMessageReceived(sender_handle, test_cmd.msg, raw_msg.data(),
+                                                                 raw_msg.size()),
+            HandleMessageResult::kGetNextMessage);
+
+  rc_send_fake.custom_fake = [](etcpal_socket_t, const void* data, size_t data_size, int) -> int {
+    auto bytes = static_cast<const uint8_t*>(data);
+    sent_data.insert(sent_data.end(), bytes, bytes + data_size);
+    return (int)data_size;
+  };
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+
+  EXPECT_NE(std::search(sent_data.begin(), sent_data.end(), raw_msg.begin(), raw_msg.end()), sent_data.end());
+}
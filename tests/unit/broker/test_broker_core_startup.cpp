@@ -96,6 +96,56 @@ TEST_F(TestBrokerCoreStartup, DoesNotStartWhenClientServiceThreadFails)
   EXPECT_FALSE(StartBroker(DefaultBrokerSettings()));
 }
 
+// Dynamic UID reservations are saved on their own thread, which is only needed if they are kept in a
+// file.
+TEST_F(TestBrokerCoreStartup, NoUidReservationSaveThreadWithoutFile)
+{
+  EXPECT_CALL(*mocks_.threads, AddUidReservationSaveThread()).Times(0);
+  EXPECT_TRUE(StartBroker(DefaultBrokerSettings()));
+}
+
+TEST_F(TestBrokerCoreStartup, StartsUidReservationSaveThreadWithFile)
+{
+  auto settings = DefaultBrokerSettings();
+  settings.uid_reservation_file = "test_broker_core_startup_uid_reservations.bin";
+  EXPECT_CALL(*mocks_.threads, AddUidReservationSaveThread()).WillOnce(Return(kEtcPalErrOk));
+  EXPECT_TRUE(StartBroker(settings));
+}
+
+// The broker should not start if it cannot start the thread which saves dynamic UID reservations.
+TEST_F(TestBrokerCoreStartup, DoesNotStartWhenUidReservationSaveThreadFails)
+{
+  auto settings = DefaultBrokerSettings();
+  settings.uid_reservation_file = "test_broker_core_startup_uid_reservations.bin";
+  EXPECT_CALL(*mocks_.threads, AddUidReservationSaveThread()).WillOnce(Return(kEtcPalErrSys));
+  EXPECT_FALSE(StartBroker(settings));
+}
+
+// The socket worker thread settings should be passed to the socket manager before it is started.
+TEST_F(TestBrokerCoreStartup, ConfiguresSocketWorkerThreads)
+{
+  auto settings = DefaultBrokerSettings();
+  settings.socket_worker_threads = 4;
+  settings.pin_socket_worker_threads = true;
+
+  testing::InSequence seq;
+  EXPECT_CALL(*mocks_.socket_mgr, SetWorkerThreadConfig(4u, true));
+  EXPECT_CALL(*mocks_.socket_mgr, Startup()).WillOnce(Return(true));
+  EXPECT_TRUE(StartBroker(settings));
+}
+
+// The receive buffer size setting should be passed to the socket manager before it is started.
+TEST_F(TestBrokerCoreStartup, ConfiguresSocketRecvBufferSize)
+{
+  auto settings = DefaultBrokerSettings();
+  settings.recv_buffer_size = 32768;
+
+  testing::InSequence seq;
+  EXPECT_CALL(*mocks_.socket_mgr, SetRecvBufferSize(32768u));
+  EXPECT_CALL(*mocks_.socket_mgr, Startup()).WillOnce(Return(true));
+  EXPECT_TRUE(StartBroker(settings));
+}
+
 // When explicit listen interfaces are specified, the broker should create a socket per interface
 // with the appropriate IP protocol and bind it to the interface IP address.
 // TODO: Factor in if netints in settings = NULL for all interfaces - should still be individual sockets.
@@ -152,6 +152,25 @@ TEST_F(TestBrokerCoreMessageHandling, HandlesNoHeartbeat)
   EXPECT_EQ(broker_.GetNumClients(), 0u);
 }
 
+TEST_F(TestBrokerCoreMessageHandling, IdleClientsOnlyServicedWhenTimersExpire)
+{
+  AddClient(etcpal::Uuid::OsPreferred());
+
+  // Nothing is queued and no timers have expired, so nothing is sent.
+  EXPECT_FALSE(mocks_.broker_callbacks->ServiceClients());
+  EXPECT_EQ(rc_send_fake.call_count, 0u);
+
+  // Once the null message interval passes, the client gets a null message, and then nothing more
+  // until the next interval.
+  etcpal_getms_fake.return_val += (E133_TCP_HEARTBEAT_INTERVAL_SEC * 1000) + 500;
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(rc_send_fake.arg2_val, static_cast<size_t>(BROKER_NULL_FULL_MSG_SIZE));
+
+  EXPECT_FALSE(mocks_.broker_callbacks->ServiceClients());
+  EXPECT_EQ(rc_send_fake.call_count, 1u);
+}
+
 TEST_F(TestBrokerCoreMessageHandling, SendsRptClientListOnRequest)
 {
   auto client_1_cid = etcpal::Uuid::OsPreferred();
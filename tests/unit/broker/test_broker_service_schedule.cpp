@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "broker_service_schedule.h"
+
+#include <vector>
+#include "gmock/gmock.h"
+
+using Handles = std::vector<BrokerClient::Handle>;
+
+TEST(TestClientServiceSchedule, SendReadyListsEachClientOnce)
+{
+  ClientServiceSchedule schedule;
+  schedule.MarkSendReady(3);
+  schedule.MarkSendReady(1);
+  schedule.MarkSendReady(3);
+
+  Handles handles;
+  schedule.TakeSendReady(handles);
+  EXPECT_EQ(handles, Handles({1, 3}));
+
+  // Taking the list empties it.
+  schedule.TakeSendReady(handles);
+  EXPECT_TRUE(handles.empty());
+}
+
+TEST(TestClientServiceSchedule, TimersExpireInDeadlineOrder)
+{
+  ClientServiceSchedule schedule;
+  schedule.ScheduleTimer(1, 300);
+  schedule.ScheduleTimer(2, 100);
+  schedule.ScheduleTimer(3, 200);
+  schedule.ScheduleTimer(4, 1000);
+
+  Handles handles;
+  schedule.TakeExpiredTimers(50, handles);
+  EXPECT_TRUE(handles.empty());
+
+  schedule.TakeExpiredTimers(300, handles);
+  EXPECT_EQ(handles, Handles({2, 3, 1}));
+  EXPECT_EQ(schedule.num_timers(), 1u);
+
+  schedule.TakeExpiredTimers(999, handles);
+  EXPECT_TRUE(handles.empty());
+  schedule.TakeExpiredTimers(1000, handles);
+  EXPECT_EQ(handles, Handles({4}));
+  EXPECT_EQ(schedule.num_timers(), 0u);
+}
+
+TEST(TestClientServiceSchedule, TimersHandleMillisecondCounterWrap)
+{
+  ClientServiceSchedule schedule;
+  const uint32_t        now = 0xfffffff0u;
+  schedule.ScheduleTimer(1, now + 0x20);  // Wraps past 0
+  schedule.ScheduleTimer(2, now + 0x10);  // Exactly 0
+
+  Handles handles;
+  schedule.TakeExpiredTimers(now, handles);
+  EXPECT_TRUE(handles.empty());
+
+  schedule.TakeExpiredTimers(now + 0x10, handles);
+  EXPECT_EQ(handles, Handles({2}));
+  schedule.TakeExpiredTimers(now + 0x20, handles);
+  EXPECT_EQ(handles, Handles({1}));
+}
+
+TEST(TestClientServiceSchedule, ClearRemovesEverything)
+{
+  ClientServiceSchedule schedule;
+  schedule.MarkSendReady(1);
+  schedule.ScheduleTimer(1, 100);
+
+  schedule.Clear();
+  EXPECT_EQ(schedule.num_send_ready(), 0u);
+  EXPECT_EQ(schedule.num_timers(), 0u);
+}
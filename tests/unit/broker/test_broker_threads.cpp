@@ -89,6 +89,9 @@ TEST_F(TestListenThread, AcceptResultIsForwarded)
   etcpal_accept_fake.custom_fake = [](etcpal_socket_t socket, EtcPalSockAddr* accept_addr,
                                       etcpal_socket_t* accept_sock) {
     EXPECT_EQ(socket, (etcpal_socket_t)0);
+    if (etcpal_accept_fake.call_count > 1)
+      return kEtcPalErrWouldBlock;
+
     ETCPAL_IP_SET_V4_ADDRESS(&accept_addr->ip, kTestIpv4);
     accept_addr->port = kTestPort;
     *accept_sock = 1;
@@ -105,7 +108,8 @@ TEST_F(TestListenThread, SocketClosedAfterNotHandled)
   ListenThread lt(0, &notify_, nullptr);
   ASSERT_TRUE(lt.Start());
 
-  etcpal_accept_fake.return_val = kEtcPalErrOk;
+  etcpal_error_t accept_results[] = {kEtcPalErrOk, kEtcPalErrWouldBlock};
+  SET_RETURN_SEQ(etcpal_accept, accept_results, 2);
 
   EXPECT_CALL(notify_, HandleNewConnection(_, _)).WillOnce(Return(false));
   lt.ReadSocket();
@@ -113,6 +117,48 @@ TEST_F(TestListenThread, SocketClosedAfterNotHandled)
   EXPECT_FALSE(lt.terminated());
 }
 
+TEST_F(TestListenThread, PendingConnectionsAreAcceptedTogether)
+{
+  ListenThread lt(0, &notify_, nullptr);
+  ASSERT_TRUE(lt.Start());
+
+  etcpal_error_t accept_results[] = {kEtcPalErrOk, kEtcPalErrOk, kEtcPalErrOk, kEtcPalErrWouldBlock};
+  SET_RETURN_SEQ(etcpal_accept, accept_results, 4);
+
+  EXPECT_CALL(notify_, HandleNewConnection(_, _)).Times(3).WillRepeatedly(Return(true));
+  lt.ReadSocket();
+  EXPECT_EQ(etcpal_accept_fake.call_count, 4u);
+  EXPECT_EQ(etcpal_close_fake.call_count, 0u);
+  EXPECT_FALSE(lt.terminated());
+}
+
+TEST_F(TestListenThread, AcceptBatchIsLimited)
+{
+  ListenThread lt(0, &notify_, nullptr);
+  ASSERT_TRUE(lt.Start());
+
+  etcpal_accept_fake.return_val = kEtcPalErrOk;
+
+  EXPECT_CALL(notify_, HandleNewConnection(_, _))
+      .Times(static_cast<int>(ListenThread::kMaxAcceptBatch))
+      .WillRepeatedly(Return(true));
+  lt.ReadSocket();
+  EXPECT_EQ(etcpal_accept_fake.call_count, ListenThread::kMaxAcceptBatch);
+  EXPECT_FALSE(lt.terminated());
+}
+
+TEST_F(TestListenThread, PollTimeoutDoesNotAccept)
+{
+  ListenThread lt(0, &notify_, nullptr);
+  ASSERT_TRUE(lt.Start());
+
+  etcpal_poll_wait_fake.return_val = kEtcPalErrTimedOut;
+
+  lt.ReadSocket();
+  EXPECT_EQ(etcpal_accept_fake.call_count, 0u);
+  EXPECT_FALSE(lt.terminated());
+}
+
 TEST_F(TestListenThread, AcceptErrorStopsThread)
 {
   ListenThread lt(0, &notify_, nullptr);
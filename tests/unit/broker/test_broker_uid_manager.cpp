@@ -16,9 +16,15 @@
  * This file is a part of RDMnet. For more information, go to:
  * https://github.com/ETCLabs/RDMnet
  *****************************************************************************/
-#include "gtest/gtest.h"
 #include "broker_uid_manager.h"
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
 class TestBrokerUidManager : public testing::Test
 {
 protected:
@@ -106,6 +112,8 @@ TEST_F(TestBrokerUidManager, DynamicUid)
   ASSERT_EQ(res, BrokerUidManager::AddResult::kOk);
   ASSERT_EQ(uid_1.manu, 0xe574u);
   ASSERT_EQ(uid_1.id, 1000u);
+  ASSERT_TRUE(manager_.UidToHandle(uid_1, handle_out));
+  ASSERT_EQ(handle_out, 4);
 }
 
 TEST_F(TestBrokerUidManager, HandlesWraparound)
@@ -161,3 +169,132 @@ TEST_F(TestBrokerUidManager, HandlesWraparound)
   ASSERT_EQ(res, BrokerUidManager::AddResult::kOk);
   ASSERT_EQ(test_uid.id, 4u);
 }
+
+TEST_F(TestBrokerUidManager, EvictsLeastRecentlyDisconnectedReservation)
+{
+  manager_.SetMaxReservations(2);
+
+  EtcPalUuid cid_1 = {1};
+  EtcPalUuid cid_2 = {2};
+  EtcPalUuid cid_3 = {3};
+  RdmUid     uid_1 = {0xe574, 0};
+  RdmUid     uid_2 = {0xe574, 0};
+  RdmUid     uid_3 = {0xe574, 0};
+
+  ASSERT_EQ(manager_.AddDynamicUid(1, cid_1, uid_1), BrokerUidManager::AddResult::kOk);
+  ASSERT_EQ(manager_.AddDynamicUid(2, cid_2, uid_2), BrokerUidManager::AddResult::kOk);
+  manager_.RemoveUid(uid_2);
+  manager_.RemoveUid(uid_1);
+
+  // cid_2 has been disconnected the longest, so its reservation makes room for cid_3.
+  ASSERT_EQ(manager_.AddDynamicUid(3, cid_3, uid_3), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(manager_.GetNumReservations(), 2u);
+
+  RdmUid uid_1_again = {0xe574, 0};
+  ASSERT_EQ(manager_.AddDynamicUid(4, cid_1, uid_1_again), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid_1_again.id, uid_1.id);
+
+  RdmUid uid_2_again = {0xe574, 0};
+  ASSERT_EQ(manager_.AddDynamicUid(5, cid_2, uid_2_again), BrokerUidManager::AddResult::kOk);
+  EXPECT_NE(uid_2_again.id, uid_2.id);
+}
+
+TEST_F(TestBrokerUidManager, NeverEvictsConnectedReservations)
+{
+  manager_.SetMaxReservations(1);
+
+  EtcPalUuid cid_1 = {1};
+  EtcPalUuid cid_2 = {2};
+  RdmUid     uid_1 = {0xe574, 0};
+  RdmUid     uid_2 = {0xe574, 0};
+
+  ASSERT_EQ(manager_.AddDynamicUid(1, cid_1, uid_1), BrokerUidManager::AddResult::kOk);
+  ASSERT_EQ(manager_.AddDynamicUid(2, cid_2, uid_2), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(manager_.GetNumReservations(), 2u);
+
+  // Still connected, so still a duplicate.
+  ASSERT_EQ(manager_.AddDynamicUid(3, cid_1, uid_1), BrokerUidManager::AddResult::kDuplicateId);
+}
+
+class TestBrokerUidReservationFile : public TestBrokerUidManager
+{
+protected:
+  const std::string file_path_{"test_broker_uid_reservations.bin"};
+
+  void SetUp() override
+  {
+    std::remove(file_path_.c_str());
+    std::remove((file_path_ + ".tmp").c_str());
+  }
+  void TearDown() override { SetUp(); }
+};
+
+TEST_F(TestBrokerUidReservationFile, ReservationsSurviveRestart)
+{
+  EXPECT_EQ(manager_.LoadReservations(file_path_).error(), kEtcPalErrNotFound);
+
+  manager_.SetNextDeviceId(1000);
+  EtcPalUuid cid_1 = {1};
+  EtcPalUuid cid_2 = {2};
+  RdmUid     uid_1 = {0xe574, 0};
+  RdmUid     uid_2 = {0x8001, 0};
+  ASSERT_EQ(manager_.AddDynamicUid(1, cid_1, uid_1), BrokerUidManager::AddResult::kOk);
+  ASSERT_EQ(manager_.AddDynamicUid(2, cid_2, uid_2), BrokerUidManager::AddResult::kOk);
+  manager_.RemoveUid(uid_1);
+  ASSERT_TRUE(manager_.SaveReservations());
+
+  BrokerUidManager restarted;
+  auto             num_loaded = restarted.LoadReservations(file_path_);
+  ASSERT_TRUE(num_loaded);
+  EXPECT_EQ(*num_loaded, 2u);
+
+  RdmUid uid_1_again = {0xe574, 0};
+  ASSERT_EQ(restarted.AddDynamicUid(3, cid_1, uid_1_again), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid_1_again.id, uid_1.id);
+  RdmUid uid_2_again = {0x8001, 0};
+  ASSERT_EQ(restarted.AddDynamicUid(4, cid_2, uid_2_again), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid_2_again.id, uid_2.id);
+
+  // New components don't get any of the loaded UIDs.
+  EtcPalUuid cid_3 = {3};
+  RdmUid     uid_3 = {0xe574, 0};
+  ASSERT_EQ(restarted.AddDynamicUid(5, cid_3, uid_3), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid_3.id, 1002u);
+}
+
+TEST_F(TestBrokerUidReservationFile, RejectsTruncatedFile)
+{
+  EtcPalUuid cid_1 = {1};
+  RdmUid     uid_1 = {0xe574, 0};
+  ASSERT_FALSE(manager_.LoadReservations(file_path_));
+  ASSERT_EQ(manager_.AddDynamicUid(1, cid_1, uid_1), BrokerUidManager::AddResult::kOk);
+  ASSERT_TRUE(manager_.SaveReservations());
+
+  std::ifstream     in(file_path_, std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream out(file_path_, std::ios::binary | std::ios::trunc);
+  out.write(data.data(), static_cast<std::streamsize>(data.size() - 1));
+  out.close();
+
+  BrokerUidManager restarted;
+  EXPECT_EQ(restarted.LoadReservations(file_path_).error(), kEtcPalErrProtocol);
+  EXPECT_EQ(restarted.GetNumReservations(), 0u);
+}
+
+TEST_F(TestBrokerUidReservationFile, FallsBackToTempFile)
+{
+  EtcPalUuid cid_1 = {1};
+  RdmUid     uid_1 = {0xe574, 0};
+  ASSERT_FALSE(manager_.LoadReservations(file_path_));
+  ASSERT_EQ(manager_.AddDynamicUid(1, cid_1, uid_1), BrokerUidManager::AddResult::kOk);
+  ASSERT_TRUE(manager_.SaveReservations());
+
+  // Simulate a crash after the old file was removed but before the new one was renamed into place.
+  ASSERT_EQ(std::rename(file_path_.c_str(), (file_path_ + ".tmp").c_str()), 0);
+
+  BrokerUidManager restarted;
+  auto             num_loaded = restarted.LoadReservations(file_path_);
+  ASSERT_TRUE(num_loaded);
+  EXPECT_EQ(*num_loaded, 1u);
+}
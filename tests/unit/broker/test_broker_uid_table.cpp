@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "broker_uid_table.h"
+
+#include <cstdint>
+#include "gmock/gmock.h"
+
+// The table never dereferences its client pointers, so distinct fake addresses suffice.
+static RPTClient* FakeClient(uintptr_t index)
+{
+  return reinterpret_cast<RPTClient*>((index + 1) * 16);
+}
+
+TEST(TestRptClientUidTable, FindsInsertedClients)
+{
+  RptClientUidTable table;
+  EXPECT_EQ(table.Find(RdmUid{0x6574, 1}), nullptr);
+
+  table.Insert(RdmUid{0x6574, 1}, FakeClient(1));
+  table.Insert(RdmUid{0x6574, 2}, FakeClient(2));
+  table.Insert(RdmUid{0xe574, 1}, FakeClient(3));
+
+  EXPECT_EQ(table.size(), 3u);
+  EXPECT_EQ(table.Find(RdmUid{0x6574, 1}), FakeClient(1));
+  EXPECT_EQ(table.Find(RdmUid{0x6574, 2}), FakeClient(2));
+  EXPECT_EQ(table.Find(RdmUid{0xe574, 1}), FakeClient(3));
+  EXPECT_EQ(table.Find(RdmUid{0xe574, 2}), nullptr);
+}
+
+TEST(TestRptClientUidTable, GrowsAndKeepsEntries)
+{
+  RptClientUidTable table;
+
+  constexpr uint32_t kNumClients = 5000;
+  for (uint32_t i = 0; i < kNumClients; ++i)
+    table.Insert(RdmUid{0xe574, i}, FakeClient(i));
+
+  EXPECT_EQ(table.size(), kNumClients);
+  EXPECT_GE(table.capacity(), kNumClients * 2);
+  for (uint32_t i = 0; i < kNumClients; ++i)
+    EXPECT_EQ(table.Find(RdmUid{0xe574, i}), FakeClient(i));
+}
+
+TEST(TestRptClientUidTable, EraseKeepsOtherEntriesReachable)
+{
+  RptClientUidTable table;
+
+  constexpr uint32_t kNumClients = 1000;
+  for (uint32_t i = 0; i < kNumClients; ++i)
+    table.Insert(RdmUid{0xe574, i}, FakeClient(i));
+
+  // Remove every other entry to exercise backward-shift deletion across probe chains.
+  for (uint32_t i = 0; i < kNumClients; i += 2)
+    table.Erase(RdmUid{0xe574, i}, FakeClient(i));
+
+  EXPECT_EQ(table.size(), kNumClients / 2);
+  for (uint32_t i = 0; i < kNumClients; ++i)
+  {
+    if (i % 2 == 0)
+      EXPECT_EQ(table.Find(RdmUid{0xe574, i}), nullptr);
+    else
+      EXPECT_EQ(table.Find(RdmUid{0xe574, i}), FakeClient(i));
+  }
+}
+
+TEST(TestRptClientUidTable, DetachMakesUidUnroutable)
+{
+  RptClientUidTable table;
+  table.Insert(RdmUid{0x6574, 1}, FakeClient(1));
+
+  table.Detach(RdmUid{0x6574, 1});
+  EXPECT_EQ(table.Find(RdmUid{0x6574, 1}), nullptr);
+  // The key stays until the client is destroyed.
+  EXPECT_EQ(table.size(), 1u);
+
+  table.Erase(RdmUid{0x6574, 1}, FakeClient(1));
+  EXPECT_EQ(table.size(), 0u);
+}
+
+TEST(TestRptClientUidTable, EraseIgnoresUidTakenOverByNewClient)
+{
+  RptClientUidTable table;
+  table.Insert(RdmUid{0x6574, 1}, FakeClient(1));
+
+  // The old client is marked for destruction and a new one reconnects with the same static UID
+  // before the old one is destroyed.
+  table.Detach(RdmUid{0x6574, 1});
+  table.Insert(RdmUid{0x6574, 1}, FakeClient(2));
+  EXPECT_EQ(table.size(), 1u);
+
+  table.Erase(RdmUid{0x6574, 1}, FakeClient(1));
+  EXPECT_EQ(table.Find(RdmUid{0x6574, 1}), FakeClient(2));
+}
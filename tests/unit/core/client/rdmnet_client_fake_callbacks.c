@@ -31,6 +31,7 @@ DEFINE_FAKE_VOID_FUNC(rc_client_rpt_msg_received,
                       const RptClientMessage*,
                       RdmnetSyncRdmResponse*,
                       bool*);
+DEFINE_FAKE_VOID_FUNC(rc_client_request_complete, RCClient*, rdmnet_client_scope_t, const RdmnetRequestResult*);
 DEFINE_FAKE_VOID_FUNC(rc_client_ept_msg_received,
                       RCClient*,
                       rdmnet_client_scope_t,
@@ -47,5 +48,6 @@ void rc_client_callbacks_reset_all_fakes(void)
   RESET_FAKE(rc_client_destroyed);
   RESET_FAKE(rc_client_llrp_msg_received);
   RESET_FAKE(rc_client_rpt_msg_received);
+  RESET_FAKE(rc_client_request_complete);
   RESET_FAKE(rc_client_ept_msg_received);
 }
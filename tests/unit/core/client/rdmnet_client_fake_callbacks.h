@@ -42,6 +42,7 @@ DECLARE_FAKE_VOID_FUNC(rc_client_rpt_msg_received,
                        const RptClientMessage*,
                        RdmnetSyncRdmResponse*,
                        bool*);
+DECLARE_FAKE_VOID_FUNC(rc_client_request_complete, RCClient*, rdmnet_client_scope_t, const RdmnetRequestResult*);
 DECLARE_FAKE_VOID_FUNC(rc_client_ept_msg_received,
                        RCClient*,
                        rdmnet_client_scope_t,
@@ -63,7 +64,8 @@ constexpr RCClientCommonCallbacks kClientFakeCommonCallbacks = {
 
 constexpr RCRptClientCallbacks kClientFakeRptCallbacks = {
   rc_client_llrp_msg_received,
-  rc_client_rpt_msg_received
+  rc_client_rpt_msg_received,
+  rc_client_request_complete
 };
 
 constexpr RCEptClientCallbacks kClientFakeEptCallbacks = {
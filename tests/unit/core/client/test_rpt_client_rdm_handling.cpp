@@ -32,6 +32,7 @@
 #include "etcpal/cpp/uuid.h"
 #include "etcpal/pack.h"
 #include "etcpal_mock/common.h"
+#include "etcpal_mock/timer.h"
 #include "rdm/defs.h"
 #include "rdm/message.h"
 #include "rdmnet_mock/core/broker_prot.h"
@@ -556,6 +557,33 @@ TEST_F(TestRptClientRdmHandling, ParsesOverflowNotificationWithoutCommand)
   EXPECT_EQ(rc_client_rpt_msg_received_fake.call_count, 1u);
 }
 
+// A response that fits in a single RDM PDU should have its data delivered directly from the parsed
+// message rather than copied into a separate buffer.
+static const RdmBuffer* single_resp_buf;
+
+TEST_F(TestRptClientRdmHandling, DeliversSingleResponseDataInPlace)
+{
+  static constexpr char kDeviceLabel[] = "Test Device";
+
+  auto test_resp = TestRdmResponse::GetResponse(
+      client_, E120_DEVICE_LABEL, reinterpret_cast<const uint8_t*>(kDeviceLabel), sizeof(kDeviceLabel) - 1);
+  ASSERT_EQ(test_resp.bufs.size(), 2u);
+  single_resp_buf = &test_resp.bufs[1];
+
+  rc_client_rpt_msg_received_fake.custom_fake = [](RCClient*, rdmnet_client_scope_t, const RptClientMessage* msg,
+                                                   RdmnetSyncRdmResponse*, bool*) {
+    EXPECT_FALSE(msg->owns_rdm_data);
+    const RdmnetRdmResponse* resp = RDMNET_GET_RDM_RESPONSE(msg);
+    ASSERT_EQ(resp->rdm_data_len, sizeof(kDeviceLabel) - 1);
+    EXPECT_GE(resp->rdm_data, single_resp_buf->data);
+    EXPECT_LE(resp->rdm_data + resp->rdm_data_len, single_resp_buf->data + single_resp_buf->data_len);
+    EXPECT_EQ(std::memcmp(resp->rdm_data, kDeviceLabel, resp->rdm_data_len), 0);
+  };
+
+  last_conn->callbacks.message_received(last_conn, &test_resp.msg);
+  EXPECT_EQ(rc_client_rpt_msg_received_fake.call_count, 1u);
+}
+
 // clang-format off
 const RdmnetSavedRdmCommand kSetDeviceInfoSavedCmd{
   {1, 2},
@@ -592,3 +620,205 @@ TEST_F(TestRptClientRdmHandling, RespondsBroadcastToSetCommands)
   rdm_dest_uid.id = etcpal_unpack_u32b(&response.data[RDM_OFFSET_DEST_DEVICE]);
   EXPECT_EQ(rdm_dest_uid, kRdmBroadcastUid);
 }
+
+// With request tracking enabled, commands sent to a single client are remembered until answered.
+
+static const RdmnetDestinationAddr kTrackedDest = RDMNET_ADDR_TO_DEFAULT_RESPONDER(42, 84);
+
+class TestRptClientRequestTracking : public TestRptClientRdmHandling
+{
+protected:
+  void SetUp() override
+  {
+    TestRptClientRdmHandling::SetUp();
+    RCRequestTrackingConfig& config = RC_RPT_CLIENT_DATA(&client_)->request_tracking;
+    config.enabled = true;
+    config.timeout_ms = 1000;
+    config.max_retries = 1;
+    config.max_in_flight_per_dest = 2;
+  }
+
+  uint32_t SendTrackedCommand()
+  {
+    uint32_t seq_num = 0;
+    EXPECT_EQ(rc_client_send_rdm_command(&client_, scope_handle_, &kTrackedDest, kRdmnetCCGetCommand, E120_DEVICE_LABEL,
+                                         nullptr, 0, &seq_num),
+              kEtcPalErrOk);
+    return seq_num;
+  }
+};
+
+TEST_F(TestRptClientRequestTracking, ResponseCompletesRequest)
+{
+  static constexpr char kDeviceLabel[] = "Test Device";
+
+  uint32_t seq_num = SendTrackedCommand();
+  auto     test_resp = TestRdmResponse::GetResponse(
+      client_, E120_DEVICE_LABEL, reinterpret_cast<const uint8_t*>(kDeviceLabel), sizeof(kDeviceLabel) - 1);
+  RDMNET_GET_RPT_MSG(&test_resp.msg)->header.seqnum = seq_num;
+
+  rc_client_request_complete_fake.custom_fake = [](RCClient*, rdmnet_client_scope_t,
+                                                   const RdmnetRequestResult* result) {
+    EXPECT_EQ(result->outcome, kRdmnetRequestResponseReceived);
+    EXPECT_EQ(result->destination.rdmnet_uid, kTrackedDest.rdmnet_uid);
+    ASSERT_NE(result->response, nullptr);
+    EXPECT_EQ(result->response->seq_num, result->seq_num);
+    EXPECT_EQ(result->response->rdm_header.param_id, E120_DEVICE_LABEL);
+  };
+
+  last_conn->callbacks.message_received(last_conn, &test_resp.msg);
+  EXPECT_EQ(rc_client_request_complete_fake.call_count, 1u);
+  EXPECT_EQ(rc_client_rpt_msg_received_fake.call_count, 0u);
+
+  // A second response with the same sequence number is no longer tracked.
+  last_conn->callbacks.message_received(last_conn, &test_resp.msg);
+  EXPECT_EQ(rc_client_request_complete_fake.call_count, 1u);
+  EXPECT_EQ(rc_client_rpt_msg_received_fake.call_count, 1u);
+}
+
+TEST_F(TestRptClientRequestTracking, PartialResponsesKeepRequestTracked)
+{
+  static constexpr char kDeviceLabel[] = "Test Device";
+
+  uint32_t seq_num = SendTrackedCommand();
+  auto     test_resp = TestRdmResponse::GetResponse(
+      client_, E120_DEVICE_LABEL, reinterpret_cast<const uint8_t*>(kDeviceLabel), sizeof(kDeviceLabel) - 1);
+  RDMNET_GET_RPT_MSG(&test_resp.msg)->header.seqnum = seq_num;
+
+  // The first part is delivered without completing the request, and restarts its timeout.
+  etcpal_getms_fake.return_val += 900;
+  RPT_GET_RDM_BUF_LIST(RDMNET_GET_RPT_MSG(&test_resp.msg))->more_coming = true;
+  rc_client_request_complete_fake.custom_fake = [](RCClient*, rdmnet_client_scope_t,
+                                                   const RdmnetRequestResult* result) {
+    EXPECT_EQ(result->outcome, kRdmnetRequestResponseReceived);
+    EXPECT_EQ(result->destination.rdmnet_uid, kTrackedDest.rdmnet_uid);
+    ASSERT_NE(result->response, nullptr);
+    EXPECT_TRUE(result->response->more_coming);
+  };
+  last_conn->callbacks.message_received(last_conn, &test_resp.msg);
+  EXPECT_EQ(rc_client_request_complete_fake.call_count, 1u);
+  EXPECT_EQ(rc_client_rpt_msg_received_fake.call_count, 0u);
+
+  etcpal_getms_fake.return_val += 900;
+  last_conn->callbacks.periodic(last_conn);
+  EXPECT_EQ(rc_rpt_send_request_fake.call_count, 1u);
+
+  // The last part completes the request.
+  RPT_GET_RDM_BUF_LIST(RDMNET_GET_RPT_MSG(&test_resp.msg))->more_coming = false;
+  rc_client_request_complete_fake.custom_fake = [](RCClient*, rdmnet_client_scope_t,
+                                                   const RdmnetRequestResult* result) {
+    EXPECT_EQ(result->outcome, kRdmnetRequestResponseReceived);
+    ASSERT_NE(result->response, nullptr);
+    EXPECT_FALSE(result->response->more_coming);
+  };
+  last_conn->callbacks.message_received(last_conn, &test_resp.msg);
+  EXPECT_EQ(rc_client_request_complete_fake.call_count, 2u);
+  EXPECT_EQ(rc_client_rpt_msg_received_fake.call_count, 0u);
+
+  etcpal_getms_fake.return_val += 2000;
+  last_conn->callbacks.periodic(last_conn);
+  EXPECT_EQ(rc_rpt_send_request_fake.call_count, 1u);
+  EXPECT_EQ(rc_client_request_complete_fake.call_count, 2u);
+}
+
+TEST_F(TestRptClientRequestTracking, LimitsRequestsInFlightPerDestination)
+{
+  SendTrackedCommand();
+  SendTrackedCommand();
+  EXPECT_EQ(rc_client_send_rdm_command(&client_, scope_handle_, &kTrackedDest, kRdmnetCCGetCommand, E120_DEVICE_LABEL,
+                                       nullptr, 0, nullptr),
+            kEtcPalErrWouldBlock);
+  EXPECT_EQ(rc_rpt_send_request_fake.call_count, 2u);
+}
+
+TEST_F(TestRptClientRequestTracking, RetriesThenTimesOut)
+{
+  SendTrackedCommand();
+  EXPECT_EQ(rc_rpt_send_request_fake.call_count, 1u);
+
+  etcpal_getms_fake.return_val += 1001;
+  last_conn->callbacks.periodic(last_conn);
+  EXPECT_EQ(rc_rpt_send_request_fake.call_count, 2u);
+  EXPECT_EQ(rc_client_request_complete_fake.call_count, 0u);
+
+  etcpal_getms_fake.return_val += 1001;
+  rc_client_request_complete_fake.custom_fake = [](RCClient*, rdmnet_client_scope_t,
+                                                   const RdmnetRequestResult* result) {
+    EXPECT_EQ(result->outcome, kRdmnetRequestTimedOut);
+    EXPECT_EQ(result->response, nullptr);
+    EXPECT_EQ(result->status, nullptr);
+  };
+  last_conn->callbacks.periodic(last_conn);
+  EXPECT_EQ(rc_rpt_send_request_fake.call_count, 2u);
+  EXPECT_EQ(rc_client_request_complete_fake.call_count, 1u);
+}
+
+TEST_F(TestRptClientRequestTracking, DisconnectCancelsRequests)
+{
+  SendTrackedCommand();
+  SendTrackedCommand();
+
+  rc_client_request_complete_fake.custom_fake = [](RCClient*, rdmnet_client_scope_t,
+                                                   const RdmnetRequestResult* result) {
+    EXPECT_EQ(result->outcome, kRdmnetRequestCancelled);
+  };
+
+  RCDisconnectedInfo disconn_info{};
+  disconn_info.event = kRdmnetDisconnectAbruptClose;
+  disconn_info.socket_err = kEtcPalErrConnReset;
+  last_conn->callbacks.disconnected(last_conn, &disconn_info);
+  EXPECT_EQ(rc_client_request_complete_fake.call_count, 2u);
+  EXPECT_EQ(rc_client_disconnected_fake.call_count, 1u);
+}
+
+// A batch of RDM commands is sent with consecutive sequence numbers while the connection is corked.
+
+static const std::array<RdmnetBatchRdmCommand, 3> kBatchCommands = {{
+    {RDMNET_ADDR_TO_DEFAULT_RESPONDER(42, 1), kRdmnetCCGetCommand, E120_DMX_START_ADDRESS, nullptr, 0},
+    {RDMNET_ADDR_TO_DEFAULT_RESPONDER(42, 2), kRdmnetCCGetCommand, E120_DMX_START_ADDRESS, nullptr, 0},
+    {RDMNET_ADDR_TO_DEFAULT_RESPONDER(42, 3), kRdmnetCCGetCommand, E120_DMX_START_ADDRESS, nullptr, 0},
+}};
+
+TEST_F(TestRptClientRdmHandling, SendsBatchOfCommandsCorked)
+{
+  std::array<uint32_t, kBatchCommands.size()> seq_nums{};
+  size_t                                      num_sent = 0;
+  ASSERT_EQ(rc_client_send_rdm_commands(&client_, scope_handle_, kBatchCommands.data(), kBatchCommands.size(),
+                                        seq_nums.data(), &num_sent),
+            kEtcPalErrOk);
+
+  EXPECT_EQ(num_sent, kBatchCommands.size());
+  EXPECT_EQ(rc_rpt_send_request_fake.call_count, kBatchCommands.size());
+  EXPECT_EQ(rc_conn_cork_fake.call_count, 1u);
+  EXPECT_EQ(rc_conn_uncork_fake.call_count, 1u);
+  EXPECT_EQ(seq_nums[1], seq_nums[0] + 1);
+  EXPECT_EQ(seq_nums[2], seq_nums[0] + 2);
+}
+
+TEST_F(TestRptClientRdmHandling, BatchStopsAtFirstCommandWhichCannotBeSent)
+{
+  // The send queue fills up after two commands, and the socket can't take the queued data.
+  rc_rpt_send_request_fake.custom_fake = [](RCConnection*, const EtcPalUuid*, const RptHeader*, const RdmBuffer*) {
+    return (rc_rpt_send_request_fake.call_count > 2 ? kEtcPalErrWouldBlock : kEtcPalErrOk);
+  };
+
+  std::array<uint32_t, kBatchCommands.size()> seq_nums{};
+  size_t                                      num_sent = 0;
+  EXPECT_EQ(rc_client_send_rdm_commands(&client_, scope_handle_, kBatchCommands.data(), kBatchCommands.size(),
+                                        seq_nums.data(), &num_sent),
+            kEtcPalErrWouldBlock);
+  EXPECT_EQ(num_sent, 2u);
+
+  // The queued commands were pushed to the socket once before the last one was retried.
+  EXPECT_EQ(rc_rpt_send_request_fake.call_count, 4u);
+  EXPECT_EQ(rc_conn_cork_fake.call_count, 2u);
+  EXPECT_EQ(rc_conn_uncork_fake.call_count, 2u);
+
+  // The command which failed didn't use up a sequence number.
+  uint32_t seq_num = 0;
+  rc_rpt_send_request_fake.custom_fake = nullptr;
+  ASSERT_EQ(rc_client_send_rdm_command(&client_, scope_handle_, &kBatchCommands[2].destination, kRdmnetCCGetCommand,
+                                       E120_DMX_START_ADDRESS, nullptr, 0, &seq_num),
+            kEtcPalErrOk);
+  EXPECT_EQ(seq_num, seq_nums[1] + 1);
+}
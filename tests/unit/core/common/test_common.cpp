@@ -24,6 +24,8 @@
 #include <string>
 #include <vector>
 #include "etcpal_mock/common.h"
+#include "etcpal_mock/socket.h"
+#include "etcpal_mock/timer.h"
 #include "rdmnet_mock/core/client.h"
 #include "rdmnet_mock/core/connection.h"
 #include "rdmnet_mock/core/llrp.h"
@@ -146,3 +148,87 @@ TEST_F(TestCoreCommon, InitFailsGracefullyAndCleansUp)
     }
   }
 }
+
+static std::vector<etcpal_socket_t> serviced_sockets;
+static RCPolledSocketInfo           polled_socket_info;
+
+static void record_socket_activity(const EtcPalPollEvent* event, RCPolledSocketOpaqueData)
+{
+  serviced_sockets.push_back(event->socket);
+}
+
+static void fill_poll_event(EtcPalPollEvent* event, etcpal_socket_t socket)
+{
+  event->socket = socket;
+  event->events = ETCPAL_POLL_IN;
+  event->err = kEtcPalErrOk;
+  event->user_data = &polled_socket_info;
+}
+
+TEST_F(TestCoreCommon, TickServicesAllReadySockets)
+{
+  ASSERT_EQ(rc_init(nullptr, nullptr), kEtcPalErrOk);
+  serviced_sockets.clear();
+  polled_socket_info.callback = record_socket_activity;
+
+  // Three sockets are ready, then no more.
+  etcpal_poll_wait_fake.custom_fake = [](EtcPalPollContext*, EtcPalPollEvent* event, int) {
+    if (etcpal_poll_wait_fake.call_count > 3)
+      return kEtcPalErrTimedOut;
+    fill_poll_event(event, (etcpal_socket_t)etcpal_poll_wait_fake.call_count);
+    return kEtcPalErrOk;
+  };
+
+  rc_tick();
+  EXPECT_EQ(serviced_sockets, std::vector<etcpal_socket_t>({1, 2, 3}));
+  EXPECT_EQ(etcpal_poll_wait_fake.call_count, 4u);
+  // Only the first wait should block.
+  EXPECT_GT(etcpal_poll_wait_fake.arg2_history[0], 0);
+  EXPECT_EQ(etcpal_poll_wait_fake.arg2_history[1], 0);
+
+  rc_deinit();
+}
+
+TEST_F(TestCoreCommon, TickBudgetExcludesFirstWait)
+{
+  ASSERT_EQ(rc_init(nullptr, nullptr), kEtcPalErrOk);
+  serviced_sockets.clear();
+  polled_socket_info.callback = record_socket_activity;
+
+  // The first wait blocks for longer than the tick budget before three sockets become ready.
+  etcpal_getms_fake.return_val = 1000;
+  etcpal_poll_wait_fake.custom_fake = [](EtcPalPollContext*, EtcPalPollEvent* event, int) {
+    if (etcpal_poll_wait_fake.call_count == 1)
+      etcpal_getms_fake.return_val += 1000;
+    if (etcpal_poll_wait_fake.call_count > 3)
+      return kEtcPalErrTimedOut;
+    fill_poll_event(event, (etcpal_socket_t)etcpal_poll_wait_fake.call_count);
+    return kEtcPalErrOk;
+  };
+
+  rc_tick();
+  EXPECT_EQ(serviced_sockets, std::vector<etcpal_socket_t>({1, 2, 3}));
+
+  rc_deinit();
+}
+
+TEST_F(TestCoreCommon, TickServicesEachSocketOnce)
+{
+  ASSERT_EQ(rc_init(nullptr, nullptr), kEtcPalErrOk);
+  serviced_sockets.clear();
+  polled_socket_info.callback = record_socket_activity;
+
+  // The same socket is always ready.
+  etcpal_poll_wait_fake.custom_fake = [](EtcPalPollContext*, EtcPalPollEvent* event, int) {
+    fill_poll_event(event, (etcpal_socket_t)1);
+    return kEtcPalErrOk;
+  };
+
+  rc_tick();
+  EXPECT_EQ(serviced_sockets, std::vector<etcpal_socket_t>({1}));
+
+  rc_tick();
+  EXPECT_EQ(serviced_sockets, std::vector<etcpal_socket_t>({1, 1}));
+
+  rc_deinit();
+}
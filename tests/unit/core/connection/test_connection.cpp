@@ -362,7 +362,7 @@ TEST_F(TestConnectionAlreadyConnected, DisconnectsOnSocketError)
 
 TEST_F(TestConnectionAlreadyConnected, MsgBufResetOnDisconnect)
 {
-  RESET_FAKE(rc_msg_buf_init);
+  RESET_FAKE(rc_msg_buf_reset);
 
   EtcPalPollEvent event;
   event.err = kEtcPalErrConnReset;
@@ -372,8 +372,8 @@ TEST_F(TestConnectionAlreadyConnected, MsgBufResetOnDisconnect)
   conn_.poll_info.callback(&event, conn_.poll_info.data);
   ASSERT_EQ(conncb_disconnected_fake.call_count, 1u);
 
-  EXPECT_EQ(rc_msg_buf_init_fake.call_count, 1u);
-  EXPECT_EQ(rc_msg_buf_init_fake.arg0_val, &conn_.recv_buf);
+  EXPECT_EQ(rc_msg_buf_reset_fake.call_count, 1u);
+  EXPECT_EQ(rc_msg_buf_reset_fake.arg0_val, &conn_.recv_buf);
 }
 
 TEST_F(TestConnectionAlreadyConnected, ProcessesMultipleMessagesInOneReceive)
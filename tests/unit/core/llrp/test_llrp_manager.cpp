@@ -257,6 +257,36 @@ TEST_F(TestLlrpManager, HandlesResponderThatDoesntStopReplying)
   EXPECT_EQ(managercb_discovery_finished_fake.call_count, 1u);
 }
 
+#if RDMNET_DYNAMIC_MEM
+// The tests from here on discover more targets than the static probe ranges have room for, so
+// they take far longer with static memory.
+
+// Dense UID ranges are split up and probed concurrently, so that discovering a large number of
+// targets takes about as many probe rounds as discovering a few.
+TEST_F(TestLlrpManager, ProbesRangesConcurrently)
+{
+  std::uniform_int_distribution<uint32_t> device_id_distribution(0);
+  std::set<rdm::Uid>                      responders;
+  while (responders.size() < 1000)
+    responders.insert({0x6574, device_id_distribution(rand_engine_)});
+  for (const rdm::Uid& responder_uid : responders)
+    llrp_network.AddTarget(responder_uid);
+
+  int finish_time_ms = 0;
+  discovery_finished_cb = [&](RCLlrpManager*) { finish_time_ms = llrp_network.elapsed_time_ms(); };
+
+  rc_llrp_manager_start_discovery(&manager_, 0);
+  while (managercb_discovery_finished_fake.call_count == 0)
+    llrp_network.AdvanceTimeAndTick();
+
+  EXPECT_EQ(managercb_target_discovered_fake.call_count, 1000u);
+
+  // One round to discover the targets, then three clean rounds; allow one extra round for ranges
+  // waiting on the in-flight limit. Probing one range at a time would take many times longer.
+  EXPECT_LE(finish_time_ms, 5 * LLRP_TIMEOUT_MS + 1000);
+  EXPECT_GT(llrp_network.num_probe_requests_received(), 3 * 5);
+}
+
 class TestLlrpManagerAtScale : public TestLlrpManager, public testing::WithParamInterface<int>
 {
 };
@@ -297,3 +327,33 @@ INSTANTIATE_TEST_SUITE_P(DefaultLossinessValues,
                          [](const testing::TestParamInfo<TestLlrpManagerAtScale::ParamType>& info) {
                            return "Lossiness" + std::to_string(info.param);
                          });
+#endif  // RDMNET_DYNAMIC_MEM
+
+#if !RDMNET_DYNAMIC_MEM
+// Once every probe range has filled its Known UID list, ranges are narrowed and the UIDs above them
+// are probed afterwards, so every target is still discovered exactly once.
+TEST_F(TestLlrpManager, DiscoversAllTargetsWhenProbeRangesRunOut)
+{
+  constexpr size_t kNumTargets = (RDMNET_LLRP_MANAGER_MAX_PROBE_RANGES + 1) * LLRP_KNOWN_UID_SIZE;
+
+  std::uniform_int_distribution<uint32_t> device_id_distribution(0);
+  std::set<rdm::Uid>                      responders;
+  while (responders.size() < kNumTargets)
+    responders.insert({0x6574, device_id_distribution(rand_engine_)});
+  for (const rdm::Uid& responder_uid : responders)
+    llrp_network.AddTarget(responder_uid);
+
+  std::set<rdm::Uid> responders_discovered;
+  target_discovered_cb = [&](RCLlrpManager*, const LlrpDiscoveredTarget* target) {
+    ASSERT_TRUE(target != nullptr);
+    responders_discovered.insert(target->uid);
+  };
+
+  rc_llrp_manager_start_discovery(&manager_, 0);
+  while (managercb_discovery_finished_fake.call_count == 0)
+    llrp_network.AdvanceTimeAndTick();
+
+  EXPECT_EQ(responders_discovered, responders);
+  EXPECT_EQ(managercb_target_discovered_fake.call_count, kNumTargets);
+}
+#endif
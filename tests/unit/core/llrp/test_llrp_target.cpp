@@ -19,12 +19,16 @@
 
 #include "rdmnet/core/llrp_target.h"
 
+#include <vector>
 #include "gtest/gtest.h"
 #include "fff.h"
 #include "etcpal/cpp/mutex.h"
 #include "etcpal/cpp/uuid.h"
 #include "etcpal_mock/common.h"
+#include "etcpal_mock/socket.h"
 #include "rdm/cpp/uid.h"
+#include "rdm/message.h"
+#include "rdmnet/core/llrp_prot.h"
 #include "rdmnet/core/mcast.h"
 #include "rdmnet_mock/core/common.h"
 #include "fake_mcast.h"
@@ -34,10 +38,13 @@ FAKE_VOID_FUNC(targetcb_rdm_cmd_received, RCLlrpTarget*, const LlrpRdmCommand*,
 FAKE_VOID_FUNC(targetcb_destroyed, RCLlrpTarget*);
 }
 
+static const etcpal::Uuid kManagerCid = etcpal::Uuid::FromString("1a4ec3b4-6e6b-4f2e-a8a5-0a4e0ad8b4d1");
+
 class TestLlrpTarget : public testing::Test
 {
 protected:
   RCLlrpTarget  target_;
+  RCLlrpTarget  other_targets_[3];
   etcpal::Mutex target_lock_;
 
   void SetUp() override
@@ -66,6 +73,56 @@ protected:
     rc_llrp_target_module_deinit();
     rc_llrp_module_deinit();
   }
+
+  void RegisterOtherTarget(size_t index, const char* cid, const char* uid)
+  {
+    RCLlrpTarget& target = other_targets_[index];
+    target = target_;
+    target.cid = etcpal::Uuid::FromString(cid).get();
+    target.uid = rdm::Uid::FromString(uid).get();
+    ASSERT_EQ(kEtcPalErrOk, rc_llrp_target_register(&target));
+  }
+
+  // Pack an LLRP message using one of the LLRP send functions, returning the bytes that would have
+  // been sent.
+  template <typename SendFunction>
+  std::vector<uint8_t> PackMessage(const etcpal::Uuid& dest_cid, SendFunction send_fn)
+  {
+    LlrpHeader header;
+    header.sender_cid = kManagerCid.get();
+    header.dest_cid = dest_cid.get();
+    header.transaction_number = 1;
+
+    std::vector<uint8_t> buf(LLRP_MAX_MESSAGE_SIZE);
+    EXPECT_EQ(kEtcPalErrOk, send_fn(buf.data(), &header));
+    EXPECT_EQ(etcpal_sendto_fake.arg1_val, buf.data());
+    buf.resize(etcpal_sendto_fake.arg2_val);
+    return buf;
+  }
+
+  std::vector<uint8_t> PackProbeRequest(const LocalProbeRequest& request)
+  {
+    return PackMessage(*kLlrpBroadcastCid, [&](uint8_t* buf, const LlrpHeader* header) {
+      return rc_send_llrp_probe_request(ETCPAL_SOCKET_INVALID, buf, false, header, &request);
+    });
+  }
+
+  std::vector<uint8_t> PackRdmCommand(const etcpal::Uuid& dest_cid, const rdm::Uid& dest_uid)
+  {
+    RdmCommandHeader rdm_header{};
+    rdm_header.source_uid = rdm::Uid::FromString("e574:00000001").get();
+    rdm_header.dest_uid = dest_uid.get();
+    rdm_header.transaction_num = 1;
+    rdm_header.port_id = 1;
+    rdm_header.command_class = kRdmCCGetCommand;
+    rdm_header.param_id = E120_DEVICE_INFO;
+
+    RdmBuffer cmd;
+    EXPECT_EQ(kEtcPalErrOk, rdm_pack_command(&rdm_header, nullptr, 0, &cmd));
+    return PackMessage(dest_cid, [&](uint8_t* buf, const LlrpHeader* header) {
+      return rc_send_llrp_rdm_command(ETCPAL_SOCKET_INVALID, buf, false, header, &cmd);
+    });
+  }
 };
 
 TEST_F(TestLlrpTarget, DestroyedCalledOnUnregister)
@@ -76,3 +133,59 @@ TEST_F(TestLlrpTarget, DestroyedCalledOnUnregister)
   EXPECT_EQ(targetcb_destroyed_fake.call_count, 1u);
   EXPECT_EQ(targetcb_destroyed_fake.arg0_val, &target_);
 }
+
+// A broadcast probe request should be evaluated against every target's UID, honoring the probe
+// range and the Known UID list.
+TEST_F(TestLlrpTarget, BroadcastProbeRequestHandledByEachTargetInRange)
+{
+  RegisterOtherTarget(0, "92c5b1a8-2f4e-4a43-9bd1-7a6a1e05b6e1", "6574:60313951");
+  RegisterOtherTarget(1, "03d7e0a0-5d0a-4a4e-9a1e-4f7de3a2c1b2", "6574:60313952");
+  RegisterOtherTarget(2, "5e2c4d6f-7f1b-4b58-8c0e-2a1f9b3d4e5f", "6575:00000001");
+  rc_llrp_target_module_tick();
+
+  const RdmUid      known_uids[] = {rdm::Uid::FromString("6574:60313952").get()};
+  LocalProbeRequest request{};
+  request.lower_uid = rdm::Uid::FromString("6574:00000000").get();
+  request.upper_uid = rdm::Uid::FromString("6574:ffffffff").get();
+  request.known_uids = known_uids;
+  request.num_known_uids = 1;
+  auto message = PackProbeRequest(request);
+
+  rc_llrp_target_data_received(message.data(), message.size(), &kFakeNetints[0]);
+
+  // In range
+  EXPECT_TRUE(target_.netints[0].reply_pending);
+  EXPECT_TRUE(other_targets_[0].netints[0].reply_pending);
+  // Suppressed by the Known UID list
+  EXPECT_FALSE(other_targets_[1].netints[0].reply_pending);
+  // Out of range
+  EXPECT_FALSE(other_targets_[2].netints[0].reply_pending);
+
+  // The reply is only pending on the interface the request was received on.
+  EXPECT_FALSE(target_.netints[1].reply_pending);
+}
+
+TEST_F(TestLlrpTarget, RdmCommandDeliveredToAddressedTargets)
+{
+  RegisterOtherTarget(0, "92c5b1a8-2f4e-4a43-9bd1-7a6a1e05b6e1", "6574:60313951");
+  rc_llrp_target_module_tick();
+
+  // Unicast commands are delivered only to the target with the matching CID.
+  auto message = PackRdmCommand(etcpal::Uuid(other_targets_[0].cid), rdm::Uid(other_targets_[0].uid));
+  rc_llrp_target_data_received(message.data(), message.size(), &kFakeNetints[0]);
+  ASSERT_EQ(targetcb_rdm_cmd_received_fake.call_count, 1u);
+  EXPECT_EQ(targetcb_rdm_cmd_received_fake.arg0_val, &other_targets_[0]);
+
+  // Broadcast commands are delivered to every target.
+  RESET_FAKE(targetcb_rdm_cmd_received);
+  message = PackRdmCommand(*kLlrpBroadcastCid, rdm::Uid::FromString("ffff:ffffffff"));
+  rc_llrp_target_data_received(message.data(), message.size(), &kFakeNetints[0]);
+  EXPECT_EQ(targetcb_rdm_cmd_received_fake.call_count, 2u);
+
+  // Commands addressed to unknown targets are ignored.
+  RESET_FAKE(targetcb_rdm_cmd_received);
+  message = PackRdmCommand(etcpal::Uuid::FromString("c0ffee00-0000-4000-8000-000000000000"),
+                           rdm::Uid::FromString("6574:60313950"));
+  rc_llrp_target_data_received(message.data(), message.size(), &kFakeNetints[0]);
+  EXPECT_EQ(targetcb_rdm_cmd_received_fake.call_count, 0u);
+}
@@ -311,3 +311,22 @@ TEST_F(TestMcast, SetsReuseAddrWhenSourcePortSpecified)
 
   EXPECT_TRUE(reuseaddr_set);
 }
+
+TEST_F(TestMcast, RecvSocketIsNonBlocking)
+{
+  ASSERT_EQ(kEtcPalErrOk, rc_mcast_module_init(nullptr));
+  etcpal_socket_reset_all_fakes();
+  etcpal_socket_fake.custom_fake = [](unsigned int, unsigned int, etcpal_socket_t* sock) {
+    *sock = (etcpal_socket_t)0;
+    return kEtcPalErrOk;
+  };
+
+  const EtcPalIpAddr group = etcpal::IpAddr::FromString("239.255.250.134").get();
+  etcpal_socket_t    socket;
+  ASSERT_EQ(kEtcPalErrOk, rc_mcast_create_recv_socket(&group, 5569, &socket));
+
+  // Receive sockets are drained until they would block, so they must be non-blocking.
+  ASSERT_EQ(etcpal_setblocking_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_setblocking_fake.arg1_val, false);
+  EXPECT_EQ(etcpal_bind_fake.call_count, 1u);
+}
@@ -63,7 +63,8 @@ const std::unordered_map<std::string, const std::vector<size_t>> kFixedChunkSize
 class TestMsgBufParsing : public testing::Test, public testing::WithParamInterface<DataValidationPair>
 {
 protected:
-  TestMsgBufParsing() { rc_msg_buf_init(&buf_); }
+  TestMsgBufParsing() { rc_msg_buf_init(&buf_, 0); }
+  ~TestMsgBufParsing() { rc_msg_buf_cleanup(&buf_); }
 
   std::vector<std::vector<uint8_t>> DivideIntoRandomChunks(const std::vector<uint8_t>& original, size_t num_chunks);
   std::vector<std::vector<uint8_t>> DivideIntoFixedChunks(const std::vector<uint8_t>& original,
@@ -142,9 +143,34 @@ TEST_P(TestMsgBufParsing, ParseMessageInFull)
   buf_.cur_data_size += test_data.size();
   ASSERT_EQ(kEtcPalErrOk, rc_msg_buf_parse_data(&buf_));
   ExpectMessagesEqual(buf_.msg, GetParam().second);
+  // A message received in full can be forwarded as the bytes it was parsed from.
+  EXPECT_EQ(std::vector<uint8_t>(buf_.raw_msg, buf_.raw_msg + buf_.raw_msg_size), test_data);
   rc_free_message_resources(&buf_.msg);
 }
 
+// Test parsing two copies of the message received back-to-back. The storage for the first
+// message's lists is reused for the second.
+TEST_P(TestMsgBufParsing, ParseConsecutiveMessages)
+{
+  SCOPED_TRACE(std::string{"While testing input file: "} + GetParam().first);
+
+  std::ifstream test_data_file(GetParam().first);
+  auto          test_data = rdmnet::testing::LoadTestData(test_data_file);
+  ASSERT_LE(test_data.size() * 2, buf_.buf_size);
+
+  for (int i = 0; i < 2; ++i)
+  {
+    std::memcpy(&buf_.buf[buf_.cur_data_size], test_data.data(), test_data.size());
+    buf_.cur_data_size += test_data.size();
+  }
+  for (int i = 0; i < 2; ++i)
+  {
+    ASSERT_EQ(kEtcPalErrOk, rc_msg_buf_parse_data(&buf_)) << "While parsing message " << i + 1;
+    ExpectMessagesEqual(buf_.msg, GetParam().second);
+    rc_free_message_resources(&buf_.msg);
+  }
+}
+
 // Test parsing the message after dividing it into a number of randomly-sized chunks and simulating
 // receiving each chunk at discrete times. This simulates the byte-stream nature of TCP. The number
 // of chunks is controlled by kNumChunksPerMessage, and this test case re-divides the message
@@ -221,8 +247,9 @@ protected:
   TestMsgBufReceiving()
   {
     etcpal_reset_all_fakes();
-    rc_msg_buf_init(&buf_);
+    rc_msg_buf_init(&buf_, kRecvBufMaxSize);
   }
+  ~TestMsgBufReceiving() { rc_msg_buf_cleanup(&buf_); }
 
   RCMsgBuf buf_;
 };
@@ -287,3 +314,18 @@ TEST_F(TestMsgBufReceiving, AvoidsReceiveIfBufferAlreadyFull)
   EXPECT_EQ(buf_.cur_data_size, kRecvBufMaxSize);
   EXPECT_EQ(etcpal_recv_fake.call_count, 0u);
 }
+
+TEST_F(TestMsgBufReceiving, CompactsParsedDataToMakeRoom)
+{
+  static constexpr size_t kUnparsedSize = 4u;
+
+  // Simulate a buffer which is full, but where everything except the last few bytes has been parsed.
+  buf_.cur_data_offset = kRecvBufMaxSize - kUnparsedSize;
+  buf_.cur_data_size = kRecvBufMaxSize;
+  std::memcpy(&buf_.buf[buf_.cur_data_offset], kTestRecvData, kUnparsedSize);
+
+  EXPECT_EQ(rc_msg_buf_make_room(&buf_), kRecvBufMaxSize - kUnparsedSize);
+  EXPECT_EQ(buf_.cur_data_offset, 0u);
+  EXPECT_EQ(buf_.cur_data_size, kUnparsedSize);
+  EXPECT_EQ(memcmp(buf_.buf, kTestRecvData, kUnparsedSize), 0);
+}
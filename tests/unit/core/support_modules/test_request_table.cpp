@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "rdmnet/core/request_table.h"
+
+#include <set>
+#include "gtest/gtest.h"
+
+class TestRcRequestTable : public testing::Test
+{
+protected:
+#if RDMNET_DYNAMIC_MEM
+  static constexpr uint32_t kNumRequests = 100;
+#else
+  static constexpr uint32_t kNumRequests = RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE;
+#endif
+
+  RCRequestTable table_;
+
+  void SetUp() override { rc_request_table_init(&table_); }
+  void TearDown() override { rc_request_table_cleanup(&table_); }
+
+  static RdmnetDestinationAddr Destination(uint32_t device_id)
+  {
+    RdmnetDestinationAddr dest = RDMNET_ADDR_TO_DEFAULT_RESPONDER(0x6574, device_id);
+    return dest;
+  }
+};
+
+TEST_F(TestRcRequestTable, AddedRequestsCanBeFound)
+{
+  for (uint32_t seq_num = 1; seq_num <= kNumRequests; ++seq_num)
+  {
+    const RdmnetDestinationAddr dest = Destination(seq_num);
+    RCTrackedRequest*           request = rc_request_table_add(&table_, seq_num, &dest);
+    ASSERT_NE(request, nullptr) << "Failed on seq_num " << seq_num;
+    EXPECT_EQ(request->seq_num, seq_num);
+  }
+  EXPECT_EQ(table_.num_requests, kNumRequests);
+
+  for (uint32_t seq_num = 1; seq_num <= kNumRequests; ++seq_num)
+  {
+    RCTrackedRequest* request = rc_request_table_find(&table_, seq_num);
+    ASSERT_NE(request, nullptr) << "Failed on seq_num " << seq_num;
+    EXPECT_EQ(request->seq_num, seq_num);
+    EXPECT_EQ(request->destination.rdmnet_uid.id, seq_num);
+  }
+  EXPECT_EQ(rc_request_table_find(&table_, kNumRequests + 1), nullptr);
+}
+
+TEST_F(TestRcRequestTable, DuplicateSeqNumIsRejected)
+{
+  const RdmnetDestinationAddr dest = Destination(1);
+  ASSERT_NE(rc_request_table_add(&table_, 20, &dest), nullptr);
+  EXPECT_EQ(rc_request_table_add(&table_, 20, &dest), nullptr);
+  EXPECT_EQ(table_.num_requests, 1u);
+  EXPECT_EQ(rc_request_table_num_in_flight(&table_, &dest.rdmnet_uid), 1u);
+}
+
+TEST_F(TestRcRequestTable, RemoveKeepsOtherRequestsReachable)
+{
+  // Sequence numbers which collide in the table exercise the deletion of probe sequences.
+  const RdmnetDestinationAddr dest = Destination(1);
+  const uint32_t              stride = 16;
+  for (uint32_t i = 0; i < kNumRequests; ++i)
+    ASSERT_NE(rc_request_table_add(&table_, i * stride, &dest), nullptr);
+
+  RCTrackedRequest removed;
+  for (uint32_t i = 0; i < kNumRequests; i += 2)
+  {
+    ASSERT_TRUE(rc_request_table_remove(&table_, i * stride, &removed));
+    EXPECT_EQ(removed.seq_num, i * stride);
+  }
+  EXPECT_FALSE(rc_request_table_remove(&table_, 0, &removed));
+
+  for (uint32_t i = 0; i < kNumRequests; ++i)
+  {
+    if (i % 2)
+      EXPECT_NE(rc_request_table_find(&table_, i * stride), nullptr) << "Failed on index " << i;
+    else
+      EXPECT_EQ(rc_request_table_find(&table_, i * stride), nullptr) << "Failed on index " << i;
+  }
+  EXPECT_EQ(table_.num_requests, kNumRequests / 2);
+}
+
+TEST_F(TestRcRequestTable, CountsRequestsInFlightPerDestination)
+{
+  const RdmnetDestinationAddr dest_1 = Destination(1);
+  const RdmnetDestinationAddr dest_2 = Destination(2);
+  ASSERT_NE(rc_request_table_add(&table_, 1, &dest_1), nullptr);
+  ASSERT_NE(rc_request_table_add(&table_, 2, &dest_1), nullptr);
+  ASSERT_NE(rc_request_table_add(&table_, 3, &dest_2), nullptr);
+
+  EXPECT_EQ(rc_request_table_num_in_flight(&table_, &dest_1.rdmnet_uid), 2u);
+  EXPECT_EQ(rc_request_table_num_in_flight(&table_, &dest_2.rdmnet_uid), 1u);
+
+  ASSERT_TRUE(rc_request_table_remove(&table_, 1, nullptr));
+  EXPECT_EQ(rc_request_table_num_in_flight(&table_, &dest_1.rdmnet_uid), 1u);
+  ASSERT_TRUE(rc_request_table_remove(&table_, 3, nullptr));
+  EXPECT_EQ(rc_request_table_num_in_flight(&table_, &dest_2.rdmnet_uid), 0u);
+  EXPECT_EQ(rc_request_table_num_in_flight(&table_, &dest_1.rdmnet_uid), 1u);
+}
+
+TEST_F(TestRcRequestTable, IteratesOverAllRequests)
+{
+  std::set<uint32_t> expected;
+  for (uint32_t seq_num = 1; seq_num <= kNumRequests; ++seq_num)
+  {
+    const RdmnetDestinationAddr dest = Destination(seq_num % 3);
+    ASSERT_NE(rc_request_table_add(&table_, seq_num, &dest), nullptr);
+    expected.insert(seq_num);
+  }
+
+  std::set<uint32_t> found;
+  size_t             index = 0;
+  for (RCTrackedRequest* request = rc_request_table_next(&table_, &index); request;
+       request = rc_request_table_next(&table_, &index))
+  {
+    EXPECT_TRUE(found.insert(request->seq_num).second);
+  }
+  EXPECT_EQ(found, expected);
+}
+
+#if !RDMNET_DYNAMIC_MEM
+TEST_F(TestRcRequestTable, AddFailsWhenFull)
+{
+  const RdmnetDestinationAddr dest = Destination(1);
+  for (uint32_t seq_num = 0; seq_num < RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE; ++seq_num)
+    ASSERT_NE(rc_request_table_add(&table_, seq_num, &dest), nullptr);
+  EXPECT_EQ(rc_request_table_add(&table_, RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE, &dest), nullptr);
+
+  ASSERT_TRUE(rc_request_table_remove(&table_, 0, nullptr));
+  EXPECT_NE(rc_request_table_add(&table_, RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE, &dest), nullptr);
+}
+#endif
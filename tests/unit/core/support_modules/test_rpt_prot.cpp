@@ -54,8 +54,8 @@ void TestSendStatus(const std::string& file_name)
   static std::vector<uint8_t> packed_msg;
   packed_msg.clear();
 
-  RESET_FAKE(rc_send);
-  rc_send_fake.custom_fake = [](etcpal_socket_t, const void* msg, size_t length, int) {
+  RESET_FAKE(rc_try_send);
+  rc_try_send_fake.custom_fake = [](etcpal_socket_t, const void* msg, size_t length, int) {
     const uint8_t* msg_bytes = reinterpret_cast<const uint8_t*>(msg);
     std::transform(msg_bytes, msg_bytes + length, std::back_inserter(packed_msg),
                    [](const uint8_t& byte) { return byte; });
@@ -64,6 +64,9 @@ void TestSendStatus(const std::string& file_name)
   RCConnection conn{};
   EXPECT_EQ(rc_rpt_send_status(&conn, &msg.sender_cid, &RDMNET_GET_RPT_MSG(&msg)->header, status), kEtcPalErrOk);
   EXPECT_EQ(msg_bytes, packed_msg);
+  // The whole message should be handed to the network stack at once.
+  EXPECT_EQ(rc_try_send_fake.call_count, 1u);
+  rc_send_buf_cleanup(&conn.send_buf);
 }
 
 TEST(TestRptProt, PackRptStatusWithoutString)
@@ -105,3 +108,95 @@ TEST(TestRptProt, SendRptStatusMaxLengthString)
 {
   TestSendStatus("rpt_status_max_length_string");
 }
+
+TEST(TestRptProt, CorkedSendsAreBatched)
+{
+  RdmnetMessage        msg;
+  std::vector<uint8_t> msg_bytes;
+  ASSERT_TRUE(GetTestFileByBasename("rpt_status_mid_length_string", msg_bytes, msg));
+  RptStatusMsg* status = RPT_GET_STATUS_MSG(RDMNET_GET_RPT_MSG(&msg));
+
+  static std::vector<uint8_t> packed_msgs;
+  packed_msgs.clear();
+
+  RESET_FAKE(rc_try_send);
+  rc_try_send_fake.custom_fake = [](etcpal_socket_t, const void* msg, size_t length, int) {
+    const uint8_t* msg_bytes = reinterpret_cast<const uint8_t*>(msg);
+    packed_msgs.insert(packed_msgs.end(), msg_bytes, msg_bytes + length);
+    return (int)length;
+  };
+
+  RCConnection conn{};
+  rc_send_buf_cork(&conn.send_buf);
+  EXPECT_EQ(rc_rpt_send_status(&conn, &msg.sender_cid, &RDMNET_GET_RPT_MSG(&msg)->header, status), kEtcPalErrOk);
+  EXPECT_EQ(rc_rpt_send_status(&conn, &msg.sender_cid, &RDMNET_GET_RPT_MSG(&msg)->header, status), kEtcPalErrOk);
+  EXPECT_EQ(rc_try_send_fake.call_count, 0u);
+
+  EXPECT_EQ(rc_send_buf_uncork(&conn.send_buf, conn.sock), kEtcPalErrOk);
+  EXPECT_EQ(rc_try_send_fake.call_count, 1u);
+
+  std::vector<uint8_t> expected_bytes = msg_bytes;
+  expected_bytes.insert(expected_bytes.end(), msg_bytes.begin(), msg_bytes.end());
+  EXPECT_EQ(packed_msgs, expected_bytes);
+  rc_send_buf_cleanup(&conn.send_buf);
+}
+
+TEST(TestRptProt, BlockedSendsAreQueued)
+{
+  RdmnetMessage        msg;
+  std::vector<uint8_t> msg_bytes;
+  ASSERT_TRUE(GetTestFileByBasename("rpt_status_mid_length_string", msg_bytes, msg));
+  RptStatusMsg* status = RPT_GET_STATUS_MSG(RDMNET_GET_RPT_MSG(&msg));
+
+  static std::vector<uint8_t> packed_msgs;
+  packed_msgs.clear();
+
+  // The socket accepts part of the first message, then nothing more.
+  RESET_FAKE(rc_try_send);
+  rc_try_send_fake.custom_fake = [](etcpal_socket_t, const void* msg, size_t length, int) {
+    if (rc_try_send_fake.call_count > 1)
+      return (int)kEtcPalErrWouldBlock;
+    const uint8_t* msg_bytes = reinterpret_cast<const uint8_t*>(msg);
+    packed_msgs.insert(packed_msgs.end(), msg_bytes, msg_bytes + length / 2);
+    return (int)(length / 2);
+  };
+  RESET_FAKE(rc_modify_polled_socket);
+
+  RCConnection conn{};
+  rc_send_buf_init(&conn.send_buf, &conn.poll_info);
+
+  // Messages should be accepted without blocking until the queue reaches the high-water mark.
+  size_t         num_sent = 0;
+  etcpal_error_t res = kEtcPalErrOk;
+  while (res == kEtcPalErrOk && num_sent <= RDMNET_CONN_SEND_QUEUE_HIGH_WATER / msg_bytes.size() + 1)
+  {
+    res = rc_rpt_send_status(&conn, &msg.sender_cid, &RDMNET_GET_RPT_MSG(&msg)->header, status);
+    if (res == kEtcPalErrOk)
+      ++num_sent;
+  }
+  EXPECT_EQ(res, kEtcPalErrWouldBlock);
+  EXPECT_EQ(packed_msgs.size(), msg_bytes.size() / 2);
+  EXPECT_EQ(rc_send_buf_queued_size(&conn.send_buf), num_sent * msg_bytes.size() - packed_msgs.size());
+  EXPECT_GE(rc_send_buf_queued_size(&conn.send_buf), (size_t)RDMNET_CONN_SEND_QUEUE_HIGH_WATER);
+
+  // Write interest should have been registered once.
+  EXPECT_EQ(rc_modify_polled_socket_fake.call_count, 1u);
+  EXPECT_EQ(rc_modify_polled_socket_fake.arg1_val, ETCPAL_POLL_IN | ETCPAL_POLL_OUT);
+
+  // Once the socket is writable, the rest of the queue should be sent in order.
+  rc_try_send_fake.custom_fake = [](etcpal_socket_t, const void* msg, size_t length, int) {
+    const uint8_t* msg_bytes = reinterpret_cast<const uint8_t*>(msg);
+    packed_msgs.insert(packed_msgs.end(), msg_bytes, msg_bytes + length);
+    return (int)length;
+  };
+  EXPECT_EQ(rc_send_buf_flush(&conn.send_buf, conn.sock), kEtcPalErrOk);
+  EXPECT_EQ(rc_send_buf_queued_size(&conn.send_buf), 0u);
+  EXPECT_EQ(rc_modify_polled_socket_fake.call_count, 2u);
+  EXPECT_EQ(rc_modify_polled_socket_fake.arg1_val, ETCPAL_POLL_IN);
+
+  ASSERT_EQ(packed_msgs.size(), num_sent * msg_bytes.size());
+  for (size_t i = 0; i < num_sent; ++i)
+    EXPECT_TRUE(std::equal(msg_bytes.begin(), msg_bytes.end(), &packed_msgs[i * msg_bytes.size()]));
+
+  rc_send_buf_cleanup(&conn.send_buf);
+}
@@ -29,6 +29,7 @@
 #include "rdm/cpp/uid.h"
 #include "rdmnet_mock/core/mcast.h"
 #include "rdmnet_mock/core/common.h"
+#include "rdmnet/core/opts.h"
 #include "rdmnet/disc/common.h"
 #include "rdmnet/disc/monitored_scope.h"
 #include "rdmnet/disc/discovered_broker.h"
@@ -43,6 +44,7 @@ class TestLwMdnsRecv : public testing::Test
 protected:
   RdmnetScopeMonitorRef*      monitor_ref_;
   static std::vector<uint8_t> data_to_recv_;
+  static size_t               datagrams_queued_;
 
   void SetUp() override
   {
@@ -53,6 +55,7 @@ protected:
     recv_socket_info = RCPolledSocketInfo{};
 
     data_to_recv_.clear();
+    datagrams_queued_ = 0;
     rc_add_polled_socket_fake.custom_fake = [](etcpal_socket_t, etcpal_poll_events_t events,
                                                RCPolledSocketInfo* socket_info) {
       EXPECT_TRUE(events & ETCPAL_POLL_IN);
@@ -60,6 +63,11 @@ protected:
       return kEtcPalErrOk;
     };
     etcpal_recvfrom_fake.custom_fake = [](etcpal_socket_t, void* buffer, size_t length, int, EtcPalSockAddr* address) {
+      // The socket is non-blocking and is drained until empty.
+      if (datagrams_queued_ == 0)
+        return static_cast<int>(kEtcPalErrWouldBlock);
+      --datagrams_queued_;
+
       EXPECT_LE(data_to_recv_.size(), length);
       std::memcpy(buffer, data_to_recv_.data(), data_to_recv_.size());
       *address = recvfrom_addr.get();
@@ -82,9 +90,20 @@ protected:
     scope_monitor_delete(monitor_ref_);
     rdmnet_disc_module_deinit();
   }
+
+  // Queue data_to_recv_ num_datagrams times and deliver a readable event on the receive socket.
+  void ReceiveData(size_t num_datagrams = 1)
+  {
+    datagrams_queued_ = num_datagrams;
+
+    EtcPalPollEvent event{};
+    event.events = ETCPAL_POLL_IN;
+    recv_socket_info.callback(&event, recv_socket_info.data);
+  }
 };
 
 std::vector<uint8_t> TestLwMdnsRecv::data_to_recv_;
+size_t               TestLwMdnsRecv::datagrams_queued_;
 
 TEST_F(TestLwMdnsRecv, HandlesPtrRecordProperly)
 {
@@ -115,9 +134,7 @@ TEST_F(TestLwMdnsRecv, HandlesPtrRecordProperly)
       0xc0, 0x1a                                          // Pointer to _rdmnet._tcp.local
   };
 
-  EtcPalPollEvent event{};
-  event.events = ETCPAL_POLL_IN;
-  recv_socket_info.callback(&event, recv_socket_info.data);
+  ReceiveData();
 
   // We should add a discovered broker to the list
   ASSERT_NE(monitor_ref_->broker_list, nullptr);
@@ -126,6 +143,29 @@ TEST_F(TestLwMdnsRecv, HandlesPtrRecordProperly)
   EXPECT_EQ(db->platform_data.ttl_timer.interval, 120u * 1000u);
 }
 
+// Responses which are queued on the socket should be drained in batches on a single readable event.
+TEST_F(TestLwMdnsRecv, DrainsQueuedResponsesInBatches)
+{
+  data_to_recv_ = {
+      0, 0,        // Transaction ID
+      0x84, 0x00,  // Flags: Standard query response, no error
+      0, 0,        // Question count: 0
+      0, 0,        // Answer count: 0
+      0, 0,        // Authority count: 0
+      0, 0,        // Additional count: 0
+  };
+
+  // Fewer than a batch: everything is read, then the socket reports that it would block.
+  ReceiveData(3);
+  EXPECT_EQ(etcpal_recvfrom_fake.call_count, 4u);
+  EXPECT_EQ(datagrams_queued_, 0u);
+
+  // More than a batch: reading stops at the batch size and the rest is left for the next event.
+  ReceiveData(RDMNET_MCAST_RECV_BATCH_SIZE + 2);
+  EXPECT_EQ(etcpal_recvfrom_fake.call_count, 4u + RDMNET_MCAST_RECV_BATCH_SIZE);
+  EXPECT_EQ(datagrams_queued_, 2u);
+}
+
 // A zero-TTL PTR record should remove the broker from the list.
 TEST_F(TestLwMdnsRecv, HandlesPtrRecordZeroTTL)
 {
@@ -154,9 +194,7 @@ TEST_F(TestLwMdnsRecv, HandlesPtrRecordZeroTTL)
       0xc0, 0x1a                                          // Pointer to _rdmnet._tcp.local
   };
 
-  EtcPalPollEvent event{};
-  event.events = ETCPAL_POLL_IN;
-  recv_socket_info.callback(&event, recv_socket_info.data);
+  ReceiveData();
 
   // Receiving a message with zero TTL, when there are no brokers, should not add one.
   ASSERT_EQ(monitor_ref_->broker_list, nullptr);
@@ -166,7 +204,7 @@ TEST_F(TestLwMdnsRecv, HandlesPtrRecordZeroTTL)
   discovered_broker_insert(&monitor_ref_->broker_list, db);
   EXPECT_EQ(db->platform_data.destruction_pending, false);
 
-  recv_socket_info.callback(&event, recv_socket_info.data);
+  ReceiveData();
 
   // The broker should now be marked for destruction.
   EXPECT_EQ(db->platform_data.destruction_pending, true);
@@ -221,9 +259,7 @@ TEST_F(TestLwMdnsRecv, HandlesMultipleServiceRecordsProperly)
       16, 77, 97, 110, 117, 102, 61, 84, 101, 115, 116, 32, 77, 97, 110, 117, 102     // Manuf=Test Manuf
   };
 
-  EtcPalPollEvent event{};
-  event.events = ETCPAL_POLL_IN;
-  recv_socket_info.callback(&event, recv_socket_info.data);
+  ReceiveData();
 
   EXPECT_EQ(db->cid, etcpal::Uuid::FromString("6824b7be1fb54cb598f0d216b77e67ca"));
   EXPECT_EQ(db->uid, rdm::Uid::FromString("6574081caf15"));
@@ -271,9 +307,7 @@ TEST_F(TestLwMdnsRecv, HandlesPtrQueryWithAnswer)
       0xc0, 0x1a                                          // Pointer to _rdmnet._tcp.local
   };
 
-  EtcPalPollEvent event{};
-  event.events = ETCPAL_POLL_IN;
-  recv_socket_info.callback(&event, recv_socket_info.data);
+  ReceiveData();
 
   // We should add a discovered broker to the list
   ASSERT_NE(monitor_ref_->broker_list, nullptr);
@@ -20,6 +20,7 @@ bool RdmnetTestingAssertHandler(const char* expression, const char* file, const
 #define RDMNET_MAX_DEVICES 5
 #define RDMNET_MAX_EPT_CLIENTS 5
 #define RDMNET_MAX_SCOPES_PER_CONTROLLER 5
+#define RDMNET_MAX_TRACKED_REQUESTS_PER_SCOPE 5
 #define RDMNET_MAX_ENDPOINTS_PER_DEVICE 5
 #define RDMNET_MAX_RESPONDERS_PER_DEVICE 25
 #define RDMNET_MAX_PROTOCOLS_PER_EPT_CLIENT 5
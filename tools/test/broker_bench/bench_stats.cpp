@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "bench_stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+std::atomic<bool> LatencyRecorder::recording_{false};
+
+uint64_t BenchTimestampNow()
+{
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+void LatencyRecorder::Record(uint64_t sent_timestamp)
+{
+  if (!recording_)
+    return;
+
+  uint64_t now = BenchTimestampNow();
+  uint64_t latency_us = (now > sent_timestamp ? (now - sent_timestamp) / 1000 : 0);
+
+  std::lock_guard<std::mutex> guard(lock_);
+  samples_us_.push_back(latency_us);
+}
+
+LatencyRecorder::Summary LatencyRecorder::Summarize()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  Summary summary;
+  summary.count = samples_us_.size();
+  if (samples_us_.empty())
+    return summary;
+
+  std::sort(samples_us_.begin(), samples_us_.end());
+
+  // Nearest-rank percentile
+  auto percentile = [&](double p) {
+    size_t rank = static_cast<size_t>(p * static_cast<double>(samples_us_.size()) + 0.999999);
+    if (rank == 0)
+      rank = 1;
+    return samples_us_[std::min(rank, samples_us_.size()) - 1];
+  };
+
+  summary.p50_us = percentile(0.5);
+  summary.p99_us = percentile(0.99);
+  summary.p999_us = percentile(0.999);
+  summary.max_us = samples_us_.back();
+  return summary;
+}
+
+// Reads utime and stime from /proc/<pid>/stat and VmRSS and VmHWM from /proc/<pid>/status.
+bool GetProcessUsage(pid_t pid, ProcessUsage& usage)
+{
+  std::string   proc_dir = "/proc/" + std::to_string(pid);
+  std::ifstream stat_file(proc_dir + "/stat");
+  std::string   stat_line;
+  if (!std::getline(stat_file, stat_line))
+    return false;
+
+  // The command name field may contain spaces; the fields after it are space-separated. utime and
+  // stime are fields 14 and 15, i.e. the 12th and 13th fields after the closing parenthesis.
+  auto name_end = stat_line.rfind(')');
+  if (name_end == std::string::npos)
+    return false;
+
+  std::istringstream fields(stat_line.substr(name_end + 2));
+  std::string        field;
+  uint64_t           utime = 0;
+  uint64_t           stime = 0;
+  for (int i = 0; i < 13 && (fields >> field); ++i)
+  {
+    if (i == 11)
+      utime = std::stoull(field);
+    else if (i == 12)
+      stime = std::stoull(field);
+  }
+  usage.cpu_ticks = utime + stime;
+
+  std::ifstream status_file(proc_dir + "/status");
+  std::string   status_line;
+  while (std::getline(status_file, status_line))
+  {
+    if (status_line.compare(0, 6, "VmRSS:") == 0)
+      usage.rss_kb = std::stoull(status_line.substr(6));
+    else if (status_line.compare(0, 6, "VmHWM:") == 0)
+      usage.hwm_kb = std::stoull(status_line.substr(6));
+  }
+  return true;
+}
+
+// Returns CPU usage over an interval as a percentage of one core.
+double CpuPercent(const ProcessUsage& start, const ProcessUsage& end, double elapsed_sec)
+{
+  static const long kTicksPerSec = sysconf(_SC_CLK_TCK);
+
+  if (elapsed_sec <= 0.0 || kTicksPerSec <= 0 || end.cpu_ticks < start.cpu_ticks)
+    return 0.0;
+  double cpu_sec = static_cast<double>(end.cpu_ticks - start.cpu_ticks) / static_cast<double>(kTicksPerSec);
+  return 100.0 * cpu_sec / elapsed_sec;
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#ifndef BENCH_STATS_H_
+#define BENCH_STATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <sys/types.h>
+
+// Timestamps carried in benchmark message data, in nanoseconds of a monotonic clock. Senders and
+// receivers all live in the benchmark process, so no clock synchronization is needed.
+uint64_t BenchTimestampNow();
+
+// Collects end-to-end latency samples for one kind of message.
+class LatencyRecorder
+{
+public:
+  struct Summary
+  {
+    size_t   count{0};
+    uint64_t p50_us{0};
+    uint64_t p99_us{0};
+    uint64_t p999_us{0};
+    uint64_t max_us{0};
+  };
+
+  // Samples are only kept while recording is enabled, so that connection setup and warmup traffic
+  // does not skew the results.
+  static void SetRecording(bool recording) { recording_ = recording; }
+  static bool recording() { return recording_; }
+
+  void    Record(uint64_t sent_timestamp);
+  Summary Summarize();
+
+private:
+  static std::atomic<bool> recording_;
+
+  std::mutex            lock_;
+  std::vector<uint64_t> samples_us_;
+};
+
+// Resource usage of a process, read from procfs.
+struct ProcessUsage
+{
+  uint64_t cpu_ticks{0};  // User plus system time, in clock ticks
+  uint64_t rss_kb{0};     // Current resident set size
+  uint64_t hwm_kb{0};     // Peak resident set size
+};
+
+bool   GetProcessUsage(pid_t pid, ProcessUsage& usage);
+double CpuPercent(const ProcessUsage& start, const ProcessUsage& end, double elapsed_sec);
+
+#endif  // BENCH_STATS_H_
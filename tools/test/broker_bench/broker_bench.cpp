@@ -0,0 +1,508 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// broker_bench: Measures broker throughput, latency and resource usage.
+//
+// Starts an RDMnet broker on the loopback interface in a child process, connects a set of
+// simulated RPT devices and controllers to it from this process using the RDMnet client library,
+// then drives a configurable mix of traffic through the broker and reports the results. Running
+// the broker in its own process lets its CPU and memory usage be measured separately from the
+// simulated clients.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "etcpal/cpp/inet.h"
+#include "etcpal/cpp/uuid.h"
+#include "rdmnet/cpp/broker.h"
+#include "rdmnet/cpp/common.h"
+#include "bench_stats.h"
+#include "sim_clients.h"
+
+constexpr uint16_t kBenchManufacturerId = 0x6574;
+
+struct BenchOptions
+{
+  size_t       num_devices{10};
+  size_t       num_controllers{2};
+  unsigned int duration_sec{10};
+  unsigned int warmup_sec{2};
+  unsigned int rate{0};  // Operations per second across all clients; 0 means as fast as possible
+  size_t       window{16};
+  unsigned int request_weight{90};
+  unsigned int notification_weight{10};
+  unsigned int broadcast_weight{0};
+  uint16_t     port{18888};
+  std::string  netint{"lo"};
+  size_t       send_batch_size{0};
+  unsigned int socket_worker_threads{1};
+};
+
+// Print the command-line usage details.
+void PrintHelp(const char* app_name)
+{
+  std::cout << "Usage: " << app_name << " [OPTION]...\n";
+  std::cout << "\n";
+  std::cout << "Options:\n";
+  std::cout << "  --devices=N             Number of simulated RPT devices. Default 10.\n";
+  std::cout << "  --controllers=N         Number of simulated RPT controllers. Default 2.\n";
+  std::cout << "  --duration=SECONDS      Length of the measurement period. Default 10.\n";
+  std::cout << "  --warmup=SECONDS        Traffic to send before measuring. Default 2.\n";
+  std::cout << "  --rate=OPS              Operations to start per second across all clients. By\n";
+  std::cout << "                          default, operations are sent as fast as the request\n";
+  std::cout << "                          window allows.\n";
+  std::cout << "  --window=N              Maximum requests awaiting a response per controller.\n";
+  std::cout << "                          Default 16.\n";
+  std::cout << "  --mix=REQ,NOTIF,BCAST   Relative weights of controller requests, device\n";
+  std::cout << "                          notifications and controller broadcasts in the\n";
+  std::cout << "                          traffic. Default 90,10,0.\n";
+  std::cout << "  --port=PORT             Port for the broker to listen on. Default 18888.\n";
+  std::cout << "  --iface=IFACE           Loopback interface name. Default 'lo'.\n";
+  std::cout << "  --send-batch-size=BYTES Broker send_batch_size setting. Default 0.\n";
+  std::cout << "  --socket-threads=N      Broker socket_worker_threads setting. Default 1.\n";
+  std::cout << "  --help                  Display this help and exit.\n";
+}
+
+// Parse an unsigned decimal option value, rejecting trailing garbage.
+bool ParseUnsigned(const char* str, unsigned long& value)
+{
+  char* end;
+  if (*str == '\0' || *str == '-')
+    return false;
+  value = std::strtoul(str, &end, 10);
+  return (*end == '\0');
+}
+
+bool ParseMix(const char* str, BenchOptions& options)
+{
+  unsigned int req, notif, bcast;
+  char         extra;
+  if (std::sscanf(str, "%u,%u,%u%c", &req, &notif, &bcast, &extra) != 3 || (req + notif + bcast) == 0)
+    return false;
+  options.request_weight = req;
+  options.notification_weight = notif;
+  options.broadcast_weight = bcast;
+  return true;
+}
+
+// Possible results of parsing the command-line arguments.
+enum class ParseResult
+{
+  kGoodParse,  // Arguments were parsed OK.
+  kParseErr,   // Error while parsing arguments - should print usage and exit error.
+  kPrintHelp   // A help argument was passed - should print usage and exit success.
+};
+
+ParseResult ParseArgs(int argc, char* argv[], BenchOptions& options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const char*   arg = argv[i];
+    unsigned long value = 0;
+    auto          option_value = [&](const char* name) -> const char* {
+      size_t len = std::strlen(name);
+      return (std::strncmp(arg, name, len) == 0 ? &arg[len] : nullptr);
+    };
+
+    const char* val;
+    if (std::strcmp(arg, "--help") == 0)
+      return ParseResult::kPrintHelp;
+    else if ((val = option_value("--devices=")) && ParseUnsigned(val, value) && value > 0)
+      options.num_devices = value;
+    else if ((val = option_value("--controllers=")) && ParseUnsigned(val, value) && value > 0)
+      options.num_controllers = value;
+    else if ((val = option_value("--duration=")) && ParseUnsigned(val, value) && value > 0)
+      options.duration_sec = static_cast<unsigned int>(value);
+    else if ((val = option_value("--warmup=")) && ParseUnsigned(val, value))
+      options.warmup_sec = static_cast<unsigned int>(value);
+    else if ((val = option_value("--rate=")) && ParseUnsigned(val, value))
+      options.rate = static_cast<unsigned int>(value);
+    else if ((val = option_value("--window=")) && ParseUnsigned(val, value) && value > 0)
+      options.window = value;
+    else if ((val = option_value("--mix=")) && ParseMix(val, options))
+      continue;
+    else if ((val = option_value("--port=")) && ParseUnsigned(val, value) && value >= 1024 && value <= 65535)
+      options.port = static_cast<uint16_t>(value);
+    else if ((val = option_value("--iface=")) && *val != '\0')
+      options.netint = val;
+    else if ((val = option_value("--send-batch-size=")) && ParseUnsigned(val, value))
+      options.send_batch_size = value;
+    else if ((val = option_value("--socket-threads=")) && ParseUnsigned(val, value))
+      options.socket_worker_threads = static_cast<unsigned int>(value);
+    else
+      return ParseResult::kParseErr;
+  }
+  return ParseResult::kGoodParse;
+}
+
+/******************************************************************************
+ * Broker process
+ *****************************************************************************/
+
+// Runs in the child process. Reports startup success or failure through ready_fd, then runs the
+// broker until the parent closes the other end of stop_fd (or exits).
+int RunBrokerProcess(const BenchOptions& options, int ready_fd, int stop_fd)
+{
+  char status = 'E';
+
+  if (rdmnet::Init())
+  {
+    rdmnet::Broker::Settings settings(etcpal::Uuid::V4(), kBenchManufacturerId);
+    settings.dns.manufacturer = "ETC";
+    settings.dns.model = "RDMnet Broker Benchmark";
+    settings.listen_port = options.port;
+    settings.listen_interfaces.push_back(options.netint);
+    settings.send_batch_size = options.send_batch_size;
+    settings.socket_worker_threads = options.socket_worker_threads;
+    // The benchmark measures delivery, not queue limits.
+    settings.limits.controller_messages = 0;
+    settings.limits.device_messages = 0;
+
+    rdmnet::Broker broker;
+    if (broker.Startup(settings))
+    {
+      status = 'R';
+      (void)write(ready_fd, &status, 1);
+      close(ready_fd);
+
+      char buf;
+      while (read(stop_fd, &buf, 1) > 0)
+        ;
+
+      broker.Shutdown();
+      rdmnet::Deinit();
+      return 0;
+    }
+    rdmnet::Deinit();
+  }
+
+  (void)write(ready_fd, &status, 1);
+  close(ready_fd);
+  return 1;
+}
+
+class BrokerProcess
+{
+public:
+  ~BrokerProcess() { Stop(); }
+
+  bool  Start(const BenchOptions& options);
+  void  Stop();
+  pid_t pid() const { return pid_; }
+
+private:
+  pid_t pid_{-1};
+  int   stop_fd_{-1};
+};
+
+bool BrokerProcess::Start(const BenchOptions& options)
+{
+  int ready_pipe[2];
+  int stop_pipe[2];
+  if (pipe(ready_pipe) != 0)
+    return false;
+  if (pipe(stop_pipe) != 0)
+  {
+    close(ready_pipe[0]);
+    close(ready_pipe[1]);
+    return false;
+  }
+
+  pid_ = fork();
+  if (pid_ == 0)
+  {
+    close(ready_pipe[0]);
+    close(stop_pipe[1]);
+    _exit(RunBrokerProcess(options, ready_pipe[1], stop_pipe[0]));
+  }
+
+  close(ready_pipe[1]);
+  close(stop_pipe[0]);
+  stop_fd_ = stop_pipe[1];
+
+  char status = 'E';
+  bool started = (pid_ > 0 && read(ready_pipe[0], &status, 1) == 1 && status == 'R');
+  close(ready_pipe[0]);
+  if (!started)
+    Stop();
+  return started;
+}
+
+void BrokerProcess::Stop()
+{
+  if (stop_fd_ >= 0)
+  {
+    close(stop_fd_);
+    stop_fd_ = -1;
+  }
+  if (pid_ > 0)
+  {
+    waitpid(pid_, nullptr, 0);
+    pid_ = -1;
+  }
+}
+
+/******************************************************************************
+ * Traffic generation and reporting
+ *****************************************************************************/
+
+enum class BenchOp
+{
+  kRequest,
+  kNotification,
+  kBroadcast
+};
+
+// Interleaves operations according to the configured weights using a smooth weighted round-robin,
+// so the mix is exact over any window of (sum of weights) operations.
+class OpMix
+{
+public:
+  explicit OpMix(const BenchOptions& options)
+      : weights_{options.request_weight, options.notification_weight, options.broadcast_weight}
+  {
+  }
+
+  BenchOp Next()
+  {
+    int total = 0;
+    int best = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+      current_[i] += static_cast<int>(weights_[i]);
+      total += static_cast<int>(weights_[i]);
+      if (current_[i] > current_[best])
+        best = i;
+    }
+    current_[best] -= total;
+    return static_cast<BenchOp>(best);
+  }
+
+private:
+  unsigned int weights_[3];
+  int          current_[3]{};
+};
+
+struct ClientSet
+{
+  std::vector<rdm::Uid>                       device_uids;
+  std::vector<std::unique_ptr<SimDevice>>     devices;
+  std::vector<std::unique_ptr<SimController>> controllers;
+};
+
+// Sends traffic until the deadline. Returns the number of operations started.
+size_t DriveTraffic(const BenchOptions&                   options,
+                    ClientSet&                            clients,
+                    OpMix&                                mix,
+                    std::chrono::steady_clock::time_point deadline)
+{
+  using namespace std::chrono;
+
+  size_t next_device = 0;
+  size_t next_controller = 0;
+  size_t ops_started = 0;
+
+  auto interval = (options.rate ? nanoseconds(1000000000 / options.rate) : nanoseconds(0));
+  auto next_op_time = steady_clock::now();
+
+  while (steady_clock::now() < deadline)
+  {
+    bool sent = false;
+    switch (mix.Next())
+    {
+      case BenchOp::kRequest:
+        // Try each controller in turn; if every window is full, wait for responses to come in.
+        for (size_t tries = 0; tries < clients.controllers.size() && !sent; ++tries)
+        {
+          auto& controller = clients.controllers[next_controller];
+          next_controller = (next_controller + 1) % clients.controllers.size();
+          sent = controller->SendRequest(clients.device_uids[next_device], options.window);
+        }
+        next_device = (next_device + 1) % clients.devices.size();
+        if (!sent)
+          std::this_thread::sleep_for(microseconds(50));
+        break;
+      case BenchOp::kNotification:
+        sent = clients.devices[next_device]->SendNotification().IsOk();
+        next_device = (next_device + 1) % clients.devices.size();
+        break;
+      case BenchOp::kBroadcast:
+        sent = clients.controllers[next_controller]->SendBroadcast();
+        next_controller = (next_controller + 1) % clients.controllers.size();
+        break;
+    }
+
+    if (sent)
+      ++ops_started;
+
+    if (options.rate)
+    {
+      next_op_time += interval;
+      std::this_thread::sleep_until(next_op_time);
+    }
+  }
+
+  return ops_started;
+}
+
+void PrintLatency(const char* name, LatencyRecorder& recorder)
+{
+  auto summary = recorder.Summarize();
+  std::cout << "  " << std::left << std::setw(14) << name << std::right << std::setw(10) << summary.count;
+  if (summary.count)
+  {
+    std::cout << std::setw(10) << summary.p50_us << std::setw(10) << summary.p99_us << std::setw(10)
+              << summary.p999_us << std::setw(10) << summary.max_us;
+  }
+  std::cout << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+  BenchOptions options;
+  switch (ParseArgs(argc, argv, options))
+  {
+    case ParseResult::kParseErr:
+      PrintHelp(argv[0]);
+      return 1;
+    case ParseResult::kPrintHelp:
+      PrintHelp(argv[0]);
+      return 0;
+    default:
+      break;
+  }
+
+  // The broker must be forked before this process starts any threads.
+  BrokerProcess broker;
+  if (!broker.Start(options))
+  {
+    std::cout << "Broker failed to start on interface '" << options.netint << "', port " << options.port << ".\n";
+    return 1;
+  }
+
+  auto res = rdmnet::Init(nullptr, rdmnet::McastMode::kDisabledOnAllInterfaces);
+  if (!res)
+  {
+    std::cout << "RDMnet library failed to initialize: " << res.ToString() << '\n';
+    return 1;
+  }
+
+  BenchContext     context;
+  ClientSet        clients;
+  etcpal::SockAddr broker_addr(etcpal::IpAddr::FromString("127.0.0.1"), options.port);
+
+  std::cout << "Connecting " << options.num_devices << " devices and " << options.num_controllers
+            << " controllers to the broker...\n";
+  for (size_t i = 0; i < options.num_devices; ++i)
+  {
+    rdm::Uid uid(kBenchManufacturerId, static_cast<uint32_t>(0x00010000 + i));
+    auto     device = std::unique_ptr<SimDevice>(new SimDevice(context));
+    res = device->Startup(uid, broker_addr);
+    if (!res)
+    {
+      std::cout << "Device " << i << " failed to start: " << res.ToString() << '\n';
+      break;
+    }
+    clients.device_uids.push_back(uid);
+    clients.devices.push_back(std::move(device));
+  }
+  for (size_t i = 0; res && i < options.num_controllers; ++i)
+  {
+    rdm::Uid uid(kBenchManufacturerId, static_cast<uint32_t>(0x00020000 + i));
+    auto     controller = std::unique_ptr<SimController>(new SimController(context));
+    res = controller->Startup(uid, broker_addr);
+    if (!res)
+    {
+      std::cout << "Controller " << i << " failed to start: " << res.ToString() << '\n';
+      break;
+    }
+    clients.controllers.push_back(std::move(controller));
+  }
+
+  size_t num_clients = options.num_devices + options.num_controllers;
+  auto   connect_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (res && context.num_connected < num_clients && std::chrono::steady_clock::now() < connect_deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  int exit_code = 1;
+  if (res && context.num_connected == num_clients)
+  {
+    OpMix mix(options);
+    DriveTraffic(options, clients, mix, std::chrono::steady_clock::now() + std::chrono::seconds(options.warmup_sec));
+
+    ProcessUsage usage_start;
+    GetProcessUsage(broker.pid(), usage_start);
+    size_t messages_start = context.messages_received;
+    auto   start = std::chrono::steady_clock::now();
+
+    LatencyRecorder::SetRecording(true);
+    size_t ops = DriveTraffic(options, clients, mix, start + std::chrono::seconds(options.duration_sec));
+    LatencyRecorder::SetRecording(false);
+
+    double elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t messages = context.messages_received - messages_start;
+
+    ProcessUsage usage_end;
+    GetProcessUsage(broker.pid(), usage_end);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\nMeasured " << elapsed_sec << " s with " << options.num_devices << " devices and "
+              << options.num_controllers << " controllers (mix " << options.request_weight << ','
+              << options.notification_weight << ',' << options.broadcast_weight << ").\n\n";
+    std::cout << "Throughput:\n";
+    std::cout << "  Operations started:  " << static_cast<double>(ops) / elapsed_sec << " /s\n";
+    std::cout << "  Messages delivered:  " << static_cast<double>(messages) / elapsed_sec << " /s\n";
+    std::cout << "  Request errors:      " << context.request_errors << '\n';
+    std::cout << "  Disconnects:         " << context.disconnects << '\n';
+    std::cout << "\nLatency (us):\n";
+    std::cout << "  " << std::left << std::setw(14) << "" << std::right << std::setw(10) << "count" << std::setw(10)
+              << "p50" << std::setw(10) << "p99" << std::setw(10) << "p999" << std::setw(10) << "max" << '\n';
+    PrintLatency("request", context.request_latency);
+    PrintLatency("notification", context.notification_latency);
+    PrintLatency("broadcast", context.broadcast_latency);
+    std::cout << "\nBroker process:\n";
+    std::cout << "  CPU:                 " << CpuPercent(usage_start, usage_end, elapsed_sec) << " % of one core\n";
+    std::cout << "  RSS:                 " << usage_end.rss_kb << " kB (peak " << usage_end.hwm_kb << " kB)\n";
+
+    exit_code = (context.disconnects == 0 ? 0 : 1);
+  }
+  else if (res)
+  {
+    std::cout << "Only " << context.num_connected << " of " << num_clients
+              << " clients connected to the broker within 30 seconds.\n";
+  }
+
+  for (auto& controller : clients.controllers)
+    controller->Shutdown();
+  for (auto& device : clients.devices)
+    device->Shutdown();
+  rdmnet::Deinit();
+  broker.Stop();
+  return exit_code;
+}
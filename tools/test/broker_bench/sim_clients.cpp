@@ -0,0 +1,257 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "sim_clients.h"
+
+#include <cstring>
+
+// All RPT devices: the broker forwards commands addressed here to every connected device.
+static const rdm::Uid kAllDevicesUid(0xfffd, 0xffffffff);
+
+static void PackTimestamp(uint8_t* buf, uint64_t timestamp)
+{
+  std::memcpy(buf, &timestamp, kBenchTimestampSize);
+}
+
+static uint64_t UnpackTimestamp(const uint8_t* buf)
+{
+  uint64_t timestamp;
+  std::memcpy(&timestamp, buf, kBenchTimestampSize);
+  return timestamp;
+}
+
+/******************************************************************************
+ * SimDevice
+ *****************************************************************************/
+
+etcpal::Error SimDevice::Startup(const rdm::Uid& uid, const etcpal::SockAddr& broker_addr)
+{
+  rdmnet::Device::Settings settings(etcpal::Uuid::V4(), uid);
+  settings.response_buf = response_buf_.data();
+  return device_.StartupWithDefaultScope(*this, settings, broker_addr);
+}
+
+void SimDevice::Shutdown()
+{
+  device_.Shutdown();
+}
+
+etcpal::Error SimDevice::SendNotification()
+{
+  uint8_t data[kBenchTimestampSize];
+  PackTimestamp(data, BenchTimestampNow());
+  return device_.SendRdmUpdate(kBenchNotificationPid, data, kBenchTimestampSize);
+}
+
+void SimDevice::HandleConnectedToBroker(rdmnet::Device::Handle handle, const rdmnet::ClientConnectedInfo& info)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(info);
+  ++context_.num_connected;
+}
+
+void SimDevice::HandleBrokerConnectFailed(rdmnet::Device::Handle handle, const rdmnet::ClientConnectFailedInfo& info)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(info);
+  ++context_.connect_failures;
+}
+
+void SimDevice::HandleDisconnectedFromBroker(rdmnet::Device::Handle handle, const rdmnet::ClientDisconnectedInfo& info)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(info);
+  --context_.num_connected;
+  ++context_.disconnects;
+}
+
+// Requests are echoed back to the controller so it can measure the round trip; broadcasts are
+// timed here, on arrival.
+rdmnet::RdmResponseAction SimDevice::HandleRdmCommand(rdmnet::Device::Handle handle, const rdmnet::RdmCommand& cmd)
+{
+  ETCPAL_UNUSED_ARG(handle);
+
+  if (cmd.data_len() != kBenchTimestampSize)
+    return rdmnet::RdmResponseAction::SendNack(kRdmNRUnknownPid);
+
+  if (cmd.param_id() == kBenchRequestPid)
+  {
+    std::memcpy(response_buf_.data(), cmd.data(), kBenchTimestampSize);
+    return rdmnet::RdmResponseAction::SendAck(kBenchTimestampSize);
+  }
+  else if (cmd.param_id() == kBenchBroadcastPid)
+  {
+    ++context_.messages_received;
+    context_.broadcast_latency.Record(UnpackTimestamp(cmd.data()));
+    return rdmnet::RdmResponseAction::SendAck();
+  }
+  return rdmnet::RdmResponseAction::SendNack(kRdmNRUnknownPid);
+}
+
+rdmnet::RdmResponseAction SimDevice::HandleLlrpRdmCommand(rdmnet::Device::Handle          handle,
+                                                          const rdmnet::llrp::RdmCommand& cmd)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(cmd);
+  return rdmnet::RdmResponseAction::SendNack(kRdmNRUnknownPid);
+}
+
+/******************************************************************************
+ * SimController
+ *****************************************************************************/
+
+etcpal::Error SimController::Startup(const rdm::Uid& uid, const etcpal::SockAddr& broker_addr)
+{
+  rdmnet::Controller::Settings settings(etcpal::Uuid::V4(), uid);
+  rdmnet::Controller::RdmData  rdm_data(0x0001, 0x00000001, "ETC", "RDMnet Broker Benchmark Controller", "1.0",
+                                        "Benchmark Controller");
+
+  auto res = controller_.Startup(*this, settings, rdm_data);
+  if (!res)
+    return res;
+
+  auto scope_handle = controller_.AddDefaultScope(broker_addr);
+  if (!scope_handle)
+  {
+    controller_.Shutdown();
+    return scope_handle.error();
+  }
+  scope_handle_ = *scope_handle;
+  return etcpal::Error::Ok();
+}
+
+void SimController::Shutdown()
+{
+  controller_.Shutdown();
+}
+
+bool SimController::SendRequest(const rdm::Uid& device_uid, size_t max_outstanding)
+{
+  if (outstanding_requests_ >= max_outstanding)
+    return false;
+
+  uint8_t data[kBenchTimestampSize];
+  PackTimestamp(data, BenchTimestampNow());
+
+  ++outstanding_requests_;
+  auto res = controller_.SendGetCommand(scope_handle_, rdmnet::DestinationAddr::ToDefaultResponder(device_uid),
+                                        kBenchRequestPid, data, kBenchTimestampSize);
+  if (!res)
+  {
+    --outstanding_requests_;
+    return false;
+  }
+  return true;
+}
+
+bool SimController::SendBroadcast()
+{
+  uint8_t data[kBenchTimestampSize];
+  PackTimestamp(data, BenchTimestampNow());
+
+  return controller_
+      .SendSetCommand(scope_handle_, rdmnet::DestinationAddr::ToDefaultResponder(kAllDevicesUid), kBenchBroadcastPid,
+                      data, kBenchTimestampSize)
+      .has_value();
+}
+
+void SimController::HandleConnectedToBroker(rdmnet::Controller::Handle         handle,
+                                            rdmnet::ScopeHandle                scope_handle,
+                                            const rdmnet::ClientConnectedInfo& info)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(scope_handle);
+  ETCPAL_UNUSED_ARG(info);
+  ++context_.num_connected;
+}
+
+void SimController::HandleBrokerConnectFailed(rdmnet::Controller::Handle             handle,
+                                              rdmnet::ScopeHandle                    scope_handle,
+                                              const rdmnet::ClientConnectFailedInfo& info)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(scope_handle);
+  ETCPAL_UNUSED_ARG(info);
+  ++context_.connect_failures;
+}
+
+void SimController::HandleDisconnectedFromBroker(rdmnet::Controller::Handle            handle,
+                                                 rdmnet::ScopeHandle                   scope_handle,
+                                                 const rdmnet::ClientDisconnectedInfo& info)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(scope_handle);
+  ETCPAL_UNUSED_ARG(info);
+  --context_.num_connected;
+  ++context_.disconnects;
+  outstanding_requests_ = 0;
+}
+
+void SimController::HandleClientListUpdate(rdmnet::Controller::Handle   handle,
+                                           rdmnet::ScopeHandle          scope_handle,
+                                           client_list_action_t         list_action,
+                                           const rdmnet::RptClientList& list)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(scope_handle);
+  ETCPAL_UNUSED_ARG(list_action);
+  ETCPAL_UNUSED_ARG(list);
+}
+
+bool SimController::HandleRdmResponse(rdmnet::Controller::Handle handle,
+                                      rdmnet::ScopeHandle        scope_handle,
+                                      const rdmnet::RdmResponse& resp)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(scope_handle);
+
+  if (resp.param_id() == kBenchRequestPid && resp.IsResponseToMe())
+  {
+    if (outstanding_requests_ > 0)
+      --outstanding_requests_;
+    ++context_.messages_received;
+    if (resp.IsAck() && resp.data_len() == kBenchTimestampSize)
+      context_.request_latency.Record(UnpackTimestamp(resp.data()));
+    else
+      ++context_.request_errors;
+  }
+  else if (resp.param_id() == kBenchNotificationPid && resp.data_len() == kBenchTimestampSize)
+  {
+    ++context_.messages_received;
+    context_.notification_latency.Record(UnpackTimestamp(resp.data()));
+  }
+  return true;
+}
+
+void SimController::HandleRptStatus(rdmnet::Controller::Handle handle,
+                                    rdmnet::ScopeHandle        scope_handle,
+                                    const rdmnet::RptStatus&   status)
+{
+  ETCPAL_UNUSED_ARG(handle);
+  ETCPAL_UNUSED_ARG(scope_handle);
+
+  // Broadcasts are acknowledged by the broker with a status message; anything else means a request
+  // was not delivered.
+  if (status.status_code() != kRptStatusBroadcastComplete)
+  {
+    if (outstanding_requests_ > 0)
+      --outstanding_requests_;
+    ++context_.request_errors;
+  }
+}
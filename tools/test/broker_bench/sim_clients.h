@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#ifndef SIM_CLIENTS_H_
+#define SIM_CLIENTS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "etcpal/cpp/inet.h"
+#include "rdmnet/cpp/controller.h"
+#include "rdmnet/cpp/device.h"
+#include "bench_stats.h"
+
+// Manufacturer-specific PIDs used for benchmark traffic. Each carries an 8-byte timestamp from
+// BenchTimestampNow() as its parameter data.
+constexpr uint16_t kBenchRequestPid = 0x8001;       // Controller GET, echoed back by the device
+constexpr uint16_t kBenchNotificationPid = 0x8002;  // Unsolicited device update to all controllers
+constexpr uint16_t kBenchBroadcastPid = 0x8003;     // Controller SET to all devices
+
+constexpr size_t kBenchTimestampSize = 8;
+
+// State shared between all simulated clients.
+struct BenchContext
+{
+  LatencyRecorder request_latency;
+  LatencyRecorder notification_latency;
+  LatencyRecorder broadcast_latency;
+
+  std::atomic<size_t> num_connected{0};
+  std::atomic<size_t> messages_received{0};  // Benchmark messages delivered to any client
+  std::atomic<size_t> request_errors{0};     // Benchmark requests answered with a NACK or RPT status
+  std::atomic<size_t> connect_failures{0};
+  std::atomic<size_t> disconnects{0};
+};
+
+// SimDevice : An RPT device with a single default responder which answers benchmark requests and
+// sends benchmark notifications.
+class SimDevice : public rdmnet::Device::NotifyHandler
+{
+public:
+  explicit SimDevice(BenchContext& context) : context_(context) {}
+
+  etcpal::Error Startup(const rdm::Uid& uid, const etcpal::SockAddr& broker_addr);
+  void          Shutdown();
+
+  etcpal::Error SendNotification();
+
+private:
+  void HandleConnectedToBroker(rdmnet::Device::Handle handle, const rdmnet::ClientConnectedInfo& info) override;
+  void HandleBrokerConnectFailed(rdmnet::Device::Handle handle, const rdmnet::ClientConnectFailedInfo& info) override;
+  void HandleDisconnectedFromBroker(rdmnet::Device::Handle                handle,
+                                    const rdmnet::ClientDisconnectedInfo& info) override;
+  rdmnet::RdmResponseAction HandleRdmCommand(rdmnet::Device::Handle handle, const rdmnet::RdmCommand& cmd) override;
+  rdmnet::RdmResponseAction HandleLlrpRdmCommand(rdmnet::Device::Handle          handle,
+                                                 const rdmnet::llrp::RdmCommand& cmd) override;
+
+  BenchContext&                    context_;
+  rdmnet::Device                   device_;
+  std::array<uint8_t, RDM_MAX_PDL> response_buf_{};
+};
+
+// SimController : An RPT controller which sends benchmark requests and broadcasts and receives
+// benchmark notifications.
+class SimController : public rdmnet::Controller::NotifyHandler
+{
+public:
+  explicit SimController(BenchContext& context) : context_(context) {}
+
+  etcpal::Error Startup(const rdm::Uid& uid, const etcpal::SockAddr& broker_addr);
+  void          Shutdown();
+
+  // Send a benchmark request, unless this controller already has max_outstanding requests awaiting
+  // responses. Returns false if the request was not sent.
+  bool SendRequest(const rdm::Uid& device_uid, size_t max_outstanding);
+  bool SendBroadcast();
+
+private:
+  void HandleConnectedToBroker(rdmnet::Controller::Handle         handle,
+                               rdmnet::ScopeHandle                scope_handle,
+                               const rdmnet::ClientConnectedInfo& info) override;
+  void HandleBrokerConnectFailed(rdmnet::Controller::Handle             handle,
+                                 rdmnet::ScopeHandle                    scope_handle,
+                                 const rdmnet::ClientConnectFailedInfo& info) override;
+  void HandleDisconnectedFromBroker(rdmnet::Controller::Handle            handle,
+                                    rdmnet::ScopeHandle                   scope_handle,
+                                    const rdmnet::ClientDisconnectedInfo& info) override;
+  void HandleClientListUpdate(rdmnet::Controller::Handle   handle,
+                              rdmnet::ScopeHandle          scope_handle,
+                              client_list_action_t         list_action,
+                              const rdmnet::RptClientList& list) override;
+  bool HandleRdmResponse(rdmnet::Controller::Handle handle,
+                         rdmnet::ScopeHandle        scope_handle,
+                         const rdmnet::RdmResponse& resp) override;
+  void HandleRptStatus(rdmnet::Controller::Handle handle,
+                       rdmnet::ScopeHandle        scope_handle,
+                       const rdmnet::RptStatus&   status) override;
+
+  BenchContext&       context_;
+  rdmnet::Controller  controller_;
+  rdmnet::ScopeHandle scope_handle_{};
+  std::atomic<size_t> outstanding_requests_{0};
+};
+
+#endif  // SIM_CLIENTS_H_